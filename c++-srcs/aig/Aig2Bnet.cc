@@ -20,16 +20,20 @@ void
 Aig2Bnet::conv(
   const AigModel& aig,
   const string& clock_name,
-  const string& reset_name
+  const string& reset_name,
+  bool prim_and
 )
 {
-  mLitMap.clear();
-
   SizeType ni = aig.I();
   SizeType no = aig.O();
   SizeType nl = aig.L();
   SizeType na = aig.A();
 
+  // リテラルは 0 から (M + 1) * 2 - 1 までの値をとる．
+  SizeType nlit = (aig.M() + 1) * 2;
+  mLitMap.clear();
+  mLitMap.resize(nlit);
+
   // 入力ポートの生成
   for ( SizeType i = 0; i < ni; ++ i ) {
     auto name = aig.input_symbol(i);
@@ -41,7 +45,7 @@ Aig2Bnet::conv(
     auto port = new_input_port(name);
     auto node = port.bit(0);
     auto lit = aig.input(i);
-    mLitMap.emplace(lit, node);
+    mLitMap[lit] = node;
   }
 
   // 出力ポートの生成
@@ -81,12 +85,12 @@ Aig2Bnet::conv(
     set_output_src(dff.clear(), reset_node);
     auto node = dff.data_out();
     auto lit = aig.latch(i);
-    mLitMap.emplace(lit, node);
+    mLitMap[lit] = node;
     latch_list[i] = dff.data_in();
   }
 
   // 必要とされている極性を調べる．
-  vector<bool> req_map((ni + nl + na + 1) * 2, false);
+  vector<bool> req_map(nlit, false);
   for ( SizeType i = 0; i < no; ++ i ) {
     auto src = aig.output_src(i);
     req_map[src] = true;
@@ -102,9 +106,9 @@ Aig2Bnet::conv(
     auto lit = aig.input(i);
     auto lit1 = lit ^ 1UL;
     if ( req_map[lit1] ) {
-      auto src_node = mLitMap.at(lit);
+      auto src_node = mLitMap[lit];
       auto node1 = new_not(string{}, src_node);
-      mLitMap.emplace(lit1, node1);
+      mLitMap[lit1] = node1;
     }
   }
 
@@ -114,64 +118,158 @@ Aig2Bnet::conv(
     buf << "a" << i;
     auto src1 = aig.and_src1(i);
     auto src2 = aig.and_src2(i);
-
-    auto l1 = Expr::make_posi_literal(0);
-    if ( mLitMap.count(src1) == 0 ) {
-      l1 = ~l1;
-      src1 ^= 1UL;
-    }
-    ASSERT_COND( mLitMap.count(src1) > 0 );
-    auto i1 = mLitMap.at(src1);
-
-    auto l2 = Expr::make_posi_literal(1);
-    if ( mLitMap.count(src2) == 0 ) {
-      l2 = ~l2;
-      src2 ^= 1UL;
-    }
-    ASSERT_COND( mLitMap.count(src2) > 0 );
-    auto i2 = mLitMap.at(src2);
-
-    auto expr = l1 & l2;
+    make_const(src1);
+    make_const(src2);
     auto lit = aig.and_node(i);
-    auto lit1 = lit ^ 1UL;
-    if ( !req_map[lit] && req_map[lit1] ) {
-      expr = ~expr;
-      auto node1 = new_logic_expr(buf.str(), expr, {i1, i2});
-      mLitMap.emplace(lit1, node1);
+    if ( prim_and ) {
+      make_prim_and(buf.str(), lit, src1, src2, req_map);
     }
     else {
-      auto node = new_logic_expr(buf.str(), expr, {i1, i2});
-      mLitMap.emplace(lit, node);
-      if ( req_map[lit1] ) {
-	auto node1 = new_not(string{}, node);
-	mLitMap.emplace(lit1, node1);
-      }
+      make_expr_and(buf.str(), lit, src1, src2, req_map);
     }
   }
 
   // 出力の接続
   for ( SizeType i = 0; i < no; ++ i ) {
     auto src_lit = aig.output_src(i);
-    ASSERT_COND ( mLitMap.count(src_lit) >  0 );
-    auto src_node = mLitMap.at(src_lit);
+    make_const(src_lit);
+    auto src_node = mLitMap[src_lit];
+    ASSERT_COND( src_node.is_valid() );
     set_output_src(output_list[i], src_node);
   }
 
   // ラッチの入力の接続
   for ( SizeType i = 0; i < nl; ++ i ) {
     auto src_lit = aig.latch_src(i);
-    ASSERT_COND( mLitMap.count(src_lit) > 0 );
-    auto src_node = mLitMap.at(src_lit);
+    make_const(src_lit);
+    auto src_node = mLitMap[src_lit];
+    ASSERT_COND( src_node.is_valid() );
     set_output_src(latch_list[i], src_node);
   }
 }
 
+// @brief 定数リテラルに対応するノードを用意する．
+void
+Aig2Bnet::make_const(
+  SizeType lit
+)
+{
+  if ( lit > 1 || mLitMap[lit].is_valid() ) {
+    return;
+  }
+  if ( lit == 0 ) {
+    mLitMap[lit] = new_c0(string{});
+  }
+  else {
+    mLitMap[lit] = new_c1(string{});
+  }
+}
+
+// @brief 論理式型の AND ノードを作る．
+void
+Aig2Bnet::make_expr_and(
+  const string& name,
+  SizeType lit,
+  SizeType src1,
+  SizeType src2,
+  const vector<bool>& req_map
+)
+{
+  auto l1 = Expr::make_posi_literal(0);
+  if ( mLitMap[src1].is_invalid() ) {
+    l1 = ~l1;
+    src1 ^= 1UL;
+  }
+  auto i1 = mLitMap[src1];
+  ASSERT_COND( i1.is_valid() );
+
+  auto l2 = Expr::make_posi_literal(1);
+  if ( mLitMap[src2].is_invalid() ) {
+    l2 = ~l2;
+    src2 ^= 1UL;
+  }
+  auto i2 = mLitMap[src2];
+  ASSERT_COND( i2.is_valid() );
+
+  auto expr = l1 & l2;
+  auto lit1 = lit ^ 1UL;
+  if ( !req_map[lit] && req_map[lit1] ) {
+    expr = ~expr;
+    auto node1 = new_logic_expr(name, expr, {i1, i2});
+    mLitMap[lit1] = node1;
+  }
+  else {
+    auto node = new_logic_expr(name, expr, {i1, i2});
+    mLitMap[lit] = node;
+    if ( req_map[lit1] ) {
+      auto node1 = new_not(string{}, node);
+      mLitMap[lit1] = node1;
+    }
+  }
+}
+
+// @brief 組み込み型の AND ノードを作る．
+//
+// 両方のファンインのノードがあれば AND(NAND) を用いる．
+// 両方のファンインの否定のノードがあれば NOR(OR) を用いる．
+// それ以外の場合は足りない極性のインバータを作って AND(NAND) を用いる．
+// インバータは mLitMap に登録されるので同じリテラルを参照する
+// 他のノードと共有される．
+void
+Aig2Bnet::make_prim_and(
+  const string& name,
+  SizeType lit,
+  SizeType src1,
+  SizeType src2,
+  const vector<bool>& req_map
+)
+{
+  PrimType type = PrimType::And;
+  PrimType ntype = PrimType::Nand;
+  if ( (mLitMap[src1].is_invalid() || mLitMap[src2].is_invalid()) &&
+       mLitMap[src1 ^ 1UL].is_valid() && mLitMap[src2 ^ 1UL].is_valid() ) {
+    type = PrimType::Nor;
+    ntype = PrimType::Or;
+    src1 ^= 1UL;
+    src2 ^= 1UL;
+  }
+  else {
+    if ( mLitMap[src1].is_invalid() ) {
+      auto src_node = mLitMap[src1 ^ 1UL];
+      ASSERT_COND( src_node.is_valid() );
+      mLitMap[src1] = new_not(string{}, src_node);
+    }
+    if ( mLitMap[src2].is_invalid() ) {
+      auto src_node = mLitMap[src2 ^ 1UL];
+      ASSERT_COND( src_node.is_valid() );
+      mLitMap[src2] = new_not(string{}, src_node);
+    }
+  }
+  auto i1 = mLitMap[src1];
+  auto i2 = mLitMap[src2];
+
+  auto lit1 = lit ^ 1UL;
+  if ( !req_map[lit] && req_map[lit1] ) {
+    auto node1 = new_logic_primitive(name, ntype, {i1, i2});
+    mLitMap[lit1] = node1;
+  }
+  else {
+    auto node = new_logic_primitive(name, type, {i1, i2});
+    mLitMap[lit] = node;
+    if ( req_map[lit1] ) {
+      auto node1 = new_not(string{}, node);
+      mLitMap[lit1] = node1;
+    }
+  }
+}
+
 // @brief .aag 形式のファイルを読み込む．
 BnNetwork
 BnNetwork::read_aag(
   const string& filename,
   const string& clock_name,
-  const string& reset_name
+  const string& reset_name,
+  bool prim_and
 )
 {
   AigModel aig;
@@ -182,7 +280,7 @@ BnNetwork::read_aag(
   }
 
   Aig2Bnet op;
-  op.conv(aig, clock_name, reset_name);
+  op.conv(aig, clock_name, reset_name, prim_and);
   return BnNetwork{std::move(op)};
 }
 
@@ -191,7 +289,8 @@ BnNetwork
 BnNetwork::read_aig(
   const string& filename,
   const string& clock_name,
-  const string& reset_name
+  const string& reset_name,
+  bool prim_and
 )
 {
   AigModel aig;
@@ -202,7 +301,7 @@ BnNetwork::read_aig(
   }
 
   Aig2Bnet op;
-  op.conv(aig, clock_name, reset_name);
+  op.conv(aig, clock_name, reset_name, prim_and);
   return BnNetwork{std::move(op)};
 }
 
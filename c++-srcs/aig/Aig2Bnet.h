@@ -36,11 +36,52 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief AIG から変換する．
+  ///
+  /// prim_and が false の場合，ANDノードはファンインの極性を含んだ
+  /// 論理式型のノードとなる．
+  /// prim_and が true の場合，ANDノードは組み込み型のノードとなる．
+  /// ファンインと出力の極性は AND/NAND/OR/NOR の型に吸収し，
+  /// 吸収できない場合のみインバータを用いる．
   void
   conv(
     const AigModel& aig,      ///< [in] AIG の情報
     const string& clock_name, ///< [in] クロック端子の名前
-    const string& reset_name  ///< [in] リセット端子の名前
+    const string& reset_name, ///< [in] リセット端子の名前
+    bool prim_and = false     ///< [in] 組み込み型のANDノードを用いる時 true
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 定数リテラルに対応するノードを用意する．
+  ///
+  /// lit が定数でない場合はなにもしない．
+  void
+  make_const(
+    SizeType lit ///< [in] リテラル
+  );
+
+  /// @brief 論理式型の AND ノードを作る．
+  void
+  make_expr_and(
+    const string& name,      ///< [in] ノード名
+    SizeType lit,            ///< [in] 出力のリテラル
+    SizeType src1,           ///< [in] ソース1のリテラル
+    SizeType src2,           ///< [in] ソース2のリテラル
+    const vector<bool>& req_map ///< [in] 必要とされている極性
+  );
+
+  /// @brief 組み込み型の AND ノードを作る．
+  void
+  make_prim_and(
+    const string& name,      ///< [in] ノード名
+    SizeType lit,            ///< [in] 出力のリテラル
+    SizeType src1,           ///< [in] ソース1のリテラル
+    SizeType src2,           ///< [in] ソース2のリテラル
+    const vector<bool>& req_map ///< [in] 必要とされている極性
   );
 
 
@@ -49,8 +90,9 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // AIG のリテラルと BnNetwork のノードの対応表
-  unordered_map<SizeType, BnNode> mLitMap;
+  // AIG のリテラルをキーにして BnNetwork のノードを格納する配列
+  // 対応するノードがない場合は不正値となる．
+  vector<BnNode> mLitMap;
 
 };
 
@@ -8,6 +8,9 @@
 
 #include "ym/AigModel.h"
 #include "ModelImpl.h"
+#include "Bnet2Aig.h"
+#include "CompStream.h"
+#include "MappedFile.h"
 
 
 BEGIN_NAMESPACE_YM_AIG
@@ -34,7 +37,7 @@ AigModel::read_aag(
   const string& filename
 )
 {
-  ifstream s{filename};
+  nsBnet::CompInStream s{filename};
   if ( s ) {
     return read_aag(s);
   }
@@ -51,16 +54,19 @@ AigModel::read_aag(
 }
 
 // @brief AIG フォーマットを読み込む．
+//
+// ファイルの内容を MappedFile でメモリ上に置いて直接デコードする．
+// gzip/zstd で圧縮されている場合は展開した内容をデコードする．
 bool
 AigModel::read_aig(
   const string& filename
 )
 {
-  ifstream s{filename};
-  if ( s ) {
-    return read_aig(s);
+  nsBnet::MappedFile file{filename};
+  if ( !file.is_valid() ) {
+    return false;
   }
-  return false;
+  return mImpl->read_aig(file.contents());
 }
 
 // @brief AIG フォーマットを読み込む．
@@ -72,6 +78,84 @@ AigModel::read_aig(
   return mImpl->read_aig(s);
 }
 
+// @brief Ascii AIG フォーマットで出力する．
+void
+AigModel::write_aag(
+  const string& filename,
+  const string& comment
+) const
+{
+  AigWriter s{filename};
+  if ( s.is_valid() ) {
+    mImpl->write_aag(s, comment);
+    s.close();
+    if ( !s.is_ok() ) {
+      ostringstream buf;
+      buf << filename << ": Write error";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+}
+
+// @brief Ascii AIG フォーマットで出力する．
+void
+AigModel::write_aag(
+  ostream& s,
+  const string& comment
+) const
+{
+  AigWriter writer{s};
+  mImpl->write_aag(writer, comment);
+  writer.close();
+  if ( !writer.is_ok() ) {
+    throw std::invalid_argument{"AigModel::write_aag(): Write error"};
+  }
+}
+
+// @brief AIG フォーマットで出力する．
+void
+AigModel::write_aig(
+  const string& filename,
+  const string& comment
+) const
+{
+  AigWriter s{filename};
+  if ( s.is_valid() ) {
+    mImpl->write_aig(s, comment);
+    s.close();
+    if ( !s.is_ok() ) {
+      ostringstream buf;
+      buf << filename << ": Write error";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+}
+
+// @brief AIG フォーマットで出力する．
+void
+AigModel::write_aig(
+  ostream& s,
+  const string& comment
+) const
+{
+  AigWriter writer{s};
+  mImpl->write_aig(writer, comment);
+  writer.close();
+  if ( !writer.is_ok() ) {
+    throw std::invalid_argument{"AigModel::write_aig(): Write error"};
+  }
+}
+
+// @brief BnNetwork の内容を変換する．
+bool
+AigModel::from_bnet(
+  const BnNetwork& network
+)
+{
+  nsBnet::Bnet2Aig op;
+  return op.conv(network, *mImpl);
+}
+
 // @brief 変数番号の最大値を返す．
 SizeType
 AigModel::M() const
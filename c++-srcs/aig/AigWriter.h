@@ -0,0 +1,72 @@
+#ifndef AIGWRITER_H
+#define AIGWRITER_H
+
+/// @file AigWriter.h
+/// @brief AigWriter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/aig_nsdef.h"
+#include "OutBuffer.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+//////////////////////////////////////////////////////////////////////
+/// @class AigWriter AigWriter.h "AigWriter.h"
+/// @brief AIG ファイルを出力するためのバッファ付きの出力器
+///
+/// OutBuffer に aig 形式の差分符号の出力を加えたもの．
+//////////////////////////////////////////////////////////////////////
+class AigWriter :
+  public nsBnet::OutBuffer
+{
+public:
+
+  /// @brief ストリームに書き出すコンストラクタ
+  AigWriter(
+    ostream& s ///< [in] 出力ストリーム
+  ) : OutBuffer{s}
+  {
+  }
+
+  /// @brief ファイルに書き出すコンストラクタ
+  ///
+  /// ファイルがオープンできなかった場合は is_valid() が false となる．
+  AigWriter(
+    const string& filename ///< [in] ファイル名
+  ) : OutBuffer{filename}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~AigWriter() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 数値を aig 形式の差分符号で出力する．
+  ///
+  /// 下位から7ビットずつ区切って，後続がある場合は最上位ビットを立てる．
+  void
+  put_delta(
+    SizeType num ///< [in] 数値
+  )
+  {
+    while ( num > 127 ) {
+      put_char(static_cast<char>((num & 127) | 128));
+      num >>= 7;
+    }
+    put_char(static_cast<char>(num));
+  }
+
+};
+
+END_NAMESPACE_YM_AIG
+
+#endif // AIGWRITER_H
@@ -0,0 +1,652 @@
+
+/// @file Bnet2Aig.cc
+/// @brief Bnet2Aig の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Bnet2Aig.h"
+#include "ModelImpl.h"
+#include "AigWriter.h"
+#include "ym/AigModel.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNode.h"
+#include "ym/BnNodeList.h"
+#include "ym/BnDff.h"
+#include <algorithm>
+#include <queue>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// 未定義を表す値
+const SizeType UNDEF = static_cast<SizeType>(-1);
+
+END_NONAMESPACE
+
+// @brief BnNetwork の内容を変換する．
+bool
+Bnet2Aig::conv(
+  const BnNetwork& src_network,
+  nsAig::ModelImpl& model
+)
+{
+  vector<SizeType> lit_map;
+  if ( !make_aig(src_network, lit_map) ) {
+    return false;
+  }
+
+  auto input_list = src_network.primary_input_list();
+  auto output_list = src_network.primary_output_list();
+  SizeType I = input_list.size();
+  SizeType L = src_network.dff_num();
+  SizeType O = output_list.size();
+
+  // 結果を model に設定する．
+  SizeType A = mAndList.size();
+  model.initialize(I, L, O, A);
+  for ( SizeType i = 0; i < A; ++ i ) {
+    const auto& and_info = mAndList[i];
+    model.set_and_src(i, and_info.mSrc1, and_info.mSrc2);
+  }
+  // ラッチのソースとシンボル名を設定する．
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto dff = src_network.dff(i);
+    auto src_id = dff.data_in().output_src().id();
+    auto src = lit_map[src_id];
+    ASSERT_COND( src != UNDEF );
+    model.set_latch_src(i, src);
+    model.set_latch_symbol(i, dff.name());
+  }
+  // 出力のソースとシンボル名を設定する．
+  for ( SizeType i = 0; i < O; ++ i ) {
+    auto node = output_list[i];
+    auto src_id = node.output_src().id();
+    auto src = lit_map[src_id];
+    ASSERT_COND( src != UNDEF );
+    model.set_output_src(i, src);
+    model.set_output_symbol(i, node.name());
+  }
+  // 入力のシンボル名を設定する．
+  for ( SizeType i = 0; i < I; ++ i ) {
+    model.set_input_symbol(i, input_list[i].name());
+  }
+
+  mAndList.clear();
+  mAndHash.clear();
+
+  return true;
+}
+
+// @brief BnNetwork の内容を変換して直接出力する．
+bool
+Bnet2Aig::write(
+  const BnNetwork& src_network,
+  nsAig::AigWriter& s,
+  const string& comment,
+  bool ascii
+)
+{
+  vector<SizeType> lit_map;
+  if ( !make_aig(src_network, lit_map) ) {
+    return false;
+  }
+
+  auto input_list = src_network.primary_input_list();
+  auto output_list = src_network.primary_output_list();
+  SizeType I = input_list.size();
+  SizeType L = src_network.dff_num();
+  SizeType O = output_list.size();
+  SizeType A = mAndList.size();
+
+  // ヘッダ行の出力
+  s.put_string(ascii ? "aag " : "aig ");
+  s.put_decimal(I + L + A);
+  s.put_char(' ');
+  s.put_decimal(I);
+  s.put_char(' ');
+  s.put_decimal(L);
+  s.put_char(' ');
+  s.put_decimal(O);
+  s.put_char(' ');
+  s.put_decimal(A);
+  s.put_char('\n');
+
+  // 入力行の出力
+  if ( ascii ) {
+    for ( SizeType i = 0; i < I; ++ i ) {
+      s.put_decimal((i + 1) * 2);
+      s.put_char('\n');
+    }
+  }
+
+  // ラッチ行の出力
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto dff = src_network.dff(i);
+    auto src = lit_map[dff.data_in().output_src().id()];
+    ASSERT_COND( src != UNDEF );
+    if ( ascii ) {
+      s.put_decimal((i + I + 1) * 2);
+      s.put_char(' ');
+    }
+    s.put_decimal(src);
+    s.put_char('\n');
+  }
+
+  // 出力行の出力
+  for ( SizeType i = 0; i < O; ++ i ) {
+    auto src = lit_map[output_list[i].output_src().id()];
+    ASSERT_COND( src != UNDEF );
+    s.put_decimal(src);
+    s.put_char('\n');
+  }
+
+  // AND行の出力
+  // mAndList の src1 >= src2 は make_and() で保証されている．
+  for ( SizeType i = 0; i < A; ++ i ) {
+    const auto& and_info = mAndList[i];
+    SizeType lhs = (i + mBaseId + 1) * 2;
+    if ( ascii ) {
+      s.put_decimal(lhs);
+      s.put_char(' ');
+      s.put_decimal(and_info.mSrc1);
+      s.put_char(' ');
+      s.put_decimal(and_info.mSrc2);
+      s.put_char('\n');
+    }
+    else {
+      s.put_delta(lhs - and_info.mSrc1);
+      s.put_delta(and_info.mSrc1 - and_info.mSrc2);
+    }
+  }
+
+  mAndList.clear();
+  mAndHash.clear();
+
+  // シンボルテーブルの出力
+  for ( SizeType i = 0; i < I; ++ i ) {
+    nsAig::ModelImpl::write_symbol(s, 'i', i, input_list[i].name());
+  }
+  for ( SizeType i = 0; i < L; ++ i ) {
+    nsAig::ModelImpl::write_symbol(s, 'l', i, src_network.dff(i).name());
+  }
+  for ( SizeType i = 0; i < O; ++ i ) {
+    nsAig::ModelImpl::write_symbol(s, 'o', i, output_list[i].name());
+  }
+
+  // コメントの出力
+  nsAig::ModelImpl::write_comment(s, comment);
+
+  return true;
+}
+
+// @brief BnNetwork の内容を AND ノードのリストに変換する．
+bool
+Bnet2Aig::make_aig(
+  const BnNetwork& src_network,
+  vector<SizeType>& lit_map
+)
+{
+  auto input_list = src_network.primary_input_list();
+  SizeType I = input_list.size();
+  SizeType L = src_network.dff_num();
+
+  // Latchタイプ，Cellタイプの BnDff やクリア/プリセットを持つとき変換不能
+  for ( auto dff: src_network.dff_list() ) {
+    if ( dff.type() != BnDffType::Dff ) {
+      return false;
+    }
+    if ( dff.clear().is_valid() || dff.preset().is_valid() ) {
+      return false;
+    }
+  }
+  // TvFuncタイプ，Bddタイプ，Cellタイプの論理ノードを持つ時変換不能
+  for ( auto node: src_network.logic_list() ) {
+    if ( node.type() == BnNodeType::TvFunc ||
+	 node.type() == BnNodeType::Bdd ||
+	 node.type() == BnNodeType::Cell ) {
+      return false;
+    }
+  }
+
+  mBaseId = I + L;
+  mAndList.clear();
+  mAndHash.clear();
+
+  // ノード番号をキーにしてリテラルを格納する配列
+  lit_map.clear();
+  lit_map.resize(src_network.node_num() + 1, UNDEF);
+
+  // 入力ノードを登録する．
+  for ( SizeType i = 0; i < I; ++ i ) {
+    lit_map[input_list[i].id()] = (i + 1) * 2;
+  }
+  // ラッチノード(DFFの出力ノード)を登録する．
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto dff = src_network.dff(i);
+    lit_map[dff.data_out().id()] = (i + I + 1) * 2;
+  }
+  // AND ノードを生成する．
+  make_logic(src_network, lit_map);
+
+  return true;
+}
+
+// @brief BnNetwork の組み合わせ回路部分を AIG に変換する．
+bool
+Bnet2Aig::make_comb(
+  const BnNetwork& src_network,
+  vector<SizeType>& lit_map
+)
+{
+  // TvFuncタイプ，Bddタイプの論理ノードを持つ時変換不能
+  for ( auto node: src_network.logic_list() ) {
+    if ( node.type() == BnNodeType::TvFunc ||
+	 node.type() == BnNodeType::Bdd ) {
+      return false;
+    }
+  }
+
+  auto input_list = src_network.input_list();
+  SizeType I = input_list.size();
+
+  mBaseId = I;
+  mAndList.clear();
+  mAndHash.clear();
+
+  lit_map.clear();
+  lit_map.resize(src_network.node_num() + 1, UNDEF);
+
+  // 入力ノードを登録する．
+  for ( SizeType i = 0; i < I; ++ i ) {
+    lit_map[input_list[i].id()] = (i + 1) * 2;
+  }
+  make_logic(src_network, lit_map);
+
+  return true;
+}
+
+// @brief 論理ノードを AND ノードのリストに変換する．
+void
+Bnet2Aig::make_logic(
+  const BnNetwork& src_network,
+  vector<SizeType>& lit_map
+)
+{
+  // logic_list() はトポロジカル順とは限らない．
+  vector<SizeType> fanin_list;
+  for ( auto node: src_network.sorted_logic_list() ) {
+    if ( node.type() == BnNodeType::Cell ) {
+      // 葉とする．
+      SizeType var = mAndList.size() + mBaseId + 1;
+      mAndList.push_back(AndInfo{0, 0, 0});
+      lit_map[node.id()] = var * 2;
+      continue;
+    }
+    SizeType ni = node.fanin_num();
+    // ファンインのリテラルのリスト
+    fanin_list.resize(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto ilit = lit_map[node.fanin_id(i)];
+      ASSERT_COND( ilit != UNDEF );
+      fanin_list[i] = ilit;
+    }
+    lit_map[node.id()] = make_bnnode(node, src_network, fanin_list);
+  }
+}
+
+// @brief 2入力の AND ノードを作る．
+SizeType
+Bnet2Aig::make_and(
+  SizeType src1,
+  SizeType src2
+)
+{
+  // 自明な場合
+  if ( src1 == 0 || src2 == 0 ) {
+    return 0;
+  }
+  if ( src1 == 1 ) {
+    return src2;
+  }
+  if ( src2 == 1 ) {
+    return src1;
+  }
+  if ( src1 == src2 ) {
+    return src1;
+  }
+  if ( src1 == (src2 ^ 1) ) {
+    return 0;
+  }
+
+  // aig 形式では src1 >= src2 である必要がある．
+  if ( src1 < src2 ) {
+    std::swap(src1, src2);
+  }
+  auto key = make_pair(src1, src2);
+  auto p = mAndHash.find(key);
+  if ( p != mAndHash.end() ) {
+    return p->second;
+  }
+
+  SizeType id = mAndList.size();
+  SizeType lv = std::max(level(src1), level(src2)) + 1;
+  mAndList.push_back(AndInfo{src1, src2, lv});
+  SizeType ans = (id + mBaseId + 1) * 2;
+  mAndHash.emplace(key, ans);
+  return ans;
+}
+
+// @brief 2入力の XOR を作る．
+SizeType
+Bnet2Aig::make_xor(
+  SizeType src1,
+  SizeType src2
+)
+{
+  // 極性を取り除いておくと構造ハッシュで共有されやすくなる．
+  SizeType oinv = (src1 ^ src2) & 1;
+  src1 &= ~static_cast<SizeType>(1);
+  src2 &= ~static_cast<SizeType>(1);
+  if ( src1 == 0 ) {
+    return src2 ^ oinv;
+  }
+  if ( src2 == 0 ) {
+    return src1 ^ oinv;
+  }
+  if ( src1 == src2 ) {
+    return oinv;
+  }
+  SizeType tmp1 = make_and(src1, src2);
+  SizeType tmp2 = make_and(src1 ^ 1, src2 ^ 1);
+  return make_and(tmp1 ^ 1, tmp2 ^ 1) ^ oinv;
+}
+
+// AND ゲートをAIGに変換する．
+SizeType
+Bnet2Aig::make_and(
+  const vector<SizeType>& fanin_lits
+)
+{
+  vector<SizeType> lit_list;
+  lit_list.reserve(fanin_lits.size());
+  for ( auto lit: fanin_lits ) {
+    if ( lit == 0 ) {
+      return 0;
+    }
+    if ( lit != 1 ) {
+      lit_list.push_back(lit);
+    }
+  }
+  if ( lit_list.empty() ) {
+    return 1;
+  }
+
+  // 重複を取り除く．
+  // ソートすると x と ~x は隣り合う．
+  std::sort(lit_list.begin(), lit_list.end());
+  lit_list.erase(std::unique(lit_list.begin(), lit_list.end()), lit_list.end());
+  SizeType n = lit_list.size();
+  for ( SizeType i = 1; i < n; ++ i ) {
+    if ( lit_list[i - 1] == (lit_list[i] ^ 1) ) {
+      return 0;
+    }
+  }
+
+  return make_tree(lit_list, false);
+}
+
+// OR ゲートをAIGに変換する．
+SizeType
+Bnet2Aig::make_or(
+  const vector<SizeType>& fanin_lits
+)
+{
+  vector<SizeType> inv_lits;
+  inv_lits.reserve(fanin_lits.size());
+  for ( auto lit: fanin_lits ) {
+    inv_lits.push_back(lit ^ 1);
+  }
+  return make_and(inv_lits) ^ 1;
+}
+
+// XOR ゲートをAIGに変換する．
+SizeType
+Bnet2Aig::make_xor(
+  const vector<SizeType>& fanin_lits
+)
+{
+  // 極性は出力にまとめる．
+  SizeType oinv = 0;
+  vector<SizeType> lit_list;
+  lit_list.reserve(fanin_lits.size());
+  for ( auto lit: fanin_lits ) {
+    oinv ^= lit & 1;
+    lit &= ~static_cast<SizeType>(1);
+    if ( lit != 0 ) {
+      lit_list.push_back(lit);
+    }
+  }
+
+  // x ^ x = 0 なので偶数個現れるものは取り除く．
+  std::sort(lit_list.begin(), lit_list.end());
+  SizeType n = lit_list.size();
+  SizeType wpos = 0;
+  for ( SizeType rpos = 0; rpos < n; ) {
+    auto lit = lit_list[rpos];
+    SizeType rpos1 = rpos + 1;
+    while ( rpos1 < n && lit_list[rpos1] == lit ) {
+      ++ rpos1;
+    }
+    if ( ((rpos1 - rpos) % 2) == 1 ) {
+      lit_list[wpos] = lit;
+      ++ wpos;
+    }
+    rpos = rpos1;
+  }
+  lit_list.erase(lit_list.begin() + wpos, lit_list.end());
+  if ( lit_list.empty() ) {
+    return oinv;
+  }
+
+  return make_tree(lit_list, true) ^ oinv;
+}
+
+// @brief 段数が最小になるように2入力の木で分解する．
+SizeType
+Bnet2Aig::make_tree(
+  const vector<SizeType>& lit_list,
+  bool is_xor
+)
+{
+  ASSERT_COND( !lit_list.empty() );
+
+  // (段数, リテラル) を段数の小さい順に取り出すヒープ
+  using LitPair = pair<SizeType, SizeType>;
+  std::priority_queue<LitPair, vector<LitPair>, std::greater<LitPair>> queue;
+  for ( auto lit: lit_list ) {
+    queue.push(make_pair(level(lit), lit));
+  }
+  while ( queue.size() > 1 ) {
+    auto lit1 = queue.top().second;
+    queue.pop();
+    auto lit2 = queue.top().second;
+    queue.pop();
+    auto lit = is_xor ? make_xor(lit1, lit2) : make_and(lit1, lit2);
+    queue.push(make_pair(level(lit), lit));
+  }
+  return queue.top().second;
+}
+
+// Expr を AIG に変換する．
+SizeType
+Bnet2Aig::make_expr(
+  const Expr& expr,
+  const vector<SizeType>& fanin_lits
+)
+{
+  if ( expr.is_zero() ) {
+    return 0;
+  }
+  if ( expr.is_one() ) {
+    return 1;
+  }
+  if ( expr.is_posi_literal() ) {
+    return fanin_lits[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return fanin_lits[expr.varid()] ^ 1;
+  }
+  SizeType nc = expr.operand_num();
+  vector<SizeType> opr_lits;
+  opr_lits.reserve(nc);
+  for ( auto& opr: expr.operand_list() ) {
+    auto lit = make_expr(opr, fanin_lits);
+    opr_lits.push_back(lit);
+  }
+  if ( expr.is_and() ) {
+    return make_and(opr_lits);
+  }
+  if ( expr.is_or() ) {
+    return make_or(opr_lits);
+  }
+  if ( expr.is_xor() ) {
+    return make_xor(opr_lits);
+  }
+  ASSERT_NOT_REACHED;
+  return UNDEF;
+}
+
+// BnNode の内容を AIG に変換する．
+SizeType
+Bnet2Aig::make_bnnode(
+  const BnNode& node,
+  const BnNetwork& network,
+  const vector<SizeType>& fanin_lits
+)
+{
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    switch ( node.primitive_type() ) {
+    case PrimType::C0:   // 定数0
+      return 0;
+    case PrimType::C1:   // 定数1
+      return 1;
+    case PrimType::Buff: // バッファ
+      return fanin_lits[0];
+    case PrimType::Not:  // インバータ
+      return fanin_lits[0] ^ 1;
+    case PrimType::And:  // AND
+      return make_and(fanin_lits);
+    case PrimType::Nand: // NAND
+      return make_and(fanin_lits) ^ 1;
+    case PrimType::Or:   // OR
+      return make_or(fanin_lits);
+    case PrimType::Nor:  // NOR
+      return make_or(fanin_lits) ^ 1;
+    case PrimType::Xor:  // XOR
+      return make_xor(fanin_lits);
+    case PrimType::Xnor: // XNOR
+      return make_xor(fanin_lits) ^ 1;
+    case PrimType::None:
+      break;
+    }
+    break;
+  case BnNodeType::Expr: // 論理式
+    return make_expr(network.expr(node.expr_id()), fanin_lits);
+  default:
+    break;
+  }
+  ASSERT_NOT_REACHED;
+  return UNDEF;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 内容を aig 形式で出力する．
+void
+BnNetwork::write_aig(
+  const string& filename,
+  const string& comment
+) const
+{
+  nsAig::AigWriter s{filename};
+  if ( s.is_valid() ) {
+    Bnet2Aig op;
+    if ( !op.write(*this, s, comment, false) ) {
+      cerr << "Cannot convert to aig." << endl;
+    }
+    s.close();
+    if ( !s.is_ok() ) {
+      ostringstream buf;
+      buf << filename << ": Write error";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+}
+
+// @brief 内容を aag (ascii aig) 形式で出力する．
+void
+BnNetwork::write_aag(
+  const string& filename,
+  const string& comment
+) const
+{
+  nsAig::AigWriter s{filename};
+  if ( s.is_valid() ) {
+    Bnet2Aig op;
+    if ( !op.write(*this, s, comment, true) ) {
+      cerr << "Cannot convert to aag." << endl;
+    }
+    s.close();
+    if ( !s.is_ok() ) {
+      ostringstream buf;
+      buf << filename << ": Write error";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+}
+
+// @brief 内容を aig 形式で出力する．
+void
+BnNetwork::write_aig(
+  ostream& s,
+  const string& comment
+) const
+{
+  nsAig::AigWriter writer{s};
+  Bnet2Aig op;
+  if ( !op.write(*this, writer, comment, false) ) {
+    cerr << "Cannot convert to aig." << endl;
+  }
+  writer.close();
+  if ( !writer.is_ok() ) {
+    throw std::invalid_argument{"BnNetwork::write_aig(): Write error"};
+  }
+}
+
+// @brief 内容を aag (ascii aig) 形式で出力する．
+void
+BnNetwork::write_aag(
+  ostream& s,
+  const string& comment
+) const
+{
+  nsAig::AigWriter writer{s};
+  Bnet2Aig op;
+  if ( !op.write(*this, writer, comment, true) ) {
+    cerr << "Cannot convert to aag." << endl;
+  }
+  writer.close();
+  if ( !writer.is_ok() ) {
+    throw std::invalid_argument{"BnNetwork::write_aag(): Write error"};
+  }
+}
+
+END_NAMESPACE_YM_BNET
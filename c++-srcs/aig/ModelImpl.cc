@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "ModelImpl.h"
+#include <cstring>
 
 
 BEGIN_NAMESPACE_YM_AIG
@@ -28,15 +29,24 @@ ModelImpl::initialize(
 {
   mInputList.clear();
   mInputList.resize(I);
+  for ( SizeType i = 0; i < I; ++ i ) {
+    mInputList[i].mLiteral = (i + 1) * 2;
+  }
 
   mLatchList.clear();
   mLatchList.resize(L);
+  for ( SizeType i = 0; i < L; ++ i ) {
+    mLatchList[i].mLiteral = (i + I + 1) * 2;
+  }
 
   mOutputList.clear();
   mOutputList.resize(O);
 
   mAndList.clear();
   mAndList.resize(A);
+  for ( SizeType i = 0; i < A; ++ i ) {
+    mAndList[i].mLiteral = (i + I + L + 1) * 2;
+  }
 
   mComment = string{};
 }
@@ -74,7 +84,10 @@ ModelImpl::read_aag(
   initialize(I, L, O, A);
 
   // 定義されたリテラルの辞書
-  vector<bool> defined(M * 2, false);
+  // 定数(0/1)は定義済みとみなす．
+  vector<bool> defined((M + 1) * 2, false);
+  defined[0] = true;
+  defined[1] = true;
 
   // 入力行の読み込み
   for ( SizeType i = 0; i < I; ++ i ) {
@@ -258,11 +271,6 @@ ModelImpl::read_aig(
   // M は捨てる．
   initialize(I, L, O, A);
 
-  // 入力の情報を作る．
-  for ( SizeType i = 0; i < I; ++ i ) {
-    mInputList[i].mLiteral = (i + 1) * 2;
-  }
-
   // ラッチ行の読み込み
   for ( SizeType i = 0; i < L; ++ i ) {
     if ( !getline(s, linebuf) ) {
@@ -313,6 +321,258 @@ ModelImpl::read_aig(
   return true;
 }
 
+BEGIN_NONAMESPACE
+
+// 行の内容を取り出す．
+//
+// p は次の行の先頭に進む．
+std::string_view
+get_line(
+  const char*& p,
+  const char* end
+)
+{
+  if ( p == end ) {
+    throw std::invalid_argument{"Unexpected EOF"};
+  }
+  auto q = static_cast<const char*>(std::memchr(p, '\n', end - p));
+  if ( q == nullptr ) {
+    q = end;
+  }
+  std::string_view line{p, static_cast<SizeType>(q - p)};
+  p = q < end ? q + 1 : end;
+  return line;
+}
+
+// 行の先頭の10進数を読み出す．
+SizeType
+get_decimal(
+  std::string_view line
+)
+{
+  SizeType num = 0;
+  SizeType i = 0;
+  while ( i < line.size() && line[i] == ' ' ) {
+    ++ i;
+  }
+  if ( i == line.size() || line[i] < '0' || line[i] > '9' ) {
+    ostringstream buf;
+    buf << line << ": Number expected.";
+    throw std::invalid_argument{buf.str()};
+  }
+  for ( ; i < line.size() && line[i] >= '0' && line[i] <= '9'; ++ i ) {
+    num = num * 10 + (line[i] - '0');
+  }
+  return num;
+}
+
+// 差分符号化された数字を一つ読み出す．
+inline
+SizeType
+decode_number(
+  const char*& p,
+  const char* end
+)
+{
+  SizeType num = 0;
+  for ( SizeType shift = 0; ; shift += 7 ) {
+    if ( p == end ) {
+      throw std::invalid_argument{"Unexpected EOF"};
+    }
+    SizeType c = static_cast<unsigned char>(*p);
+    ++ p;
+    num |= (c & 127) << shift;
+    if ( (c & 128) == 0 ) {
+      return num;
+    }
+  }
+}
+
+END_NONAMESPACE
+
+// @brief メモリ上の AIG フォーマットを読み込む．
+bool
+ModelImpl::read_aig(
+  std::string_view contents
+)
+{
+  auto p = contents.data();
+  auto end = p + contents.size();
+
+  // ヘッダ行の読み込み
+  auto header = get_line(p, end);
+  if ( header.substr(0, 3) != "aig" ) {
+    ostringstream buf;
+    buf << header << ": Illegal header signature, 'aig' expected.";
+    throw std::invalid_argument{buf.str()};
+  }
+  istringstream tmp{string{header.substr(3)}};
+  SizeType M, I, L, O, A;
+  if ( !(tmp >> M >> I >> L >> O >> A) || M != I + L + A ) {
+    ostringstream buf;
+    buf << header << ": Illegal header.";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  // M は捨てる．
+  initialize(I, L, O, A);
+
+  // リテラルの上限
+  SizeType max_lit = (M + 1) * 2;
+
+  // ラッチ行の読み込み
+  // 2番目以降の数字(初期値)は読み飛ばす．
+  for ( SizeType i = 0; i < L; ++ i ) {
+    auto src = get_decimal(get_line(p, end));
+    if ( src >= max_lit ) {
+      ostringstream buf;
+      buf << "L#" << i << ": " << src << ": Illegal literal.";
+      throw std::invalid_argument{buf.str()};
+    }
+    mLatchList[i].mSrc = src;
+  }
+
+  // 出力行の読み込み
+  for ( SizeType i = 0; i < O; ++ i ) {
+    auto src = get_decimal(get_line(p, end));
+    if ( src >= max_lit ) {
+      ostringstream buf;
+      buf << "O#" << i << ": " << src << ": Illegal literal.";
+      throw std::invalid_argument{buf.str()};
+    }
+    mOutputList[i].mSrc = src;
+  }
+
+  // AND行の読み込み
+  // mAndList に直接書き込む．
+  SizeType lhs = (I + L) * 2;
+  for ( auto& info: mAndList ) {
+    lhs += 2;
+    auto d0 = decode_number(p, end);
+    auto d1 = decode_number(p, end);
+    // d0 が 0 だと自分自身をファンインに持つことになる．
+    if ( d0 == 0 || d0 > lhs || d1 > lhs - d0 ) {
+      ostringstream buf;
+      buf << "A#" << (lhs / 2 - I - L - 1) << ": Illegal delta.";
+      throw std::invalid_argument{buf.str()};
+    }
+    info.mSrc1 = lhs - d0;
+    info.mSrc2 = info.mSrc1 - d1;
+  }
+
+  // シンボルの読み込み
+  read_symbols(std::string_view{p, static_cast<SizeType>(end - p)});
+
+  return true;
+}
+
+// @brief Ascii AIG フォーマットで出力する．
+void
+ModelImpl::write_aag(
+  AigWriter& s,
+  const string& comment
+) const
+{
+  // ヘッダ行の出力
+  write_header(s, "aag ");
+
+  // 入力行の出力
+  for ( SizeType i = 0; i < I(); ++ i ) {
+    s.put_decimal(input(i));
+    s.put_char('\n');
+  }
+
+  // ラッチ行の出力
+  for ( SizeType i = 0; i < L(); ++ i ) {
+    s.put_decimal(latch(i));
+    s.put_char(' ');
+    s.put_decimal(latch_src(i));
+    s.put_char('\n');
+  }
+
+  // 出力行の出力
+  for ( SizeType i = 0; i < O(); ++ i ) {
+    s.put_decimal(output_src(i));
+    s.put_char('\n');
+  }
+
+  // AND行の出力
+  for ( SizeType i = 0; i < A(); ++ i ) {
+    s.put_decimal(and_node(i));
+    s.put_char(' ');
+    s.put_decimal(and_src1(i));
+    s.put_char(' ');
+    s.put_decimal(and_src2(i));
+    s.put_char('\n');
+  }
+
+  // シンボルテーブルとコメントの出力
+  write_symbols(s, comment);
+}
+
+// @brief AIG フォーマットで出力する．
+void
+ModelImpl::write_aig(
+  AigWriter& s,
+  const string& comment
+) const
+{
+  // ヘッダ行の出力
+  write_header(s, "aig ");
+
+  // ラッチ行の出力
+  for ( SizeType i = 0; i < L(); ++ i ) {
+    ASSERT_COND( latch(i) == (i + I() + 1) * 2 );
+    s.put_decimal(latch_src(i));
+    s.put_char('\n');
+  }
+
+  // 出力行の出力
+  for ( SizeType i = 0; i < O(); ++ i ) {
+    s.put_decimal(output_src(i));
+    s.put_char('\n');
+  }
+
+  // AND行の出力
+  for ( SizeType i = 0; i < A(); ++ i ) {
+    SizeType lhs = and_node(i);
+    SizeType src0 = and_src1(i);
+    SizeType src1 = and_src2(i);
+    if ( src0 < src1 ) {
+      std::swap(src0, src1);
+    }
+    ASSERT_COND( lhs == (i + I() + L() + 1) * 2 );
+    ASSERT_COND( lhs > src0 );
+    SizeType d0 = lhs - src0;
+    SizeType d1 = src0 - src1;
+    s.put_delta(d0);
+    s.put_delta(d1);
+  }
+
+  // シンボルテーブルとコメントの出力
+  write_symbols(s, comment);
+}
+
+// @brief ヘッダ行を出力する．
+void
+ModelImpl::write_header(
+  AigWriter& s,
+  const string& magic
+) const
+{
+  s.put_string(magic);
+  s.put_decimal(M());
+  s.put_char(' ');
+  s.put_decimal(I());
+  s.put_char(' ');
+  s.put_decimal(L());
+  s.put_char(' ');
+  s.put_decimal(O());
+  s.put_char(' ');
+  s.put_decimal(A());
+  s.put_char('\n');
+}
+
 // @brief シンボルテーブルとコメントを読み込む．
 void
 ModelImpl::read_symbols(
@@ -322,33 +582,121 @@ ModelImpl::read_symbols(
   string linebuf;
   bool symbol_mode = true;
   while ( getline(s, linebuf) ) {
-    if ( symbol_mode ) {
-      if ( linebuf == "c" ) {
-	symbol_mode = false;
+    read_symbol_line(linebuf, symbol_mode);
+  }
+}
+
+// @brief メモリ上のシンボルテーブルとコメントを読み込む．
+void
+ModelImpl::read_symbols(
+  std::string_view contents
+)
+{
+  // getline() と同じく最後の改行の後の空の行は読まない．
+  bool symbol_mode = true;
+  SizeType pos = 0;
+  SizeType size = contents.size();
+  while ( pos < size ) {
+    auto p = contents.find('\n', pos);
+    if ( p == std::string_view::npos ) {
+      p = size;
+    }
+    string linebuf{contents.substr(pos, p - pos)};
+    read_symbol_line(linebuf, symbol_mode);
+    pos = p + 1;
+  }
+}
+
+// @brief シンボルテーブルとコメントの1行を読み込む．
+void
+ModelImpl::read_symbol_line(
+  const string& linebuf,
+  bool& symbol_mode
+)
+{
+  if ( symbol_mode ) {
+    if ( linebuf == "c" ) {
+      symbol_mode = false;
+    }
+    else {
+      auto p = linebuf.find_first_of(" ");
+      auto pos_str = linebuf.substr(0, p);
+      auto name = linebuf.substr(p + 1, string::npos);
+      SizeType pos = atoi(pos_str.substr(1, string::npos).c_str());
+      char prefix = pos_str[0];
+      if ( prefix == 'i' ) {
+	set_input_symbol(pos, name);
+      }
+      else if ( prefix == 'l' ) {
+	set_latch_symbol(pos, name);
+      }
+      else if ( prefix == 'o' ) {
+	set_output_symbol(pos, name);
       }
       else {
-	auto p = linebuf.find_first_of(" ");
-	auto pos_str = linebuf.substr(0, p);
-	auto name = linebuf.substr(p + 1, string::npos);
-	SizeType pos = atoi(pos_str.substr(1, string::npos).c_str());
-	char prefix = pos_str[0];
-	if ( prefix == 'i' ) {
-	  set_input_symbol(pos, name);
-	}
-	else if ( prefix == 'l' ) {
-	  set_latch_symbol(pos, name);
-	}
-	else if ( prefix == 'o' ) {
-	  set_output_symbol(pos, name);
-	}
-	else {
-	  ASSERT_NOT_REACHED;
-	}
+	ASSERT_NOT_REACHED;
       }
     }
-    else {
-      mComment += linebuf + '\n';
-    }
+  }
+  else {
+    mComment += linebuf + '\n';
+  }
+}
+
+// @brief シンボルテーブルとコメントを出力する．
+void
+ModelImpl::write_symbols(
+  AigWriter& s,
+  const string& comment
+) const
+{
+  // 入力のシンボルテーブルの出力
+  for ( SizeType i = 0; i < I(); ++ i ) {
+    write_symbol(s, 'i', i, input_symbol(i));
+  }
+
+  // ラッチのシンボルテーブルの出力
+  for ( SizeType i = 0; i < L(); ++ i ) {
+    write_symbol(s, 'l', i, latch_symbol(i));
+  }
+
+  // 出力のシンボルテーブルの出力
+  for ( SizeType i = 0; i < O(); ++ i ) {
+    write_symbol(s, 'o', i, output_symbol(i));
+  }
+
+  // コメントの出力
+  write_comment(s, mComment + comment);
+}
+
+// @brief シンボルを1つ出力する．
+void
+ModelImpl::write_symbol(
+  AigWriter& s,
+  char prefix,
+  SizeType pos,
+  const string& name
+)
+{
+  if ( name != string{} ) {
+    s.put_char(prefix);
+    s.put_decimal(pos);
+    s.put_char(' ');
+    s.put_string(name);
+    s.put_char('\n');
+  }
+}
+
+// @brief コメントを出力する．
+void
+ModelImpl::write_comment(
+  AigWriter& s,
+  const string& comment
+)
+{
+  if ( comment != string{} ) {
+    s.put_string("c\n");
+    s.put_string(comment);
   }
 }
 
@@ -9,13 +9,15 @@
 /// All rights reserved.
 
 #include "ym/aig_nsdef.h"
+#include "AigWriter.h"
+#include <string_view>
 
 
 BEGIN_NAMESPACE_YM_AIG
 
 //////////////////////////////////////////////////////////////////////
 /// @class ModelImpl ModelImpl.h "ModelImpl.h"
-/// @brief AIG 形式のファイルを読むためのクラス
+/// @brief AIG の内容を保持するクラス
 //////////////////////////////////////////////////////////////////////
 class ModelImpl
 {
@@ -48,6 +50,55 @@ public:
     istream& s ///< [in] 入力ストリーム
   );
 
+  /// @brief メモリ上の AIG フォーマットを読み込む．
+  /// @return 読み込みが成功したら true を返す．
+  ///
+  /// ファイルを mmap() した領域を直接読むために用いる．
+  /// AND ノードの差分符号は1バイトずつ直接デコードする．
+  bool
+  read_aig(
+    std::string_view contents ///< [in] ファイルの内容
+  );
+
+  /// @brief Ascii AIG フォーマットで出力する．
+  void
+  write_aag(
+    AigWriter& s,         ///< [in] 出力器
+    const string& comment ///< [in] 追加のコメント
+  ) const;
+
+  /// @brief AIG フォーマットで出力する．
+  ///
+  /// ANDノードのリテラルは入力，ラッチの後に連番で並んでいて，
+  /// ファンインのリテラルよりも大きい必要がある．
+  void
+  write_aig(
+    AigWriter& s,         ///< [in] 出力器
+    const string& comment ///< [in] 追加のコメント
+  ) const;
+
+  /// @brief シンボルを1つ出力する．
+  ///
+  /// name が空文字列の場合はなにも出力しない．
+  static
+  void
+  write_symbol(
+    AigWriter& s,      ///< [in] 出力器
+    char prefix,       ///< [in] 種類を表す文字('i', 'l', 'o')
+    SizeType pos,      ///< [in] 位置番号
+    const string& name ///< [in] 名前
+  );
+
+  /// @brief コメントを出力する．
+  ///
+  /// comment が空文字列の場合はなにも出力しない．
+  static
+  void
+  write_comment(
+    AigWriter& s,         ///< [in] 出力器
+    const string& comment ///< [in] コメント
+  );
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -200,12 +251,16 @@ public:
   }
 
 
-private:
+public:
   //////////////////////////////////////////////////////////////////////
-  // 内部で用いられる関数
+  /// @name 内容を設定する関数
+  /// @{
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 初期化する．
+  ///
+  /// 入力，ラッチ，ANDノードのリテラルはこの順に連番で設定される．
+  /// ファイルから読み込む場合には後で上書きされる．
   void
   initialize(
     SizeType I, ///< [in] 入力数
@@ -225,7 +280,7 @@ private:
     mLatchList[pos].mSrc = src;
   }
 
-  /// @brief 出力のソースハンドルを設定する．
+  /// @brief 出力のソースリテラルを設定する．
   void
   set_output_src(
     SizeType pos, ///< [in] 出力番号 ( 0 <= pos < O() )
@@ -240,8 +295,8 @@ private:
   void
   set_and_src(
     SizeType pos,   ///< [in] AND番号 ( 0 <= pos < A() )
-    SizeType src1, ///< [in] ソース1のハンドル
-    SizeType src2  ///< [in] ソース1のハンドル
+    SizeType src1, ///< [in] ソース1のリテラル
+    SizeType src2  ///< [in] ソース2のリテラル
   )
   {
     ASSERT_COND( 0 <= pos && pos < A() );
@@ -282,12 +337,57 @@ private:
     mOutputList[pos].mSymbol = name;
   }
 
+  /// @brief コメントを設定する．
+  void
+  set_comment(
+    const string& comment ///< [in] コメント文字列
+  )
+  {
+    mComment = comment;
+  }
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
   /// @brief シンボルテーブルとコメントを読み込む．
   void
   read_symbols(
     istream& s ///< [in] 入力ストリーム
   );
 
+  /// @brief メモリ上のシンボルテーブルとコメントを読み込む．
+  void
+  read_symbols(
+    std::string_view contents ///< [in] シンボルテーブル以降の内容
+  );
+
+  /// @brief シンボルテーブルとコメントの1行を読み込む．
+  void
+  read_symbol_line(
+    const string& linebuf, ///< [in] 行の内容
+    bool& symbol_mode      ///< [inout] シンボルテーブルを読んでいる時 true
+  );
+
+  /// @brief ヘッダ行を出力する．
+  void
+  write_header(
+    AigWriter& s,       ///< [in] 出力器
+    const string& magic ///< [in] 先頭の識別子("aag " か "aig ")
+  ) const;
+
+  /// @brief シンボルテーブルとコメントを出力する．
+  void
+  write_symbols(
+    AigWriter& s,         ///< [in] 出力器
+    const string& comment ///< [in] 追加のコメント
+  ) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
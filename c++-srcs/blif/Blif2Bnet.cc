@@ -25,10 +25,12 @@ BnNetwork
 BnNetwork::read_blif(
   const string& filename,
   const string& clock_name,
-  const string& reset_name
+  const string& reset_name,
+  SizeType thread_num
 )
 {
-  return read_blif(filename, ClibCellLibrary{}, clock_name, reset_name);
+  return read_blif(filename, ClibCellLibrary{}, clock_name, reset_name,
+		   thread_num);
 }
 
 // @brief blif ファイルを読み込む．
@@ -37,11 +39,12 @@ BnNetwork::read_blif(
   const string& filename,
   const ClibCellLibrary& cell_library,
   const string& clock_name,
-  const string& reset_name
+  const string& reset_name,
+  SizeType thread_num
 )
 {
   BlifModel model;
-  bool stat = model.read(filename, cell_library);
+  bool stat = model.read(filename, cell_library, thread_num);
   if ( !stat ) {
     ostringstream buf;
     buf << "Error in read_blif(\"" << filename << "\"";
@@ -211,8 +214,10 @@ Blif2Bnet::make_logic(
   BnNode node;
   if ( type == BlifType::Cover ) {
     SizeType cover_id = mModel.node_cover_id(src_id);
-    if ( mCoverDict.count(cover_id) > 0 ) {
-      auto& cover_info = mCoverDict.at(cover_id);
+    auto& cover = mModel.node_cover(src_id);
+    auto cover_info_p = find_cover(cover_id, cover);
+    if ( cover_info_p != nullptr ) {
+      auto& cover_info = *cover_info_p;
       if ( cover_info.type != PrimType::None ) {
 	node = mNetwork.new_logic_primitive(oname, cover_info.type, fanin_list);
       }
@@ -221,14 +226,18 @@ Blif2Bnet::make_logic(
       }
     }
     else {
-      auto& cover = mModel.node_cover(src_id);
       auto expr = cover.expr();
       node = mNetwork.new_logic_expr(oname, expr, fanin_list);
+      CoverInfo cover_info{PrimType::None, 0};
       if ( node.type() == BnNodeType::Prim ) {
-	mCoverDict.emplace(cover_id, CoverInfo{node.primitive_type(), 0});
+	cover_info.type = node.primitive_type();
       }
       else {
-	mCoverDict.emplace(cover_id, CoverInfo{PrimType::None, node.expr_id()});
+	cover_info.expr_id = node.expr_id();
+      }
+      mCoverDict.emplace(cover_id, cover_info);
+      if ( cover.has_tvfunc() ) {
+	mFuncDict.emplace(cover.tvfunc(), cover_info);
       }
     }
   }
@@ -243,4 +252,26 @@ Blif2Bnet::make_logic(
   mNodeMap.emplace(src_id, node);
 }
 
+// @brief 論理式が等しいカバーの変換結果を探す．
+const Blif2Bnet::CoverInfo*
+Blif2Bnet::find_cover(
+  SizeType cover_id,
+  const BlifCover& cover
+) const
+{
+  // 同じカバー番号のものを探す．
+  auto p = mCoverDict.find(cover_id);
+  if ( p != mCoverDict.end() ) {
+    return &p->second;
+  }
+  // 入力数が少ない場合は関数として等しいものを探す．
+  if ( cover.has_tvfunc() ) {
+    auto q = mFuncDict.find(cover.tvfunc());
+    if ( q != mFuncDict.end() ) {
+      return &q->second;
+    }
+  }
+  return nullptr;
+}
+
 END_NAMESPACE_YM_BNET
@@ -9,6 +9,7 @@
 /// All rights reserved.
 
 #include "ym/BlifModel.h"
+#include "ym/BlifCover.h"
 #include "ym/BnModifier.h"
 //#include "ym/Expr.h"
 
@@ -44,6 +45,20 @@ public:
   get_network();
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief カバーの変換結果
+  struct CoverInfo {
+    // 組み込み型
+    PrimType type;
+    // 論理式番号
+    SizeType expr_id;
+  };
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる下請け関数
@@ -73,19 +88,13 @@ private:
     SizeType src_id ///< [in] BlifModel のノード番号
   );
 
-
-private:
-  //////////////////////////////////////////////////////////////////////
-  // 内部で用いられるデータ構造
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief カバーの変換結果
-  struct CoverInfo {
-    // 組み込み型
-    PrimType type;
-    // 論理式番号
-    SizeType expr_id;
-  };
+  /// @brief 論理式が等しいカバーの変換結果を探す．
+  /// @return 見つかった変換結果を返す．見つからなければ nullptr を返す．
+  const CoverInfo*
+  find_cover(
+    SizeType cover_id,     ///< [in] カバー番号
+    const BlifCover& cover ///< [in] カバー
+  ) const;
 
 
 private:
@@ -117,9 +126,13 @@ private:
   // リセット端子のノード
   BnNode mReset;
 
-  // カバーの変換結果を格納する辞書
+  // カバー番号をキーにしてカバーの変換結果を格納する辞書
   unordered_map<SizeType, CoverInfo> mCoverDict;
 
+  // 真理値表をキーにしてカバーの変換結果を格納する辞書
+  // 真理値表を持つカバーのみが対象となる．
+  unordered_map<TvFunc, CoverInfo> mFuncDict;
+
 };
 
 END_NAMESPACE_YM_BNET
@@ -0,0 +1,419 @@
+
+/// @file BlifBnetBuilder.cc
+/// @brief BlifBnetBuilder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifBnetBuilder.h"
+#include "BlifParser.h"
+#include "ym/BlifCover.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnDff.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/ClibCell.h"
+#include "ym/MsgMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief blif ファイルを BlifModel を経由せずに読み込む．
+BnNetwork
+BnNetwork::read_blif_direct(
+  const string& filename,
+  const string& clock_name,
+  const string& reset_name,
+  SizeType thread_num
+)
+{
+  return read_blif_direct(filename, ClibCellLibrary{},
+			  clock_name, reset_name, thread_num);
+}
+
+// @brief blif ファイルを BlifModel を経由せずに読み込む．
+BnNetwork
+BnNetwork::read_blif_direct(
+  const string& filename,
+  const ClibCellLibrary& cell_library,
+  const string& clock_name,
+  const string& reset_name,
+  SizeType thread_num
+)
+{
+  auto _clock_name = clock_name;
+  if ( _clock_name == string{} ) {
+    _clock_name = "clock";
+  }
+  auto _reset_name = reset_name;
+  if ( _reset_name == string{} ) {
+    _reset_name = "reset";
+  }
+
+  BlifBnetBuilder builder{cell_library, _clock_name, _reset_name};
+  nsBlif::BlifParser parser;
+  bool stat = parser.read(filename, cell_library, builder, thread_num);
+  if ( !stat ) {
+    ostringstream buf;
+    buf << "Error in read_blif_direct(\"" << filename << "\")";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  return builder.get_network();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BlifBnetBuilder
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BlifBnetBuilder::BlifBnetBuilder(
+  const ClibCellLibrary& cell_library,
+  const string& clock_name,
+  const string& reset_name
+) : mClockName{clock_name},
+    mResetName{reset_name}
+{
+  mNetwork.set_library(cell_library);
+}
+
+// @brief 結果のネットワークを返す．
+BnNetwork
+BlifBnetBuilder::get_network()
+{
+  return BnNetwork{std::move(mNetwork)};
+}
+
+// @brief モデル名を設定する．
+void
+BlifBnetBuilder::set_name(
+  const string& name
+)
+{
+  mNetwork.set_name(name);
+}
+
+// @brief 新しい識別子を登録する．
+void
+BlifBnetBuilder::new_node(
+  const string& name
+)
+{
+  // 名前は定義時に受け取るのでここでは領域を確保するだけ
+  mNodeArray.push_back(BnNode{});
+}
+
+// @brief 入力を定義する．
+void
+BlifBnetBuilder::set_input(
+  SizeType id,
+  const string& name
+)
+{
+  auto port = mNetwork.new_input_port(name);
+  resolve(id, port.bit(0));
+}
+
+// @brief 出力を設定する．
+void
+BlifBnetBuilder::set_output(
+  SizeType id,
+  const string& name
+)
+{
+  // ポートの順番を Blif2Bnet と合わせるため，
+  // 出力ポートは end() でまとめて作る．
+  mOutputList.push_back(make_pair(id, name));
+}
+
+// @brief .names 文の内容を設定する．
+void
+BlifBnetBuilder::set_cover(
+  SizeType id,
+  const string& name,
+  const vector<SizeType>& fanin_list,
+  SizeType cover_id,
+  const BlifCover& cover
+)
+{
+  def_logic(id, name, fanin_list, false, cover_id, &cover);
+}
+
+// @brief .gate 文の内容を設定する．
+void
+BlifBnetBuilder::set_cell(
+  SizeType id,
+  const string& name,
+  const vector<SizeType>& fanin_list,
+  SizeType cell_id
+)
+{
+  def_logic(id, name, fanin_list, true, cell_id, nullptr);
+}
+
+// @brief .latch 文の内容を設定する．
+void
+BlifBnetBuilder::set_dff(
+  SizeType id,
+  const string& name,
+  SizeType input_id,
+  char rval
+)
+{
+  bool has_clear = false;
+  bool has_preset = false;
+  if ( rval == '0' ) {
+    has_clear = true;
+  }
+  else if ( rval == '1' ) {
+    has_preset = true;
+  }
+  auto dff = mNetwork.new_dff(name, has_clear, has_preset);
+
+  // 入力側の接続は end() で行う．
+  auto input = dff.data_in();
+  mDffInputList.push_back(make_pair(input.id(), input_id));
+
+  if ( mClock.is_invalid() ) {
+    // クロックのポートを作る．
+    auto clock_port = mNetwork.new_input_port(mClockName);
+    // クロックの入力ノードを記録する．
+    mClock = clock_port.bit(0);
+  }
+
+  // クロック入力とdffのクロック端子を結びつける．
+  mNetwork.set_output_src(dff.clock(), mClock);
+
+  if ( has_clear || has_preset ) {
+    if ( mReset.is_invalid() ) {
+      // リセット端子のポートを作る．
+      auto reset_port = mNetwork.new_input_port(mResetName);
+      // リセット端子の入力ノードを記録する．
+      mReset = reset_port.bit(0);
+    }
+  }
+  if ( has_clear ) {
+    // リセット入力とクリア端子を結びつける．
+    mNetwork.set_output_src(dff.clear(), mReset);
+  }
+  else if ( has_preset ) {
+    // リセット入力とプリセット端子を結びつける．
+    mNetwork.set_output_src(dff.preset(), mReset);
+  }
+
+  resolve(id, dff.data_out());
+}
+
+// @brief 読み込みの終了処理を行う．
+bool
+BlifBnetBuilder::end()
+{
+  if ( !mPendingDict.empty() ) {
+    // 保留中のノードはループの上にあるか，ループの先にある．
+    auto& pending = mPendingDict.begin()->second;
+    ostringstream buf;
+    buf << pending.mName << ": Combinational loop detected.";
+    MsgMgr::put_msg(__FILE__, __LINE__, FileRegion{},
+		    MsgType::Error,
+		    "LOOP01", buf.str());
+    return false;
+  }
+
+  for ( auto& p: mOutputList ) {
+    auto id = p.first;
+    auto& name = p.second;
+    string name1;
+    if ( mNetwork.find_port(name).is_invalid() ) {
+      name1 = name;
+    }
+    auto port = mNetwork.new_output_port(name1);
+    auto node = port.bit(0);
+    ASSERT_COND( mNodeArray[id].is_valid() );
+    mNetwork.set_output_src(node, mNodeArray[id]);
+  }
+
+  for ( auto& p: mDffInputList ) {
+    auto node_id = p.first;
+    auto src_id = p.second;
+    ASSERT_COND( mNodeArray[src_id].is_valid() );
+    mNetwork.set_output_src(mNetwork.node(node_id), mNodeArray[src_id]);
+  }
+
+  return true;
+}
+
+// @brief 論理ノードを定義する．
+void
+BlifBnetBuilder::def_logic(
+  SizeType id,
+  const string& name,
+  const vector<SizeType>& fanin_list,
+  bool is_cell,
+  SizeType ext_id,
+  const BlifCover* cover
+)
+{
+  // 未生成のファンインを数える．
+  // 同じファンインが複数回現れる場合は1つと数える．
+  SizeType wait_num = 0;
+  SizeType ni = fanin_list.size();
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto iid = fanin_list[i];
+    if ( mNodeArray[iid].is_valid() ) {
+      continue;
+    }
+    bool dup = false;
+    for ( SizeType j = 0; j < i; ++ j ) {
+      if ( fanin_list[j] == iid ) {
+	dup = true;
+	break;
+      }
+    }
+    if ( !dup ) {
+      mPatchDict[iid].push_back(id);
+      ++ wait_num;
+    }
+  }
+
+  // カバーの論理式は同じ関数のカバーが未生成の場合のみ必要となる．
+  Expr expr;
+  const TvFunc* tvfunc = nullptr;
+  if ( !is_cell ) {
+    if ( cover->has_tvfunc() ) {
+      tvfunc = &cover->tvfunc();
+    }
+    if ( find_cover(ext_id, tvfunc) == nullptr ) {
+      expr = cover->expr();
+    }
+  }
+
+  if ( wait_num == 0 ) {
+    auto node = make_logic(name, fanin_list, is_cell, ext_id, expr, tvfunc);
+    resolve(id, node);
+  }
+  else {
+    bool has_tvfunc = tvfunc != nullptr;
+    TvFunc tv;
+    if ( has_tvfunc ) {
+      tv = *tvfunc;
+    }
+    mPendingDict.emplace(id, Pending{name, fanin_list, is_cell,
+				     ext_id, expr, has_tvfunc, tv,
+				     wait_num});
+  }
+}
+
+// @brief 論理ノードを生成する．
+BnNode
+BlifBnetBuilder::make_logic(
+  const string& name,
+  const vector<SizeType>& fanin_list,
+  bool is_cell,
+  SizeType ext_id,
+  const Expr& expr,
+  const TvFunc* tvfunc
+)
+{
+  vector<BnNode> node_list;
+  node_list.reserve(fanin_list.size());
+  for ( auto iid: fanin_list ) {
+    ASSERT_COND( mNodeArray[iid].is_valid() );
+    node_list.push_back(mNodeArray[iid]);
+  }
+
+  if ( is_cell ) {
+    auto cell = mNetwork.library().cell(ext_id);
+    return mNetwork.new_logic_cell(name, cell, node_list);
+  }
+
+  BnNode node;
+  auto cover_id = ext_id;
+  auto cover_info_p = find_cover(cover_id, tvfunc);
+  if ( cover_info_p != nullptr ) {
+    auto& cover_info = *cover_info_p;
+    if ( cover_info.type != PrimType::None ) {
+      node = mNetwork.new_logic_primitive(name, cover_info.type, node_list);
+    }
+    else {
+      node = mNetwork.new_logic_expr(name, cover_info.expr_id, node_list);
+    }
+  }
+  else {
+    node = mNetwork.new_logic_expr(name, expr, node_list);
+    CoverInfo cover_info{PrimType::None, 0};
+    if ( node.type() == BnNodeType::Prim ) {
+      cover_info.type = node.primitive_type();
+    }
+    else {
+      cover_info.expr_id = node.expr_id();
+    }
+    mCoverDict.emplace(cover_id, cover_info);
+    if ( tvfunc != nullptr ) {
+      mFuncDict.emplace(*tvfunc, cover_info);
+    }
+  }
+  return node;
+}
+
+// @brief 論理式が等しいカバーの変換結果を探す．
+const BlifBnetBuilder::CoverInfo*
+BlifBnetBuilder::find_cover(
+  SizeType cover_id,
+  const TvFunc* tvfunc
+) const
+{
+  auto p = mCoverDict.find(cover_id);
+  if ( p != mCoverDict.end() ) {
+    return &p->second;
+  }
+  if ( tvfunc != nullptr ) {
+    auto q = mFuncDict.find(*tvfunc);
+    if ( q != mFuncDict.end() ) {
+      return &q->second;
+    }
+  }
+  return nullptr;
+}
+
+// @brief ノードが生成されたことを記録して保留中のノードを処理する．
+void
+BlifBnetBuilder::resolve(
+  SizeType id,
+  BnNode node
+)
+{
+  // 深い再帰を避けるためにキューを用いる．
+  vector<SizeType> queue;
+  mNodeArray[id] = node;
+  queue.push_back(id);
+  while ( !queue.empty() ) {
+    auto id1 = queue.back();
+    queue.pop_back();
+    if ( mPatchDict.count(id1) == 0 ) {
+      continue;
+    }
+    auto wait_list = std::move(mPatchDict.at(id1));
+    mPatchDict.erase(id1);
+    for ( auto wid: wait_list ) {
+      auto& pending = mPendingDict.at(wid);
+      -- pending.mWaitNum;
+      if ( pending.mWaitNum == 0 ) {
+	auto node1 = make_logic(pending.mName, pending.mFaninList,
+				pending.mIsCell, pending.mExtId,
+				pending.mExpr,
+				pending.mHasTvFunc ? &pending.mTvFunc : nullptr);
+	mPendingDict.erase(wid);
+	mNodeArray[wid] = node1;
+	queue.push_back(wid);
+      }
+    }
+  }
+}
+
+END_NAMESPACE_YM_BNET
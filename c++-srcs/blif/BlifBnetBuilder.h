@@ -0,0 +1,265 @@
+#ifndef BLIFBNETBUILDER_H
+#define BLIFBNETBUILDER_H
+
+/// @file BlifBnetBuilder.h
+/// @brief BlifBnetBuilder のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "BlifHandler.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlifBnetBuilder BlifBnetBuilder.h "BlifBnetBuilder.h"
+/// @brief BlifParser の読み込み結果から直接 BnNetwork を作るクラス
+///
+/// BlifModel を経由せずに，定義が現れた時点でノードを BnModifier 上に作る．
+/// - ファンインがすべて生成済みのノードはその場で生成する．
+/// - 未生成のファンインを持つノードは保留しておき，未生成のファンインの
+///   識別子番号をキーにした表(パッチ表)に登録する．
+///   そのファンインが生成された時点で保留中のノードの待ち数を減らし，
+///   0 になったものを生成する．
+/// この結果，論理ノードは入力からのトポロジカル順に生成される．
+/// 出力と DFF の入力は end() でまとめて接続する．
+///
+/// Blif2Bnet と異なり，出力から到達できない論理ノードも生成される．
+//////////////////////////////////////////////////////////////////////
+class BlifBnetBuilder :
+  public nsBlif::BlifHandler
+{
+public:
+
+  /// @brief コンストラクタ
+  BlifBnetBuilder(
+    const ClibCellLibrary& cell_library, ///< [in] セルライブラリ
+    const string& clock_name = "clock",  ///< [in] クロック端子名
+    const string& reset_name = "reset"   ///< [in] リセット端子名
+  );
+
+  /// @brief デストラクタ
+  ~BlifBnetBuilder() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 結果のネットワークを返す．
+  BnNetwork
+  get_network();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // BlifHandler の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モデル名を設定する．
+  void
+  set_name(
+    const string& name ///< [in] モデル名
+  ) override;
+
+  /// @brief 新しい識別子を登録する．
+  void
+  new_node(
+    const string& name ///< [in] 名前
+  ) override;
+
+  /// @brief 入力を定義する．
+  void
+  set_input(
+    SizeType id,       ///< [in] 識別子番号
+    const string& name ///< [in] 名前
+  ) override;
+
+  /// @brief 出力を設定する．
+  void
+  set_output(
+    SizeType id,       ///< [in] 識別子番号
+    const string& name ///< [in] 名前
+  ) override;
+
+  /// @brief .names 文の内容を設定する．
+  void
+  set_cover(
+    SizeType id,                        ///< [in] 識別子番号
+    const string& name,                 ///< [in] 名前
+    const vector<SizeType>& fanin_list, ///< [in] ファンインの識別子番号のリスト
+    SizeType cover_id,                  ///< [in] カバー番号
+    const BlifCover& cover              ///< [in] カバー
+  ) override;
+
+  /// @brief .gate 文の内容を設定する．
+  void
+  set_cell(
+    SizeType id,                        ///< [in] 識別子番号
+    const string& name,                 ///< [in] 名前
+    const vector<SizeType>& fanin_list, ///< [in] ファンインの識別子番号のリスト
+    SizeType cell_id                    ///< [in] セル番号
+  ) override;
+
+  /// @brief .latch 文の内容を設定する．
+  void
+  set_dff(
+    SizeType id,        ///< [in] 識別子番号
+    const string& name, ///< [in] 名前
+    SizeType input_id,  ///< [in] 入力の識別子番号
+    char rval           ///< [in] リセット値
+  ) override;
+
+  /// @brief 読み込みの終了処理を行う．
+  ///
+  /// 保留中のノードが残っている(組み合わせ回路のループがある)場合は
+  /// false を返す．
+  bool
+  end() override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 生成を保留している論理ノードの情報
+  struct Pending
+  {
+    // 名前
+    string mName;
+
+    // ファンインの識別子番号のリスト
+    vector<SizeType> mFaninList;
+
+    // セルの時 true
+    bool mIsCell;
+
+    // カバー番号/セル番号
+    SizeType mExtId;
+
+    // カバーの論理式
+    // 同じカバーがまだ生成されていない時のみ意味を持つ．
+    Expr mExpr;
+
+    // カバーが真理値表を持つ時 true
+    bool mHasTvFunc;
+
+    // カバーの真理値表
+    TvFunc mTvFunc;
+
+    // 未生成のファンイン数
+    SizeType mWaitNum;
+  };
+
+  /// @brief カバーの変換結果
+  struct CoverInfo {
+    // 組み込み型
+    PrimType type;
+    // 論理式番号
+    SizeType expr_id;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 論理ノードを定義する．
+  ///
+  /// ファンインがすべて生成済みならその場で生成し，
+  /// そうでなければ保留する．
+  void
+  def_logic(
+    SizeType id,                        ///< [in] 識別子番号
+    const string& name,                 ///< [in] 名前
+    const vector<SizeType>& fanin_list, ///< [in] ファンインの識別子番号のリスト
+    bool is_cell,                       ///< [in] セルの時 true
+    SizeType ext_id,                    ///< [in] カバー番号/セル番号
+    const BlifCover* cover              ///< [in] カバー(セルの時は nullptr)
+  );
+
+  /// @brief 論理ノードを生成する．
+  BnNode
+  make_logic(
+    const string& name,                 ///< [in] 名前
+    const vector<SizeType>& fanin_list, ///< [in] ファンインの識別子番号のリスト
+    bool is_cell,                       ///< [in] セルの時 true
+    SizeType ext_id,                    ///< [in] カバー番号/セル番号
+    const Expr& expr,                   ///< [in] カバーの論理式
+    const TvFunc* tvfunc                ///< [in] カバーの真理値表
+                                        ///<      (持たない場合は nullptr)
+  );
+
+  /// @brief 論理式が等しいカバーの変換結果を探す．
+  /// @return 見つかった変換結果を返す．見つからなければ nullptr を返す．
+  const CoverInfo*
+  find_cover(
+    SizeType cover_id,   ///< [in] カバー番号
+    const TvFunc* tvfunc ///< [in] 真理値表(持たない場合は nullptr)
+  ) const;
+
+  /// @brief ノードが生成されたことを記録して保留中のノードを処理する．
+  void
+  resolve(
+    SizeType id, ///< [in] 識別子番号
+    BnNode node  ///< [in] 生成したノード
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ネットワーク
+  BnModifier mNetwork;
+
+  // クロック端子名
+  string mClockName;
+
+  // リセット端子名
+  string mResetName;
+
+  // 識別子番号をキーにして生成したノードを格納する配列
+  // 未生成の場合は不正値となる．
+  vector<BnNode> mNodeArray;
+
+  // 識別子番号をキーにして保留中のノードを格納する辞書
+  unordered_map<SizeType, Pending> mPendingDict;
+
+  // 未生成の識別子番号をキーにしてそれを待っているノードの
+  // 識別子番号のリストを格納する辞書(パッチ表)
+  unordered_map<SizeType, vector<SizeType>> mPatchDict;
+
+  // 出力の識別子番号と名前のリスト
+  vector<pair<SizeType, string>> mOutputList;
+
+  // DFF の入力ノードのノード番号とファンインの識別子番号のリスト
+  vector<pair<SizeType, SizeType>> mDffInputList;
+
+  // クロック端子のノード
+  BnNode mClock;
+
+  // リセット端子のノード
+  BnNode mReset;
+
+  // カバー番号をキーにしてカバーの変換結果を格納する辞書
+  unordered_map<SizeType, CoverInfo> mCoverDict;
+
+  // 真理値表をキーにしてカバーの変換結果を格納する辞書
+  // 真理値表を持つカバーのみが対象となる．
+  unordered_map<TvFunc, CoverInfo> mFuncDict;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // BLIFBNETBUILDER_H
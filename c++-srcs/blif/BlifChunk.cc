@@ -0,0 +1,342 @@
+
+/// @file BlifChunk.cc
+/// @brief BlifChunk の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifChunk.h"
+
+
+BEGIN_NAMESPACE_YM_BLIF
+
+//////////////////////////////////////////////////////////////////////
+// クラス BlifChunk
+//////////////////////////////////////////////////////////////////////
+
+// @brief 範囲を読み込む．
+bool
+BlifChunk::parse(
+  BlifMmapScanner& scanner,
+  bool is_first
+)
+{
+  // 文法は BlifParser と同じだが，エラーや警告となる場合は
+  // メッセージを出さずに false を返す．
+
+  mScanner = &scanner;
+  mStmtList.clear();
+  mNameList.clear();
+  mPatBuf.clear();
+
+  next_token();
+  if ( is_first ) {
+    // ファイルの先頭は .model 文でなければならない．
+    while ( mCurToken == BlifToken::NL ) {
+      next_token();
+    }
+    if ( mCurToken != BlifToken::MODEL ) {
+      return false;
+    }
+    if ( !parse_model() ) {
+      return false;
+    }
+  }
+
+  bool after_end = false;
+  for ( ; ; ) {
+    auto tk = mCurToken;
+    if ( after_end && tk != BlifToken::NL && tk != BlifToken::_EOF ) {
+      // .end の後の文は警告となる．
+      return false;
+    }
+    switch ( tk ) {
+    case BlifToken::NL:
+      next_token();
+      break;
+
+    case BlifToken::_EOF:
+      return true;
+
+    case BlifToken::INPUTS:
+    case BlifToken::OUTPUTS:
+      if ( !parse_list(tk) ) {
+	return false;
+      }
+      break;
+
+    case BlifToken::NAMES:
+      if ( !parse_names() ) {
+	return false;
+      }
+      break;
+
+    case BlifToken::GATE:
+      if ( !parse_gate() ) {
+	return false;
+      }
+      break;
+
+    case BlifToken::LATCH:
+      if ( !parse_latch() ) {
+	return false;
+      }
+      break;
+
+    case BlifToken::END:
+      add_stmt(BlifToken::END, mNameList.size());
+      after_end = true;
+      next_token();
+      break;
+
+    case BlifToken::WIRE_LOAD_SLOPE:
+    case BlifToken::WIRE:
+    case BlifToken::INPUT_ARRIVAL:
+    case BlifToken::DEFAULT_INPUT_ARRIVAL:
+    case BlifToken::OUTPUT_REQUIRED:
+    case BlifToken::DEFAULT_OUTPUT_REQUIRED:
+    case BlifToken::INPUT_DRIVE:
+    case BlifToken::DEFAULT_INPUT_DRIVE:
+    case BlifToken::OUTPUT_LOAD:
+    case BlifToken::DEFAULT_OUTPUT_LOAD:
+      if ( !parse_dummy1() ) {
+	return false;
+      }
+      break;
+
+    default:
+      // .model の重複，.exdc 文，文法エラー
+      return false;
+    }
+  }
+}
+
+// @brief .model 文を読む．
+bool
+BlifChunk::parse_model()
+{
+  auto name_begin = mNameList.size();
+  next_token();
+  if ( mCurToken != BlifToken::STRING ) {
+    return false;
+  }
+  mNameList.push_back(mScanner->cur_view());
+  next_token();
+  if ( mCurToken != BlifToken::NL ) {
+    return false;
+  }
+  add_stmt(BlifToken::MODEL, name_begin);
+  next_token();
+  return true;
+}
+
+// @brief .inputs/.outputs 文を読む．
+bool
+BlifChunk::parse_list(
+  BlifToken type
+)
+{
+  auto name_begin = mNameList.size();
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::STRING ) {
+      mNameList.push_back(mScanner->cur_view());
+    }
+    else if ( mCurToken == BlifToken::NL ) {
+      if ( mNameList.size() == name_begin ) {
+	// 空の文は警告となる．
+	return false;
+      }
+      add_stmt(type, name_begin);
+      next_token();
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+}
+
+// @brief .names 文を読む．
+bool
+BlifChunk::parse_names()
+{
+  auto name_begin = mNameList.size();
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::STRING ) {
+      mNameList.push_back(mScanner->cur_view());
+    }
+    else if ( mCurToken == BlifToken::NL ) {
+      if ( mNameList.size() == name_begin ) {
+	return false;
+      }
+      break;
+    }
+    else {
+      return false;
+    }
+  }
+
+  SizeType ni = mNameList.size() - name_begin - 1;
+  auto pat_begin = mPatBuf.size();
+  SizeType cube_num = 0;
+  char opat_char = '-';
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::STRING ) {
+      if ( ni > 0 ) {
+	// 入力のキューブ
+	auto ipat = mScanner->cur_view();
+	if ( ipat.size() != ni ) {
+	  return false;
+	}
+	for ( char c: ipat ) {
+	  if ( c != '0' && c != '1' && c != '-' ) {
+	    return false;
+	  }
+	}
+	mPatBuf.append(ipat.data(), ipat.size());
+
+	next_token();
+	if ( mCurToken != BlifToken::STRING ) {
+	  return false;
+	}
+      }
+      // 出力のキューブ
+      if ( !check_opat(opat_char) ) {
+	return false;
+      }
+      next_token();
+      if ( mCurToken != BlifToken::NL ) {
+	return false;
+      }
+      ++ cube_num;
+    }
+    else if ( mCurToken == BlifToken::NL ) {
+      // 空行はスキップ
+      ;
+    }
+    else {
+      // それ以外のトークンの場合には
+      // 読み込まずに終わる．
+      break;
+    }
+  }
+
+  add_stmt(BlifToken::NAMES, name_begin, pat_begin, cube_num, opat_char);
+  return true;
+}
+
+// @brief .gate 文を読む．
+bool
+BlifChunk::parse_gate()
+{
+  auto name_begin = mNameList.size();
+  next_token();
+  if ( mCurToken != BlifToken::STRING ) {
+    return false;
+  }
+  // セル名
+  mNameList.push_back(mScanner->cur_view());
+
+  // (str '=' str)* nl
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::STRING ) {
+      // ピン名
+      mNameList.push_back(mScanner->cur_view());
+      next_token();
+      if ( mCurToken != BlifToken::EQ ) {
+	return false;
+      }
+      next_token();
+      if ( mCurToken != BlifToken::STRING ) {
+	return false;
+      }
+      // ネット名
+      mNameList.push_back(mScanner->cur_view());
+    }
+    else if ( mCurToken == BlifToken::NL ) {
+      if ( mNameList.size() == name_begin + 1 ) {
+	return false;
+      }
+      add_stmt(BlifToken::GATE, name_begin);
+      next_token();
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+}
+
+// @brief .latch 文を読む．
+bool
+BlifChunk::parse_latch()
+{
+  auto name_begin = mNameList.size();
+  for ( SizeType i = 0; i < 2; ++ i ) {
+    next_token();
+    if ( mCurToken != BlifToken::STRING ) {
+      return false;
+    }
+    mNameList.push_back(mScanner->cur_view());
+  }
+
+  next_token();
+  char rval = ' ';
+  if ( mCurToken == BlifToken::STRING ) {
+    auto str = mScanner->cur_view();
+    rval = str.empty() ? '\0' : str[0];
+    if ( rval != '0' && rval != '1' ) {
+      return false;
+    }
+    next_token();
+  }
+  if ( mCurToken != BlifToken::NL ) {
+    return false;
+  }
+  add_stmt(BlifToken::LATCH, name_begin, 0, 0, rval);
+  next_token();
+  return true;
+}
+
+// @brief 読み飛ばす文を読む．
+bool
+BlifChunk::parse_dummy1()
+{
+  for ( ; ; ) {
+    next_token();
+    if ( mCurToken == BlifToken::NL ) {
+      next_token();
+      return true;
+    }
+    else if ( mCurToken == BlifToken::_EOF ) {
+      return false;
+    }
+  }
+}
+
+// @brief 出力パタンを調べる．
+bool
+BlifChunk::check_opat(
+  char& opat_char
+)
+{
+  auto str = mScanner->cur_view();
+  char ochar = str.empty() ? '\0' : str[0];
+  if ( ochar != '0' && ochar != '1' ) {
+    return false;
+  }
+  if ( opat_char == '-' ) {
+    opat_char = ochar;
+  }
+  else if ( opat_char != ochar ) {
+    return false;
+  }
+  return true;
+}
+
+END_NAMESPACE_YM_BLIF
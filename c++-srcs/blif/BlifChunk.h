@@ -0,0 +1,198 @@
+#ifndef BLIFCHUNK_H
+#define BLIFCHUNK_H
+
+/// @file BlifChunk.h
+/// @brief BlifChunk のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/blif_nsdef.h"
+#include "BlifMmapScanner.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_BLIF
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlifChunk BlifChunk.h "BlifChunk.h"
+/// @brief blif ファイルの一部分(文の区切りで分割したもの)の解析結果
+///
+/// 並列読み込み用のクラスで，他の部分とは独立に解析できる処理のみを行う．
+/// - 字句解析と文法のチェック
+/// - .names 文のキューブパタンのチェックと連結
+/// 名前の解決や二重定義のチェックは行わず，文ごとに名前(ファイルの内容を
+/// 指す std::string_view)のリストを記録しておく．
+///
+/// 以下の場合は false を返す．この場合は逐次版の BlifParser で読み直す
+/// ことで，エラーメッセージや警告を含めて逐次版と同一の結果となる．
+/// - 文法エラー
+/// - 警告の出る記述(空の .inputs 文など)
+/// - .exdc 文などの並列に扱わない文
+//////////////////////////////////////////////////////////////////////
+class BlifChunk
+{
+public:
+
+  /// @brief 文の情報
+  struct Stmt
+  {
+    // 文の種類
+    // MODEL, INPUTS, OUTPUTS, NAMES, GATE, LATCH, END のいずれか
+    BlifToken mType;
+
+    // 名前のリスト(name_list()) 中の開始位置
+    SizeType mNameBegin;
+
+    // 名前のリスト(name_list()) 中の終了位置
+    SizeType mNameEnd;
+
+    // 入力パタン(.names 文のみ)の開始位置
+    SizeType mPatBegin;
+
+    // キューブ数(.names 文のみ)
+    SizeType mCubeNum;
+
+    // 出力パタン(.names 文)もしくはリセット値(.latch 文)
+    char mChar;
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  BlifChunk() = default;
+
+  /// @brief デストラクタ
+  ~BlifChunk() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 範囲を読み込む．
+  /// @retval true 並列版で扱える内容だった．
+  /// @retval false 逐次版で読み直す必要がある．
+  bool
+  parse(
+    BlifMmapScanner& scanner, ///< [in] 範囲を読む字句解析器
+    bool is_first             ///< [in] ファイルの先頭の時 true
+  );
+
+  /// @brief 文のリストを返す．
+  const vector<Stmt>&
+  stmt_list() const
+  {
+    return mStmtList;
+  }
+
+  /// @brief 名前のリストを返す．
+  ///
+  /// .gate 文の場合はセル名，ピン名，ネット名，ピン名，ネット名... の順に並ぶ．
+  const vector<std::string_view>&
+  name_list() const
+  {
+    return mNameList;
+  }
+
+  /// @brief .names 文の入力パタンを返す．
+  ///
+  /// 全キューブのパタンを連結したものとなる．
+  std::string_view
+  pat_str(
+    const Stmt& stmt ///< [in] 文
+  ) const
+  {
+    SizeType ni = stmt.mNameEnd - stmt.mNameBegin - 1;
+    return std::string_view{mPatBuf}.substr(stmt.mPatBegin, ni * stmt.mCubeNum);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief .model 文を読む．
+  bool
+  parse_model();
+
+  /// @brief .inputs/.outputs 文を読む．
+  bool
+  parse_list(
+    BlifToken type ///< [in] 文の種類
+  );
+
+  /// @brief .names 文を読む．
+  bool
+  parse_names();
+
+  /// @brief .gate 文を読む．
+  bool
+  parse_gate();
+
+  /// @brief .latch 文を読む．
+  bool
+  parse_latch();
+
+  /// @brief 読み飛ばす文を読む．
+  bool
+  parse_dummy1();
+
+  /// @brief 出力パタンを調べる．
+  bool
+  check_opat(
+    char& opat_char ///< [inout] これまでの出力パタン
+  );
+
+  /// @brief 次のトークンを読み出す．
+  void
+  next_token()
+  {
+    mCurToken = mScanner->read_token();
+  }
+
+  /// @brief 文を追加する．
+  void
+  add_stmt(
+    BlifToken type,         ///< [in] 文の種類
+    SizeType name_begin,    ///< [in] 名前の開始位置
+    SizeType pat_begin = 0, ///< [in] 入力パタンの開始位置
+    SizeType cube_num = 0,  ///< [in] キューブ数
+    char c = ' '            ///< [in] 出力パタン/リセット値
+  )
+  {
+    mStmtList.push_back(Stmt{type, name_begin, mNameList.size(),
+			     pat_begin, cube_num, c});
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 字句解析器
+  // この変数は parse() 内でのみ有効
+  BlifMmapScanner* mScanner{nullptr};
+
+  // 現在のトークン
+  BlifToken mCurToken;
+
+  // 文のリスト
+  vector<Stmt> mStmtList;
+
+  // 名前のリスト
+  vector<std::string_view> mNameList;
+
+  // .names 文の入力パタンを連結したもの
+  string mPatBuf;
+
+};
+
+END_NAMESPACE_YM_BLIF
+
+#endif // BLIFCHUNK_H
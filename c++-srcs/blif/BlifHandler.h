@@ -0,0 +1,115 @@
+#ifndef BLIFHANDLER_H
+#define BLIFHANDLER_H
+
+/// @file BlifHandler.h
+/// @brief BlifHandler のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/blif_nsdef.h"
+#include "ym/BlifCover.h"
+
+
+BEGIN_NAMESPACE_YM_BLIF
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlifHandler BlifHandler.h "BlifHandler.h"
+/// @brief BlifParser の読み込み結果を受け取るクラスの基底クラス
+///
+/// 識別子(信号名)は new_node() で登録された順に 0 から番号が振られる．
+/// 各関数は識別子が定義された順(ファイルに現れた順)に呼ばれるので，
+/// ファンインの識別子がまだ定義されていない場合がある．
+/// 未定義の識別子が残っている場合は end() は呼ばれない．
+//////////////////////////////////////////////////////////////////////
+class BlifHandler
+{
+public:
+
+  /// @brief デストラクタ
+  virtual
+  ~BlifHandler() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 継承クラスが実装する必要のある仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief モデル名を設定する．
+  virtual
+  void
+  set_name(
+    const string& name ///< [in] モデル名
+  ) = 0;
+
+  /// @brief 新しい識別子を登録する．
+  virtual
+  void
+  new_node(
+    const string& name ///< [in] 名前
+  ) = 0;
+
+  /// @brief 入力を定義する．
+  virtual
+  void
+  set_input(
+    SizeType id,       ///< [in] 識別子番号
+    const string& name ///< [in] 名前
+  ) = 0;
+
+  /// @brief 出力を設定する．
+  virtual
+  void
+  set_output(
+    SizeType id,       ///< [in] 識別子番号
+    const string& name ///< [in] 名前
+  ) = 0;
+
+  /// @brief .names 文の内容を設定する．
+  ///
+  /// cover_id は内容の等しいカバーに対して同じ値となる．
+  /// 新しいカバー番号は現れた順に 0 から振られる．
+  virtual
+  void
+  set_cover(
+    SizeType id,                        ///< [in] 識別子番号
+    const string& name,                 ///< [in] 名前
+    const vector<SizeType>& fanin_list, ///< [in] ファンインの識別子番号のリスト
+    SizeType cover_id,                  ///< [in] カバー番号
+    const BlifCover& cover              ///< [in] カバー
+  ) = 0;
+
+  /// @brief .gate 文の内容を設定する．
+  virtual
+  void
+  set_cell(
+    SizeType id,                        ///< [in] 識別子番号
+    const string& name,                 ///< [in] 名前
+    const vector<SizeType>& fanin_list, ///< [in] ファンインの識別子番号のリスト
+    SizeType cell_id                    ///< [in] セル番号
+  ) = 0;
+
+  /// @brief .latch 文の内容を設定する．
+  virtual
+  void
+  set_dff(
+    SizeType id,        ///< [in] 識別子番号
+    const string& name, ///< [in] 名前
+    SizeType input_id,  ///< [in] 入力の識別子番号
+    char rval           ///< [in] リセット値
+  ) = 0;
+
+  /// @brief 読み込みの終了処理を行う．
+  /// @retval true 正しく終了した．
+  /// @retval false エラーが起こった．
+  virtual
+  bool
+  end() = 0;
+
+};
+
+END_NAMESPACE_YM_BLIF
+
+#endif // BLIFHANDLER_H
@@ -0,0 +1,366 @@
+
+/// @file BlifMmapScanner.cc
+/// @brief BlifMmapScanner の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifMmapScanner.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_BLIF
+
+BEGIN_NONAMESPACE
+
+// word が keyword に等しい時 true を返す．
+// 長さは等しいと仮定している．
+inline
+bool
+match(
+  std::string_view word,
+  const char* keyword
+)
+{
+  return std::memcmp(word.data(), keyword, word.size()) == 0;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BlifMmapScanner
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BlifMmapScanner::BlifMmapScanner(
+  const string& filename
+) : mFileInfo{filename},
+    mFile{filename}
+{
+  if ( !mFile.is_valid() ) {
+    return;
+  }
+  auto contents = mFile.contents();
+  mBegin = contents.data();
+  mEnd = mBegin + contents.size();
+  mCur = mBegin;
+  mLocPos = mBegin;
+  mLocHead = mBegin;
+  mValid = true;
+}
+
+// @brief メモリ上の文字列を読む場合のコンストラクタ
+BlifMmapScanner::BlifMmapScanner(
+  std::string_view contents,
+  const FileInfo& file_info
+) : mFileInfo{file_info},
+    mValid{true},
+    mBuffer{contents}
+{
+  mBegin = mBuffer.data();
+  mEnd = mBegin + mBuffer.size();
+  mCur = mBegin;
+  mLocPos = mBegin;
+  mLocHead = mBegin;
+}
+
+// @brief 他の字句解析器の部分範囲を読む場合のコンストラクタ
+BlifMmapScanner::BlifMmapScanner(
+  const BlifMmapScanner& src,
+  SizeType begin,
+  SizeType end
+) : mFileInfo{src.mFileInfo},
+    mValid{src.mValid}
+{
+  ASSERT_COND( begin <= end && src.mBegin + end <= src.mEnd );
+  mBegin = src.mBegin + begin;
+  mEnd = src.mBegin + end;
+  mCur = mBegin;
+  mLocPos = mBegin;
+  mLocHead = mBegin;
+}
+
+// @brief トークンを一つ読み出す．
+BlifToken
+BlifMmapScanner::read_token()
+{
+  return scan();
+}
+
+// @brief read_token() の下請け関数
+BlifToken
+BlifMmapScanner::scan()
+{
+  // 状態遷移は BlifScanner::scan() と同じ
+
+ ST_INIT:
+  mFirstPos = mCur;
+  mTokenBegin = mCur;
+  mTokenEnd = mCur;
+  if ( mCur == mEnd ) {
+    return BlifToken::_EOF;
+  }
+  switch ( *mCur ) {
+  case ' ':
+  case '\t':
+    // ホワイトスペースは読み飛ばす．
+    ++ mCur;
+    goto ST_INIT;
+
+  case '\n':
+    ++ mCur;
+    mTokenEnd = mCur;
+    return BlifToken::NL;
+
+  case '=':
+    ++ mCur;
+    mTokenEnd = mCur;
+    return BlifToken::EQ;
+
+  case '.':
+    ++ mCur;
+    mTokenBegin = mCur;
+    return scan_string(true);
+
+  case '#':
+    {
+      // 改行までは読み飛ばす．
+      auto p = static_cast<const char*>(std::memchr(mCur, '\n', mEnd - mCur));
+      if ( p == nullptr ) {
+	mCur = mEnd;
+	mFirstPos = mCur;
+	mTokenBegin = mCur;
+	mTokenEnd = mCur;
+	return BlifToken::_EOF;
+      }
+      mFirstPos = p;
+      mTokenBegin = p;
+      mCur = p + 1;
+      mTokenEnd = mCur;
+      return BlifToken::NL;
+    }
+
+  case '/':
+    if ( mCur + 1 < mEnd && mCur[1] == '*' ) {
+      // "/*" から "*/" までは空白扱いにする．
+      for ( auto p = mCur + 2; p + 1 < mEnd; ++ p ) {
+	if ( p[0] == '*' && p[1] == '/' ) {
+	  mCur = p + 2;
+	  goto ST_INIT;
+	}
+      }
+      mCur = mEnd;
+      mFirstPos = mCur;
+      mTokenBegin = mCur;
+      mTokenEnd = mCur;
+      return BlifToken::_EOF;
+    }
+    return scan_string(false);
+
+  case '\\':
+    ++ mCur;
+    if ( mCur == mEnd ) {
+      // これはおかしいけど無視する．
+      mTokenBegin = mCur;
+      mTokenEnd = mCur;
+      return BlifToken::STRING;
+    }
+    if ( *mCur == '\n' ) {
+      // エスケープされた改行は空白扱いにする．
+      ++ mCur;
+      goto ST_INIT;
+    }
+    // それ以外は普通の文字として扱う．
+    mTokenBegin = mCur;
+    ++ mCur;
+    return scan_string(false);
+
+  default:
+    return scan_string(false);
+  }
+}
+
+// @brief 文字列の終わりまで読み進める．
+BlifToken
+BlifMmapScanner::scan_string(
+  bool start_with_dot
+)
+{
+  auto p = mCur;
+  for ( ; p < mEnd; ++ p ) {
+    auto c = *p;
+    if ( c == ' ' || c == '\t' || c == '\n' ||
+	 c == '=' || c == '#' || c == '\\' ) {
+      break;
+    }
+  }
+  mCur = p;
+  mTokenEnd = p;
+  if ( start_with_dot ) {
+    return check_word(cur_view());
+  }
+  return BlifToken::STRING;
+}
+
+// @brief 予約語を調べる．
+BlifToken
+BlifMmapScanner::check_word(
+  std::string_view word
+)
+{
+  switch ( word.size() ) {
+  case 1:
+    switch ( word[0] ) {
+    case 'i': return BlifToken::I;
+    case 'o': return BlifToken::O;
+    case 'p': return BlifToken::P;
+    case 'r': return BlifToken::R;
+    default: break;
+    }
+    break;
+
+  case 3:
+    if ( match(word, "end") ) return BlifToken::END;
+    break;
+
+  case 4:
+    switch ( word[0] ) {
+    case 'a': if ( match(word, "area") ) return BlifToken::AREA; break;
+    case 'c': if ( match(word, "code") ) return BlifToken::CODE; break;
+    case 'e': if ( match(word, "exdc") ) return BlifToken::EXDC; break;
+    case 'g': if ( match(word, "gate") ) return BlifToken::GATE; break;
+    case 'w': if ( match(word, "wire") ) return BlifToken::WIRE; break;
+    default: break;
+    }
+    break;
+
+  case 5:
+    switch ( word[0] ) {
+    case 'c':
+      if ( match(word, "clock") ) return BlifToken::CLOCK;
+      if ( match(word, "cycle") ) return BlifToken::CYCLE;
+      break;
+    case 'd': if ( match(word, "delay") ) return BlifToken::DELAY; break;
+    case 'l': if ( match(word, "latch") ) return BlifToken::LATCH; break;
+    case 'm': if ( match(word, "model") ) return BlifToken::MODEL; break;
+    case 'n': if ( match(word, "names") ) return BlifToken::NAMES; break;
+    default: break;
+    }
+    break;
+
+  case 6:
+    switch ( word[0] ) {
+    case 'i': if ( match(word, "inputs") ) return BlifToken::INPUTS; break;
+    case 'm': if ( match(word, "mlatch") ) return BlifToken::MLATCH; break;
+    case 's':
+      if ( match(word, "subckt") ) return BlifToken::SUBCKT;
+      if ( match(word, "search") ) return BlifToken::SEARCH;
+      break;
+    default: break;
+    }
+    break;
+
+  case 7:
+    if ( match(word, "outputs") ) return BlifToken::OUTPUTS;
+    break;
+
+  case 8:
+    if ( match(word, "end_kiss") ) return BlifToken::END_KISS;
+    break;
+
+  case 10:
+    if ( match(word, "start_kiss") ) return BlifToken::START_KISS;
+    break;
+
+  case 11:
+    switch ( word[0] ) {
+    case 'c': if ( match(word, "clock_event") ) return BlifToken::CLOCK_EVENT; break;
+    case 'i': if ( match(word, "input_drive") ) return BlifToken::INPUT_DRIVE; break;
+    case 'l': if ( match(word, "latch_order") ) return BlifToken::LATCH_ORDER; break;
+    case 'o': if ( match(word, "output_load") ) return BlifToken::OUTPUT_LOAD; break;
+    default: break;
+    }
+    break;
+
+  case 13:
+    if ( match(word, "input_arrival") ) return BlifToken::INPUT_ARRIVAL;
+    break;
+
+  case 15:
+    switch ( word[0] ) {
+    case 'o': if ( match(word, "output_required") ) return BlifToken::OUTPUT_REQUIRED; break;
+    case 'w': if ( match(word, "wire_load_slope") ) return BlifToken::WIRE_LOAD_SLOPE; break;
+    default: break;
+    }
+    break;
+
+  case 19:
+    if ( match(word, "default_input_drive") ) return BlifToken::DEFAULT_INPUT_DRIVE;
+    if ( match(word, "default_output_load") ) return BlifToken::DEFAULT_OUTPUT_LOAD;
+    break;
+
+  case 21:
+    if ( match(word, "default_input_arrival") ) return BlifToken::DEFAULT_INPUT_ARRIVAL;
+    break;
+
+  case 23:
+    if ( match(word, "default_output_required") ) return BlifToken::DEFAULT_OUTPUT_REQUIRED;
+    break;
+
+  default:
+    break;
+  }
+  return BlifToken::STRING;
+}
+
+// @brief 最後の read_token() で読み出したトークンの位置を返す．
+FileRegion
+BlifMmapScanner::cur_region()
+{
+  SizeType line1;
+  const char* head1;
+  locate(mFirstPos, line1, head1);
+  // 終了位置は最後の文字の位置とする．
+  auto last_pos = mTokenEnd > mFirstPos ? mTokenEnd - 1 : mFirstPos;
+  SizeType line2;
+  const char* head2;
+  locate(last_pos, line2, head2);
+  int column1 = mFirstPos - head1 + 1;
+  int column2 = last_pos - head2 + 1;
+  return FileRegion{mFileInfo,
+		    static_cast<int>(line1), column1,
+		    static_cast<int>(line2), column2};
+}
+
+// @brief pos の位置の行番号と行頭を求める．
+void
+BlifMmapScanner::locate(
+  const char* pos,
+  SizeType& line,
+  const char*& line_head
+)
+{
+  if ( pos < mLocPos ) {
+    // 後戻りする場合は先頭から数え直す．
+    mLocPos = mBegin;
+    mLocLine = 1;
+    mLocHead = mBegin;
+  }
+  auto p = mLocPos;
+  for ( ; ; ) {
+    auto q = static_cast<const char*>(std::memchr(p, '\n', pos - p));
+    if ( q == nullptr ) {
+      break;
+    }
+    ++ mLocLine;
+    p = q + 1;
+    mLocHead = p;
+  }
+  mLocPos = pos;
+  line = mLocLine;
+  line_head = mLocHead;
+}
+
+END_NAMESPACE_YM_BLIF
@@ -0,0 +1,204 @@
+#ifndef BLIFMMAPSCANNER_H
+#define BLIFMMAPSCANNER_H
+
+/// @file BlifMmapScanner.h
+/// @brief BlifMmapScanner のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/blif_nsdef.h"
+#include "ym/FileInfo.h"
+#include "ym/FileRegion.h"
+#include "BlifToken.h"
+#include "MappedFile.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_BLIF
+
+//////////////////////////////////////////////////////////////////////
+/// @class BlifMmapScanner BlifMmapScanner.h "BlifMmapScanner.h"
+/// @brief ファイルをメモリにマップして読む blif 用の字句解析器
+///
+/// BlifScanner と同じトークン列を返すが，以下の点が異なる．
+/// - ファイル全体を MappedFile でメモリ上に置き，1文字ずつのコピーを行わない．
+/// - 文字列トークンはマップした領域を指す std::string_view で返す．
+///   ビューはこのオブジェクトが存在する間有効である．
+/// - 予約語は長さと先頭の文字による switch 文で判定する．
+/// - 行番号とコラム位置は cur_region() が呼ばれた時に，
+///   前回求めた位置から改行を数えて求める．
+//////////////////////////////////////////////////////////////////////
+class BlifMmapScanner
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// ファイルが開けなかった場合は is_valid() が false となる．
+  BlifMmapScanner(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief メモリ上の文字列を読む場合のコンストラクタ
+  ///
+  /// 内容はコピーされる．
+  BlifMmapScanner(
+    std::string_view contents, ///< [in] 内容
+    const FileInfo& file_info  ///< [in] ファイル情報
+  );
+
+  /// @brief 他の字句解析器の部分範囲を読む場合のコンストラクタ
+  ///
+  /// 内容は src と共有するのでコピーは行わない．
+  /// src はこのオブジェクトよりも長く存在する必要がある．
+  /// 行番号は範囲の先頭を1行目として数える．
+  BlifMmapScanner(
+    const BlifMmapScanner& src, ///< [in] 元の字句解析器
+    SizeType begin,             ///< [in] 開始位置(先頭からのオフセット)
+    SizeType end                ///< [in] 終了位置(先頭からのオフセット)
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  BlifMmapScanner(
+    const BlifMmapScanner& src
+  ) = delete;
+
+  /// @brief 代入演算子は禁止
+  BlifMmapScanner&
+  operator=(
+    const BlifMmapScanner& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~BlifMmapScanner() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを読み込めた時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mValid;
+  }
+
+  /// @brief 内容全体を返す．
+  std::string_view
+  contents() const
+  {
+    return std::string_view{mBegin, static_cast<SizeType>(mEnd - mBegin)};
+  }
+
+  /// @brief トークンを一つ読み出す．
+  BlifToken
+  read_token();
+
+  /// @brief 最後の read_token() で読み出した字句を返す．
+  ///
+  /// '.' で始まる字句の場合，'.' は含まない．
+  std::string_view
+  cur_view() const
+  {
+    return std::string_view{mTokenBegin,
+			    static_cast<SizeType>(mTokenEnd - mTokenBegin)};
+  }
+
+  /// @brief 最後の read_token() で読み出した字句の文字列を返す．
+  string
+  cur_string() const
+  {
+    return string{cur_view()};
+  }
+
+  /// @brief 最後の read_token() で読み出したトークンの位置を返す．
+  FileRegion
+  cur_region();
+
+  /// @brief 予約語を調べる．
+  /// @return 予約語の場合は対応するトークンを，
+  /// そうでなければ BlifToken::STRING を返す．
+  static
+  BlifToken
+  check_word(
+    std::string_view word ///< [in] '.' を除いた字句
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief read_token() の下請け関数
+  BlifToken
+  scan();
+
+  /// @brief 文字列の終わりまで読み進める．
+  BlifToken
+  scan_string(
+    bool start_with_dot ///< [in] '.' で始まっている時に true を渡す．
+  );
+
+  /// @brief pos の位置の行番号と行頭を求める．
+  void
+  locate(
+    const char* pos,       ///< [in] 位置
+    SizeType& line,        ///< [out] 行番号
+    const char*& line_head ///< [out] 行頭の位置
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル情報
+  FileInfo mFileInfo;
+
+  // 読み込めた時 true
+  bool mValid{false};
+
+  // ファイルの内容
+  nsBnet::MappedFile mFile;
+
+  // メモリ上の文字列を読む場合のバッファ
+  string mBuffer;
+
+  // 内容の先頭
+  const char* mBegin{nullptr};
+
+  // 内容の末尾
+  const char* mEnd{nullptr};
+
+  // 次に読む位置
+  const char* mCur{nullptr};
+
+  // 最後のトークンの先頭(先頭の '.' は含まない)
+  const char* mTokenBegin{nullptr};
+
+  // 最後のトークンの末尾
+  const char* mTokenEnd{nullptr};
+
+  // 最後のトークンの先頭('.' を含む)
+  const char* mFirstPos{nullptr};
+
+  // 行番号を求めた最後の位置
+  const char* mLocPos{nullptr};
+
+  // mLocPos の行番号
+  SizeType mLocLine{1};
+
+  // mLocPos の行頭
+  const char* mLocHead{nullptr};
+
+};
+
+END_NAMESPACE_YM_BLIF
+
+#endif // BLIFMMAPSCANNER_H
@@ -30,14 +30,15 @@ BlifModel::read(
 bool
 BlifModel::read(
   const string& filename,
-  const ClibCellLibrary& cell_library
+  const ClibCellLibrary& cell_library,
+  SizeType thread_num
 )
 {
   delete mImpl;
   mImpl = new ModelImpl;
 
   BlifParser parser;
-  return parser.read(filename, cell_library, mImpl);
+  return parser.read(filename, cell_library, *mImpl, thread_num);
 }
 
 // @brief コンストラクタ
@@ -24,7 +24,8 @@ bool
 BlifParser::read(
   const string& filename,
   const ClibCellLibrary& cell_library,
-  ModelImpl* model
+  BlifHandler& handler,
+  SizeType thread_num
 )
 {
   // blif ファイル読み込みの状態遷移
@@ -42,8 +43,8 @@ BlifParser::read(
   //          otherwise                     -> neutral
 
   // ファイルをオープンする．
-  ifstream fin{filename};
-  if ( !fin ) {
+  BlifMmapScanner scanner{filename};
+  if ( !scanner.is_valid() ) {
     // エラー
     ostringstream buf;
     buf << filename << " : No such file.";
@@ -52,15 +53,23 @@ BlifParser::read(
     return false;
   }
 
-  BlifScanner scanner{fin, {filename}};
-  CoverMgr cover_mgr{model};
-
   // 初期化を行う．
+  mHandler = &handler;
+  mCellLibrary = cell_library;
+  clear_ids();
+
+  if ( thread_num > 1 ) {
+    bool stat;
+    if ( read_mt(scanner, thread_num, stat) ) {
+      return stat;
+    }
+    // 並列に扱えない内容だったので逐次的に読み直す．
+    clear_ids();
+  }
+
+  CoverMgr cover_mgr;
   mScanner = &scanner;
   mCoverMgr = &cover_mgr;
-  mModel = model;
-
-  mCellLibrary = cell_library;
 
   // エラー箇所
   FileRegion error_loc;
@@ -242,18 +251,8 @@ BlifParser::read(
     }
   }
 
-  // 出力ノードからファンインをたどり
-  // post-order で番号をつける．
-  // 結果としてノードは入力からのトポロジカル順
-  // に整列される．
-  for ( auto id: mModel->mOutputList ) {
-    order_node(id);
-  }
-
-  // ラッチノードのファンインに番号をつける．
-  for ( auto id: mModel->mDffList ) {
-    auto& node = mModel->mNodeArray[id];
-    order_node(node.input());
+  if ( !mHandler->end() ) {
+    goto ST_ERROR_EXIT;
   }
 
   return true;
@@ -271,6 +270,16 @@ BlifParser::read(
   return false;
 }
 
+// @brief 識別子の情報をクリアする．
+void
+BlifParser::clear_ids()
+{
+  mNodeHash.clear();
+  mNameArray.clear();
+  mRefLocArray.clear();
+  mDefLocDict.clear();
+}
+
 // @brief .model 文の読み込みを行う．
 bool
 BlifParser::read_model()
@@ -316,7 +325,7 @@ BlifParser::read_model()
     return false;
   }
 
-  mModel->mName = cur_string();
+  mHandler->set_name(cur_string());
 
   // NL を待つ．
   next_token();
@@ -360,8 +369,7 @@ BlifParser::read_inputs()
       }
 
       set_defined(id, name_loc);
-      mModel->set_input(id);
-      mMark.emplace(id);
+      mHandler->set_input(id, name);
 
       ++ n_token;
     }
@@ -394,7 +402,7 @@ BlifParser::read_outputs()
       auto name = cur_string();
       auto name_loc = cur_loc();
       auto id = find_id(name, name_loc);
-      mModel->mOutputList.push_back(id);
+      mHandler->set_output(id, name);
       ++ n_token;
     }
     else if ( tk == BlifToken::NL ) {
@@ -626,7 +634,8 @@ BlifParser::read_names()
   auto cover_id = mCoverMgr->pat2cover(ni, cube_num, ipat_str, opat_char);
 
   set_defined(oid, names_loc);
-  mModel->set_cover(oid, names_id_list, cover_id);
+  mHandler->set_cover(oid, id2str(oid), names_id_list,
+		      cover_id, mCoverMgr->cover(cover_id));
 
   return true;
 }
@@ -791,7 +800,7 @@ BlifParser::read_gate()
       }
 
       set_defined(oid, oloc);
-      mModel->set_cell(oid, id_array, cell.id());
+      mHandler->set_cell(oid, id2str(oid), id_array, cell.id());
 
       // 次のトークンを読み込んでおく
       next_token();
@@ -860,8 +869,7 @@ BlifParser::read_latch()
     }
 
     set_defined(id2, name2_loc);
-    mModel->set_dff(id2, id1, rval);
-    mMark.emplace(id2);
+    mHandler->set_dff(id2, name2, id1, rval);
 
     return true;
   }
@@ -914,7 +922,7 @@ BlifParser::read_dummy1()
 void
 BlifParser::next_token()
 {
-  mCurToken = mScanner->read_token(mCurLoc);
+  mCurToken = mScanner->read_token();
 }
 
 // @brief 直前に読み出したトークンを返す．
@@ -935,25 +943,8 @@ BlifParser::cur_string() const
 FileRegion
 BlifParser::cur_loc() const
 {
-  return mCurLoc;
-}
-
-// @brief BlifNode を生成する．
-void
-BlifParser::order_node(
-  SizeType id
-)
-{
-  if ( mMark.count(id) > 0 ) {
-    return;
-  }
-  auto& node = mModel->mNodeArray[id];
-  ASSERT_COND( node.is_cover() || node.is_cell() );
-  for ( auto iid: node.fanin_list() ) {
-    order_node(iid);
-  }
-  mModel->mLogicList.push_back(id);
-  mMark.emplace(id);
+  // 位置は必要になった時に求める．
+  return mScanner->cur_region();
 }
 
 END_NAMESPACE_YM_BLIF
@@ -10,8 +10,8 @@
 
 #include "ym/blif_nsdef.h"
 #include "ym/ClibCellLibrary.h"
-#include "BlifScanner.h"
-#include "ModelImpl.h"
+#include "BlifMmapScanner.h"
+#include "BlifHandler.h"
 #include "CoverMgr.h"
 
 
@@ -21,8 +21,8 @@ BEGIN_NAMESPACE_YM_BLIF
 /// @class BlifParser BlifParser.h "ym/BlifParser.h"
 /// @brief blif形式のファイルを読み込むパーサークラス
 ///
-/// 適切なハンドラクラスを生成して add_handler() で登録して使う．
-/// @sa BlifHandler MsgHandler
+/// 読み込んだ内容は BlifHandler に順次渡される．
+/// @sa BlifHandler
 //////////////////////////////////////////////////////////////////////
 class BlifParser
 {
@@ -43,11 +43,16 @@ public:
   /// @brief 読み込みを行う(セルライブラリ付き)．
   /// @retval true 読み込みが成功した．
   /// @retval false 読み込みが失敗した．
+  ///
+  /// thread_num が 2 以上の時はファイルを文の区切りで分割して
+  /// 並列に解析する．並列に扱えない内容の場合は逐次的に読み直すので，
+  /// 結果は thread_num によらず同一となる．
   bool
   read(
     const string& filename,              ///< [in] ファイル名
     const ClibCellLibrary& cell_library, ///< [in] セルライブラリ
-    ModelImpl* model                     ///< [out] 結果を格納する変数
+    BlifHandler& handler,                ///< [in] 結果を受け取るハンドラ
+    SizeType thread_num = 1              ///< [in] スレッド数
   );
 
 
@@ -59,20 +64,40 @@ private:
   /// @brief 名前に対応するID番号を取り出す．
   /// @return 対応するID番号を返す．
   ///
-  /// 未登録の場合には新たに作る．
+  /// 未登録の場合には新たに作り，ハンドラにも登録する．
   SizeType
   find_id(
     const string& name,   ///< [in] 名前
     const FileRegion& loc ///< [in] name の位置
   )
   {
-    if ( mNodeHash.count(name) > 0 ) {
-      return mNodeHash.at(name);
+    auto n = mNameArray.size();
+    auto id = reg_id(name, loc);
+    if ( id == n ) {
+      mHandler->new_node(name);
+    }
+    return id;
+  }
+
+  /// @brief 名前に対応するID番号を取り出す．
+  /// @return 対応するID番号を返す．
+  ///
+  /// 未登録の場合には新たに作る．
+  /// ハンドラへの登録は行わない．
+  SizeType
+  reg_id(
+    const string& name,   ///< [in] 名前
+    const FileRegion& loc ///< [in] name の位置
+  )
+  {
+    auto p = mNodeHash.find(name);
+    if ( p != mNodeHash.end() ) {
+      return p->second;
     }
     auto id = mRefLocArray.size();
     mRefLocArray.push_back(loc);
-    mNodeHash.emplace(name, id);
-    mModel->new_node(name);
+    auto q = mNodeHash.emplace(name, id).first;
+    mNameArray.push_back(&q->first);
     return id;
   }
 
@@ -82,7 +107,8 @@ private:
     SizeType id ///< [in] ID番号
   )
   {
-    return mModel->node_name(id);
+    ASSERT_COND( 0 <= id && id < mNameArray.size() );
+    return *mNameArray[id];
   }
 
   /// @brief 参照位置を返す．
@@ -132,6 +158,22 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 識別子の情報をクリアする．
+  void
+  clear_ids();
+
+  /// @brief 並列に読み込みを行う．
+  /// @return 並列に処理できた時 true を返す．
+  ///
+  /// 読み込みの成否は stat に格納する．
+  /// false を返した場合はハンドラは呼ばれていない．
+  bool
+  read_mt(
+    const BlifMmapScanner& scanner, ///< [in] ファイル全体の字句解析器
+    SizeType thread_num,            ///< [in] スレッド数
+    bool& stat                      ///< [out] 読み込みが成功した時 true
+  );
+
   /// @brief .model 文の読み込みを行う．
   /// @retval true 正しく読み込んだ．
   /// @retval false エラーが起こった．
@@ -196,12 +238,6 @@ private:
   FileRegion
   cur_loc() const;
 
-  /// @brief 入力からのトポロジカル順にする．
-  void
-  order_node(
-    SizeType id ///< [in] 識別子番号
-  );
-
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -213,37 +249,34 @@ private:
 
   // 字句解析器
   // この変数は read() 内でのみ有効
-  BlifScanner* mScanner;
+  BlifMmapScanner* mScanner;
 
   // BlifCover を管理するオブジェクト
   // この変数は read() 内でのみ有効
   CoverMgr* mCoverMgr;
 
-  // 結果を格納するオブジェクト
+  // 結果を受け取るハンドラ
   // この変数は read() 内でのみ有効
-  ModelImpl* mModel;
+  BlifHandler* mHandler;
 
   // 現在のトークン
   BlifToken mCurToken;
 
-  // 現在のトークンの位置
-  FileRegion mCurLoc;
-
   // モデル名
   string mModelName;
 
   // 名前をキーにしたノード番号のハッシュ表
   unordered_map<string, SizeType> mNodeHash;
 
+  // ノード番号をキーにして名前(mNodeHash のキー)を格納する配列
+  vector<const string*> mNameArray;
+
   // ノードを参照している箇所の配列
   vector<FileRegion> mRefLocArray;
 
   // ノードを定義している箇所の辞書
   unordered_map<SizeType, FileRegion> mDefLocDict;
 
-  // 処理済みの印
-  unordered_set<SizeType> mMark;
-
 };
 
 END_NAMESPACE_YM_BLIF
@@ -0,0 +1,347 @@
+
+/// @file BlifParser_mt.cc
+/// @brief BlifParser の並列読み込み関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BlifParser.h"
+#include "BlifChunk.h"
+#include "ym/ClibCell.h"
+#include "ym/ClibPin.h"
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_BLIF
+
+BEGIN_NONAMESPACE
+
+// pos 以降で最初の文の先頭の位置を返す．
+//
+// 文の先頭は行頭の '.' とする．
+// ただし，直前の行が '\' で継続している場合は除く．
+// 見つからない場合は contents.size() を返す．
+SizeType
+find_stmt_head(
+  std::string_view contents,
+  SizeType pos
+)
+{
+  for ( ; ; ) {
+    auto p = contents.find("\n.", pos);
+    if ( p == std::string_view::npos ) {
+      return contents.size();
+    }
+    if ( p == 0 || contents[p - 1] != '\\' ) {
+      return p + 1;
+    }
+    pos = p + 1;
+  }
+}
+
+// 1つの範囲を解析する．
+void
+parse_chunk(
+  const BlifMmapScanner& scanner,
+  SizeType begin,
+  SizeType end,
+  BlifChunk& chunk,
+  int& result
+)
+{
+  BlifMmapScanner sub_scanner{scanner, begin, end};
+  result = chunk.parse(sub_scanner, begin == 0);
+}
+
+// ゲートのピンの情報
+// 出力ピンの場合は OUTPUT_PIN となる．
+const SizeType OUTPUT_PIN = static_cast<SizeType>(-1);
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BlifParser
+//////////////////////////////////////////////////////////////////////
+
+// @brief 並列に読み込みを行う．
+bool
+BlifParser::read_mt(
+  const BlifMmapScanner& scanner,
+  SizeType thread_num,
+  bool& stat
+)
+{
+  // 処理は以下の3段階で行う．
+  // 1. ファイルを文の区切りで分割し，それぞれをスレッドで解析する．
+  // 2. 名前の解決と二重定義などのチェックを逐次的に行う．
+  // 3. 文の順にハンドラを呼び出す．
+  // 1, 2 でエラーや警告となる内容が見つかった場合は false を返して
+  // 逐次版で読み直す．
+
+  auto contents = scanner.contents();
+  if ( contents.find("/*") != std::string_view::npos ) {
+    // 複数行にまたがるコメント中の '.' を文の先頭と区別できないので
+    // 並列には扱わない．
+    return false;
+  }
+
+  // ファイルを分割する．
+  SizeType size = contents.size();
+  vector<SizeType> bound_list{0};
+  for ( SizeType t = 1; t < thread_num; ++ t ) {
+    auto pos = std::max(size * t / thread_num, bound_list.back());
+    pos = find_stmt_head(contents, pos);
+    if ( pos >= size ) {
+      break;
+    }
+    if ( pos > bound_list.back() ) {
+      bound_list.push_back(pos);
+    }
+  }
+  bound_list.push_back(size);
+
+  // 各範囲を並列に解析する．
+  SizeType n = bound_list.size() - 1;
+  vector<BlifChunk> chunk_list(n);
+  vector<int> result_list(n, 0);
+  if ( n == 1 ) {
+    parse_chunk(scanner, 0, size, chunk_list[0], result_list[0]);
+  }
+  else {
+    vector<std::thread> thread_list;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      thread_list.push_back(std::thread{parse_chunk,
+					std::cref(scanner),
+					bound_list[i], bound_list[i + 1],
+					std::ref(chunk_list[i]),
+					std::ref(result_list[i])});
+    }
+    for ( auto& thr: thread_list ) {
+      thr.join();
+    }
+  }
+  for ( auto result: result_list ) {
+    if ( !result ) {
+      return false;
+    }
+  }
+
+  // 名前を識別子番号に変換しつつ，逐次版でエラーとなる内容を調べる．
+  // 結果は名前のリストと同じ並びで id_list_array に格納する．
+  // .gate 文の場合，セル名の位置にはセル番号を，ピン名の位置には
+  // 入力ピン番号(出力ピンの場合は OUTPUT_PIN)を格納する．
+  string model_name;
+  bool end_seen = false;
+  vector<vector<SizeType>> id_list_array(n);
+  for ( SizeType c = 0; c < n; ++ c ) {
+    auto& chunk = chunk_list[c];
+    auto& name_list = chunk.name_list();
+    auto& id_list = id_list_array[c];
+    id_list.resize(name_list.size());
+    for ( auto& stmt: chunk.stmt_list() ) {
+      if ( end_seen ) {
+	// .end の後の文は警告となる．
+	return false;
+      }
+      auto b = stmt.mNameBegin;
+      auto e = stmt.mNameEnd;
+      switch ( stmt.mType ) {
+      case BlifToken::MODEL:
+	model_name = string{name_list[b]};
+	break;
+
+      case BlifToken::INPUTS:
+	for ( auto i = b; i < e; ++ i ) {
+	  auto id = reg_id(string{name_list[i]}, FileRegion{});
+	  if ( is_defined(id) ) {
+	    return false;
+	  }
+	  set_defined(id, FileRegion{});
+	  id_list[i] = id;
+	}
+	break;
+
+      case BlifToken::OUTPUTS:
+	for ( auto i = b; i < e; ++ i ) {
+	  id_list[i] = reg_id(string{name_list[i]}, FileRegion{});
+	}
+	break;
+
+      case BlifToken::NAMES:
+	for ( auto i = b; i < e; ++ i ) {
+	  id_list[i] = reg_id(string{name_list[i]}, FileRegion{});
+	}
+	if ( is_defined(id_list[e - 1]) ) {
+	  return false;
+	}
+	set_defined(id_list[e - 1], FileRegion{});
+	break;
+
+      case BlifToken::GATE:
+	{
+	  if ( mCellLibrary.cell_num() == 0 ) {
+	    return false;
+	  }
+	  auto cell = mCellLibrary.cell(string{name_list[b]});
+	  if ( cell.is_invalid() ||
+	       !cell.is_logic() ||
+	       cell.output_num() != 1 ||
+	       cell.has_tristate(0) ||
+	       cell.inout_num() > 0 ) {
+	    return false;
+	  }
+	  id_list[b] = cell.id();
+	  auto ni = cell.input_num();
+	  vector<bool> assigned(ni, false);
+	  SizeType oid = 0;
+	  bool has_output = false;
+	  for ( auto i = b + 1; i < e; i += 2 ) {
+	    auto pin = cell.pin(string{name_list[i]});
+	    if ( pin.is_invalid() ) {
+	      return false;
+	    }
+	    auto id2 = reg_id(string{name_list[i + 1]}, FileRegion{});
+	    id_list[i + 1] = id2;
+	    if ( pin.is_output() ) {
+	      if ( is_defined(id2) ) {
+		return false;
+	      }
+	      oid = id2;
+	      has_output = true;
+	      id_list[i] = OUTPUT_PIN;
+	    }
+	    else {
+	      auto pos = pin.input_id();
+	      if ( assigned[pos] ) {
+		return false;
+	      }
+	      assigned[pos] = true;
+	      id_list[i] = pos;
+	    }
+	  }
+	  if ( !has_output ) {
+	    return false;
+	  }
+	  for ( SizeType i = 0; i < ni; ++ i ) {
+	    if ( !assigned[i] ) {
+	      return false;
+	    }
+	  }
+	  set_defined(oid, FileRegion{});
+	}
+	break;
+
+      case BlifToken::LATCH:
+	{
+	  auto id1 = reg_id(string{name_list[b]}, FileRegion{});
+	  auto id2 = reg_id(string{name_list[b + 1]}, FileRegion{});
+	  if ( is_defined(id2) ) {
+	    return false;
+	  }
+	  set_defined(id2, FileRegion{});
+	  id_list[b] = id1;
+	  id_list[b + 1] = id2;
+	}
+	break;
+
+      case BlifToken::END:
+	end_seen = true;
+	break;
+
+      default:
+	ASSERT_NOT_REACHED;
+	break;
+      }
+    }
+  }
+  if ( !end_seen ) {
+    // .end がない場合は警告となる．
+    return false;
+  }
+  SizeType id_num = mNameArray.size();
+  for ( SizeType id = 0; id < id_num; ++ id ) {
+    if ( !is_defined(id) ) {
+      return false;
+    }
+  }
+
+  // ここから先はエラーにならないので結果をハンドラに渡す．
+  mHandler->set_name(model_name);
+  for ( SizeType id = 0; id < id_num; ++ id ) {
+    mHandler->new_node(id2str(id));
+  }
+
+  CoverMgr cover_mgr;
+  for ( SizeType c = 0; c < n; ++ c ) {
+    auto& chunk = chunk_list[c];
+    auto& id_list = id_list_array[c];
+    for ( auto& stmt: chunk.stmt_list() ) {
+      auto b = stmt.mNameBegin;
+      auto e = stmt.mNameEnd;
+      switch ( stmt.mType ) {
+      case BlifToken::INPUTS:
+	for ( auto i = b; i < e; ++ i ) {
+	  auto id = id_list[i];
+	  mHandler->set_input(id, id2str(id));
+	}
+	break;
+
+      case BlifToken::OUTPUTS:
+	for ( auto i = b; i < e; ++ i ) {
+	  auto id = id_list[i];
+	  mHandler->set_output(id, id2str(id));
+	}
+	break;
+
+      case BlifToken::NAMES:
+	{
+	  SizeType ni = e - b - 1;
+	  vector<SizeType> fanin_list(id_list.begin() + b,
+				      id_list.begin() + e - 1);
+	  auto oid = id_list[e - 1];
+	  auto cover_id = cover_mgr.pat2cover(ni, stmt.mCubeNum,
+					      chunk.pat_str(stmt), stmt.mChar);
+	  mHandler->set_cover(oid, id2str(oid), fanin_list,
+			      cover_id, cover_mgr.cover(cover_id));
+	}
+	break;
+
+      case BlifToken::GATE:
+	{
+	  auto cell_id = id_list[b];
+	  auto ni = mCellLibrary.cell(cell_id).input_num();
+	  vector<SizeType> fanin_list(ni);
+	  SizeType oid = 0;
+	  for ( auto i = b + 1; i < e; i += 2 ) {
+	    if ( id_list[i] == OUTPUT_PIN ) {
+	      oid = id_list[i + 1];
+	    }
+	    else {
+	      fanin_list[id_list[i]] = id_list[i + 1];
+	    }
+	  }
+	  mHandler->set_cell(oid, id2str(oid), fanin_list, cell_id);
+	}
+	break;
+
+      case BlifToken::LATCH:
+	{
+	  auto id1 = id_list[b];
+	  auto id2 = id_list[b + 1];
+	  mHandler->set_dff(id2, id2str(id2), id1, stmt.mChar);
+	}
+	break;
+
+      default:
+	break;
+      }
+    }
+  }
+
+  stat = mHandler->end();
+  return true;
+}
+
+END_NAMESPACE_YM_BLIF
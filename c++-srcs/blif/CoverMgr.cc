@@ -13,19 +13,67 @@ BEGIN_NAMESPACE_YM_BLIF
 
 BEGIN_NONAMESPACE
 
-// キー生成関数その１
-string
-key_func(
+// 1ワードに詰め込むリテラル数
+const SizeType LIT_PER_WORD = 32;
+
+// 入力パタンのワード数を返す．
+inline
+SizeType
+word_num(
+  SizeType lit_num
+)
+{
+  return (lit_num + LIT_PER_WORD - 1) / LIT_PER_WORD;
+}
+
+// パタン文字を2ビットのコードに変換する．
+//
+// '-' -> 0, '1' -> 1, '0' -> 2
+inline
+std::uint64_t
+pat2code(
+  char c
+)
+{
+  switch ( c ) {
+  case '1': return 1;
+  case '0': return 2;
+  default:  return 0;
+  }
+}
+
+// 入力パタンの wpos 番目のワードを作る．
+std::uint64_t
+pack_word(
+  std::string_view ipat_str,
+  SizeType wpos
+)
+{
+  SizeType b = wpos * LIT_PER_WORD;
+  SizeType e = std::min(b + LIT_PER_WORD, ipat_str.size());
+  std::uint64_t word = 0;
+  for ( SizeType i = b; i < e; ++ i ) {
+    word |= pat2code(ipat_str[i]) << ((i - b) * 2);
+  }
+  return word;
+}
+
+// パタンのハッシュ値を求める．
+SizeType
+hash_func(
   SizeType input_num,
-  const string& ipat_str,
+  SizeType cube_num,
+  std::string_view ipat_str,
   char opat_char
 )
 {
-  ostringstream buf;
-  buf << input_num << ':'
-      << opat_char << ':'
-      << ipat_str;
-  return buf.str();
+  SizeType h = (input_num * 1021 + cube_num) * 4 + opat_char;
+  SizeType nw = word_num(ipat_str.size());
+  for ( SizeType w = 0; w < nw; ++ w ) {
+    auto word = pack_word(ipat_str, w);
+    h ^= word + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  }
+  return h;
 }
 
 END_NONAMESPACE
@@ -34,6 +82,23 @@ END_NONAMESPACE
 // クラス BlifCover
 //////////////////////////////////////////////////////////////////////
 
+// @brief 真理値表を持つ最大の入力数
+const SizeType BlifCover::kMaxTvInputs = 10;
+
+// @brief コンストラクタ
+BlifCover::BlifCover(
+  SizeType input_num,
+  const vector<vector<Literal>>& icover,
+  char opat
+) : mInputCover{input_num, icover},
+    mOutputPat{opat}
+{
+  if ( input_num <= kMaxTvInputs ) {
+    mTvFunc = expr().make_tv(input_num);
+  }
+}
+
+// @brief 内容を Expr に変換する．
 Expr
 BlifCover::expr() const
 {
@@ -66,45 +131,64 @@ BlifCover::print(
 // クラス CoverMgr
 //////////////////////////////////////////////////////////////////////
 
-// @brief コンストラクタ
-CoverMgr::CoverMgr(
-  ModelImpl* model
-) : mModel{model}
-{
-}
-
-// @brief 登録されているカバー数を返す．
-SizeType
-CoverMgr::cover_num() const
-{
-  return mModel->mCoverArray.size();
-}
-
 // @brief パタン文字列からカバーを返す．
 SizeType
 CoverMgr::pat2cover(
   SizeType input_num,
   SizeType cube_num,
-  const string& ipat_str,
+  std::string_view ipat_str,
   char opat_char
 )
 {
-  // カバーを表す文字列を作る．
-  auto key_str{key_func(input_num, ipat_str, opat_char)};
+  ASSERT_COND( ipat_str.size() == input_num * cube_num );
 
   // すでに登録されているか調べる．
-  if ( mCoverDict.count(key_str) > 0 ) {
-    auto id = mCoverDict.at(key_str);
-    return id;
+  auto h = hash_func(input_num, cube_num, ipat_str, opat_char);
+  auto range = mCoverDict.equal_range(h);
+  for ( auto p = range.first; p != range.second; ++ p ) {
+    auto id = p->second;
+    if ( check_equal(id, input_num, cube_num, ipat_str, opat_char) ) {
+      return id;
+    }
   }
-  else {
-    // 新しいカバーを作る．
-    auto id = new_cover(input_num, cube_num, ipat_str, opat_char);
 
-    // そのカバーを登録する．
-    mCoverDict.insert({key_str, id});
-    return id;
+  // 新しいカバーを作る．
+  auto id = new_cover(input_num, cube_num, ipat_str, opat_char);
+
+  // パタンを詰め込んで登録する．
+  auto begin = mPatBuf.size();
+  SizeType nw = word_num(ipat_str.size());
+  for ( SizeType w = 0; w < nw; ++ w ) {
+    mPatBuf.push_back(pack_word(ipat_str, w));
+  }
+  mPatInfoArray.push_back(PatInfo{input_num, cube_num, opat_char, begin});
+  mCoverDict.emplace(h, id);
+  return id;
+}
+
+// @brief 登録済みのカバーがパタンと等しいか調べる．
+bool
+CoverMgr::check_equal(
+  SizeType cover_id,
+  SizeType input_num,
+  SizeType cube_num,
+  std::string_view ipat_str,
+  char opat_char
+) const
+{
+  auto& info = mPatInfoArray[cover_id];
+  if ( info.mInputNum != input_num ||
+       info.mCubeNum != cube_num ||
+       info.mOpat != opat_char ) {
+    return false;
+  }
+  SizeType nw = word_num(ipat_str.size());
+  for ( SizeType w = 0; w < nw; ++ w ) {
+    if ( mPatBuf[info.mBegin + w] != pack_word(ipat_str, w) ) {
+      return false;
+    }
   }
+  return true;
 }
 
 // @brief SopCover を作る．
@@ -112,18 +196,18 @@ SizeType
 CoverMgr::new_cover(
   SizeType input_num,
   SizeType cube_num,
-  const string& ipat_str,
+  std::string_view ipat_str,
   char opat
 )
 {
   vector<vector<Literal>> cube_list;
   cube_list.reserve(cube_num);
   for ( SizeType c = 0; c < cube_num; ++ c ) {
-    string ipat = ipat_str.substr(c * input_num, (c + 1) * input_num);
+    auto base = c * input_num;
     vector<Literal> cube;
     cube.reserve(input_num);
     for ( SizeType var = 0; var < input_num; ++ var ) {
-      switch ( ipat[var] ) {
+      switch ( ipat_str[base + var] ) {
       case '0': cube.push_back(Literal{var, true}); break;
       case '1': cube.push_back(Literal{var, false}); break;
       case '-': break;
@@ -134,7 +218,7 @@ CoverMgr::new_cover(
   }
 
   auto id = cover_num();
-  mModel->mCoverArray.push_back(BlifCover{input_num, cube_list, opat});
+  mCoverArray.push_back(BlifCover{input_num, cube_list, opat});
 
   return id;
 }
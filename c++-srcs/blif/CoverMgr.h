@@ -10,7 +10,7 @@
 
 #include "ym/blif_nsdef.h"
 #include "ym/BlifCover.h"
-#include "ModelImpl.h"
+#include <string_view>
 
 
 BEGIN_NAMESPACE_YM_BLIF
@@ -18,15 +18,20 @@ BEGIN_NAMESPACE_YM_BLIF
 //////////////////////////////////////////////////////////////////////
 /// @class CoverMgr CoverMgr.h "CoverMgr.h"
 /// @brief BlifCover を管理するクラス
+///
+/// 内容の等しいカバーには同じ番号を割り当てる．
+///
+/// 入力パタンは1リテラルあたり2ビットに詰め込んだ形で保持し，
+/// そのハッシュ値で登録済みのカバーを探す．
+/// パタン文字列からは一時的な文字列を作らずに直接ハッシュ値の計算と
+/// 比較を行う．
 //////////////////////////////////////////////////////////////////////
 class CoverMgr
 {
 public:
 
   /// @brief コンストラクタ
-  CoverMgr(
-    ModelImpl* model
-  );
+  CoverMgr() = default;
 
   /// @brief デストラクタ
   ~CoverMgr() = default;
@@ -39,15 +44,28 @@ public:
 
   /// @brief 登録されているカバー数を返す．
   SizeType
-  cover_num() const;
+  cover_num() const
+  {
+    return mCoverArray.size();
+  }
+
+  /// @brief カバーを取り出す．
+  const BlifCover&
+  cover(
+    SizeType cover_id ///< [in] カバー番号
+  ) const
+  {
+    ASSERT_COND( 0 <= cover_id && cover_id < mCoverArray.size() );
+    return mCoverArray[cover_id];
+  }
 
   /// @brief パタン文字列からカバー番号を返す．
   SizeType
   pat2cover(
     SizeType input_num,     ///< [in] 入力数
     SizeType cube_num,      ///< [in] キューブ数
-    const string& ipat_str, ///< [in] 入力パタン文字列
-    char opat_char          ///< [in] 出力パタン
+    std::string_view ipat_str, ///< [in] 入力パタン文字列
+    char opat_char             ///< [in] 出力パタン
   );
 
 
@@ -62,8 +80,8 @@ private:
   new_cover(
     SizeType input_num,     ///< [in] 入力数
     SizeType cube_num,      ///< [in] キューブ数
-    const string& ipat_str, ///< [in] 入力パタン文字列
-    char opat_char          ///< [in] 出力パタン
+    std::string_view ipat_str, ///< [in] 入力パタン文字列
+    char opat_char             ///< [in] 出力パタン
   );
 
 
@@ -72,11 +90,17 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // モデル
-  ModelImpl* mModel;
+  // カバー番号をキーにしてカバーを格納する配列
+  vector<BlifCover> mCoverArray;
+
+  // カバー番号をキーにしてパタンの情報を格納する配列
+  vector<PatInfo> mPatInfoArray;
+
+  // 入力パタンを1リテラル2ビットで詰め込んだもの
+  vector<std::uint64_t> mPatBuf;
 
-  // カバーを表す文字列をキーにしてID番号を納める辞書
-  unordered_map<string, SizeType> mCoverDict;
+  // パタンのハッシュ値をキーにしてカバー番号を格納する辞書
+  unordered_multimap<SizeType, SizeType> mCoverDict;
 
 };
 
@@ -11,4 +11,57 @@
 
 BEGIN_NAMESPACE_YM_BLIF
 
+//////////////////////////////////////////////////////////////////////
+// クラス ModelImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 読み込みの終了処理を行う．
+bool
+ModelImpl::end()
+{
+  // 入力とラッチは処理済みとする．
+  unordered_set<SizeType> mark;
+  for ( auto id: mInputList ) {
+    mark.emplace(id);
+  }
+  for ( auto id: mDffList ) {
+    mark.emplace(id);
+  }
+
+  // 出力ノードからファンインをたどり
+  // post-order で番号をつける．
+  // 結果としてノードは入力からのトポロジカル順
+  // に整列される．
+  for ( auto id: mOutputList ) {
+    order_node(id, mark);
+  }
+
+  // ラッチノードのファンインに番号をつける．
+  for ( auto id: mDffList ) {
+    auto& node = _node(id);
+    order_node(node.input(), mark);
+  }
+
+  return true;
+}
+
+// @brief 出力側からたどって論理ノードのリストに加える．
+void
+ModelImpl::order_node(
+  SizeType id,
+  unordered_set<SizeType>& mark
+)
+{
+  if ( mark.count(id) > 0 ) {
+    return;
+  }
+  auto& node = _node(id);
+  ASSERT_COND( node.is_cover() || node.is_cell() );
+  for ( auto iid: node.fanin_list() ) {
+    order_node(iid, mark);
+  }
+  mLogicList.push_back(id);
+  mark.emplace(id);
+}
+
 END_NAMESPACE_YM_BLIF
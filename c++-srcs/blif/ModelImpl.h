@@ -13,6 +13,7 @@
 #include "ym/BlifCover.h"
 #include "ym/SopCover.h"
 #include "ym/FileRegion.h"
+#include "BlifHandler.h"
 
 
 BEGIN_NAMESPACE_YM_BLIF
@@ -20,12 +21,12 @@ BEGIN_NAMESPACE_YM_BLIF
 //////////////////////////////////////////////////////////////////////
 /// @class ModelImpl ModelImpl.h "ModelImpl.h"
 /// @brief BlifModel の内部情報を表すクラス
+///
+/// BlifParser の読み込み結果を BlifHandler として受け取る．
 //////////////////////////////////////////////////////////////////////
-class ModelImpl
+class ModelImpl :
+  public BlifHandler
 {
-  friend class BlifParser;
-  friend class CoverMgr;
-
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられるデータ構造
@@ -328,14 +329,23 @@ public:
 
 public:
   //////////////////////////////////////////////////////////////////////
-  // 設定用の関数
+  // BlifHandler の仮想関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief モデル名を設定する．
+  void
+  set_name(
+    const string& name ///< [in] モデル名
+  ) override
+  {
+    mName = name;
+  }
+
   /// @brief 新しいノードを作る．
   void
   new_node(
     const string& name ///< [in] 名前
-  )
+  ) override
   {
     mNodeArray.push_back({name});
   }
@@ -343,22 +353,40 @@ public:
   /// @brief 対応するID番号に入力用の印を付ける．
   void
   set_input(
-    SizeType id ///< [in] ID番号
-  )
+    SizeType id,       ///< [in] ID番号
+    const string& name ///< [in] 名前
+  ) override
   {
     auto& node = _node(id);
     node.set_input();
     mInputList.push_back(id);
   }
 
+  /// @brief 出力を設定する．
+  void
+  set_output(
+    SizeType id,       ///< [in] ID番号
+    const string& name ///< [in] 名前
+  ) override
+  {
+    mOutputList.push_back(id);
+  }
+
   /// @brief .names 文の情報をセットする．
   void
   set_cover(
     SizeType id,                        ///< [in] ID番号
+    const string& name,                 ///< [in] 名前
     const vector<SizeType>& input_list, ///< [in] 入力の識別子番号のリスト
-    SizeType cover_id                   ///< [in] カバー番号
-  )
+    SizeType cover_id,                  ///< [in] カバー番号
+    const BlifCover& cover              ///< [in] カバー
+  ) override
   {
+    if ( cover_id == mCoverArray.size() ) {
+      // 新しいカバー
+      mCoverArray.push_back(cover);
+    }
+    ASSERT_COND( cover_id < mCoverArray.size() );
     auto& node = _node(id);
     node.set_cover(input_list, cover_id);
   }
@@ -367,9 +395,10 @@ public:
   void
   set_cell(
     SizeType id,                        ///< [in] ID番号
+    const string& name,                 ///< [in] 名前
     const vector<SizeType>& input_list, ///< [in] 入力の識別子番号のリスト
     SizeType cell_id                    ///< [in] セル番号
-  )
+  ) override
   {
     auto& node = _node(id);
     node.set_cell(input_list, cell_id);
@@ -378,22 +407,36 @@ public:
   /// @brief .latch 文の情報をセットする．
   void
   set_dff(
-    SizeType id,           ///< [in] ID番号
-    SizeType input_id,     ///< [in] 入力の識別子番号
-    char rval              ///< [in] リセット値
-  )
+    SizeType id,        ///< [in] ID番号
+    const string& name, ///< [in] 名前
+    SizeType input_id,  ///< [in] 入力の識別子番号
+    char rval           ///< [in] リセット値
+  ) override
   {
     auto& node = _node(id);
     node.set_dff(input_id, rval);
     mDffList.push_back(id);
   }
 
+  /// @brief 読み込みの終了処理を行う．
+  ///
+  /// 論理ノードのリストを入力からのトポロジカル順に作る．
+  bool
+  end() override;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 出力側からたどって論理ノードのリストに加える．
+  void
+  order_node(
+    SizeType id,                  ///< [in] ID番号
+    unordered_set<SizeType>& mark ///< [inout] 処理済みの印
+  );
+
   /// @brief ノードを取り出す．
   Node&
   _node(
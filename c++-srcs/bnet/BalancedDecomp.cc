@@ -0,0 +1,425 @@
+
+/// @file BalancedDecomp.cc
+/// @brief BalancedDecomp の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BalancedDecomp.h"
+#include "Isop.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNodeMap.h"
+#include "ym/BnDff.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include <queue>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// カバーのリテラル数を数える．
+SizeType
+literal_num(
+  const vector<IsopCube>& cover
+)
+{
+  SizeType n = 0;
+  for ( auto& cube: cover ) {
+    n += cube.size();
+  }
+  return n;
+}
+
+END_NONAMESPACE
+
+
+// @brief 入力数を制限して段数が小さくなるように分解する．
+BnNetwork
+BnNetwork::balanced_decomp(
+  SizeType max_fanin
+) const
+{
+  if ( max_fanin < 2 ) {
+    ostringstream buf;
+    buf << "BnNetwork::balanced_decomp(" << max_fanin << "): "
+	<< "max_fanin should be greater than 1";
+    throw std::invalid_argument{buf.str()};
+  }
+
+  BalancedDecomp op{max_fanin};
+  op.decomp(*this);
+  return BnNetwork{std::move(op)};
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BalancedDecomp
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BalancedDecomp::BalancedDecomp(
+  SizeType max_fanin
+) : mMaxFanin{max_fanin}
+{
+  ASSERT_COND( mMaxFanin >= 2 );
+}
+
+// @brief 各ノードのファンイン数が max_fanin 以下になるように分解する．
+void
+BalancedDecomp::decomp(
+  const BnNetwork& src_network
+)
+{
+  mLevelArray.clear();
+  mInvMap.clear();
+
+  auto node_map = make_skelton_copy(src_network);
+
+  // DFFをコピーする．
+  for ( auto src_dff: src_network.dff_list() ) {
+    copy_dff(src_dff, node_map);
+  }
+
+  // 論理ノードを分解しつつコピーする．
+  for ( auto src_node: src_network.logic_list() ) {
+    SizeType ni = src_node.fanin_num();
+    vector<BnNode> fanin_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto src_iid = src_node.fanin_id(i);
+      ASSERT_COND( node_map.is_in(src_iid) );
+      fanin_list[i] = node_map.get(src_iid);
+    }
+    auto dst_node = decomp_node(src_node, fanin_list, node_map);
+    node_map.put(src_node.id(), dst_node);
+  }
+
+  // 出力のファンインをセットする．
+  for ( auto src_node: src_network.output_list() ) {
+    copy_output(src_node, node_map);
+  }
+}
+
+// @brief ノードを分解する．
+BnNode
+BalancedDecomp::decomp_node(
+  const BnNode& src_node,
+  const vector<BnNode>& fanin_list,
+  BnNodeMap& node_map
+)
+{
+  auto name = src_node.name();
+  switch ( src_node.type() ) {
+  case BnNodeType::Prim:
+    switch ( src_node.primitive_type() ) {
+    case PrimType::C0:
+    case PrimType::C1:
+      return new_gate(name, src_node.primitive_type(), {});
+    case PrimType::Buff:
+      return fanin_list[0];
+    case PrimType::Not:
+      return make_not(fanin_list[0], name);
+    case PrimType::And:
+      return make_tree(name, PrimType::And, PrimType::And, fanin_list);
+    case PrimType::Nand:
+      return make_tree(name, PrimType::And, PrimType::Nand, fanin_list);
+    case PrimType::Or:
+      return make_tree(name, PrimType::Or, PrimType::Or, fanin_list);
+    case PrimType::Nor:
+      return make_tree(name, PrimType::Or, PrimType::Nor, fanin_list);
+    case PrimType::Xor:
+      return make_tree(name, PrimType::Xor, PrimType::Xor, fanin_list);
+    case PrimType::Xnor:
+      return make_tree(name, PrimType::Xor, PrimType::Xnor, fanin_list);
+    case PrimType::None:
+      break;
+    }
+    break;
+
+  case BnNodeType::Expr:
+    return decomp_expr(src_node.expr(), fanin_list, name);
+
+  case BnNodeType::TvFunc:
+    return decomp_tv(src_node.func(), fanin_list, name);
+
+  case BnNodeType::Bdd:
+    {
+      unordered_map<Bdd, BnNode> bdd_map;
+      return decomp_bdd(src_node.bdd(), fanin_list, name, bdd_map);
+    }
+
+  default:
+    break;
+  }
+
+  // それ以外(セル型)はそのままコピーする．
+  auto dst_node = copy_logic(src_node, node_map);
+  set_level(dst_node);
+  return dst_node;
+}
+
+// @brief 論理式を分解する．
+BnNode
+BalancedDecomp::decomp_expr(
+  const Expr& expr,
+  const vector<BnNode>& fanin_list,
+  const string& name
+)
+{
+  if ( expr.is_zero() ) {
+    return new_gate(name, PrimType::C0, {});
+  }
+  if ( expr.is_one() ) {
+    return new_gate(name, PrimType::C1, {});
+  }
+  if ( expr.is_posi_literal() ) {
+    return fanin_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return make_not(fanin_list[expr.varid()], name);
+  }
+
+  vector<BnNode> opr_list;
+  opr_list.reserve(expr.operand_num());
+  for ( auto& opr: expr.operand_list() ) {
+    auto node = decomp_expr(opr, fanin_list, string{});
+    opr_list.push_back(node);
+  }
+  if ( expr.is_and() ) {
+    return make_tree(name, PrimType::And, PrimType::And, opr_list);
+  }
+  if ( expr.is_or() ) {
+    return make_tree(name, PrimType::Or, PrimType::Or, opr_list);
+  }
+  if ( expr.is_xor() ) {
+    return make_tree(name, PrimType::Xor, PrimType::Xor, opr_list);
+  }
+  ASSERT_NOT_REACHED;
+  return BnNode{};
+}
+
+// @brief 真理値表を分解する．
+BnNode
+BalancedDecomp::decomp_tv(
+  const TvFunc& func,
+  const vector<BnNode>& fanin_list,
+  const string& name
+)
+{
+  // 肯定と否定の両方の ISOP を求めてリテラル数の少ない方を用いる．
+  auto cover = isop(func);
+  auto ncover = isop(func, true);
+  bool inv = false;
+  if ( literal_num(ncover) < literal_num(cover) ) {
+    cover.swap(ncover);
+    inv = true;
+  }
+
+  if ( cover.empty() ) {
+    return new_gate(name, inv ? PrimType::C1 : PrimType::C0, {});
+  }
+
+  vector<BnNode> cube_list;
+  cube_list.reserve(cover.size());
+  for ( auto& cube: cover ) {
+    vector<BnNode> lit_list;
+    lit_list.reserve(cube.size());
+    for ( auto lit: cube ) {
+      auto node = fanin_list[lit / 2];
+      if ( lit % 2 ) {
+	node = make_not(node, string{});
+      }
+      lit_list.push_back(node);
+    }
+    if ( cover.size() == 1 ) {
+      // 積項が1つの場合はそれが根となる．
+      if ( lit_list.empty() ) {
+	return new_gate(name, inv ? PrimType::C0 : PrimType::C1, {});
+      }
+      return make_tree(name, PrimType::And,
+		       inv ? PrimType::Nand : PrimType::And,
+		       lit_list);
+    }
+    if ( lit_list.size() == 1 ) {
+      cube_list.push_back(lit_list[0]);
+    }
+    else {
+      auto node = make_tree(string{}, PrimType::And, PrimType::And, lit_list);
+      cube_list.push_back(node);
+    }
+  }
+  return make_tree(name, PrimType::Or,
+		   inv ? PrimType::Nor : PrimType::Or,
+		   cube_list);
+}
+
+// @brief BDD を分解する．
+BnNode
+BalancedDecomp::decomp_bdd(
+  const Bdd& bdd,
+  const vector<BnNode>& fanin_list,
+  const string& name,
+  unordered_map<Bdd, BnNode>& bdd_map
+)
+{
+  if ( bdd.is_zero() ) {
+    return new_gate(name, PrimType::C0, {});
+  }
+  if ( bdd.is_one() ) {
+    return new_gate(name, PrimType::C1, {});
+  }
+  if ( bdd_map.count(bdd) > 0 ) {
+    return bdd_map.at(bdd);
+  }
+
+  // 根の変数で Shannon 展開する．
+  auto var = bdd.root_var();
+  auto f0 = bdd.root_cofactor0();
+  auto f1 = bdd.root_cofactor1();
+  auto x = fanin_list[var];
+  BnNode node;
+  if ( f0.is_zero() && f1.is_one() ) {
+    node = x;
+  }
+  else if ( f0.is_one() && f1.is_zero() ) {
+    node = make_not(x, name);
+  }
+  else if ( f0.is_zero() ) {
+    // x & f1
+    auto node1 = decomp_bdd(f1, fanin_list, string{}, bdd_map);
+    node = make_tree(name, PrimType::And, PrimType::And, {x, node1});
+  }
+  else if ( f1.is_zero() ) {
+    // ~x & f0
+    auto node0 = decomp_bdd(f0, fanin_list, string{}, bdd_map);
+    auto xbar = make_not(x, string{});
+    node = make_tree(name, PrimType::And, PrimType::And, {xbar, node0});
+  }
+  else if ( f0.is_one() ) {
+    // ~x | f1
+    auto node1 = decomp_bdd(f1, fanin_list, string{}, bdd_map);
+    auto xbar = make_not(x, string{});
+    node = make_tree(name, PrimType::Or, PrimType::Or, {xbar, node1});
+  }
+  else if ( f1.is_one() ) {
+    // x | f0
+    auto node0 = decomp_bdd(f0, fanin_list, string{}, bdd_map);
+    node = make_tree(name, PrimType::Or, PrimType::Or, {x, node0});
+  }
+  else if ( f0 == ~f1 ) {
+    // x ? f1 : ~f1 = ~(x ^ f1)
+    auto node1 = decomp_bdd(f1, fanin_list, string{}, bdd_map);
+    node = make_tree(name, PrimType::Xor, PrimType::Xnor, {x, node1});
+  }
+  else {
+    // (x & f1) | (~x & f0)
+    auto node0 = decomp_bdd(f0, fanin_list, string{}, bdd_map);
+    auto node1 = decomp_bdd(f1, fanin_list, string{}, bdd_map);
+    auto xbar = make_not(x, string{});
+    auto and0 = make_tree(string{}, PrimType::And, PrimType::And, {xbar, node0});
+    auto and1 = make_tree(string{}, PrimType::And, PrimType::And, {x, node1});
+    node = make_tree(name, PrimType::Or, PrimType::Or, {and0, and1});
+  }
+  bdd_map.emplace(bdd, node);
+  return node;
+}
+
+// @brief 多入力のゲートを段数が小さくなるように分解する．
+BnNode
+BalancedDecomp::make_tree(
+  const string& name,
+  PrimType inner_type,
+  PrimType root_type,
+  const vector<BnNode>& fanin_list
+)
+{
+  SizeType n = fanin_list.size();
+  ASSERT_COND( n > 0 );
+
+  if ( n == 1 ) {
+    if ( root_type == inner_type ) {
+      return fanin_list[0];
+    }
+    // 否定型
+    return make_not(fanin_list[0], name);
+  }
+
+  // (段数, ノード番号) を段数の小さい順に取り出すヒープ
+  using LevelPair = pair<SizeType, SizeType>;
+  std::priority_queue<LevelPair, vector<LevelPair>, std::greater<LevelPair>> queue;
+  for ( auto node: fanin_list ) {
+    queue.push(make_pair(level(node), node.id()));
+  }
+
+  // 最初に組み合わせる個数を調整して以降は常に mMaxFanin 個ずつ
+  // 組み合わせられるようにする．
+  SizeType k = mMaxFanin;
+  SizeType g = n <= k ? n : (n - 2) % (k - 1) + 2;
+  for ( ; ; ) {
+    vector<BnNode> tmp_list;
+    tmp_list.reserve(g);
+    for ( SizeType i = 0; i < g; ++ i ) {
+      auto id = queue.top().second;
+      queue.pop();
+      tmp_list.push_back(node(id));
+    }
+    if ( queue.empty() ) {
+      return new_gate(name, root_type, tmp_list);
+    }
+    auto node1 = new_gate(string{}, inner_type, tmp_list);
+    queue.push(make_pair(level(node1), node1.id()));
+    g = k;
+  }
+}
+
+// @brief インバーターを作る．
+BnNode
+BalancedDecomp::make_not(
+  BnNode node,
+  const string& name
+)
+{
+  auto id = node.id();
+  if ( mInvMap.count(id) > 0 ) {
+    return mInvMap.at(id);
+  }
+  auto inv = new_gate(name, PrimType::Not, {node});
+  mInvMap.emplace(id, inv);
+  mInvMap.emplace(inv.id(), node);
+  return inv;
+}
+
+// @brief プリミティブ型のノードを作り段数を記録する．
+BnNode
+BalancedDecomp::new_gate(
+  const string& name,
+  PrimType prim_type,
+  const vector<BnNode>& fanin_list
+)
+{
+  auto node = new_logic_primitive(name, prim_type, fanin_list);
+  set_level(node);
+  return node;
+}
+
+// @brief ノードの段数を記録する．
+void
+BalancedDecomp::set_level(
+  BnNode node
+)
+{
+  SizeType lv = 0;
+  SizeType ni = node.fanin_num();
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    lv = std::max(lv, level(node.fanin(i)) + 1);
+  }
+  auto id = node.id();
+  if ( mLevelArray.size() <= id ) {
+    mLevelArray.resize(id + 1, 0);
+  }
+  mLevelArray[id] = lv;
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,164 @@
+#ifndef BALANCEDDECOMP_H
+#define BALANCEDDECOMP_H
+
+/// @file BalancedDecomp.h
+/// @brief BalancedDecomp のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "ym/Bdd.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class BalancedDecomp BalancedDecomp.h "BalancedDecomp.h"
+/// @brief 入力数を制限して段数が小さくなるように分解を行うクラス
+///
+/// - 多入力のゲートは段数の小さいファンインから順に組み合わせる
+///   (Huffman 符号の構成と同様の方法)．
+/// - インバーターは同じファンインを持つもの同士で共有する．
+/// - 真理値表型のノードは非冗長積和形(ISOP)を求めてから分解する．
+/// - BDD型のノードは根の変数で Shannon 展開して分解する．
+/// - セル型のノードはそのままコピーする．
+//////////////////////////////////////////////////////////////////////
+class BalancedDecomp :
+  public BnModifier
+{
+public:
+
+  /// @brief コンストラクタ
+  BalancedDecomp(
+    SizeType max_fanin ///< [in] ファンイン数の最大値 ( >= 2 )
+  );
+
+  /// @brief デストラクタ
+  ~BalancedDecomp() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 各ノードのファンイン数が max_fanin 以下になるように分解する．
+  void
+  decomp(
+    const BnNetwork& src_network ///< [in] 元のネットワーク
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードを分解する．
+  /// @return 生成したノードを返す．
+  BnNode
+  decomp_node(
+    const BnNode& src_node,           ///< [in] 対象のノード
+    const vector<BnNode>& fanin_list, ///< [in] ファンインのノードのリスト
+    BnNodeMap& node_map               ///< [inout] ID番号の対応表
+  );
+
+  /// @brief 論理式を分解する．
+  /// @return 生成したノードを返す．
+  BnNode
+  decomp_expr(
+    const Expr& expr,                 ///< [in] 論理式
+    const vector<BnNode>& fanin_list, ///< [in] ファンインのノードのリスト
+    const string& name                ///< [in] 根のノード名
+  );
+
+  /// @brief 真理値表を分解する．
+  /// @return 生成したノードを返す．
+  BnNode
+  decomp_tv(
+    const TvFunc& func,               ///< [in] 真理値表
+    const vector<BnNode>& fanin_list, ///< [in] ファンインのノードのリスト
+    const string& name                ///< [in] 根のノード名
+  );
+
+  /// @brief BDD を分解する．
+  /// @return 生成したノードを返す．
+  BnNode
+  decomp_bdd(
+    const Bdd& bdd,                     ///< [in] BDD
+    const vector<BnNode>& fanin_list,   ///< [in] ファンインのノードのリスト
+    const string& name,                 ///< [in] 根のノード名
+    unordered_map<Bdd, BnNode>& bdd_map ///< [inout] 分解済みの BDD の対応表
+  );
+
+  /// @brief 多入力のゲートを段数が小さくなるように分解する．
+  /// @return 根のノードを返す．
+  ///
+  /// - 根のノードのみ root_type となり，それ以外は inner_type となる．
+  BnNode
+  make_tree(
+    const string& name,              ///< [in] 根のノード名
+    PrimType inner_type,             ///< [in] 内部のノードの型
+    PrimType root_type,              ///< [in] 根のノードの型
+    const vector<BnNode>& fanin_list ///< [in] ファンインのノードのリスト
+  );
+
+  /// @brief インバーターを作る．
+  /// @return 生成したノードを返す．
+  ///
+  /// 同じノードに対するインバーターが既にあればそれを返す．
+  BnNode
+  make_not(
+    BnNode node,       ///< [in] 入力のノード
+    const string& name ///< [in] ノード名
+  );
+
+  /// @brief プリミティブ型のノードを作り段数を記録する．
+  /// @return 生成したノードを返す．
+  BnNode
+  new_gate(
+    const string& name,              ///< [in] ノード名
+    PrimType prim_type,              ///< [in] プリミティブ型
+    const vector<BnNode>& fanin_list ///< [in] ファンインのノードのリスト
+  );
+
+  /// @brief ノードの段数を記録する．
+  void
+  set_level(
+    BnNode node ///< [in] 対象のノード
+  );
+
+  /// @brief ノードの段数を返す．
+  ///
+  /// 入力ノードは 0 段となる．
+  SizeType
+  level(
+    BnNode node ///< [in] 対象のノード
+  ) const
+  {
+    auto id = node.id();
+    return id < mLevelArray.size() ? mLevelArray[id] : 0;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファンイン数の最大値
+  SizeType mMaxFanin;
+
+  // ノード番号をキーにして段数を格納する配列
+  vector<SizeType> mLevelArray;
+
+  // ノード番号をキーにして否定のノードを格納する辞書
+  unordered_map<SizeType, BnNode> mInvMap;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // BALANCEDDECOMP_H
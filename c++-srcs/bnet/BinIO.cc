@@ -10,6 +10,7 @@
 #include "ym/BnNetwork.h"
 #include "ym/Range.h"
 #include "BnNetworkImpl.h"
+#include "CompStream.h"
 
 
 BEGIN_NAMESPACE_YM_BNET
@@ -17,138 +18,245 @@ BEGIN_NAMESPACE_YM_BNET
 BEGIN_NONAMESPACE
 
 // シグネチャ
+// v1 形式と共通
 const char* BNET_SIG{"ym_bnet1.0"};
 
-END_NONAMESPACE
-
-// @brief BnNetwork の内容をダンプする．
-void
-BinIO::dump(
-  BinEnc& s,
-  const BnNetwork& network
-)
+// v2 形式であることを表すタグ
+// v1 形式ではこの位置にネットワーク名が入るので
+// 名前として用いられることのない文字列にしておく．
+const char* BNET_V2_TAG{"\x7f" "ym_bnet:v2"};
+
+// v2 形式のバージョン番号
+const SizeType BNET_VERSION = 2;
+
+// セクションの種類
+enum SecType : std::uint8_t {
+  SEC_STRINGS = 0, // 文字列表
+  SEC_EXPRS   = 1, // 論理式
+  SEC_FUNCS   = 2, // 真理値表型の関数
+  SEC_BDDS    = 3, // BDD
+  SEC_PORTS   = 4, // ポート
+  SEC_DFFS    = 5, // DFF
+  SEC_NODES   = 6, // 論理ノード
+  SEC_OUTPUTS = 7, // 出力ノード
+  SEC_NUM     = 8
+};
+
+// 論理ノードのレコードのワード数
+// ノード番号，名前，型，補助番号(論理式/関数/BDD/セル番号)，
+// ファンインの開始位置，ファンイン数 からなる．
+const SizeType NODE_REC_SIZE = 6;
+
+// セクションの内容を作るクラス
+class SecWriter
 {
-  // シグネチャ
-  s.write_signature(BNET_SIG);
+public:
 
-  // 名前
-  s.write_string(network.name());
+  // 32ビットの値を書き込む．
+  void
+  put_32(
+    SizeType val
+  )
+  {
+    ASSERT_COND( val <= 0xFFFFFFFFUL );
+    for ( SizeType i = 0; i < 4; ++ i ) {
+      mBuff.push_back(static_cast<char>((val >> (i * 8)) & 0xFF));
+    }
+  }
 
-  // 論理式
-  SizeType ne = network.expr_num();
-  s.write_vint(ne);
-  for ( SizeType i = 0; i < ne; ++ i ) {
-    network.expr(i).dump(s);
+  // 内容を取り出す．
+  string&
+  data()
+  {
+    return mBuff;
   }
 
-  // 真理値表型の関数
-  SizeType nf = network.func_num();
-  s.write_vint(nf);
-  for ( SizeType i = 0; i < nf; ++ i ) {
-    network.func(i).dump(s);
+
+private:
+
+  // 内容
+  string mBuff;
+
+};
+
+// セクションの内容を読むクラス
+class SecReader
+{
+public:
+
+  // コンストラクタ
+  explicit
+  SecReader(
+    const string& data
+  ) : mData{data}
+  {
   }
 
-  // BDD
-  mBddMap.clear();
+  // 32ビットの値を読み込む．
+  SizeType
+  get_32()
   {
-    vector<Bdd> bdd_list;
-    for ( auto node: network.logic_list() ) {
-      if ( node.type() == BnNodeType::Bdd ) {
-	auto bdd = node.bdd();
-	if ( mBddMap.count(bdd) == 0 ) {
-	  SizeType bdd_id = bdd_list.size();
-	  bdd_list.push_back(bdd);
-	  mBddMap.emplace(bdd, bdd_id);
-	}
-      }
-    }
-    Bdd::dump(s, bdd_list);
+    auto val = get_32(mPos);
+    mPos += 4;
+    return val;
   }
 
-  // ポート
-  SizeType np = network.port_num();
-  s.write_vint(np);
-  for ( auto port: network.port_list() ) {
-    s.write_string(port.name());
-    SizeType nb = port.bit_width();
-    s.write_vint(nb);
-    for ( auto i: Range(nb) ) {
-      auto node = port.bit(i);
-      if ( node.is_input() ) {
-	s.write_8(0);
-      }
-      else if ( node.is_output() ) {
-	s.write_8(1);
-      }
-      else {
-	ASSERT_NOT_REACHED;
-      }
-      s.write_vint(node.id());
+  // 指定された位置の32ビットの値を読み込む．
+  SizeType
+  get_32(
+    SizeType pos
+  ) const
+  {
+    if ( pos + 4 > mData.size() ) {
+      throw std::invalid_argument{"BnNetwork::restore(): Broken section."};
     }
+    auto p = reinterpret_cast<const std::uint8_t*>(mData.data() + pos);
+    return static_cast<SizeType>(p[0]) |
+      (static_cast<SizeType>(p[1]) << 8) |
+      (static_cast<SizeType>(p[2]) << 16) |
+      (static_cast<SizeType>(p[3]) << 24);
   }
 
-  // D-FF
-  SizeType ndff = network.dff_num();
-  s.write_vint(ndff);
-  for ( auto dff: network.dff_list() ) {
-    dump_dff(s, dff);
+  // 現在の読み出し位置を返す．
+  SizeType
+  pos() const
+  {
+    return mPos;
   }
 
-  // 論理ノード
-  SizeType nl = network.logic_num();
-  s.write_vint(nl);
-  for ( auto node: network.logic_list() ) {
-    dump_logic(s, node);
+  // 内容を返す．
+  const string&
+  data() const
+  {
+    return mData;
   }
 
-  // 出力ノード
-  SizeType no = network.output_num();
-  s.write_vint(no);
-  for ( auto node: network.output_list() ) {
-    s.write_vint(node.id());
-    auto inode = node.output_src();
-    s.write_vint(inode.id());
+
+private:
+
+  // 内容
+  const string& mData;
+
+  // 読み出し位置
+  SizeType mPos{0};
+
+};
+
+// 文字列表を作るクラス
+//
+// 0 番は空文字列とする．
+class StrPoolWriter
+{
+public:
+
+  // コンストラクタ
+  StrPoolWriter()
+  {
+    mOffsetList.push_back(0);
+    mOffsetList.push_back(0);
   }
-}
 
-// DFFの内容をバイナリダンプする．
-void
-BinIO::dump_dff(
-  BinEnc& s,
-  const BnDff& dff
-)
+  // 文字列番号を返す．
+  SizeType
+  id(
+    const string& str
+  )
+  {
+    if ( str.empty() ) {
+      return 0;
+    }
+    auto p = mDict.find(str);
+    if ( p != mDict.end() ) {
+      return p->second;
+    }
+    SizeType id = mOffsetList.size() - 1;
+    mChars.append(str);
+    mOffsetList.push_back(mChars.size());
+    mDict.emplace(str, id);
+    return id;
+  }
+
+  // 文字列表のセクションの内容を作る．
+  //
+  // 文字列数，各文字列の開始位置(文字列数 + 1 個)，文字の並び
+  // からなる．
+  string
+  make_section() const
+  {
+    SecWriter w;
+    w.put_32(mOffsetList.size() - 1);
+    for ( auto offset: mOffsetList ) {
+      w.put_32(offset);
+    }
+    w.data().append(mChars);
+    return std::move(w.data());
+  }
+
+
+private:
+
+  // 文字列をキーにして文字列番号を格納する辞書
+  unordered_map<string, SizeType> mDict;
+
+  // 各文字列の開始位置のリスト
+  vector<SizeType> mOffsetList;
+
+  // 文字の並び
+  string mChars;
+
+};
+
+// 文字列表を読むクラス
+//
+// 文字列はセクションの内容を指す std::string_view で返すので
+// コピーは name() が呼ばれた時に必要な分だけ行われる．
+class StrPoolReader
 {
-  s.write_string(dff.name());
-  switch ( dff.type() ) {
-  case BnDffType::None:  s.write_8(0); break;
-  case BnDffType::Dff:   s.write_8(1); break;
-  case BnDffType::Latch: s.write_8(2); break;
-  case BnDffType::Cell:  s.write_8(3); break;
-  }
-  if ( dff.is_dff() || dff.is_latch() ) {
-    s.write_vint(dff.data_in().id());
-    s.write_vint(dff.data_out().id());
-    s.write_vint(dff.clock().id());
-    s.write_vint(dff.clear().id());
-    s.write_vint(dff.preset().id());
-    // clear_preset_value()
-  }
-  else if ( dff.is_cell() ) {
-    s.write_vint(dff.cell().id());
-    SizeType ni = dff.cell_input_num();
-    s.write_vint(ni);
-    for ( SizeType i = 0; i < ni; ++ i ) {
-      s.write_vint(dff.cell_input(i).id());
+public:
+
+  // コンストラクタ
+  explicit
+  StrPoolReader(
+    const string& data
+  ) : mReader{data}
+  {
+    mNum = mReader.get_32();
+    mCharsBegin = 4 + (mNum + 1) * 4;
+    if ( mCharsBegin > data.size() ) {
+      throw std::invalid_argument{"BnNetwork::restore(): Broken section."};
     }
-    SizeType no = dff.cell_output_num();
-    s.write_vint(no);
-    for ( SizeType i = 0; i < no; ++ i ) {
-      s.write_vint(dff.cell_output(i).id());
+  }
+
+  // 文字列を返す．
+  std::string_view
+  name(
+    SizeType id
+  ) const
+  {
+    if ( id >= mNum ) {
+      throw std::invalid_argument{"BnNetwork::restore(): Wrong string id."};
+    }
+    auto begin = mReader.get_32(4 + id * 4);
+    auto end = mReader.get_32(4 + id * 4 + 4);
+    if ( begin > end || mCharsBegin + end > mReader.data().size() ) {
+      throw std::invalid_argument{"BnNetwork::restore(): Broken section."};
     }
+    return std::string_view{mReader.data()}.substr(mCharsBegin + begin, end - begin);
   }
-}
 
-BEGIN_NONAMESPACE
+
+private:
+
+  // 内容
+  SecReader mReader;
+
+  // 文字列数
+  SizeType mNum;
+
+  // 文字の並びの開始位置
+  SizeType mCharsBegin;
+
+};
 
 inline
 std::uint8_t
@@ -173,50 +281,270 @@ conv8(
   return 0;
 }
 
+// conv8() の逆変換
+inline
+PrimType
+conv_prim(
+  SizeType code
+)
+{
+  switch ( code ) {
+  case 1:  return PrimType::C0;
+  case 2:  return PrimType::C1;
+  case 3:  return PrimType::Buff;
+  case 4:  return PrimType::Not;
+  case 5:  return PrimType::And;
+  case 6:  return PrimType::Nand;
+  case 7:  return PrimType::Or;
+  case 8:  return PrimType::Nor;
+  case 9:  return PrimType::Xor;
+  case 10: return PrimType::Xnor;
+  default: break;
+  }
+  return PrimType::None;
+}
+
+// 論理ノードの型コードを返す．
+SizeType
+node_code(
+  const BnNode& node
+)
+{
+  switch ( node.type() ) {
+  case BnNodeType::Prim:   return conv8(node.primitive_type());
+  case BnNodeType::Expr:   return 11;
+  case BnNodeType::TvFunc: return 12;
+  case BnNodeType::Bdd:    return 13;
+  case BnNodeType::Cell:   return 14;
+  default: break;
+  }
+  return 0;
+}
+
+// DFFの型コードを返す．
+SizeType
+dff_code(
+  const BnDff& dff
+)
+{
+  switch ( dff.type() ) {
+  case BnDffType::None:  return 0;
+  case BnDffType::Dff:   return 1;
+  case BnDffType::Latch: return 2;
+  case BnDffType::Cell:  return 3;
+  }
+  return 0;
+}
+
+// 論理式のセクションの内容を作る．
+string
+make_exprs_section(
+  const BnNetwork& network
+)
+{
+  ostringstream buf;
+  {
+    BinEnc s{buf};
+    SizeType ne = network.expr_num();
+    s.write_vint(ne);
+    for ( SizeType i = 0; i < ne; ++ i ) {
+      network.expr(i).dump(s);
+    }
+  }
+  return buf.str();
+}
+
+// 真理値表型の関数のセクションの内容を作る．
+string
+make_funcs_section(
+  const BnNetwork& network
+)
+{
+  ostringstream buf;
+  {
+    BinEnc s{buf};
+    SizeType nf = network.func_num();
+    s.write_vint(nf);
+    for ( SizeType i = 0; i < nf; ++ i ) {
+      network.func(i).dump(s);
+    }
+  }
+  return buf.str();
+}
+
 END_NONAMESPACE
 
-// 論理ノードの内容をバイナリダンプする．
+
+//////////////////////////////////////////////////////////////////////
+// クラス BinIO
+//////////////////////////////////////////////////////////////////////
+
+// @brief BnNetwork の内容をダンプする．
 void
-BinIO::dump_logic(
+BinIO::dump(
   BinEnc& s,
-  const BnNode& node
+  const BnNetwork& network
 )
 {
-  s.write_vint(node.id());
-  s.write_string(node.name());
-  SizeType nfi = node.fanin_num();
-  s.write_vint(nfi);
-  for ( auto fanin: node.fanin_list() ) {
-    s.write_vint(fanin.id());
-  }
-  switch ( node.type() ) {
-  case BnNodeType::None:
-    s.write_8(0);
-    break;
-  case BnNodeType::Prim:
-    s.write_8(conv8(node.primitive_type()));
-    break;
-  case BnNodeType::Expr:
-    s.write_8(11);
-    s.write_vint(node.expr_id());
-    break;
-  case BnNodeType::TvFunc:
-    s.write_8(12);
-    s.write_vint(node.func_id());
-    break;
-  case BnNodeType::Bdd:
-    s.write_8(13);
+  vector<string> sec_list(SEC_NUM);
+  StrPoolWriter str_pool;
+
+  // 論理式
+  sec_list[SEC_EXPRS] = make_exprs_section(network);
+
+  // 真理値表型の関数
+  sec_list[SEC_FUNCS] = make_funcs_section(network);
+
+  // BDD
+  mBddMap.clear();
+  {
+    vector<Bdd> bdd_list;
+    for ( auto node: network.logic_list() ) {
+      if ( node.type() == BnNodeType::Bdd ) {
+	auto bdd = node.bdd();
+	if ( mBddMap.count(bdd) == 0 ) {
+	  SizeType bdd_id = bdd_list.size();
+	  bdd_list.push_back(bdd);
+	  mBddMap.emplace(bdd, bdd_id);
+	}
+      }
+    }
+    ostringstream buf;
     {
-      SizeType id = mBddMap.at(node.bdd());
-      s.write_vint(id);
+      BinEnc s1{buf};
+      Bdd::dump(s1, bdd_list);
     }
-    break;
-  case BnNodeType::Cell:
-    s.write_8(14);
-    s.write_vint(node.cell().id());
-    break;
-  default:
-    ASSERT_NOT_REACHED;
+    sec_list[SEC_BDDS] = buf.str();
+  }
+
+  // ポート
+  // 名前，ビット幅，各ビットの向きとノード番号
+  {
+    SecWriter w;
+    w.put_32(network.port_num());
+    for ( auto port: network.port_list() ) {
+      w.put_32(str_pool.id(port.name()));
+      SizeType nb = port.bit_width();
+      w.put_32(nb);
+      for ( auto i: Range(nb) ) {
+	auto node = port.bit(i);
+	if ( node.is_input() ) {
+	  w.put_32(0);
+	}
+	else if ( node.is_output() ) {
+	  w.put_32(1);
+	}
+	else {
+	  ASSERT_NOT_REACHED;
+	}
+	w.put_32(node.id());
+      }
+    }
+    sec_list[SEC_PORTS] = std::move(w.data());
+  }
+
+  // D-FF
+  // 名前，型，各端子のノード番号
+  {
+    SecWriter w;
+    w.put_32(network.dff_num());
+    for ( auto dff: network.dff_list() ) {
+      w.put_32(str_pool.id(dff.name()));
+      w.put_32(dff_code(dff));
+      if ( dff.is_dff() || dff.is_latch() ) {
+	w.put_32(dff.data_in().id());
+	w.put_32(dff.data_out().id());
+	w.put_32(dff.clock().id());
+	w.put_32(dff.clear().id());
+	w.put_32(dff.preset().id());
+	w.put_32(static_cast<SizeType>(dff.clear_preset_value()));
+      }
+      else if ( dff.is_cell() ) {
+	w.put_32(dff.cell().id());
+	SizeType ni = dff.cell_input_num();
+	w.put_32(ni);
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  w.put_32(dff.cell_input(i).id());
+	}
+	SizeType no = dff.cell_output_num();
+	w.put_32(no);
+	for ( SizeType i = 0; i < no; ++ i ) {
+	  w.put_32(dff.cell_output(i).id());
+	}
+      }
+    }
+    sec_list[SEC_DFFS] = std::move(w.data());
+  }
+
+  // 論理ノード
+  // 固定長のレコードの並びの後にファンインのノード番号の並びを置く．
+  // 復元時にファンインが先に作られているようにトポロジカル順に並べる．
+  {
+    SecWriter w;
+    auto logic_list = network.sorted_logic_list();
+    w.put_32(logic_list.size());
+    SizeType fanin_pos = 0;
+    for ( auto node: logic_list ) {
+      w.put_32(node.id());
+      w.put_32(str_pool.id(node.name()));
+      w.put_32(node_code(node));
+      switch ( node.type() ) {
+      case BnNodeType::Expr:   w.put_32(node.expr_id()); break;
+      case BnNodeType::TvFunc: w.put_32(node.func_id()); break;
+      case BnNodeType::Bdd:    w.put_32(mBddMap.at(node.bdd())); break;
+      case BnNodeType::Cell:   w.put_32(node.cell().id()); break;
+      default:                 w.put_32(0); break;
+      }
+      SizeType nfi = node.fanin_num();
+      w.put_32(fanin_pos);
+      w.put_32(nfi);
+      fanin_pos += nfi;
+    }
+    w.put_32(fanin_pos);
+    for ( auto node: logic_list ) {
+      for ( auto fanin: node.fanin_list() ) {
+	w.put_32(fanin.id());
+      }
+    }
+    sec_list[SEC_NODES] = std::move(w.data());
+  }
+
+  // 出力ノード
+  // 出力ノードとそのファンインのノード番号の対
+  {
+    SecWriter w;
+    w.put_32(network.output_num());
+    for ( auto node: network.output_list() ) {
+      w.put_32(node.id());
+      w.put_32(node.output_src().id());
+    }
+    sec_list[SEC_OUTPUTS] = std::move(w.data());
+  }
+
+  // 文字列表は全ての名前を登録した後で作る．
+  sec_list[SEC_STRINGS] = str_pool.make_section();
+
+  // ヘッダ
+  s.write_signature(BNET_SIG);
+  s.write_string(BNET_V2_TAG);
+  s.write_vint(BNET_VERSION);
+  s.write_string(network.name());
+  s.write_vint(network.node_num());
+
+  // セクション表
+  s.write_vint(SEC_NUM);
+  SizeType offset = 0;
+  for ( SizeType i = 0; i < SEC_NUM; ++ i ) {
+    SizeType size = sec_list[i].size();
+    s.write_8(i);
+    s.write_vint(offset);
+    s.write_vint(size);
+    offset += size;
+  }
+
+  // セクションの内容
+  for ( auto& sec: sec_list ) {
+    s.write_block(reinterpret_cast<const std::uint8_t*>(sec.data()), sec.size());
   }
 }
 
@@ -232,196 +560,282 @@ BinIO::restore(
     throw std::invalid_argument{"BnNetwork::restore(): Wrong signature."};
   }
 
+  // v1 形式ではネットワーク名，v2 形式ではタグとなる．
+  auto tag = s.read_string();
+  if ( tag == BNET_V2_TAG ) {
+    restore_v2(s, network_impl);
+  }
+  else {
+    network_impl->set_name(tag);
+    restore_v1(s, network_impl);
+  }
+}
+
+// @brief v2 形式の内容を復元する．
+void
+BinIO::restore_v2(
+  BinDec& s,
+  BnNetworkImpl* network_impl
+)
+{
+  SizeType version = s.read_vint();
+  if ( version != BNET_VERSION ) {
+    throw std::invalid_argument{"BnNetwork::restore(): Unsupported version."};
+  }
+
   // 名前
   auto name = s.read_string();
   network_impl->set_name(name);
 
+  SizeType id_num = s.read_vint();
+  mIdArray.clear();
+  mIdArray.resize(id_num + 1, BNET_NULLID);
+
+  // セクション表
+  SizeType nsec = s.read_vint();
+  vector<SizeType> type_list(nsec);
+  vector<SizeType> size_list(nsec);
+  SizeType offset = 0;
+  for ( SizeType i = 0; i < nsec; ++ i ) {
+    type_list[i] = s.read_8();
+    SizeType offset1 = s.read_vint();
+    size_list[i] = s.read_vint();
+    if ( offset1 != offset ) {
+      throw std::invalid_argument{"BnNetwork::restore(): Broken section table."};
+    }
+    offset += size_list[i];
+  }
+
+  // セクションの内容
+  // 知らない種類のセクションは読み飛ばす．
+  vector<string> sec_list(SEC_NUM);
+  vector<bool> has_sec(SEC_NUM, false);
+  for ( SizeType i = 0; i < nsec; ++ i ) {
+    string buff(size_list[i], '\0');
+    s.read_block(reinterpret_cast<std::uint8_t*>(&buff[0]), buff.size());
+    auto type = type_list[i];
+    if ( type < SEC_NUM ) {
+      sec_list[type].swap(buff);
+      has_sec[type] = true;
+    }
+  }
+  for ( SizeType i = 0; i < SEC_NUM; ++ i ) {
+    if ( !has_sec[i] ) {
+      throw std::invalid_argument{"BnNetwork::restore(): Missing section."};
+    }
+  }
+
+  StrPoolReader str_pool{sec_list[SEC_STRINGS]};
+
   // 論理式
-  SizeType ne = s.read_vint();
-  mExprList.clear();
-  mExprList.resize(ne);
-  for ( SizeType i = 0; i < ne; ++ i ) {
-    mExprList[i] = Expr::restore(s);
+  {
+    istringstream buf{sec_list[SEC_EXPRS]};
+    BinDec s1{buf};
+    SizeType ne = s1.read_vint();
+    mExprList.clear();
+    mExprList.resize(ne);
+    for ( SizeType i = 0; i < ne; ++ i ) {
+      mExprList[i] = Expr::restore(s1);
+    }
   }
 
   // 真理値表型の関数
-  SizeType nf = s.read_vint();
-  mFuncList.clear();
-  mFuncList.resize(nf);
-  for ( SizeType i = 0; i < nf; ++ i ) {
-    mFuncList[i].restore(s);
+  {
+    istringstream buf{sec_list[SEC_FUNCS]};
+    BinDec s1{buf};
+    SizeType nf = s1.read_vint();
+    mFuncList.clear();
+    mFuncList.resize(nf);
+    for ( SizeType i = 0; i < nf; ++ i ) {
+      mFuncList[i].restore(s1);
+    }
   }
 
-  // Bdd
-  mBddList = network_impl->restore_bdds(s);
-
-  mNodeMap.clear();
+  // BDD
+  {
+    istringstream buf{sec_list[SEC_BDDS]};
+    BinDec s1{buf};
+    mBddList = network_impl->restore_bdds(s1);
+  }
 
   // ポート
-  SizeType np = s.read_vint();
-  for ( SizeType i = 0; i < np; ++ i ) {
-    auto name = s.read_string();
-    SizeType nb = s.read_vint();
-    vector<BnDir> dir_vect(nb);
-    vector<SizeType> id_list(nb);
-    for ( SizeType j = 0; j < nb; ++ j ) {
-      std::uint8_t dir = s.read_8();
-      dir_vect[j] = static_cast<BnDir>(dir);
-      id_list[j] = s.read_vint();
-    }
-    SizeType id = network_impl->new_port(name, dir_vect);
-    auto port = network_impl->_port(id);
-    for ( SizeType j = 0; j < nb; ++ j ) {
-      SizeType dst_id = port->bit(j);
-      mNodeMap[id_list[j]] = dst_id;
+  {
+    SecReader r{sec_list[SEC_PORTS]};
+    SizeType np = r.get_32();
+    for ( SizeType i = 0; i < np; ++ i ) {
+      string name{str_pool.name(r.get_32())};
+      SizeType nb = r.get_32();
+      vector<BnDir> dir_vect(nb);
+      vector<SizeType> id_list(nb);
+      for ( SizeType j = 0; j < nb; ++ j ) {
+	dir_vect[j] = r.get_32() == 0 ? BnDir::INPUT : BnDir::OUTPUT;
+	id_list[j] = r.get_32();
+      }
+      SizeType id = network_impl->new_port(name, dir_vect);
+      auto port = network_impl->_port(id);
+      for ( SizeType j = 0; j < nb; ++ j ) {
+	reg_id(id_list[j], port->bit(j));
+      }
     }
   }
 
   // D-FF
-  SizeType ndff = s.read_vint();
-  for ( SizeType i = 0; i < ndff; ++ i ) {
-    restore_dff(s, network_impl);
+  {
+    SecReader r{sec_list[SEC_DFFS]};
+    SizeType ndff = r.get_32();
+    for ( SizeType i = 0; i < ndff; ++ i ) {
+      string name{str_pool.name(r.get_32())};
+      SizeType type = r.get_32();
+      if ( type == 1 || type == 2 ) {
+	SizeType src_input_id = r.get_32();
+	SizeType src_output_id = r.get_32();
+	SizeType src_clock_id = r.get_32();
+	SizeType src_clear_id = r.get_32();
+	SizeType src_preset_id = r.get_32();
+	auto cpv = static_cast<BnCPV>(r.get_32());
+	bool has_clear = src_clear_id != BNET_NULLID;
+	bool has_preset = src_preset_id != BNET_NULLID;
+	SizeType id;
+	if ( type == 1 ) {
+	  id = network_impl->new_dff(name, has_clear, has_preset, cpv);
+	}
+	else {
+	  id = network_impl->new_latch(name, has_clear, has_preset, cpv);
+	}
+	auto dff = network_impl->_dff(id);
+	reg_id(src_input_id, dff->data_in());
+	reg_id(src_output_id, dff->data_out());
+	reg_id(src_clock_id, dff->clock());
+	if ( has_clear ) {
+	  reg_id(src_clear_id, dff->clear());
+	}
+	if ( has_preset ) {
+	  reg_id(src_preset_id, dff->preset());
+	}
+      }
+      else if ( type == 3 ) {
+	SizeType cell_id = r.get_32();
+	if ( cell_id >= network_impl->library().cell_num() ) {
+	  throw std::invalid_argument{"BnNetwork::restore(): Wrong cell id."};
+	}
+	auto cell = network_impl->library().cell(cell_id);
+	SizeType id = network_impl->new_dff_cell(name, cell);
+	auto dff = network_impl->_dff(id);
+	SizeType ni = r.get_32();
+	for ( SizeType j = 0; j < ni; ++ j ) {
+	  auto src_id = r.get_32();
+	  reg_id(src_id, dff->cell_input(j));
+	}
+	SizeType no = r.get_32();
+	for ( SizeType j = 0; j < no; ++ j ) {
+	  auto src_id = r.get_32();
+	  reg_id(src_id, dff->cell_output(j));
+	}
+      }
+    }
   }
 
   // 論理ノード
-  SizeType nl = s.read_vint();
-  for ( SizeType i = 0; i < nl; ++ i ) {
-    restore_logic(s, network_impl);
+  // レコードは固定長なので i 番目のレコードの位置は直接求まる．
+  {
+    SecReader r{sec_list[SEC_NODES]};
+    SizeType nl = r.get_32();
+    SizeType rec_begin = r.pos();
+    SizeType fanin_begin = rec_begin + nl * NODE_REC_SIZE * 4 + 4;
+    vector<SizeType> fanin_id_list;
+    for ( SizeType i = 0; i < nl; ++ i ) {
+      SizeType rec = rec_begin + i * NODE_REC_SIZE * 4;
+      SizeType src_id = r.get_32(rec);
+      string name{str_pool.name(r.get_32(rec + 4))};
+      SizeType code = r.get_32(rec + 8);
+      SizeType aux = r.get_32(rec + 12);
+      SizeType pos = r.get_32(rec + 16);
+      SizeType nfi = r.get_32(rec + 20);
+      fanin_id_list.clear();
+      fanin_id_list.reserve(nfi);
+      for ( SizeType j = 0; j < nfi; ++ j ) {
+	auto fanin_id = r.get_32(fanin_begin + (pos + j) * 4);
+	fanin_id_list.push_back(map_id(fanin_id));
+      }
+      SizeType node_id = BNET_NULLID;
+      auto prim = conv_prim(code);
+      if ( prim != PrimType::None ) {
+	node_id = network_impl->new_logic_primitive(name, prim, fanin_id_list);
+      }
+      else if ( code == 11 ) {
+	if ( aux >= mExprList.size() ) {
+	  throw std::invalid_argument{"BnNetwork::restore(): Wrong expr id."};
+	}
+	node_id = network_impl->new_logic_expr(name, mExprList[aux], fanin_id_list);
+      }
+      else if ( code == 12 ) {
+	if ( aux >= mFuncList.size() ) {
+	  throw std::invalid_argument{"BnNetwork::restore(): Wrong func id."};
+	}
+	node_id = network_impl->new_logic_tv(name, mFuncList[aux], fanin_id_list);
+      }
+      else if ( code == 13 ) {
+	if ( aux >= mBddList.size() ) {
+	  throw std::invalid_argument{"BnNetwork::restore(): Wrong bdd id."};
+	}
+	node_id = network_impl->new_logic_bdd(name, mBddList[aux], fanin_id_list);
+      }
+      else if ( code == 14 ) {
+	if ( aux >= network_impl->library().cell_num() ) {
+	  throw std::invalid_argument{"BnNetwork::restore(): Wrong cell id."};
+	}
+	auto cell = network_impl->library().cell(aux);
+	node_id = network_impl->new_logic_cell(name, cell, fanin_id_list);
+      }
+      reg_id(src_id, node_id);
+    }
   }
 
   // 出力ノード
-  SizeType no = s.read_vint();
-  for ( SizeType i = 0; i < no; ++ i ) {
-    SizeType src_output_id = s.read_vint();
-    ASSERT_COND( mNodeMap.count(src_output_id) > 0 );
-    auto dst_id = mNodeMap.at(src_output_id);
-    auto dst_node = network_impl->_node(dst_id);
-    SizeType src_input_id = s.read_vint();
-    if ( src_input_id != BNET_NULLID ) {
-      network_impl->set_output_src(dst_node, mNodeMap[src_input_id]);
+  {
+    SecReader r{sec_list[SEC_OUTPUTS]};
+    SizeType no = r.get_32();
+    for ( SizeType i = 0; i < no; ++ i ) {
+      SizeType dst_id = map_id(r.get_32());
+      auto dst_node = network_impl->_node(dst_id);
+      if ( !dst_node->is_output() ) {
+	throw std::invalid_argument{"BnNetwork::restore(): Wrong output id."};
+      }
+      // ソースを持たない出力ノードは BNET_NULLID となっている．
+      SizeType src_id = r.get_32();
+      if ( src_id != BNET_NULLID ) {
+	network_impl->set_output_src(dst_node, map_id(src_id));
+      }
     }
   }
 
   network_impl->wrap_up();
 }
 
-// @brief DFFを復元する．
+// @brief 元のノード番号と新しいノード番号の対応を登録する．
 void
-BinIO::restore_dff(
-  BinDec& s,
-  BnNetworkImpl* network_impl
+BinIO::reg_id(
+  SizeType src_id,
+  SizeType dst_id
 )
 {
-  auto name = s.read_string();
-  SizeType type = s.read_vint();
-  if ( type == 1 || type == 2 ) {
-    SizeType src_input_id = s.read_vint();
-    SizeType src_output_id = s.read_vint();
-    SizeType src_clock_id = s.read_vint();
-    SizeType src_clear_id = s.read_vint();
-    bool has_clear = src_clear_id != BNET_NULLID;
-    SizeType src_preset_id = s.read_vint();
-    bool has_preset = src_preset_id != BNET_NULLID;
-    // clear_preset_value()
-    SizeType id;
-    if ( type == 0 ) {
-      id = network_impl->new_dff(name, has_clear, has_preset);
-    }
-    else {
-      id = network_impl->new_latch(name, has_clear, has_preset);
-    }
-    auto dff = network_impl->_dff(id);
-    mNodeMap[src_input_id] = dff->data_in();
-    mNodeMap[src_output_id] = dff->data_out();
-    mNodeMap[src_clock_id] = dff->clock();
-    if ( has_clear ) {
-      mNodeMap[src_clear_id] = dff->clear();
-    }
-    if ( has_preset ) {
-      mNodeMap[src_preset_id] = dff->preset();
-    }
-  }
-  else if ( type == 3 ) {
-    SizeType cell_id = s.read_vint();
-    auto cell = network_impl->library().cell(cell_id);
-    SizeType id = network_impl->new_dff_cell(name, cell);
-    auto dff = network_impl->_dff(id);
-    SizeType ni = s.read_vint();
-    for ( SizeType i = 0; i < ni; ++ i ) {
-      auto src_id = s.read_vint();
-      mNodeMap[src_id] = dff->cell_input(i);
-    }
-    SizeType no = s.read_vint();
-    for ( SizeType i = 0; i < no; ++ i ) {
-      auto src_id = s.read_vint();
-      mNodeMap[src_id] = dff->cell_output(i);
-    }
+  if ( src_id == BNET_NULLID || src_id >= mIdArray.size() ) {
+    throw std::invalid_argument{"BnNetwork::restore(): Wrong node id."};
   }
+  mIdArray[src_id] = dst_id;
 }
 
-// @brief 論理ノードを復元する．
-void
-BinIO::restore_logic(
-  BinDec& s,
-  BnNetworkImpl* network_impl
-)
+// @brief 元のノード番号を新しいノード番号に変換する．
+SizeType
+BinIO::map_id(
+  SizeType src_id
+) const
 {
-  SizeType id = s.read_vint();
-  auto name = s.read_string();
-  SizeType nfi = s.read_vint();
-  vector<SizeType> fanin_id_list(nfi);
-  for ( SizeType j = 0; j < nfi; ++ j ) {
-    SizeType src_id = s.read_vint();
-    ASSERT_COND( mNodeMap.count(src_id) > 0 );
-    fanin_id_list[j] = mNodeMap.at(src_id);
-  }
-  std::uint8_t type_code = s.read_8();
-  auto type = BnNodeType::None;
-  auto prim = PrimType::None;
-  SizeType node_id = BNET_NULLID;
-  switch ( type_code ) {
-  case 0: // None: ASSERT_NOT_REACHED; break;
-  case 1: type = BnNodeType::Prim; prim = PrimType::C0; break;
-  case 2: type = BnNodeType::Prim; prim = PrimType::C1; break;
-  case 3: type = BnNodeType::Prim; prim = PrimType::Buff; break;
-  case 4: type = BnNodeType::Prim; prim = PrimType::Not; break;
-  case 5: type = BnNodeType::Prim; prim = PrimType::And; break;
-  case 6: type = BnNodeType::Prim; prim = PrimType::Nand; break;
-  case 7: type = BnNodeType::Prim; prim = PrimType::Or; break;
-  case 8: type = BnNodeType::Prim; prim = PrimType::Nor; break;
-  case 9: type = BnNodeType::Prim; prim = PrimType::Xor; break;
-  case 10: type = BnNodeType::Prim; prim = PrimType::Xnor; break;
-  default: break;
+  if ( src_id >= mIdArray.size() || mIdArray[src_id] == BNET_NULLID ) {
+    // 範囲外の番号と，まだ登録されていない番号
+    throw std::invalid_argument{"BnNetwork::restore(): Wrong node id."};
   }
-  if ( type != BnNodeType::None ) {
-    node_id = network_impl->new_logic_primitive(name, prim, fanin_id_list);
-  }
-  else if ( type_code == 11 ) {
-    // Expr
-    SizeType id = s.read_vint();
-    ASSERT_COND( id < mExprList.size() );
-    auto& expr = mExprList[id];
-    node_id = network_impl->new_logic_expr(name, expr, fanin_id_list);
-  }
-  else if ( type_code == 12 ) {
-    // TvFunc
-    SizeType id = s.read_vint();
-    auto& func = mFuncList[id];
-    node_id = network_impl->new_logic_tv(name, func, fanin_id_list);
-  }
-  else if ( type_code == 13 ) {
-    // Bdd
-    SizeType id = s.read_vint();
-    auto bdd = mBddList[id];
-    node_id = network_impl->new_logic_bdd(name, bdd, fanin_id_list);
-  }
-  else if ( type_code == 14 ) {
-    // Cell
-    SizeType cell_id = s.read_vint();
-    auto cell = network_impl->library().cell(cell_id);
-    node_id = network_impl->new_logic_cell(name, cell, fanin_id_list);
-  }
-  mNodeMap[id] = node_id;
+  return mIdArray[src_id];
 }
 
 
@@ -439,6 +853,28 @@ BnNetwork::dump(
   bio.dump(s, *this);
 }
 
+// @brief 内容を独自形式でファイルにバイナリダンプする．
+void
+BnNetwork::dump(
+  const string& filename
+) const
+{
+  CompOutStream s{filename};
+  if ( !s ) {
+    ostringstream buf;
+    buf << filename << ": Could not open";
+    throw std::invalid_argument{buf.str()};
+  }
+  BinEnc enc{s};
+  dump(enc);
+  s.close();
+  if ( !s ) {
+    ostringstream buf;
+    buf << filename << ": Write error";
+    throw std::invalid_argument{buf.str()};
+  }
+}
+
 // @brief バイナリダンプされた内容を復元する．
 BnNetwork
 BnNetwork::restore(
@@ -451,4 +887,20 @@ BnNetwork::restore(
   return network;
 }
 
+// @brief ファイルにバイナリダンプされた内容を復元する．
+BnNetwork
+BnNetwork::restore(
+  const string& filename
+)
+{
+  CompInStream s{filename};
+  if ( !s ) {
+    ostringstream buf;
+    buf << filename << ": No such file";
+    throw std::invalid_argument{buf.str()};
+  }
+  BinDec dec{s};
+  return restore(dec);
+}
+
 END_NAMESPACE_YM_BNET
@@ -22,6 +22,22 @@ class BnNetworkImpl;
 //////////////////////////////////////////////////////////////////////
 /// @class BinIO BinIO.h "BinIO.h"
 /// @brief BnNetwork のバイナリダンプ/リストアを行うクラス
+///
+/// ダンプは常に v2 形式で行う．
+/// リストアは v1 形式(ym_bnet1.0)と v2 形式の両方を扱う．
+///
+/// v2 形式は以下のヘッダの後にセクションの内容を並べたものとなる．
+/// - シグネチャ(v1 と共通)
+/// - v2 形式を表すタグ(v1 ではこの位置にネットワーク名が入る)
+/// - バージョン番号
+/// - ネットワーク名
+/// - ノード番号の最大値
+/// - セクション表(種類，先頭からのオフセット，サイズ)
+///
+/// ポート，DFF，論理ノード，出力の各セクションは 32ビットの
+/// リトルエンディアンの整数の配列で，論理ノードは固定長のレコードとなる．
+/// 名前は文字列表のセクションにまとめ，各レコードは文字列番号を持つ．
+/// 論理式，関数，BDD のセクションは各クラスの dump() の出力となる．
 //////////////////////////////////////////////////////////////////////
 class BinIO
 {
@@ -56,29 +72,54 @@ public:
 
 private:
   //////////////////////////////////////////////////////////////////////
-  // 内部で用いられる関数
+  // v2 形式で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief DFFの内容をダンプする
+  /// @brief v2 形式の内容を復元する．
+  ///
+  /// シグネチャとタグは読み込み済みとする．
+  void
+  restore_v2(
+    BinDec& s,         ///< [in] 入力ストリーム
+    BnNetworkImpl* network_impl ///< [in] 対象のネットワーク
+  );
 
+  /// @brief 元のノード番号と新しいノード番号の対応を登録する．
   void
-  dump_dff(
-    BinEnc& s,       ///< [in] 出力ストリーム
-    const BnDff& dff ///< [in] 対象のDff
+  reg_id(
+    SizeType src_id, ///< [in] 元のノード番号
+    SizeType dst_id  ///< [in] 新しいノード番号
   );
 
-  /// @brief DFFを復元する．
+  /// @brief 元のノード番号を新しいノード番号に変換する．
+  ///
+  /// 範囲外の番号やまだ登録されていない番号の場合は
+  /// std::invalid_argument 例外を送出する．
+  SizeType
+  map_id(
+    SizeType src_id ///< [in] 元のノード番号
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // v1 形式で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief v1 形式の内容を復元する．
+  ///
+  /// シグネチャとネットワーク名は読み込み済みとする．
   void
-  restore_dff(
+  restore_v1(
     BinDec& s,         ///< [in] 入力ストリーム
     BnNetworkImpl* network_impl ///< [in] 対象のネットワーク
   );
 
-  /// @brief 論理ノードの内容をダンプする．
+  /// @brief DFFを復元する．
   void
-  dump_logic(
-    BinEnc& s,         ///< [in] 出力ストリーム
-    const BnNode& node ///< [in] 対象のノード
+  restore_dff(
+    BinDec& s,         ///< [in] 入力ストリーム
+    BnNetworkImpl* network_impl ///< [in] 対象のネットワーク
   );
 
   /// @brief 論理ノードを復元する．
@@ -106,9 +147,12 @@ private:
   // BDDの対応表
   unordered_map<Bdd, SizeType> mBddMap;
 
-  // ノード番号の対応表
+  // ノード番号の対応表(v1 形式用)
   unordered_map<SizeType, SizeType> mNodeMap;
 
+  // 元のノード番号をキーにして新しいノード番号を格納する配列(v2 形式用)
+  vector<SizeType> mIdArray;
+
 };
 
 END_NAMESPACE_YM_BNET
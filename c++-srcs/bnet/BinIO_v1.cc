@@ -0,0 +1,214 @@
+
+/// @file BinIO_v1.cc
+/// @brief BinIO の実装ファイル(v1 形式の復元)
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2022 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BinIO.h"
+#include "BnNetworkImpl.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス BinIO
+//////////////////////////////////////////////////////////////////////
+
+// @brief v1 形式の内容を復元する．
+void
+BinIO::restore_v1(
+  BinDec& s,
+  BnNetworkImpl* network_impl
+)
+{
+  // 論理式
+  SizeType ne = s.read_vint();
+  mExprList.clear();
+  mExprList.resize(ne);
+  for ( SizeType i = 0; i < ne; ++ i ) {
+    mExprList[i] = Expr::restore(s);
+  }
+
+  // 真理値表型の関数
+  SizeType nf = s.read_vint();
+  mFuncList.clear();
+  mFuncList.resize(nf);
+  for ( SizeType i = 0; i < nf; ++ i ) {
+    mFuncList[i].restore(s);
+  }
+
+  // Bdd
+  mBddList = network_impl->restore_bdds(s);
+
+  mNodeMap.clear();
+
+  // ポート
+  SizeType np = s.read_vint();
+  for ( SizeType i = 0; i < np; ++ i ) {
+    auto name = s.read_string();
+    SizeType nb = s.read_vint();
+    vector<BnDir> dir_vect(nb);
+    vector<SizeType> id_list(nb);
+    for ( SizeType j = 0; j < nb; ++ j ) {
+      std::uint8_t dir = s.read_8();
+      dir_vect[j] = static_cast<BnDir>(dir);
+      id_list[j] = s.read_vint();
+    }
+    SizeType id = network_impl->new_port(name, dir_vect);
+    auto port = network_impl->_port(id);
+    for ( SizeType j = 0; j < nb; ++ j ) {
+      SizeType dst_id = port->bit(j);
+      mNodeMap[id_list[j]] = dst_id;
+    }
+  }
+
+  // D-FF
+  SizeType ndff = s.read_vint();
+  for ( SizeType i = 0; i < ndff; ++ i ) {
+    restore_dff(s, network_impl);
+  }
+
+  // 論理ノード
+  SizeType nl = s.read_vint();
+  for ( SizeType i = 0; i < nl; ++ i ) {
+    restore_logic(s, network_impl);
+  }
+
+  // 出力ノード
+  SizeType no = s.read_vint();
+  for ( SizeType i = 0; i < no; ++ i ) {
+    SizeType src_output_id = s.read_vint();
+    ASSERT_COND( mNodeMap.count(src_output_id) > 0 );
+    auto dst_id = mNodeMap.at(src_output_id);
+    auto dst_node = network_impl->_node(dst_id);
+    SizeType src_input_id = s.read_vint();
+    if ( src_input_id != BNET_NULLID ) {
+      network_impl->set_output_src(dst_node, mNodeMap[src_input_id]);
+    }
+  }
+
+  network_impl->wrap_up();
+}
+
+// @brief DFFを復元する．
+void
+BinIO::restore_dff(
+  BinDec& s,
+  BnNetworkImpl* network_impl
+)
+{
+  auto name = s.read_string();
+  SizeType type = s.read_vint();
+  if ( type == 1 || type == 2 ) {
+    SizeType src_input_id = s.read_vint();
+    SizeType src_output_id = s.read_vint();
+    SizeType src_clock_id = s.read_vint();
+    SizeType src_clear_id = s.read_vint();
+    bool has_clear = src_clear_id != BNET_NULLID;
+    SizeType src_preset_id = s.read_vint();
+    bool has_preset = src_preset_id != BNET_NULLID;
+    // clear_preset_value()
+    SizeType id;
+    if ( type == 1 ) {
+      id = network_impl->new_dff(name, has_clear, has_preset);
+    }
+    else {
+      id = network_impl->new_latch(name, has_clear, has_preset);
+    }
+    auto dff = network_impl->_dff(id);
+    mNodeMap[src_input_id] = dff->data_in();
+    mNodeMap[src_output_id] = dff->data_out();
+    mNodeMap[src_clock_id] = dff->clock();
+    if ( has_clear ) {
+      mNodeMap[src_clear_id] = dff->clear();
+    }
+    if ( has_preset ) {
+      mNodeMap[src_preset_id] = dff->preset();
+    }
+  }
+  else if ( type == 3 ) {
+    SizeType cell_id = s.read_vint();
+    auto cell = network_impl->library().cell(cell_id);
+    SizeType id = network_impl->new_dff_cell(name, cell);
+    auto dff = network_impl->_dff(id);
+    SizeType ni = s.read_vint();
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto src_id = s.read_vint();
+      mNodeMap[src_id] = dff->cell_input(i);
+    }
+    SizeType no = s.read_vint();
+    for ( SizeType i = 0; i < no; ++ i ) {
+      auto src_id = s.read_vint();
+      mNodeMap[src_id] = dff->cell_output(i);
+    }
+  }
+}
+
+// @brief 論理ノードを復元する．
+void
+BinIO::restore_logic(
+  BinDec& s,
+  BnNetworkImpl* network_impl
+)
+{
+  SizeType id = s.read_vint();
+  auto name = s.read_string();
+  SizeType nfi = s.read_vint();
+  vector<SizeType> fanin_id_list(nfi);
+  for ( SizeType j = 0; j < nfi; ++ j ) {
+    SizeType src_id = s.read_vint();
+    ASSERT_COND( mNodeMap.count(src_id) > 0 );
+    fanin_id_list[j] = mNodeMap.at(src_id);
+  }
+  std::uint8_t type_code = s.read_8();
+  auto type = BnNodeType::None;
+  auto prim = PrimType::None;
+  SizeType node_id = BNET_NULLID;
+  switch ( type_code ) {
+  case 0: // None: ASSERT_NOT_REACHED; break;
+  case 1: type = BnNodeType::Prim; prim = PrimType::C0; break;
+  case 2: type = BnNodeType::Prim; prim = PrimType::C1; break;
+  case 3: type = BnNodeType::Prim; prim = PrimType::Buff; break;
+  case 4: type = BnNodeType::Prim; prim = PrimType::Not; break;
+  case 5: type = BnNodeType::Prim; prim = PrimType::And; break;
+  case 6: type = BnNodeType::Prim; prim = PrimType::Nand; break;
+  case 7: type = BnNodeType::Prim; prim = PrimType::Or; break;
+  case 8: type = BnNodeType::Prim; prim = PrimType::Nor; break;
+  case 9: type = BnNodeType::Prim; prim = PrimType::Xor; break;
+  case 10: type = BnNodeType::Prim; prim = PrimType::Xnor; break;
+  default: break;
+  }
+  if ( type != BnNodeType::None ) {
+    node_id = network_impl->new_logic_primitive(name, prim, fanin_id_list);
+  }
+  else if ( type_code == 11 ) {
+    // Expr
+    SizeType id = s.read_vint();
+    ASSERT_COND( id < mExprList.size() );
+    auto& expr = mExprList[id];
+    node_id = network_impl->new_logic_expr(name, expr, fanin_id_list);
+  }
+  else if ( type_code == 12 ) {
+    // TvFunc
+    SizeType id = s.read_vint();
+    auto& func = mFuncList[id];
+    node_id = network_impl->new_logic_tv(name, func, fanin_id_list);
+  }
+  else if ( type_code == 13 ) {
+    // Bdd
+    SizeType id = s.read_vint();
+    auto bdd = mBddList[id];
+    node_id = network_impl->new_logic_bdd(name, bdd, fanin_id_list);
+  }
+  else if ( type_code == 14 ) {
+    // Cell
+    SizeType cell_id = s.read_vint();
+    auto cell = network_impl->library().cell(cell_id);
+    node_id = network_impl->new_logic_cell(name, cell, fanin_id_list);
+  }
+  mNodeMap[id] = node_id;
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,467 @@
+
+/// @file BnCec.cc
+/// @brief BnCec の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnCec.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNode.h"
+#include "ym/BnPort.h"
+#include "ym/BnDff.h"
+#include "ym/BnNodeEnc.h"
+#include "Simulator.h"
+#include "EquivChecker.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// network1 の入出力ノードに対応する network2 のノードを返す．
+//
+// 見つからない場合は不正値を返す．
+BnNode
+find_node(
+  const BnNode& node1,
+  const BnNetwork& network2,
+  const vector<SizeType>& port_map
+)
+{
+  if ( node1.is_port_input() || node1.is_port_output() ) {
+    auto port2 = network2.port(port_map[node1.port_id()]);
+    return port2.bit(node1.port_bit());
+  }
+
+  auto dff2 = network2.dff(node1.dff_id());
+  if ( node1.is_data_out() ) {
+    return dff2.data_out();
+  }
+  if ( node1.is_cell_output() ) {
+    return dff2.cell_output(node1.cell_output_pos());
+  }
+  if ( node1.is_data_in() ) {
+    return dff2.data_in();
+  }
+  if ( node1.is_clock() ) {
+    return dff2.clock();
+  }
+  if ( node1.is_clear() ) {
+    return dff2.clear();
+  }
+  if ( node1.is_preset() ) {
+    return dff2.preset();
+  }
+  if ( node1.is_cell_input() ) {
+    return dff2.cell_input(node1.cell_input_pos());
+  }
+  return BnNode{};
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// 等価検証の本体
+//////////////////////////////////////////////////////////////////////
+class CecMgr
+{
+public:
+
+  // コンストラクタ
+  CecMgr(
+    const BnNetwork& network1,
+    const BnNetwork& network2,
+    const vector<pair<SizeType, SizeType>>& input_pair_list,
+    const vector<pair<SizeType, SizeType>>& output_pair_list,
+    const SatSolverType& solver_type,
+    SizeType conflict_limit,
+    vector<SatBool3>& status_list,
+    vector<vector<bool>>& cex_list
+  ) : mNetwork1{network1},
+      mNetwork2{network2},
+      mInputPairList{input_pair_list},
+      mOutputPairList{output_pair_list},
+      mStatusList{status_list},
+      mCexList{cex_list},
+      mSim1{network1},
+      mSim2{network2},
+      mSig1(network1.node_num() + 1),
+      mSig2(network2.node_num() + 1),
+      mEquiv{solver_type, conflict_limit},
+      mEnc1{mEquiv.solver(), network1},
+      mEnc2{mEquiv.solver(), network2}
+  {
+    // 入力は2つのネットワークで同じ変数を用いる．
+    for ( auto& p: mInputPairList ) {
+      auto lit = mEquiv.new_input();
+      mEnc1.set_lit(p.first, lit);
+      mEnc2.set_lit(p.second, lit);
+    }
+
+    // network1 の入力と論理ノードが等価候補となる．
+    for ( auto node1: mNetwork1.input_list() ) {
+      mCandList.push_back(node1.id());
+    }
+    for ( auto node1: mNetwork1.logic_list() ) {
+      mCandList.push_back(node1.id());
+    }
+  }
+
+  // ランダムシミュレーションを行う．
+  void
+  random_sim(
+    SizeType sim_num
+  )
+  {
+    SizeType ni = mInputPairList.size();
+    vector<PackedVal> ival_list(ni);
+    for ( SizeType c = 0; c < sim_num; ++ c ) {
+      if ( undecided_num() == 0 ) {
+	break;
+      }
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	ival_list[i] = mRandGen();
+      }
+      simulate(ival_list);
+    }
+  }
+
+  // 内部ノードの等価性を SAT で調べる．
+  void
+  sat_sweep()
+  {
+    if ( undecided_num() == 0 ) {
+      return;
+    }
+
+    // 未決定の出力の TFI に含まれる network2 のノードに印をつける．
+    vector<bool> mark(mNetwork2.node_num() + 1, false);
+    vector<SizeType> stack;
+    for ( SizeType pos = 0; pos < mOutputPairList.size(); ++ pos ) {
+      if ( mStatusList[pos] == SatBool3::X ) {
+	auto src = mNetwork2.node(mOutputPairList[pos].second).output_src();
+	if ( src.is_valid() ) {
+	  stack.push_back(src.id());
+	}
+      }
+    }
+    while ( !stack.empty() ) {
+      auto id = stack.back();
+      stack.pop_back();
+      if ( mark[id] ) {
+	continue;
+      }
+      mark[id] = true;
+      auto node = mNetwork2.node(id);
+      if ( node.is_logic() ) {
+	for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+	  auto iid = node.fanin_id(i);
+	  if ( !mark[iid] ) {
+	    stack.push_back(iid);
+	  }
+	}
+      }
+    }
+
+    for ( auto node2: mNetwork2.logic_list() ) {
+      auto id2 = node2.id();
+      if ( !mark[id2] ) {
+	continue;
+      }
+      if ( mCandDirty ) {
+	mEquiv.make_cand_map(mCandList, mSig1);
+	mCandDirty = false;
+      }
+      SizeType id1;
+      bool inv;
+      if ( !mEquiv.find_cand(mSig2[id2], id1, inv) ) {
+	continue;
+      }
+      auto lit1 = mEnc1.make_cnf(id1);
+      auto lit2 = mEnc2.make_cnf(id2);
+      if ( inv ) {
+	lit1 = ~lit1;
+      }
+      vector<bool> cex;
+      auto stat = mEquiv.check_equiv(lit1, lit2, cex);
+      // 反例をシミュレーションパタンに加える．
+      if ( stat == SatBool3::False && mEquiv.add_pattern(cex) ) {
+	flush_pattern();
+      }
+    }
+    flush_pattern();
+  }
+
+  // 出力を SAT で調べる．
+  void
+  prove_outputs()
+  {
+    for ( SizeType pos = 0; pos < mOutputPairList.size(); ++ pos ) {
+      if ( mStatusList[pos] != SatBool3::X ) {
+	continue;
+      }
+      auto& p = mOutputPairList[pos];
+      auto lit1 = mEnc1.make_cnf(p.first);
+      auto lit2 = mEnc2.make_cnf(p.second);
+      vector<bool> cex;
+      auto stat = mEquiv.check_equiv(lit1, lit2, cex);
+      mStatusList[pos] = stat;
+      if ( stat == SatBool3::False ) {
+	mCexList[pos] = cex;
+      }
+    }
+  }
+
+
+private:
+
+  // 未決定の出力数を返す．
+  SizeType
+  undecided_num() const
+  {
+    SizeType n = 0;
+    for ( auto stat: mStatusList ) {
+      if ( stat == SatBool3::X ) {
+	++ n;
+      }
+    }
+    return n;
+  }
+
+  // 64パタン分のシミュレーションを行う．
+  //
+  // ival_list は network1 の input_list() の順に並べる．
+  void
+  simulate(
+    const vector<PackedVal>& ival_list
+  )
+  {
+    SizeType ni = mInputPairList.size();
+    vector<PackedVal> ival_list2(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto node2 = mNetwork2.node(mInputPairList[i].second);
+      ival_list2[node2.input_pos()] = ival_list[i];
+    }
+    mSim1.simulate(ival_list);
+    mSim2.simulate(ival_list2);
+    for ( SizeType id = 1; id < mSig1.size(); ++ id ) {
+      mSig1[id].push_back(mSim1.val(id));
+    }
+    for ( SizeType id = 1; id < mSig2.size(); ++ id ) {
+      mSig2[id].push_back(mSim2.val(id));
+    }
+    mCandDirty = true;
+
+    // 出力の値が異なるパタンを探す．
+    for ( SizeType pos = 0; pos < mOutputPairList.size(); ++ pos ) {
+      if ( mStatusList[pos] != SatBool3::X ) {
+	continue;
+      }
+      auto& p = mOutputPairList[pos];
+      auto diff = mSim1.val(p.first) ^ mSim2.val(p.second);
+      if ( diff == 0UL ) {
+	continue;
+      }
+      SizeType b = 0;
+      while ( ((diff >> b) & 1UL) == 0 ) {
+	++ b;
+      }
+      vector<bool> cex(ni);
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	cex[i] = ((ival_list[i] >> b) & 1UL) == 1UL;
+      }
+      mStatusList[pos] = SatBool3::False;
+      mCexList[pos] = cex;
+    }
+  }
+
+  // たまっている反例を用いてシミュレーションを行う．
+  void
+  flush_pattern()
+  {
+    vector<PackedVal> ival_list;
+    if ( mEquiv.pack_pattern(ival_list) ) {
+      simulate(ival_list);
+    }
+  }
+
+
+private:
+
+  // ネットワーク1
+  const BnNetwork& mNetwork1;
+
+  // ネットワーク2
+  const BnNetwork& mNetwork2;
+
+  // 入力の対のリスト
+  const vector<pair<SizeType, SizeType>>& mInputPairList;
+
+  // 出力の対のリスト
+  const vector<pair<SizeType, SizeType>>& mOutputPairList;
+
+  // 出力の対ごとの検証結果
+  vector<SatBool3>& mStatusList;
+
+  // 出力の対ごとの反例
+  vector<vector<bool>>& mCexList;
+
+  // 乱数生成器
+  std::mt19937_64 mRandGen;
+
+  // シミュレータ
+  Simulator mSim1;
+  Simulator mSim2;
+
+  // ノード番号をキーにしてシグネチャを格納する配列
+  vector<vector<PackedVal>> mSig1;
+  vector<vector<PackedVal>> mSig2;
+
+  // 等価候補となる network1 のノード番号のリスト
+  vector<SizeType> mCandList;
+
+  // 等価候補の辞書を作り直す必要がある時 true にするフラグ
+  bool mCandDirty{true};
+
+  // 等価候補の辞書と SAT による等価性判定
+  // 入力は mInputPairList の順に登録する．
+  EquivChecker mEquiv;
+
+  // CNF 式の符号化器
+  BnNodeEnc mEnc1;
+  BnNodeEnc mEnc2;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnCec
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BnCec::BnCec(
+  const BnNetwork& network1,
+  const BnNetwork& network2,
+  bool match_by_name,
+  const SatSolverType& solver_type
+) : mNetwork1{network1},
+    mNetwork2{network2},
+    mSolverType{solver_type}
+{
+  match(match_by_name);
+}
+
+// @brief 等価検証を行う．
+bool
+BnCec::check(
+  SizeType sim_num,
+  SizeType conflict_limit
+)
+{
+  SizeType no = mOutputPairList.size();
+  mStatusList.clear();
+  mStatusList.resize(no, SatBool3::X);
+  mCexList.clear();
+  mCexList.resize(no);
+
+  CecMgr mgr{mNetwork1, mNetwork2,
+	     mInputPairList, mOutputPairList,
+	     mSolverType, conflict_limit,
+	     mStatusList, mCexList};
+  mgr.random_sim(sim_num);
+  mgr.sat_sweep();
+  mgr.prove_outputs();
+
+  for ( auto stat: mStatusList ) {
+    if ( stat != SatBool3::True ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief ポートとDFFの対応をとる．
+void
+BnCec::match(
+  bool match_by_name
+)
+{
+  // ポートの対応をとる．
+  SizeType np = mNetwork1.port_num();
+  if ( mNetwork2.port_num() != np ) {
+    ostringstream buf;
+    buf << "BnCec: port_num() mismatch: "
+	<< np << " and " << mNetwork2.port_num();
+    throw std::invalid_argument{buf.str()};
+  }
+  vector<SizeType> port_map(np);
+  for ( SizeType i = 0; i < np; ++ i ) {
+    auto port1 = mNetwork1.port(i);
+    auto port2 = match_by_name ? mNetwork2.find_port(port1.name()) : mNetwork2.port(i);
+    if ( port2.is_invalid() ) {
+      ostringstream buf;
+      buf << "BnCec: port '" << port1.name() << "' is not found";
+      throw std::invalid_argument{buf.str()};
+    }
+    if ( port2.bit_width() != port1.bit_width() ) {
+      ostringstream buf;
+      buf << "BnCec: bit_width() of port '" << port1.name() << "' mismatch: "
+	  << port1.bit_width() << " and " << port2.bit_width();
+      throw std::invalid_argument{buf.str()};
+    }
+    port_map[i] = port2.id();
+  }
+
+  // DFFの構成を調べる．
+  SizeType nd = mNetwork1.dff_num();
+  if ( mNetwork2.dff_num() != nd ) {
+    ostringstream buf;
+    buf << "BnCec: dff_num() mismatch: "
+	<< nd << " and " << mNetwork2.dff_num();
+    throw std::invalid_argument{buf.str()};
+  }
+  for ( SizeType i = 0; i < nd; ++ i ) {
+    auto dff1 = mNetwork1.dff(i);
+    auto dff2 = mNetwork2.dff(i);
+    if ( dff1.type() != dff2.type() ||
+	 (dff1.is_cell() &&
+	  (dff1.cell_input_num() != dff2.cell_input_num() ||
+	   dff1.cell_output_num() != dff2.cell_output_num())) ) {
+      ostringstream buf;
+      buf << "BnCec: type of dff#" << i << " mismatch";
+      throw std::invalid_argument{buf.str()};
+    }
+  }
+
+  // 入力ノードと出力ノードの対応をとる．
+  mInputPairList.clear();
+  for ( auto node1: mNetwork1.input_list() ) {
+    auto node2 = find_node(node1, mNetwork2, port_map);
+    if ( node2.is_invalid() || !node2.is_input() ) {
+      ostringstream buf;
+      buf << "BnCec: no counterpart for input node '" << node1.name() << "'";
+      throw std::invalid_argument{buf.str()};
+    }
+    mInputPairList.push_back(make_pair(node1.id(), node2.id()));
+  }
+  mOutputPairList.clear();
+  for ( auto node1: mNetwork1.output_list() ) {
+    auto node2 = find_node(node1, mNetwork2, port_map);
+    if ( node2.is_invalid() || !node2.is_output() ) {
+      ostringstream buf;
+      buf << "BnCec: no counterpart for output node '" << node1.name() << "'";
+      throw std::invalid_argument{buf.str()};
+    }
+    mOutputPairList.push_back(make_pair(node1.id(), node2.id()));
+  }
+  if ( mNetwork2.input_num() != mInputPairList.size() ||
+       mNetwork2.output_num() != mOutputPairList.size() ) {
+    throw std::invalid_argument{"BnCec: input/output mismatch"};
+  }
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,406 @@
+
+/// @file BnGlobalBdd.cc
+/// @brief BnGlobalBdd の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnGlobalBdd.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNode.h"
+#include "ym/BddMgr.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/ClibCell.h"
+#include "BnNetworkImpl.h"
+#include "Isop.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnGlobalBdd
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BnGlobalBdd::BnGlobalBdd(
+  const BnNetwork& network,
+  SizeType node_limit,
+  bool sifting
+) : mNetwork{network},
+    mNodeLimit{node_limit},
+    mSifting{sifting},
+    mStatusArray(network.node_num() + 1, Status::None),
+    mBddArray(network.node_num() + 1)
+{
+  for ( auto node: mNetwork.output_list() ) {
+    mOutputList.push_back(node.id());
+  }
+
+  order_vars();
+
+  // 入力の BDD は変数順に作っておく．
+  auto& mgr = mNetwork.mImpl->bdd_mgr();
+  for ( SizeType var = 0; var < mVarInputList.size(); ++ var ) {
+    auto id = mVarInputList[var];
+    mBddArray[id] = mgr.literal(var);
+    mStatusArray[id] = Status::Done;
+  }
+}
+
+// @brief 出力の BDD を返す．
+Bdd
+BnGlobalBdd::output_bdd(
+  SizeType pos
+)
+{
+  ASSERT_COND( pos < output_num() );
+
+  auto id = mOutputList[pos];
+  if ( mStatusArray[id] == Status::None ) {
+    auto& mgr = mNetwork.mImpl->bdd_mgr();
+    if ( mSifting ) {
+      mgr.enable_dvo();
+    }
+    make_bdd(id);
+    if ( mSifting ) {
+      mgr.disable_dvo();
+    }
+  }
+  if ( mStatusArray[id] == Status::Aborted ) {
+    return Bdd::invalid();
+  }
+  return mBddArray[id];
+}
+
+// @brief 全ての出力の BDD を作る．
+SizeType
+BnGlobalBdd::build_all()
+{
+  SizeType n = 0;
+  for ( SizeType pos = 0; pos < output_num(); ++ pos ) {
+    if ( is_aborted(pos) ) {
+      ++ n;
+    }
+  }
+  return n;
+}
+
+// @brief 出力の BDD を打ち切った時 true を返す．
+bool
+BnGlobalBdd::is_aborted(
+  SizeType pos
+)
+{
+  return output_bdd(pos).is_invalid();
+}
+
+// @brief 変数順を決める．
+void
+BnGlobalBdd::order_vars()
+{
+  SizeType n = mNetwork.node_num();
+  vector<bool> mark(n + 1, false);
+  vector<SizeType> var_array(n + 1, 0);
+  mVarInputList.clear();
+
+  // 出力から深さ優先でたどる．
+  // ファンインの順にたどるようにスタックには逆順に積む．
+  for ( auto id: mOutputList ) {
+    vector<SizeType> stack{id};
+    while ( !stack.empty() ) {
+      auto id1 = stack.back();
+      stack.pop_back();
+      if ( mark[id1] ) {
+	continue;
+      }
+      mark[id1] = true;
+      auto node = mNetwork.node(id1);
+      if ( node.is_input() ) {
+	var_array[id1] = mVarInputList.size();
+	mVarInputList.push_back(id1);
+      }
+      else if ( node.is_output() ) {
+	auto src = node.output_src();
+	if ( src.is_valid() && !mark[src.id()] ) {
+	  stack.push_back(src.id());
+	}
+      }
+      else if ( node.is_logic() ) {
+	for ( SizeType i = node.fanin_num(); i -- > 0; ) {
+	  auto iid = node.fanin_id(i);
+	  if ( !mark[iid] ) {
+	    stack.push_back(iid);
+	  }
+	}
+      }
+    }
+  }
+
+  // 到達しなかった入力
+  for ( auto node: mNetwork.input_list() ) {
+    auto id = node.id();
+    if ( !mark[id] ) {
+      var_array[id] = mVarInputList.size();
+      mVarInputList.push_back(id);
+    }
+  }
+
+  mInputVarList.clear();
+  for ( auto node: mNetwork.input_list() ) {
+    mInputVarList.push_back(var_array[node.id()]);
+  }
+}
+
+// @brief ノードの BDD を作る．
+void
+BnGlobalBdd::make_bdd(
+  SizeType root_id
+)
+{
+  // 再帰を用いずに TFI をたどる．
+  // 全てのファンインの処理が終わったノードから BDD を作る．
+  vector<SizeType> stack{root_id};
+  while ( !stack.empty() ) {
+    auto id = stack.back();
+    if ( mStatusArray[id] != Status::None ) {
+      stack.pop_back();
+      continue;
+    }
+    auto node = mNetwork.node(id);
+    vector<SizeType> fanin_list;
+    if ( node.is_output() ) {
+      auto src = node.output_src();
+      if ( src.is_valid() ) {
+	fanin_list.push_back(src.id());
+      }
+    }
+    else {
+      ASSERT_COND( node.is_logic() );
+      for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+	fanin_list.push_back(node.fanin_id(i));
+      }
+    }
+
+    bool ready = true;
+    bool aborted = false;
+    for ( auto iid: fanin_list ) {
+      if ( mStatusArray[iid] == Status::None ) {
+	stack.push_back(iid);
+	ready = false;
+      }
+      else if ( mStatusArray[iid] == Status::Aborted ) {
+	aborted = true;
+      }
+    }
+    if ( !ready ) {
+      continue;
+    }
+    stack.pop_back();
+
+    // ファンインを打ち切った場合はこのノードも打ち切る．
+    if ( aborted ) {
+      mStatusArray[id] = Status::Aborted;
+      continue;
+    }
+
+    Bdd bdd;
+    if ( node.is_output() ) {
+      if ( fanin_list.empty() ) {
+	bdd = mNetwork.mImpl->bdd_mgr().zero();
+      }
+      else {
+	bdd = mBddArray[fanin_list[0]];
+      }
+    }
+    else {
+      SizeType ni = fanin_list.size();
+      vector<Bdd> ibdd_list(ni);
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	ibdd_list[i] = mBddArray[fanin_list[i]];
+      }
+      bdd = calc_logic(node, ibdd_list);
+    }
+    if ( mNodeLimit > 0 && bdd.size() > mNodeLimit ) {
+      mStatusArray[id] = Status::Aborted;
+    }
+    else {
+      mBddArray[id] = bdd;
+      mStatusArray[id] = Status::Done;
+    }
+  }
+}
+
+// @brief 論理ノードの BDD を計算する．
+Bdd
+BnGlobalBdd::calc_logic(
+  const BnNode& node,
+  const vector<Bdd>& ibdd_list
+)
+{
+  auto& mgr = mNetwork.mImpl->bdd_mgr();
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    {
+      auto prim_type = node.primitive_type();
+      switch ( prim_type ) {
+      case PrimType::C0:
+	return mgr.zero();
+
+      case PrimType::C1:
+	return mgr.one();
+
+      case PrimType::Buff:
+	return ibdd_list[0];
+
+      case PrimType::Not:
+	return ~ibdd_list[0];
+
+      case PrimType::And:
+      case PrimType::Nand:
+	{
+	  auto bdd = mgr.one();
+	  for ( auto& ibdd: ibdd_list ) {
+	    bdd &= ibdd;
+	  }
+	  return prim_type == PrimType::Nand ? ~bdd : bdd;
+	}
+
+      case PrimType::Or:
+      case PrimType::Nor:
+	{
+	  auto bdd = mgr.zero();
+	  for ( auto& ibdd: ibdd_list ) {
+	    bdd |= ibdd;
+	  }
+	  return prim_type == PrimType::Nor ? ~bdd : bdd;
+	}
+
+      case PrimType::Xor:
+      case PrimType::Xnor:
+	{
+	  auto bdd = mgr.zero();
+	  for ( auto& ibdd: ibdd_list ) {
+	    bdd ^= ibdd;
+	  }
+	  return prim_type == PrimType::Xnor ? ~bdd : bdd;
+	}
+
+      default:
+	break;
+      }
+    }
+    break;
+
+  case BnNodeType::Expr:
+    return calc_expr(node.expr(), ibdd_list);
+
+  case BnNodeType::TvFunc:
+    {
+      // 非冗長積和形から作る．
+      auto bdd = mgr.zero();
+      for ( auto& cube: isop(node.func()) ) {
+	auto cube_bdd = mgr.one();
+	for ( auto lit: cube ) {
+	  auto& ibdd = ibdd_list[lit / 2];
+	  if ( lit & 1 ) {
+	    cube_bdd &= ~ibdd;
+	  }
+	  else {
+	    cube_bdd &= ibdd;
+	  }
+	}
+	bdd |= cube_bdd;
+      }
+      return bdd;
+    }
+
+  case BnNodeType::Bdd:
+    {
+      unordered_map<Bdd, Bdd> result_map;
+      return compose(node.bdd(), ibdd_list, result_map);
+    }
+
+  case BnNodeType::Cell:
+    return calc_expr(node.cell().logic_expr(0), ibdd_list);
+
+  default:
+    break;
+  }
+  ASSERT_NOT_REACHED;
+  return Bdd::invalid();
+}
+
+// @brief 論理式の BDD を計算する．
+Bdd
+BnGlobalBdd::calc_expr(
+  const Expr& expr,
+  const vector<Bdd>& ibdd_list
+)
+{
+  auto& mgr = mNetwork.mImpl->bdd_mgr();
+  if ( expr.is_zero() ) {
+    return mgr.zero();
+  }
+  if ( expr.is_one() ) {
+    return mgr.one();
+  }
+  if ( expr.is_posi_literal() ) {
+    return ibdd_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return ~ibdd_list[expr.varid()];
+  }
+
+  ASSERT_COND( expr.is_op() );
+  if ( expr.is_and() ) {
+    auto bdd = mgr.one();
+    for ( auto& opr: expr.operand_list() ) {
+      bdd &= calc_expr(opr, ibdd_list);
+    }
+    return bdd;
+  }
+  if ( expr.is_or() ) {
+    auto bdd = mgr.zero();
+    for ( auto& opr: expr.operand_list() ) {
+      bdd |= calc_expr(opr, ibdd_list);
+    }
+    return bdd;
+  }
+  if ( expr.is_xor() ) {
+    auto bdd = mgr.zero();
+    for ( auto& opr: expr.operand_list() ) {
+      bdd ^= calc_expr(opr, ibdd_list);
+    }
+    return bdd;
+  }
+  ASSERT_NOT_REACHED;
+  return Bdd::invalid();
+}
+
+// @brief ローカルな BDD に大域的な BDD を代入する．
+Bdd
+BnGlobalBdd::compose(
+  const Bdd& bdd,
+  const vector<Bdd>& ibdd_list,
+  unordered_map<Bdd, Bdd>& result_map
+)
+{
+  // ローカルな BDD も同じマネージャ上にあるので定数はそのまま使える．
+  if ( bdd.is_zero() || bdd.is_one() ) {
+    return bdd;
+  }
+  if ( result_map.count(bdd) > 0 ) {
+    return result_map.at(bdd);
+  }
+  auto var = bdd.root_var();
+  auto r0 = compose(bdd.root_cofactor0(), ibdd_list, result_map);
+  auto r1 = compose(bdd.root_cofactor1(), ibdd_list, result_map);
+  auto& g = ibdd_list[var];
+  auto result = (g & r1) | (~g & r0);
+  result_map.emplace(bdd, result);
+  return result;
+}
+
+END_NAMESPACE_YM_BNET
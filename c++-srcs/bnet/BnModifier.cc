@@ -434,6 +434,17 @@ BnModifier::substitute_fanout(
   mImpl->substitute_fanout(old_node.id(), new_node.id());
 }
 
+// @brief 整合性のチェックを行う．
+void
+BnModifier::wrap_up(
+  bool check_loop
+)
+{
+  ASSERT_COND( mImpl != nullptr );
+
+  mImpl->wrap_up(check_loop);
+}
+
 // @brief ノード番号のリストを作る．
 vector<SizeType>
 BnModifier::make_id_list(
@@ -531,9 +531,16 @@ END_NONAMESPACE
 
 // @brief 整合性のチェックを行う．
 void
-BnNetworkImpl::wrap_up()
+BnNetworkImpl::wrap_up(
+  bool check_loop
+)
 {
   if ( mSane ) {
+    // 他のチェックは済んでいるがループのチェックは行われていないことがある．
+    if ( check_loop ) {
+      bool error = report_loops();
+      ASSERT_COND( !error );
+    }
     return;
   }
 
@@ -666,6 +673,14 @@ BnNetworkImpl::wrap_up()
     }
   }
 
+  // 組み合わせ回路部分のループのチェック
+  // ファンイン番号が不正な場合には行わない．
+  if ( check_loop && !error ) {
+    if ( report_loops() ) {
+      error = true;
+    }
+  }
+
   ASSERT_COND( !error );
 
   // 各ノードのファンアウトリストの作成
@@ -693,6 +708,24 @@ BnNetworkImpl::wrap_up()
   mSane = true;
 }
 
+// @brief 組み合わせ回路部分のループを出力する．
+bool
+BnNetworkImpl::report_loops() const
+{
+  bool found = false;
+  for ( auto& loop: find_loops() ) {
+    cerr << "combinational loop detected:";
+    for ( auto id: loop ) {
+      auto node_p = _node_p(id);
+      cerr << " NODE#" << id
+	   << "(" << node_p->name() << ")";
+    }
+    cerr << endl;
+    found = true;
+  }
+  return found;
+}
+
 // @brief 実装可能な構造を持っている時 true を返す．
 bool
 BnNetworkImpl::is_concrete() const
@@ -1019,6 +1052,9 @@ BnNetworkImpl::_chg_node(
   new_node->mId = id;
   mNodeList[id - 1] = new_node;
   delete old_node;
+
+  // 新しいノードのファンアウトリストは空なので作り直す必要がある．
+  mSane = false;
 }
 
 // @brief 論理式を解析する．
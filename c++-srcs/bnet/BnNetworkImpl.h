@@ -12,6 +12,7 @@
 #include "ym/Bdd.h"
 #include "ym/BddMgr.h"
 #include "ym/BnNode.h"
+#include "ym/BnNetworkStats.h"
 #include "ym/ClibCellLibrary.h"
 #include "ym/ClibCell.h"
 #include "ym/Expr.h"
@@ -331,8 +332,11 @@ public:
   /// - 各DFFの入力，出力およびクロックが設定されているか？
   /// - 各ラッチの入力，出力およびイネーブルが設定されているか？
   /// - 各ノードのファンインが設定されているか？
+  /// - check_loop が true の時，組み合わせ回路部分にループがないか？
   void
-  wrap_up();
+  wrap_up(
+    bool check_loop = false ///< [in] ループのチェックを行う時 true にする．
+  );
 
   /// @brief BDDの情報を復元する．
   ///
@@ -345,6 +349,15 @@ public:
     return mBddMgr.restore(s);
   }
 
+  /// @brief BDDマネージャを返す．
+  ///
+  /// BnGlobalBdd で用いられる．
+  BddMgr&
+  bdd_mgr()
+  {
+    return mBddMgr;
+  }
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
@@ -580,6 +593,51 @@ public:
     return mExprList[expr_id];
   }
 
+  /// @brief 組み合わせ回路部分のループを求める．
+  /// @return ループごとのノード番号のリストを返す．
+  ///
+  /// - 自己ループおよび2つ以上の論理ノードからなる強連結成分を
+  ///   ループとみなす．
+  /// - 各ノードのファンイン番号は正しい必要がある．
+  vector<vector<SizeType>>
+  find_loops() const;
+
+  /// @brief 論理ノードをトポロジカル順に並べたリストを返す．
+  ///
+  /// - 全ての論理ノードを含む．
+  /// - ループがある場合はループ上のノードの順序は不定となる．
+  /// - 各ノードのファンイン番号は正しい必要がある．
+  vector<SizeType>
+  sorted_logic_list() const;
+
+  /// @brief 入力側からの直接支配ノードの配列を求める．
+  /// @return ノード番号をキーにして直接支配ノードの番号を持つ配列を返す．
+  ///
+  /// - 全ての入力ノードを後続に持つ仮想的な根を考える．
+  /// - 直接支配ノードが仮想的な根の場合と，入力から到達不能な
+  ///   ノードの場合には BNET_NULLID となる．
+  /// - 配列のサイズは node_num() + 1 で，0番目は使用しない．
+  /// - wrap_up() 済みである必要がある．
+  vector<SizeType>
+  dominator_list() const;
+
+  /// @brief 出力側への直接支配ノード(post-dominator)の配列を求める．
+  /// @return ノード番号をキーにして直接支配ノードの番号を持つ配列を返す．
+  ///
+  /// - 全ての出力ノードを前段に持つ仮想的な根を考える．
+  /// - 直接支配ノードが仮想的な根の場合と，出力に到達しない
+  ///   ノードの場合には BNET_NULLID となる．
+  /// - 配列のサイズは node_num() + 1 で，0番目は使用しない．
+  /// - wrap_up() 済みである必要がある．
+  vector<SizeType>
+  post_dominator_list() const;
+
+  /// @brief 統計情報を得る．
+  ///
+  /// - ファンアウト数のヒストグラムは wrap_up() 済みでないと正しくない．
+  BnNetworkStats
+  stats() const;
+
   /// @brief 内容を出力する．
   ///
   /// - 形式は独自フォーマット
@@ -604,6 +662,13 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 組み合わせ回路部分のループを出力する．
+  /// @return ループが見つかった時 true を返す．
+  ///
+  /// 見つかったループは cerr に出力する．
+  bool
+  report_loops() const;
+
   /// @brief データ入力ノードを作る．
   /// @return 生成したノード番号を返す．
   SizeType
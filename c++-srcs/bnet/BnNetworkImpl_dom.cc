@@ -0,0 +1,309 @@
+
+/// @file BnNetworkImpl_dom.cc
+/// @brief BnNetworkImpl の支配ノード関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BnNetworkImpl.h"
+#include "BnNodeImpl.h"
+#include "ym/BnNetwork.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// 未定義を表す値
+const SizeType UNDEF = static_cast<SizeType>(-1);
+
+//////////////////////////////////////////////////////////////////////
+/// @class DomCalc
+/// @brief 直接支配ノードを求めるクラス
+///
+/// Cooper, Harvey, Kennedy の "A Simple, Fast Dominance Algorithm"
+/// の方法を用いる．
+/// ノード番号 0 (BNET_NULLID) を仮想的な根として扱う．
+/// post が true の時はファンインの方向に探索を行い，出力側への
+/// 支配関係(post-dominator)を求める．
+//////////////////////////////////////////////////////////////////////
+class DomCalc
+{
+public:
+
+  /// @brief コンストラクタ
+  DomCalc(
+    const BnNetworkImpl& network, ///< [in] 対象のネットワーク
+    bool post                     ///< [in] post-dominator を求める時 true
+  ) : mNetwork{network},
+      mPost{post}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~DomCalc() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 直接支配ノードの配列を求める．
+  vector<SizeType>
+  calc()
+  {
+    SizeType n = mNetwork.node_num();
+
+    // 根から到達可能なノードを深さ優先でたどってポストオーダーを求める．
+    // 後続ノードをまとめてスタックに積むので，同じノードが複数回積まれる
+    // ことがあるが，取り出した時に処理済みならスキップする．
+    vector<bool> mark(n + 1, false);
+    vector<bool> root_mark(n + 1, false);
+    vector<SizeType> order_list;
+    order_list.reserve(n);
+    vector<pair<SizeType, bool>> stack;
+    const auto& root_list = mPost ? mNetwork.output_id_list() : mNetwork.input_id_list();
+    for ( auto id: root_list ) {
+      root_mark[id] = true;
+    }
+    for ( auto id: root_list ) {
+      stack.push_back(make_pair(id, false));
+      while ( !stack.empty() ) {
+	auto id1 = stack.back().first;
+	auto done = stack.back().second;
+	stack.pop_back();
+	if ( done ) {
+	  order_list.push_back(id1);
+	  continue;
+	}
+	if ( mark[id1] ) {
+	  continue;
+	}
+	mark[id1] = true;
+	stack.push_back(make_pair(id1, true));
+	auto node_p = mNetwork._node(id1);
+	SizeType ns = succ_num(node_p);
+	for ( SizeType i = 0; i < ns; ++ i ) {
+	  auto id2 = succ_id(node_p, i);
+	  if ( id2 != BNET_NULLID && !mark[id2] ) {
+	    stack.push_back(make_pair(id2, false));
+	  }
+	}
+      }
+    }
+
+    // 逆ポストオーダーでの順番を rank に入れる．
+    // 仮想的な根(0)の rank は 0 となる．
+    SizeType nr = order_list.size();
+    mRank.clear();
+    mRank.resize(n + 1, 0);
+    for ( SizeType i = 0; i < nr; ++ i ) {
+      mRank[order_list[i]] = nr - i;
+    }
+
+    mIdom.clear();
+    mIdom.resize(n + 1, UNDEF);
+    mIdom[0] = 0;
+    bool changed = true;
+    while ( changed ) {
+      changed = false;
+      for ( SizeType i = nr; i -- > 0; ) {
+	auto id = order_list[i];
+	SizeType new_idom = root_mark[id] ? 0 : UNDEF;
+	auto node_p = mNetwork._node(id);
+	SizeType np = pred_num(node_p);
+	for ( SizeType j = 0; j < np; ++ j ) {
+	  auto id1 = pred_id(node_p, j);
+	  if ( mIdom[id1] == UNDEF ) {
+	    // 未処理か到達不能
+	    continue;
+	  }
+	  if ( new_idom == UNDEF ) {
+	    new_idom = id1;
+	  }
+	  else {
+	    new_idom = intersect(id1, new_idom);
+	  }
+	}
+	if ( mIdom[id] != new_idom ) {
+	  mIdom[id] = new_idom;
+	  changed = true;
+	}
+      }
+    }
+
+    vector<SizeType> ans(n + 1, BNET_NULLID);
+    for ( SizeType id = 1; id <= n; ++ id ) {
+      auto idom = mIdom[id];
+      if ( idom != UNDEF ) {
+	ans[id] = idom;
+      }
+    }
+    return ans;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 2つのノードの共通の支配ノードを求める．
+  SizeType
+  intersect(
+    SizeType id1,
+    SizeType id2
+  )
+  {
+    while ( id1 != id2 ) {
+      while ( mRank[id1] > mRank[id2] ) {
+	id1 = mIdom[id1];
+      }
+      while ( mRank[id2] > mRank[id1] ) {
+	id2 = mIdom[id2];
+      }
+    }
+    return id1;
+  }
+
+  /// @brief ノードのファンイン数を返す．
+  ///
+  /// 出力ノードの場合は output_src() をファンインとみなす．
+  SizeType
+  fanin_num(
+    const BnNodeImpl* node_p
+  )
+  {
+    if ( node_p->is_output() ) {
+      return node_p->output_src() != BNET_NULLID ? 1 : 0;
+    }
+    if ( node_p->is_logic() ) {
+      return node_p->fanin_num();
+    }
+    return 0;
+  }
+
+  /// @brief ノードのファンイン番号を返す．
+  SizeType
+  fanin_id(
+    const BnNodeImpl* node_p,
+    SizeType pos
+  )
+  {
+    if ( node_p->is_output() ) {
+      return node_p->output_src();
+    }
+    return node_p->fanin_id(pos);
+  }
+
+  /// @brief 探索方向の後続ノード数を返す．
+  SizeType
+  succ_num(
+    const BnNodeImpl* node_p
+  )
+  {
+    return mPost ? fanin_num(node_p) : node_p->fanout_num();
+  }
+
+  /// @brief 探索方向の後続ノードの番号を返す．
+  SizeType
+  succ_id(
+    const BnNodeImpl* node_p,
+    SizeType pos
+  )
+  {
+    return mPost ? fanin_id(node_p, pos) : node_p->fanout_id(pos);
+  }
+
+  /// @brief 探索方向の先行ノード数を返す．
+  SizeType
+  pred_num(
+    const BnNodeImpl* node_p
+  )
+  {
+    return mPost ? node_p->fanout_num() : fanin_num(node_p);
+  }
+
+  /// @brief 探索方向の先行ノードの番号を返す．
+  SizeType
+  pred_id(
+    const BnNodeImpl* node_p,
+    SizeType pos
+  )
+  {
+    return mPost ? node_p->fanout_id(pos) : fanin_id(node_p, pos);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BnNetworkImpl& mNetwork;
+
+  // post-dominator を求める時 true
+  bool mPost;
+
+  // ノード番号をキーにして逆ポストオーダーの順番を入れる配列
+  vector<SizeType> mRank;
+
+  // ノード番号をキーにして直接支配ノードを入れる配列
+  vector<SizeType> mIdom;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetworkImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 入力側からの直接支配ノードの配列を求める．
+vector<SizeType>
+BnNetworkImpl::dominator_list() const
+{
+  ASSERT_COND( mSane );
+
+  DomCalc calc{*this, false};
+  return calc.calc();
+}
+
+// @brief 出力側への直接支配ノード(post-dominator)の配列を求める．
+vector<SizeType>
+BnNetworkImpl::post_dominator_list() const
+{
+  ASSERT_COND( mSane );
+
+  DomCalc calc{*this, true};
+  return calc.calc();
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 入力側からの直接支配ノードの配列を求める．
+vector<SizeType>
+BnNetwork::dominator_list() const
+{
+  ASSERT_COND( mImpl != nullptr );
+
+  return mImpl->dominator_list();
+}
+
+// @brief 出力側への直接支配ノード(post-dominator)の配列を求める．
+vector<SizeType>
+BnNetwork::post_dominator_list() const
+{
+  ASSERT_COND( mImpl != nullptr );
+
+  return mImpl->post_dominator_list();
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,193 @@
+
+/// @file BnNetworkImpl_loop.cc
+/// @brief BnNetworkImpl のループ検出とトポロジカル順関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BnNetworkImpl.h"
+#include "BnNodeImpl.h"
+#include "ym/BnNetwork.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetworkImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 組み合わせ回路部分のループを求める．
+//
+// Tarjan の強連結成分分解を明示的なスタックを用いて行う．
+// 再帰を用いないので大規模な回路でもスタックオーバーフローしない．
+// ファンインをたどる方向で探索するが，強連結成分は向きに依らない．
+vector<vector<SizeType>>
+BnNetworkImpl::find_loops() const
+{
+  SizeType n = node_num();
+
+  // ノード番号をキーにして訪問順を入れる配列(0 は未訪問)
+  vector<SizeType> index_array(n + 1, 0);
+  // ノード番号をキーにして lowlink を入れる配列
+  vector<SizeType> low_array(n + 1, 0);
+  // ノード番号をキーにして SCC スタック上にある時 true となる配列
+  vector<bool> on_stack(n + 1, false);
+  // SCC 用のスタック
+  vector<SizeType> scc_stack;
+  // DFS 用のスタック(ノード番号と次に調べるファンイン位置)
+  vector<pair<SizeType, SizeType>> dfs_stack;
+
+  vector<vector<SizeType>> loop_list;
+  SizeType count = 0;
+  for ( auto root_p: mNodeList ) {
+    // 入力ノード，出力ノードはループに含まれない．
+    if ( !root_p->is_logic() ) {
+      continue;
+    }
+    auto root = root_p->id();
+    if ( index_array[root] != 0 ) {
+      // 処理済み
+      continue;
+    }
+
+    ++ count;
+    index_array[root] = count;
+    low_array[root] = count;
+    scc_stack.push_back(root);
+    on_stack[root] = true;
+    dfs_stack.push_back(make_pair(root, 0));
+    while ( !dfs_stack.empty() ) {
+      auto id = dfs_stack.back().first;
+      auto ipos = dfs_stack.back().second;
+      auto node_p = _node_p(id);
+      if ( ipos < node_p->fanin_num() ) {
+	++ dfs_stack.back().second;
+	auto iid = node_p->fanin_id(ipos);
+	if ( iid == BNET_NULLID || !_node_p(iid)->is_logic() ) {
+	  continue;
+	}
+	if ( index_array[iid] == 0 ) {
+	  // 未訪問のファンインに進む．
+	  ++ count;
+	  index_array[iid] = count;
+	  low_array[iid] = count;
+	  scc_stack.push_back(iid);
+	  on_stack[iid] = true;
+	  dfs_stack.push_back(make_pair(iid, 0));
+	}
+	else if ( on_stack[iid] ) {
+	  low_array[id] = std::min(low_array[id], index_array[iid]);
+	}
+	continue;
+      }
+
+      // 全てのファンインを処理した．
+      dfs_stack.pop_back();
+      if ( !dfs_stack.empty() ) {
+	auto pid = dfs_stack.back().first;
+	low_array[pid] = std::min(low_array[pid], low_array[id]);
+      }
+      if ( low_array[id] != index_array[id] ) {
+	continue;
+      }
+
+      // id を根とする強連結成分を取り出す．
+      vector<SizeType> scc;
+      for ( ; ; ) {
+	auto id1 = scc_stack.back();
+	scc_stack.pop_back();
+	on_stack[id1] = false;
+	scc.push_back(id1);
+	if ( id1 == id ) {
+	  break;
+	}
+      }
+      bool loop = scc.size() > 1;
+      if ( !loop ) {
+	// 自己ループのチェック
+	for ( auto iid: node_p->fanin_id_list() ) {
+	  if ( iid == id ) {
+	    loop = true;
+	    break;
+	  }
+	}
+      }
+      if ( loop ) {
+	std::reverse(scc.begin(), scc.end());
+	loop_list.push_back(scc);
+      }
+    }
+  }
+
+  return loop_list;
+}
+
+// @brief 論理ノードをトポロジカル順に並べたリストを返す．
+//
+// BnScoap::make_order() と同様に明示的なスタックを用いた
+// 深さ優先探索の帰りがけ順で並べる．
+vector<SizeType>
+BnNetworkImpl::sorted_logic_list() const
+{
+  SizeType n = node_num();
+  vector<SizeType> ans;
+  ans.reserve(mLogicList.size());
+  vector<bool> mark(n + 1, false);
+  vector<pair<SizeType, bool>> stack;
+  for ( auto root: mLogicList ) {
+    if ( mark[root] ) {
+      continue;
+    }
+    stack.push_back(make_pair(root, false));
+    while ( !stack.empty() ) {
+      auto id = stack.back().first;
+      auto done = stack.back().second;
+      stack.pop_back();
+      if ( done ) {
+	ans.push_back(id);
+	continue;
+      }
+      if ( mark[id] ) {
+	continue;
+      }
+      mark[id] = true;
+      stack.push_back(make_pair(id, true));
+      for ( auto iid: _node_p(id)->fanin_id_list() ) {
+	if ( iid != BNET_NULLID && !mark[iid] && _node_p(iid)->is_logic() ) {
+	  stack.push_back(make_pair(iid, false));
+	}
+      }
+    }
+  }
+  return ans;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 組み合わせ回路部分のループを求める．
+vector<BnNodeList>
+BnNetwork::find_loops() const
+{
+  ASSERT_COND( mImpl != nullptr );
+
+  vector<BnNodeList> ans;
+  for ( auto& id_list: mImpl->find_loops() ) {
+    ans.emplace_back(mImpl.get(), id_list);
+  }
+  return ans;
+}
+
+// @brief 論理ノードをトポロジカル順に並べたリストを返す．
+BnNodeList
+BnNetwork::sorted_logic_list() const
+{
+  ASSERT_COND( mImpl != nullptr );
+
+  return BnNodeList{mImpl.get(), mImpl->sorted_logic_list()};
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,161 @@
+
+/// @file BnNetworkImpl_stats.cc
+/// @brief BnNetworkImpl の統計情報関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BnNetworkImpl.h"
+#include "BnNodeImpl.h"
+#include "BnDffImpl.h"
+#include "ym/BnNetwork.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// ヒストグラムに値を加える．
+inline
+void
+add_hist(
+  vector<SizeType>& hist,
+  SizeType val
+)
+{
+  if ( hist.size() <= val ) {
+    hist.resize(val + 1, 0);
+  }
+  ++ hist[val];
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetworkStats
+//////////////////////////////////////////////////////////////////////
+
+// @brief ノードタイプ名
+const char* const
+BnNetworkStats::NODE_TYPE_NAME[] = {
+  "None", "Input", "Output", "Prim", "Expr", "TvFunc", "Bdd", "Cell"
+};
+
+// @brief プリミティブタイプ名
+const char* const
+BnNetworkStats::PRIM_TYPE_NAME[] = {
+  "None", "C0", "C1", "Buff", "Not", "And", "Nand", "Or", "Nor", "Xor", "Xnor"
+};
+
+// @brief DFFタイプ名
+const char* const
+BnNetworkStats::DFF_TYPE_NAME[] = {
+  "None", "Dff", "Latch", "Cell"
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetworkImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 統計情報を得る．
+BnNetworkStats
+BnNetworkImpl::stats() const
+{
+  BnNetworkStats stats;
+
+  stats.port_num = port_num();
+  stats.dff_num = dff_num();
+  stats.input_num = input_num();
+  stats.primary_input_num = primary_input_num();
+  stats.output_num = output_num();
+  stats.primary_output_num = primary_output_num();
+  stats.logic_num = logic_num();
+  stats.expr_num = expr_num();
+  stats.func_num = func_num();
+
+  for ( auto dff_p: mDffList ) {
+    ++ stats.dff_type_num[static_cast<SizeType>(dff_p->type())];
+  }
+
+  for ( auto node_p: mNodeList ) {
+    auto type = node_p->type();
+    ++ stats.node_type_num[static_cast<SizeType>(type)];
+    if ( node_p->is_output() ) {
+      continue;
+    }
+    add_hist(stats.fanout_hist, node_p->fanout_num());
+    if ( node_p->is_logic() ) {
+      if ( type == BnNodeType::Prim ) {
+	++ stats.prim_type_num[static_cast<SizeType>(node_p->primitive_type())];
+      }
+      add_hist(stats.fanin_hist, node_p->fanin_num());
+    }
+  }
+
+  // 論理ノードのリストは change_primitive() や substitute_fanout() の
+  // 後ではトポロジカル順になっているとは限らないので，
+  // 出力から深さ優先探索を行って帰りがけ順に段数を求める．
+  // 入力ノードの段数は 0 となる．
+  SizeType n = node_num();
+  vector<SizeType> level_array(n + 1, 0);
+  vector<bool> mark(n + 1, false);
+  vector<pair<SizeType, bool>> stack;
+  for ( auto id: mOutputList ) {
+    auto src_id = _node_p(id)->output_src();
+    if ( src_id == BNET_NULLID ) {
+      continue;
+    }
+    stack.push_back(make_pair(src_id, false));
+    while ( !stack.empty() ) {
+      auto id1 = stack.back().first;
+      auto done = stack.back().second;
+      stack.pop_back();
+      auto node_p = _node_p(id1);
+      if ( done ) {
+	SizeType level = 0;
+	for ( auto iid: node_p->fanin_id_list() ) {
+	  if ( iid != BNET_NULLID ) {
+	    level = std::max(level, level_array[iid]);
+	  }
+	}
+	level_array[id1] = level + 1;
+	continue;
+      }
+      if ( mark[id1] ) {
+	continue;
+      }
+      mark[id1] = true;
+      if ( !node_p->is_logic() ) {
+	continue;
+      }
+      stack.push_back(make_pair(id1, true));
+      for ( auto iid: node_p->fanin_id_list() ) {
+	if ( iid != BNET_NULLID && !mark[iid] ) {
+	  stack.push_back(make_pair(iid, false));
+	}
+      }
+    }
+    stats.depth = std::max(stats.depth, level_array[src_id]);
+  }
+
+  return stats;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 統計情報を得る．
+BnNetworkStats
+BnNetwork::stats() const
+{
+  ASSERT_COND( mImpl != nullptr );
+
+  return mImpl->stats();
+}
+
+END_NAMESPACE_YM_BNET
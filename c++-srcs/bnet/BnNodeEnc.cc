@@ -1,373 +1,470 @@
-﻿
+
 /// @file BnNodeEnc.cc
 /// @brief BnNodeEnc の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2018 Yusuke Matsunaga
+/// Copyright (C) 2018, 2023 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "ym/BnNodeEnc.h"
 #include "ym/BnNetwork.h"
 #include "ym/BnNode.h"
-#include "ym/Range.h"
-#include "ym/SatSolver.h"
+#include "ym/ClibCell.h"
+#include "Isop.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
 
+//////////////////////////////////////////////////////////////////////
+// クラス BnNodeEnc
+//////////////////////////////////////////////////////////////////////
 
-BEGIN_NAMESPACE_YM
+// @brief ISOP を用いて変換する最大入力数
+const SizeType BnNodeEnc::kMaxIsopInputs = 10;
 
 // @brief コンストラクタ
-// @param[in] solver SATソルバ
-// @param[in] network 対象のネットワーク
-// @param[in] varmap 変数番号のマップ
-BnNodeEnc::BnNodeEnc(SatSolver& solver,
-		     const BnNetwork& network,
-		     const vector<SatLiteral>& varmap) :
-  mSolver(solver),
-  mEnc(mSolver),
-  mNetwork(network),
-  mVarMap(varmap)
+BnNodeEnc::BnNodeEnc(
+  SatSolver& solver,
+  const BnNetwork& network
+) : mSolver{solver},
+    mNetwork{network}
 {
 }
 
-// @brief デストラクタ
-BnNodeEnc::~BnNodeEnc()
+// @brief ノードの出力を表すリテラルを返す．
+SatLiteral
+BnNodeEnc::make_cnf(
+  const BnNode& node
+)
 {
+  return make_cnf(node.id());
 }
 
-// @brief ノードの入出力の関係を表すCNF式を作る．
-// @param[in] node 対象のノード
-// @param[in] var_map 変数マップ
-void
-BnNodeEnc::make_cnf(const BnNode& node)
+// @brief ノードの出力を表すリテラルを返す．
+SatLiteral
+BnNodeEnc::make_cnf(
+  SizeType node_id
+)
 {
-  SatLiteral olit = lit(node.id());
-  int ni = node.fanin_num();
-  vector<SatLiteral> ilit_array(ni);
-  for ( auto i: Range(ni) ) {
-    ilit_array[i] = lit(node.fanin_id(i));
+  if ( is_encoded(node_id) ) {
+    return mLitArray[node_id];
   }
-  switch ( node.type() ) {
-  case BnNodeType::Input:
-    // なにもしない．
-    break;
-
-  case BnNodeType::C0:
-    make_zero(olit);
-    break;
-
-  case BnNodeType::C1:
-    make_one(olit);
-    break;
-
-  case BnNodeType::Buff:
-    make_buff(olit, ilit_array[0]);
-    break;
 
-  case BnNodeType::Not:
-    make_not(olit, ilit_array[0]);
-    break;
-
-  case BnNodeType::And:
-    make_and(olit, ilit_array);
-    break;
-
-  case BnNodeType::Nand:
-    make_and(~olit, ilit_array);
-    break;
-
-  case BnNodeType::Or:
-    make_or(olit, ilit_array);
-    break;
-
-  case BnNodeType::Nor:
-    make_or(~olit, ilit_array);
-    break;
-
-  case BnNodeType::Xor:
-    make_xor(olit, ilit_array);
-    break;
-
-  case BnNodeType::Xnor:
-    make_xor(~olit, ilit_array);
-    break;
-
-  case BnNodeType::Expr:
-    {
-      const Expr& expr = mNetwork.expr(node.expr_id());
-      if ( expr.is_zero() ) {
-	make_zero(olit);
-      }
-      else if ( expr.is_one() ) {
-	make_one(olit);
-      }
-      else if ( expr.is_posi_literal() ) {
-	VarId var = expr.varid();
-	SatLiteral ilit = ilit_array[var.val()];
-	make_buff(olit, ilit);
-      }
-      else if ( expr.is_nega_literal() ) {
-	VarId var = expr.varid();
-	SatLiteral ilit = ilit_array[var.val()];
-	make_not(olit, ilit);
-      }
-      else {
-	ASSERT_COND( expr.is_op() );
-	vector<SatLiteral> tmp_ilit_array;
-	tmp_ilit_array.reserve(expr.operand_num());
-	for ( auto& opr: expr.operand_list() ) {
-	  tmp_ilit_array[i] = make_expr(opr, ilit_array);
-	}
+  // ネットワークが変更されている場合があるので配列を伸ばしておく．
+  SizeType n = mNetwork.node_num() + 1;
+  if ( mLitArray.size() < n ) {
+    mLitArray.resize(n);
+    mEncoded.resize(n, false);
+  }
 
-	if ( expr.is_and() ) {
-	  make_and(olit, tmp_ilit_array);
-	}
-	else if ( expr.is_or() ) {
-	  make_or(olit, tmp_ilit_array);
-	}
-	else if ( expr.is_xor() ) {
-	  make_xor(olit, tmp_ilit_array);
-	}
-	else {
-	  ASSERT_NOT_REACHED;
-	}
+  // 再帰を用いずに TFI をたどる．
+  // 全てのファンインが符号化済みになったノードから符号化する．
+  vector<SizeType> stack{node_id};
+  while ( !stack.empty() ) {
+    auto id = stack.back();
+    if ( mEncoded[id] ) {
+      stack.pop_back();
+      continue;
+    }
+    auto node = mNetwork.node(id);
+    bool ready = true;
+    if ( node.is_output() ) {
+      auto src_id = node.output_src().id();
+      if ( !mEncoded[src_id] ) {
+	stack.push_back(src_id);
+	ready = false;
       }
     }
-    break;
-
-  case BnNodeType::TvFunc:
-    {
-      const TvFunc& func = mNetwork.func(node.func_id());
-      int np = 1 << ni;
-      for ( int p: Range(np) ) {
-	vector<SatLiteral> tmp_lits(ni + 1);
-	for ( int i: Range(ni) ) {
-	  SatLiteral ilit = ilit_array[i];
-	  if ( p & (1 << i) ) {
-	    tmp_lits[i] = ~ilit;
-	  }
-	  else {
-	    tmp_lits[i] =  ilit;
-	  }
-	}
-	if ( func.value(p) ) {
-	  tmp_lits[ni] =  olit;
+    else if ( node.is_logic() ) {
+      SizeType ni = node.fanin_num();
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	auto iid = node.fanin_id(i);
+	if ( !mEncoded[iid] ) {
+	  stack.push_back(iid);
+	  ready = false;
 	}
-	else {
-	  tmp_lits[ni] = ~olit;
-	}
-	mSolver.add_clause(tmp_lits);
       }
     }
-    // 未完
-    break;
-
-  default:
-    ASSERT_NOT_REACHED;
-    break;
+    if ( ready ) {
+      stack.pop_back();
+      mLitArray[id] = encode_node(node);
+      mEncoded[id] = true;
+    }
   }
+  return mLitArray[node_id];
 }
 
-// @brief 定数０のCNFを作る．
+// @brief ノードにリテラルを割り当てる．
 void
-BnNodeEnc::make_zero(SatLiteral olit)
+BnNodeEnc::set_lit(
+  SizeType node_id,
+  SatLiteral lit
+)
 {
-  mSolver.add_clause(~olit);
+  if ( is_encoded(node_id) ) {
+    ostringstream buf;
+    buf << "BnNodeEnc::set_lit(" << node_id << "): "
+	<< "the node has already been encoded";
+    throw std::invalid_argument{buf.str()};
+  }
+  SizeType n = mNetwork.node_num() + 1;
+  if ( mLitArray.size() < n ) {
+    mLitArray.resize(n);
+    mEncoded.resize(n, false);
+  }
+  mLitArray[node_id] = lit;
+  mEncoded[node_id] = true;
 }
 
-// @brief 定数1のCNFを作る．
-void
-BnNodeEnc::make_one(SatLiteral olit)
+// @brief 符号化済みのノードのリテラルを返す．
+SatLiteral
+BnNodeEnc::lit(
+  SizeType node_id
+) const
 {
-  mSolver.add_clause( olit);
+  if ( !is_encoded(node_id) ) {
+    ostringstream buf;
+    buf << "BnNodeEnc::lit(" << node_id << "): "
+	<< "the node has not been encoded yet";
+    throw std::invalid_argument{buf.str()};
+  }
+  return mLitArray[node_id];
 }
 
-// @brief BUFFのCNFを作る．
-void
-BnNodeEnc::make_buff(SatLiteral olit,
-		     SatLiteral ilit)
+// @brief ノードの入出力の関係を表す CNF 式を作る．
+SatLiteral
+BnNodeEnc::encode_node(
+  const BnNode& node
+)
 {
-  mEnc.add_buffgate(olit, ilit);
-}
+  if ( node.is_input() ) {
+    return mSolver.new_variable(true);
+  }
+  if ( node.is_output() ) {
+    return mLitArray[node.output_src().id()];
+  }
 
-// @brief NOTのCNFを作る．
-void
-BnNodeEnc::make_not(SatLiteral olit,
-		    SatLiteral ilit)
-{
-  mEnc.add_notgate(olit, ilit);
-}
+  SizeType ni = node.fanin_num();
+  vector<SatLiteral> ilit_array(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    ilit_array[i] = mLitArray[node.fanin_id(i)];
+  }
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    return make_prim(node.primitive_type(), ilit_array);
 
-// @brief AND論理のCNFを作る．
-void
-BnNodeEnc::make_and(SatLiteral olit,
-		    const vector<SatLiteral>& ilit_array)
-{
-  int ni = ilit_array.size();
-  switch ( ni ) {
-  case 2:
-    {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      mEnc.add_andgate( olit, ilit0, ilit1);
+  case BnNodeType::Expr:
+    if ( ni <= kMaxIsopInputs ) {
+      return make_cover(expr_cover(node), ilit_array);
     }
-    break;
+    return make_expr_sub(node.expr(), ilit_array);
 
-  case 3:
-    {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      SatLiteral ilit2 = ilit_array[2];
-      mEnc.add_andgate( olit, ilit0, ilit1, ilit2);
-    }
-    break;
+  case BnNodeType::TvFunc:
+    return make_cover(func_cover(node), ilit_array);
 
-  case 4:
+  case BnNodeType::Bdd:
     {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      SatLiteral ilit2 = ilit_array[2];
-      SatLiteral ilit3 = ilit_array[3];
-      mEnc.add_andgate( olit, ilit0, ilit1, ilit2, ilit3);
+      unordered_map<Bdd, SatLiteral> lit_map;
+      return make_bdd(node.bdd(), ilit_array, lit_map);
     }
-    break;
+
+  case BnNodeType::Cell:
+    return make_expr(node.cell().logic_expr(0), ilit_array);
 
   default:
-    mEnc.add_andgate( olit, ilit_array);
     break;
   }
+  ASSERT_NOT_REACHED;
+  return const_lit();
 }
 
-// @brief OR論理のCNFを作る．
-void
-BnNodeEnc::make_or(SatLiteral olit,
-		   const vector<SatLiteral>& ilit_array)
+// @brief プリミティブ型の CNF 式を作る．
+SatLiteral
+BnNodeEnc::make_prim(
+  PrimType prim_type,
+  const vector<SatLiteral>& ilit_array
+)
 {
-  int ni = ilit_array.size();
-  switch ( ni ) {
-  case 2:
-    {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      mEnc.add_orgate( olit, ilit0, ilit1);
-    }
-    break;
+  switch ( prim_type ) {
+  case PrimType::C0:
+    return ~const_lit();
 
-  case 3:
-    {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      SatLiteral ilit2 = ilit_array[2];
-      mEnc.add_orgate( olit, ilit0, ilit1, ilit2);
-    }
-    break;
+  case PrimType::C1:
+    return const_lit();
 
-  case 4:
-    {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      SatLiteral ilit2 = ilit_array[2];
-      SatLiteral ilit3 = ilit_array[3];
-      mEnc.add_orgate( olit, ilit0, ilit1, ilit2, ilit3);
-    }
-    break;
+  case PrimType::Buff:
+    return ilit_array[0];
 
-  default:
-    mEnc.add_orgate( olit, ilit_array);
-    break;
-  }
-}
+  case PrimType::Not:
+    return ~ilit_array[0];
 
-// @brief XOR論理のCNFを作る．
-void
-BnNodeEnc::make_xor(SatLiteral olit,
-		    const vector<SatLiteral>& ilit_array)
-{
-  int ni = ilit_array.size();
-  switch ( ni ) {
-  case 2:
+  case PrimType::And:
+  case PrimType::Nand:
     {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      mEnc.add_xorgate( olit, ilit0, ilit1);
+      auto olit = mSolver.new_variable(true);
+      make_and(olit, ilit_array);
+      return prim_type == PrimType::Nand ? ~olit : olit;
     }
-    break;
 
-  case 3:
+  case PrimType::Or:
+  case PrimType::Nor:
     {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      SatLiteral ilit2 = ilit_array[2];
-      mEnc.add_xorgate( olit, ilit0, ilit1, ilit2);
+      // ド・モルガンの法則で AND に変換する．
+      vector<SatLiteral> tmp_lits;
+      tmp_lits.reserve(ilit_array.size());
+      for ( auto ilit: ilit_array ) {
+	tmp_lits.push_back(~ilit);
+      }
+      auto olit = mSolver.new_variable(true);
+      make_and(olit, tmp_lits);
+      return prim_type == PrimType::Nor ? olit : ~olit;
     }
-    break;
 
-  case 4:
-    {
-      SatLiteral ilit0 = ilit_array[0];
-      SatLiteral ilit1 = ilit_array[1];
-      SatLiteral ilit2 = ilit_array[2];
-      SatLiteral ilit3 = ilit_array[3];
-      mEnc.add_xorgate( olit, ilit0, ilit1, ilit2, ilit3);
-    }
-    break;
+  case PrimType::Xor:
+    return make_xor(ilit_array);
+
+  case PrimType::Xnor:
+    return ~make_xor(ilit_array);
 
   default:
-    mEnc.add_xorgate( olit, ilit_array);
     break;
   }
+  ASSERT_NOT_REACHED;
+  return const_lit();
 }
 
-// @brief 論理式のCNFを作る．
+// @brief 論理式の CNF 式を作る．
 SatLiteral
-BnNodeEnc::make_expr(const Expr& expr,
-		     const vector<SatLiteral>& ilit_array)
+BnNodeEnc::make_expr(
+  const Expr& expr,
+  const vector<SatLiteral>& ilit_array
+)
 {
-  if ( expr.is_zero() ||
-       expr.is_one() ) {
-    ASSERT_NOT_REACHED;
-    return kSatLiteralX;
+  SizeType ni = ilit_array.size();
+  if ( ni <= kMaxIsopInputs ) {
+    return make_isop(expr.make_tv(ni), ilit_array);
   }
+  return make_expr_sub(expr, ilit_array);
+}
 
+// @brief 論理式の構造に従って CNF 式を作る．
+SatLiteral
+BnNodeEnc::make_expr_sub(
+  const Expr& expr,
+  const vector<SatLiteral>& ilit_array
+)
+{
+  if ( expr.is_zero() ) {
+    return ~const_lit();
+  }
+  if ( expr.is_one() ) {
+    return const_lit();
+  }
   if ( expr.is_posi_literal() ) {
-    VarId var = expr.varid();
-    return ilit_array[var.val()];
+    return ilit_array[expr.varid()];
   }
-
   if ( expr.is_nega_literal() ) {
-    VarId var = expr.varid();
-    return ~ilit_array[var.val()];
+    return ~ilit_array[expr.varid()];
   }
 
   ASSERT_COND( expr.is_op() );
-  vector<SatLiteral> tmp_ilit_array;
-  tmp_ilit_array.reserve(expr.operand_num());
+  vector<SatLiteral> tmp_lits;
+  tmp_lits.reserve(expr.operand_num());
   for ( auto& opr: expr.operand_list() ) {
-    auto ilit = make_expr(opr, ilit_array);
-    tmp_ilit_array.push_back(ilit);
+    tmp_lits.push_back(make_expr_sub(opr, ilit_array));
   }
-
-  SatLiteral olit{mSolver.new_variable()};
   if ( expr.is_and() ) {
-    make_and(olit, tmp_ilit_array);
+    return make_prim(PrimType::And, tmp_lits);
   }
-  else if ( expr.is_or() ) {
-    make_or(olit, tmp_ilit_array);
+  if ( expr.is_or() ) {
+    return make_prim(PrimType::Or, tmp_lits);
   }
-  else if ( expr.is_xor() ) {
-    make_xor(olit, tmp_ilit_array);
+  if ( expr.is_xor() ) {
+    return make_xor(tmp_lits);
   }
-  else {
-    ASSERT_NOT_REACHED;
+  ASSERT_NOT_REACHED;
+  return const_lit();
+}
+
+// @brief 真理値表の ISOP を用いて CNF 式を作る．
+SatLiteral
+BnNodeEnc::make_isop(
+  const TvFunc& func,
+  const vector<SatLiteral>& ilit_array
+)
+{
+  IsopCover cover;
+  cover.mCover1 = isop(func);
+  cover.mCover0 = isop(func, true);
+  return make_cover(cover, ilit_array);
+}
+
+// @brief 論理式型のノードの ISOP を返す．
+const BnNodeEnc::IsopCover&
+BnNodeEnc::expr_cover(
+  const BnNode& node
+)
+{
+  // 同じ論理式が異なる入力数のノードで使われることがあるので
+  // 論理式番号と入力数の組をキーにする．
+  SizeType ni = node.fanin_num();
+  SizeType key = node.expr_id() * (kMaxIsopInputs + 1) + ni;
+  if ( mExprCoverArray.size() <= key ) {
+    mExprCoverArray.resize(std::max(key + 1, mNetwork.expr_num() * (kMaxIsopInputs + 1)));
+  }
+  auto& cover = mExprCoverArray[key];
+  if ( !cover.mValid ) {
+    auto func = node.expr().make_tv(ni);
+    cover.mCover1 = isop(func);
+    cover.mCover0 = isop(func, true);
+    cover.mValid = true;
+  }
+  return cover;
+}
+
+// @brief 真理値表型のノードの ISOP を返す．
+const BnNodeEnc::IsopCover&
+BnNodeEnc::func_cover(
+  const BnNode& node
+)
+{
+  auto func_id = node.func_id();
+  if ( mFuncCoverArray.size() <= func_id ) {
+    mFuncCoverArray.resize(std::max(func_id + 1, mNetwork.func_num()));
+  }
+  auto& cover = mFuncCoverArray[func_id];
+  if ( !cover.mValid ) {
+    const auto& func = node.func();
+    cover.mCover1 = isop(func);
+    cover.mCover0 = isop(func, true);
+    cover.mValid = true;
+  }
+  return cover;
+}
+
+// @brief ISOP から CNF 式を作る．
+SatLiteral
+BnNodeEnc::make_cover(
+  const IsopCover& cover,
+  const vector<SatLiteral>& ilit_array
+)
+{
+  // f の積項 c に対して c -> olit
+  // ~f の積項 c に対して c -> ~olit
+  // の節を作る．
+  if ( cover.mCover1.empty() ) {
+    return ~const_lit();
+  }
+  if ( cover.mCover0.empty() ) {
+    return const_lit();
+  }
+
+  auto olit = mSolver.new_variable(true);
+  for ( auto& cube: cover.mCover1 ) {
+    vector<SatLiteral> tmp_lits;
+    tmp_lits.reserve(cube.size() + 1);
+    for ( auto code: cube ) {
+      auto ilit = ilit_array[code / 2];
+      tmp_lits.push_back(code % 2 ? ilit : ~ilit);
+    }
+    tmp_lits.push_back(olit);
+    mSolver.add_clause(tmp_lits);
+  }
+  for ( auto& cube: cover.mCover0 ) {
+    vector<SatLiteral> tmp_lits;
+    tmp_lits.reserve(cube.size() + 1);
+    for ( auto code: cube ) {
+      auto ilit = ilit_array[code / 2];
+      tmp_lits.push_back(code % 2 ? ilit : ~ilit);
+    }
+    tmp_lits.push_back(~olit);
+    mSolver.add_clause(tmp_lits);
+  }
+  return olit;
+}
+
+// @brief BDD の CNF 式を作る．
+SatLiteral
+BnNodeEnc::make_bdd(
+  const Bdd& bdd,
+  const vector<SatLiteral>& ilit_array,
+  unordered_map<Bdd, SatLiteral>& lit_map
+)
+{
+  if ( bdd.is_zero() ) {
+    return ~const_lit();
+  }
+  if ( bdd.is_one() ) {
+    return const_lit();
+  }
+  if ( lit_map.count(bdd) > 0 ) {
+    return lit_map.at(bdd);
   }
 
+  // olit = x ? f1 : f0
+  auto x = ilit_array[bdd.root_var()];
+  auto f0 = make_bdd(bdd.root_cofactor0(), ilit_array, lit_map);
+  auto f1 = make_bdd(bdd.root_cofactor1(), ilit_array, lit_map);
+  auto olit = mSolver.new_variable(true);
+  mSolver.add_clause(~x, ~f1,  olit);
+  mSolver.add_clause(~x,  f1, ~olit);
+  mSolver.add_clause( x, ~f0,  olit);
+  mSolver.add_clause( x,  f0, ~olit);
+  // 冗長だが伝搬を強めるための節
+  mSolver.add_clause(~f0, ~f1,  olit);
+  mSolver.add_clause( f0,  f1, ~olit);
+  lit_map.emplace(bdd, olit);
   return olit;
 }
 
-// @brief ノードに対応するリテラルを返す．
+// @brief AND の CNF 式を作る．
+void
+BnNodeEnc::make_and(
+  SatLiteral olit,
+  const vector<SatLiteral>& ilit_array
+)
+{
+  vector<SatLiteral> tmp_lits;
+  tmp_lits.reserve(ilit_array.size() + 1);
+  for ( auto ilit: ilit_array ) {
+    mSolver.add_clause(ilit, ~olit);
+    tmp_lits.push_back(~ilit);
+  }
+  tmp_lits.push_back(olit);
+  mSolver.add_clause(tmp_lits);
+}
+
+// @brief XOR の CNF 式を作る．
 SatLiteral
-BnNodeEnc::lit(int node_id)
+BnNodeEnc::make_xor(
+  const vector<SatLiteral>& ilit_array
+)
 {
-  return mVarMap[node_id];
+  SizeType ni = ilit_array.size();
+  ASSERT_COND( ni > 0 );
+  auto olit = ilit_array[0];
+  for ( SizeType i = 1; i < ni; ++ i ) {
+    auto ilit0 = olit;
+    auto ilit1 = ilit_array[i];
+    olit = mSolver.new_variable(true);
+    mSolver.add_clause( ilit0,  ilit1, ~olit);
+    mSolver.add_clause( ilit0, ~ilit1,  olit);
+    mSolver.add_clause(~ilit0,  ilit1,  olit);
+    mSolver.add_clause(~ilit0, ~ilit1, ~olit);
+  }
+  return olit;
+}
+
+// @brief 定数1を表すリテラルを返す．
+SatLiteral
+BnNodeEnc::const_lit()
+{
+  if ( !mHasConst ) {
+    mConstLit = mSolver.new_variable(false);
+    mSolver.add_clause(mConstLit);
+    mHasConst = true;
+  }
+  return mConstLit;
 }
 
-END_NAMESPACE_YM
+END_NAMESPACE_YM_BNET
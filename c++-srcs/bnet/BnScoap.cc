@@ -0,0 +1,789 @@
+
+/// @file BnScoap.cc
+/// @brief BnScoap の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnScoap.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnDff.h"
+#include "ym/BnNode.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include <deque>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// INF を考慮した加算
+inline
+SizeType
+add(
+  SizeType a,
+  SizeType b
+)
+{
+  if ( a == BnScoap::INF || b == BnScoap::INF ) {
+    return BnScoap::INF;
+  }
+  return a + b;
+}
+
+// 真理値表が 1 となるような入力割り当てのうち最小コストのものを求める．
+//
+// tt のサイズは 2^nv で，i 番目のビットが i 番目の変数に対応する．
+// 最上位の変数でコファクターをとり，0 に割り当てる場合，1 に割り当てる場合，
+// 割り当てない(両方のコファクターで 1 となる)場合の最小値を求める．
+SizeType
+tt_cost(
+  const vector<bool>& tt,
+  SizeType nv,
+  const vector<SizeType>& v0_array,
+  const vector<SizeType>& v1_array
+)
+{
+  bool all0 = true;
+  bool all1 = true;
+  for ( auto b: tt ) {
+    if ( b ) {
+      all0 = false;
+    }
+    else {
+      all1 = false;
+    }
+  }
+  if ( all0 ) {
+    return BnScoap::INF;
+  }
+  if ( all1 ) {
+    return 0;
+  }
+
+  ASSERT_COND( nv > 0 );
+  SizeType var = nv - 1;
+  SizeType half = tt.size() / 2;
+  vector<bool> tt0(tt.begin(), tt.begin() + half);
+  vector<bool> tt1(tt.begin() + half, tt.end());
+  vector<bool> tt01(half);
+  for ( SizeType p = 0; p < half; ++ p ) {
+    tt01[p] = tt0[p] && tt1[p];
+  }
+  auto c0 = add(v0_array[var], tt_cost(tt0, var, v0_array, v1_array));
+  auto c1 = add(v1_array[var], tt_cost(tt1, var, v0_array, v1_array));
+  auto c01 = tt_cost(tt01, var, v0_array, v1_array);
+  return std::min(std::min(c0, c1), c01);
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnScoap
+//////////////////////////////////////////////////////////////////////
+
+const SizeType BnScoap::INF = static_cast<SizeType>(-1);
+
+const SizeType BnScoap::kMaxEnumInputs = 10;
+
+// @brief コンストラクタ
+BnScoap::BnScoap(
+  const BnNetwork& network
+) : mNetwork{network}
+{
+  calc();
+}
+
+// @brief 全てのノードの値を計算し直す．
+void
+BnScoap::calc()
+{
+  resize();
+  make_order();
+  calc_cc();
+  calc_co();
+  for ( SizeType id = 1; id <= mNetwork.node_num(); ++ id ) {
+    record_fanins(mNetwork.node(id));
+  }
+}
+
+// @brief 変更のあったノードから影響のある部分を再計算する．
+void
+BnScoap::update(
+  const vector<BnNode>& node_list
+)
+{
+  resize();
+
+  SizeType n = mNetwork.node_num();
+  // これ以上の回数の再計算が必要な場合は全体を計算し直す．
+  SizeType limit = n * 4 + 16;
+
+  // 可制御性の再計算
+  vector<bool> in_queue(n + 1, false);
+  std::deque<SizeType> queue;
+  for ( auto& node: node_list ) {
+    auto id = node.id();
+    if ( !in_queue[id] ) {
+      in_queue[id] = true;
+      queue.push_back(id);
+    }
+  }
+  vector<SizeType> changed_list;
+  SizeType count = 0;
+  while ( !queue.empty() ) {
+    auto id = queue.front();
+    queue.pop_front();
+    in_queue[id] = false;
+    ++ count;
+    if ( count > limit ) {
+      calc();
+      return;
+    }
+    auto node = mNetwork.node(id);
+    if ( !update_cc(node) ) {
+      continue;
+    }
+    changed_list.push_back(id);
+    for ( SizeType i = 0; i < node.fanout_num(); ++ i ) {
+      auto oid = node.fanout(i).id();
+      if ( !in_queue[oid] ) {
+	in_queue[oid] = true;
+	queue.push_back(oid);
+      }
+    }
+    if ( node.is_data_in() || node.is_clear() || node.is_preset() ) {
+      auto dff = mNetwork.dff(node.dff_id());
+      auto oid = dff.data_out().id();
+      if ( !in_queue[oid] ) {
+	in_queue[oid] = true;
+	queue.push_back(oid);
+      }
+    }
+  }
+
+  // 可観測性の再計算
+  // 変更されたノードの変更前と変更後のファンインと，可制御性の変化した
+  // ノードのファンアウトのファンイン(兄弟)が対象となる．
+  // 変更前のファンインはファンアウトを失って可観測性が変わることがある．
+  vector<SizeType> seed_list;
+  for ( auto& node: node_list ) {
+    seed_list.push_back(node.id());
+    for ( auto iid: mFaninArray[node.id()] ) {
+      seed_list.push_back(iid);
+    }
+    record_fanins(node);
+    for ( auto iid: mFaninArray[node.id()] ) {
+      seed_list.push_back(iid);
+    }
+  }
+  for ( auto id: changed_list ) {
+    auto node = mNetwork.node(id);
+    for ( SizeType i = 0; i < node.fanout_num(); ++ i ) {
+      auto onode = node.fanout(i);
+      for ( SizeType j = 0; j < onode.fanin_num(); ++ j ) {
+	seed_list.push_back(onode.fanin_id(j));
+      }
+    }
+    if ( node.is_data_in() ) {
+      // クロック/クリア/プリセットの可観測性は data_in の可制御性に依存する．
+      auto dff = mNetwork.dff(node.dff_id());
+      for ( auto& node1: {dff.clock(), dff.clear(), dff.preset()} ) {
+	if ( node1.is_valid() ) {
+	  seed_list.push_back(node1.id());
+	}
+      }
+    }
+  }
+  for ( auto id: seed_list ) {
+    if ( id != BNET_NULLID && !in_queue[id] ) {
+      in_queue[id] = true;
+      queue.push_back(id);
+    }
+  }
+  count = 0;
+  while ( !queue.empty() ) {
+    auto id = queue.front();
+    queue.pop_front();
+    in_queue[id] = false;
+    ++ count;
+    if ( count > limit ) {
+      calc();
+      return;
+    }
+    auto node = mNetwork.node(id);
+    if ( !update_co(node) ) {
+      continue;
+    }
+    vector<SizeType> next_list;
+    if ( node.is_output() ) {
+      if ( node.output_src().is_valid() ) {
+	next_list.push_back(node.output_src().id());
+      }
+    }
+    else if ( node.is_logic() ) {
+      for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+	next_list.push_back(node.fanin_id(i));
+      }
+    }
+    else if ( node.is_data_out() ) {
+      auto dff = mNetwork.dff(node.dff_id());
+      if ( !dff.is_cell() ) {
+	for ( auto& node1: {dff.data_in(), dff.clock(), dff.clear(), dff.preset()} ) {
+	  if ( node1.is_valid() ) {
+	    next_list.push_back(node1.id());
+	  }
+	}
+      }
+    }
+    for ( auto id1: next_list ) {
+      if ( id1 != BNET_NULLID && !in_queue[id1] ) {
+	in_queue[id1] = true;
+	queue.push_back(id1);
+      }
+    }
+  }
+}
+
+// @brief 配列のサイズをネットワークに合わせる．
+void
+BnScoap::resize()
+{
+  SizeType n = mNetwork.node_num() + 1;
+  mCC0.resize(n, INF);
+  mCC1.resize(n, INF);
+  mCO.resize(n, INF);
+  mSC0.resize(n, INF);
+  mSC1.resize(n, INF);
+  mSO.resize(n, INF);
+  mFaninArray.resize(n);
+}
+
+// @brief ノードのファンインを記録する．
+void
+BnScoap::record_fanins(
+  const BnNode& node
+)
+{
+  auto& fanin_list = mFaninArray[node.id()];
+  fanin_list.clear();
+  if ( node.is_output() ) {
+    auto src = node.output_src();
+    if ( src.is_valid() ) {
+      fanin_list.push_back(src.id());
+    }
+  }
+  else if ( node.is_logic() ) {
+    fanin_list.reserve(node.fanin_num());
+    for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+      fanin_list.push_back(node.fanin_id(i));
+    }
+  }
+}
+
+// @brief 全ノードのトポロジカル順を求める．
+void
+BnScoap::make_order()
+{
+  SizeType n = mNetwork.node_num();
+  mOrder.clear();
+  mOrder.reserve(n);
+  vector<bool> mark(n + 1, false);
+  vector<pair<SizeType, bool>> stack;
+  for ( SizeType root = 1; root <= n; ++ root ) {
+    if ( mark[root] ) {
+      continue;
+    }
+    stack.push_back(make_pair(root, false));
+    while ( !stack.empty() ) {
+      auto id = stack.back().first;
+      auto done = stack.back().second;
+      stack.pop_back();
+      if ( done ) {
+	mOrder.push_back(id);
+	continue;
+      }
+      if ( mark[id] ) {
+	continue;
+      }
+      mark[id] = true;
+      stack.push_back(make_pair(id, true));
+      auto node = mNetwork.node(id);
+      if ( node.is_output() ) {
+	auto src = node.output_src();
+	if ( src.is_valid() && !mark[src.id()] ) {
+	  stack.push_back(make_pair(src.id(), false));
+	}
+      }
+      else if ( node.is_logic() ) {
+	for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+	  auto iid = node.fanin_id(i);
+	  if ( iid != BNET_NULLID && !mark[iid] ) {
+	    stack.push_back(make_pair(iid, false));
+	  }
+	}
+      }
+    }
+  }
+}
+
+// @brief 可制御性をまとめて計算する．
+void
+BnScoap::calc_cc()
+{
+  std::fill(mCC0.begin(), mCC0.end(), INF);
+  std::fill(mCC1.begin(), mCC1.end(), INF);
+  std::fill(mSC0.begin(), mSC0.end(), INF);
+  std::fill(mSC1.begin(), mSC1.end(), INF);
+
+  // DFF を介したループがあるので変化がなくなるまで繰り返す．
+  // 値は単調に減少するので必ず収束する．
+  bool changed = true;
+  while ( changed ) {
+    changed = false;
+    for ( auto id: mOrder ) {
+      if ( update_cc(mNetwork.node(id)) ) {
+	changed = true;
+      }
+    }
+  }
+}
+
+// @brief 可観測性をまとめて計算する．
+void
+BnScoap::calc_co()
+{
+  std::fill(mCO.begin(), mCO.end(), INF);
+  std::fill(mSO.begin(), mSO.end(), INF);
+
+  bool changed = true;
+  while ( changed ) {
+    changed = false;
+    for ( auto p = mOrder.rbegin(); p != mOrder.rend(); ++ p ) {
+      if ( update_co(mNetwork.node(*p)) ) {
+	changed = true;
+      }
+    }
+  }
+}
+
+// @brief ノードの可制御性を計算する．
+bool
+BnScoap::update_cc(
+  const BnNode& node
+)
+{
+  SizeType c0 = INF;
+  SizeType c1 = INF;
+  SizeType s0 = INF;
+  SizeType s1 = INF;
+  if ( node.is_input() ) {
+    bool is_pi = true;
+    if ( node.is_data_out() ) {
+      auto dff = mNetwork.dff(node.dff_id());
+      if ( !dff.is_cell() ) {
+	is_pi = false;
+	auto d_id = dff.data_in().id();
+	c0 = mCC0[d_id];
+	c1 = mCC1[d_id];
+	s0 = add(mSC0[d_id], 1);
+	s1 = add(mSC1[d_id], 1);
+	auto clear = dff.clear();
+	if ( clear.is_valid() ) {
+	  c0 = std::min(c0, mCC1[clear.id()]);
+	  s0 = std::min(s0, add(mSC1[clear.id()], 1));
+	}
+	auto preset = dff.preset();
+	if ( preset.is_valid() ) {
+	  c1 = std::min(c1, mCC1[preset.id()]);
+	  s1 = std::min(s1, add(mSC1[preset.id()], 1));
+	}
+      }
+    }
+    if ( is_pi ) {
+      // 外部入力とセル型のDFFの出力
+      c0 = 1;
+      c1 = 1;
+      s0 = 0;
+      s1 = 0;
+    }
+  }
+  else if ( node.is_output() ) {
+    auto src = node.output_src();
+    if ( src.is_valid() ) {
+      c0 = mCC0[src.id()];
+      c1 = mCC1[src.id()];
+      s0 = mSC0[src.id()];
+      s1 = mSC1[src.id()];
+    }
+  }
+  else if ( node.is_logic() ) {
+    calc_logic_cc(node, mCC0, mCC1, 1, c0, c1);
+    calc_logic_cc(node, mSC0, mSC1, 0, s0, s1);
+  }
+
+  auto id = node.id();
+  if ( mCC0[id] == c0 && mCC1[id] == c1 && mSC0[id] == s0 && mSC1[id] == s1 ) {
+    return false;
+  }
+  mCC0[id] = c0;
+  mCC1[id] = c1;
+  mSC0[id] = s0;
+  mSC1[id] = s1;
+  return true;
+}
+
+// @brief ノードの可観測性を計算する．
+bool
+BnScoap::update_co(
+  const BnNode& node
+)
+{
+  SizeType o = INF;
+  SizeType so = INF;
+  if ( node.is_output() ) {
+    if ( node.is_port_output() || node.is_cell_input() ) {
+      // 外部出力とセル型のDFFの入力
+      o = 0;
+      so = 0;
+    }
+    else if ( node.is_data_in() || node.is_clock() ||
+	      node.is_clear() || node.is_preset() ) {
+      auto dff = mNetwork.dff(node.dff_id());
+      auto q_id = dff.data_out().id();
+      auto d_id = dff.data_in().id();
+      if ( node.is_data_in() ) {
+	o = mCO[q_id];
+	so = add(mSO[q_id], 1);
+      }
+      else if ( node.is_clear() ) {
+	// クリアの効果を観測するには data_in を 1 にしておく必要がある．
+	o = add(mCO[q_id], mCC1[d_id]);
+	so = add(add(mSO[q_id], mSC1[d_id]), 1);
+      }
+      else if ( node.is_preset() ) {
+	o = add(mCO[q_id], mCC0[d_id]);
+	so = add(add(mSO[q_id], mSC0[d_id]), 1);
+      }
+      else {
+	o = add(mCO[q_id], std::min(mCC0[d_id], mCC1[d_id]));
+	so = add(add(mSO[q_id], std::min(mSC0[d_id], mSC1[d_id])), 1);
+      }
+    }
+  }
+  else {
+    auto id = node.id();
+    for ( SizeType i = 0; i < node.fanout_num(); ++ i ) {
+      auto onode = node.fanout(i);
+      if ( onode.is_output() ) {
+	o = std::min(o, mCO[onode.id()]);
+	so = std::min(so, mSO[onode.id()]);
+	continue;
+      }
+      for ( SizeType ipos = 0; ipos < onode.fanin_num(); ++ ipos ) {
+	if ( onode.fanin_id(ipos) == id ) {
+	  o = std::min(o, calc_input_co(onode, ipos, mCC0, mCC1, mCO, 1));
+	  so = std::min(so, calc_input_co(onode, ipos, mSC0, mSC1, mSO, 0));
+	}
+      }
+    }
+  }
+
+  auto id = node.id();
+  if ( mCO[id] == o && mSO[id] == so ) {
+    return false;
+  }
+  mCO[id] = o;
+  mSO[id] = so;
+  return true;
+}
+
+// @brief 論理ノードの可制御性を計算する．
+void
+BnScoap::calc_logic_cc(
+  const BnNode& node,
+  const vector<SizeType>& c0_array,
+  const vector<SizeType>& c1_array,
+  SizeType delta,
+  SizeType& c0,
+  SizeType& c1
+)
+{
+  SizeType ni = node.fanin_num();
+  c0 = INF;
+  c1 = INF;
+  bool inv = false;
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    switch ( node.primitive_type() ) {
+    case PrimType::None:
+      return;
+
+    case PrimType::C0:
+      c0 = 0;
+      return;
+
+    case PrimType::C1:
+      c1 = 0;
+      return;
+
+    case PrimType::Not:
+      inv = true;
+      // わざと次に続く
+    case PrimType::Buff:
+      {
+	auto iid = node.fanin_id(0);
+	c0 = add(c0_array[iid], delta);
+	c1 = add(c1_array[iid], delta);
+      }
+      break;
+
+    case PrimType::Nand:
+      inv = true;
+      // わざと次に続く
+    case PrimType::And:
+      c1 = 0;
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	auto iid = node.fanin_id(i);
+	c0 = std::min(c0, c0_array[iid]);
+	c1 = add(c1, c1_array[iid]);
+      }
+      c0 = add(c0, delta);
+      c1 = add(c1, delta);
+      break;
+
+    case PrimType::Nor:
+      inv = true;
+      // わざと次に続く
+    case PrimType::Or:
+      c0 = 0;
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	auto iid = node.fanin_id(i);
+	c0 = add(c0, c0_array[iid]);
+	c1 = std::min(c1, c1_array[iid]);
+      }
+      c0 = add(c0, delta);
+      c1 = add(c1, delta);
+      break;
+
+    case PrimType::Xnor:
+      inv = true;
+      // わざと次に続く
+    case PrimType::Xor:
+      {
+	// パリティごとの最小コストを求める．
+	SizeType e0 = 0;
+	SizeType e1 = INF;
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  auto iid = node.fanin_id(i);
+	  auto i0 = c0_array[iid];
+	  auto i1 = c1_array[iid];
+	  auto ne0 = std::min(add(e0, i0), add(e1, i1));
+	  auto ne1 = std::min(add(e0, i1), add(e1, i0));
+	  e0 = ne0;
+	  e1 = ne1;
+	}
+	c0 = add(e0, delta);
+	c1 = add(e1, delta);
+      }
+      break;
+    }
+    break;
+
+  case BnNodeType::Expr:
+  case BnNodeType::TvFunc:
+    {
+      auto tt_p = truth_table(node);
+      if ( tt_p != nullptr ) {
+	vector<SizeType> v0_array(ni);
+	vector<SizeType> v1_array(ni);
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  auto iid = node.fanin_id(i);
+	  v0_array[i] = c0_array[iid];
+	  v1_array[i] = c1_array[iid];
+	}
+	auto& tt = *tt_p;
+	vector<bool> ntt(tt.size());
+	for ( SizeType p = 0; p < tt.size(); ++ p ) {
+	  ntt[p] = !tt[p];
+	}
+	c0 = add(tt_cost(ntt, ni, v0_array, v1_array), delta);
+	c1 = add(tt_cost(tt, ni, v0_array, v1_array), delta);
+	break;
+      }
+    }
+    // わざと次に続く
+
+  default:
+    // 全ての入力をいずれかの値に設定する必要があるとみなす．
+    c0 = 0;
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto iid = node.fanin_id(i);
+      c0 = add(c0, std::min(c0_array[iid], c1_array[iid]));
+    }
+    c0 = add(c0, delta);
+    c1 = c0;
+    break;
+  }
+  if ( inv ) {
+    std::swap(c0, c1);
+  }
+}
+
+// @brief 論理ノードの入力の可観測性を計算する．
+SizeType
+BnScoap::calc_input_co(
+  const BnNode& node,
+  SizeType ipos,
+  const vector<SizeType>& c0_array,
+  const vector<SizeType>& c1_array,
+  const vector<SizeType>& o_array,
+  SizeType delta
+)
+{
+  auto o = add(o_array[node.id()], delta);
+  if ( o == INF ) {
+    return INF;
+  }
+
+  SizeType ni = node.fanin_num();
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    switch ( node.primitive_type() ) {
+    case PrimType::None:
+    case PrimType::C0:
+    case PrimType::C1:
+      return INF;
+
+    case PrimType::Buff:
+    case PrimType::Not:
+      return o;
+
+    case PrimType::And:
+    case PrimType::Nand:
+      // 他の入力を非制御値(1)にする．
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	if ( i != ipos ) {
+	  o = add(o, c1_array[node.fanin_id(i)]);
+	}
+      }
+      return o;
+
+    case PrimType::Or:
+    case PrimType::Nor:
+      // 他の入力を非制御値(0)にする．
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	if ( i != ipos ) {
+	  o = add(o, c0_array[node.fanin_id(i)]);
+	}
+      }
+      return o;
+
+    case PrimType::Xor:
+    case PrimType::Xnor:
+      break;
+    }
+    break;
+
+  case BnNodeType::Expr:
+  case BnNodeType::TvFunc:
+    {
+      auto tt_p = truth_table(node);
+      if ( tt_p == nullptr ) {
+	break;
+      }
+      // ipos 番目の入力に関するブール微分を求める．
+      auto& tt = *tt_p;
+      SizeType nv = ni - 1;
+      vector<SizeType> v0_array;
+      vector<SizeType> v1_array;
+      v0_array.reserve(nv);
+      v1_array.reserve(nv);
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	if ( i != ipos ) {
+	  auto iid = node.fanin_id(i);
+	  v0_array.push_back(c0_array[iid]);
+	  v1_array.push_back(c1_array[iid]);
+	}
+      }
+      SizeType nexp = 1U << nv;
+      SizeType lmask = (1U << ipos) - 1;
+      vector<bool> diff(nexp);
+      for ( SizeType q = 0; q < nexp; ++ q ) {
+	SizeType p0 = ((q & ~lmask) << 1) | (q & lmask);
+	SizeType p1 = p0 | (1U << ipos);
+	diff[q] = tt[p0] != tt[p1];
+      }
+      return add(o, tt_cost(diff, nv, v0_array, v1_array));
+    }
+
+  default:
+    break;
+  }
+
+  // 他の全ての入力をいずれかの値に設定する必要があるとみなす．
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    if ( i != ipos ) {
+      auto iid = node.fanin_id(i);
+      o = add(o, std::min(c0_array[iid], c1_array[iid]));
+    }
+  }
+  return o;
+}
+
+// @brief 真理値表を得る．
+const vector<bool>*
+BnScoap::truth_table(
+  const BnNode& node
+)
+{
+  SizeType ni = node.fanin_num();
+  if ( ni > kMaxEnumInputs ) {
+    return nullptr;
+  }
+
+  vector<bool>* tt_p = nullptr;
+  TvFunc tv;
+  if ( node.type() == BnNodeType::Expr ) {
+    // 同じ論理式が異なる入力数のノードで使われることがあるので
+    // 論理式番号と入力数の組をキーにする．
+    SizeType key = node.expr_id() * (kMaxEnumInputs + 1) + ni;
+    if ( mExprTvArray.size() <= key ) {
+      mExprTvArray.resize(std::max(key + 1, mNetwork.expr_num() * (kMaxEnumInputs + 1)));
+    }
+    tt_p = &mExprTvArray[key];
+    if ( tt_p->empty() ) {
+      tv = node.expr().make_tv(ni);
+    }
+  }
+  else if ( node.type() == BnNodeType::TvFunc ) {
+    if ( node.func().input_num() != ni ) {
+      return nullptr;
+    }
+    auto func_id = node.func_id();
+    if ( mFuncTvArray.size() <= func_id ) {
+      mFuncTvArray.resize(mNetwork.func_num());
+    }
+    tt_p = &mFuncTvArray[func_id];
+    if ( tt_p->empty() ) {
+      tv = node.func();
+    }
+  }
+  else {
+    return nullptr;
+  }
+
+  if ( tt_p->empty() ) {
+    SizeType nexp = 1U << ni;
+    tt_p->resize(nexp);
+    for ( SizeType p = 0; p < nexp; ++ p ) {
+      (*tt_p)[p] = tv.value(p) != 0;
+    }
+  }
+  return tt_p;
+}
+
+END_NAMESPACE_YM_BNET
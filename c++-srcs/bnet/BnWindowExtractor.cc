@@ -0,0 +1,208 @@
+
+/// @file BnWindowExtractor.cc
+/// @brief BnWindowExtractor の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnWindowExtractor.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnModifier.h"
+#include "ym/BnNodeMap.h"
+#include "ym/BnPort.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnWindowExtractor
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+BnWindowExtractor::BnWindowExtractor(
+  const BnNetwork& network,
+  SizeType tfi_level,
+  SizeType tfo_level
+) : mNetwork{network},
+    mTfiLevel{tfi_level},
+    mTfoLevel{tfo_level}
+{
+}
+
+// @brief ウィンドウを切り出す．
+BnNetwork
+BnWindowExtractor::extract(
+  BnNode pivot,
+  vector<BnNode>& input_list,
+  vector<BnNode>& output_list
+)
+{
+  ASSERT_COND( pivot.is_logic() );
+
+  new_stamp();
+  mNodeList.clear();
+  mLeafList.clear();
+
+  // TFI を幅優先で tfi_level 段たどる．
+  add_node(pivot.id());
+  vector<SizeType> frontier{pivot.id()};
+  for ( SizeType level = 0; level < mTfiLevel; ++ level ) {
+    vector<SizeType> next_frontier;
+    for ( auto id: frontier ) {
+      auto node = mNetwork.node(id);
+      for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+	auto iid = node.fanin_id(i);
+	if ( in_window(iid) ) {
+	  continue;
+	}
+	if ( mNetwork.node(iid).is_logic() ) {
+	  add_node(iid);
+	  next_frontier.push_back(iid);
+	}
+      }
+    }
+    frontier.swap(next_frontier);
+  }
+
+  // ウィンドウ内のノードのファンインのうちウィンドウ外のものが入力となる．
+  for ( auto id: mNodeList ) {
+    auto node = mNetwork.node(id);
+    for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+      auto iid = node.fanin_id(i);
+      ASSERT_COND( iid != BNET_NULLID );
+      if ( !in_window(iid) ) {
+	add_leaf(iid);
+      }
+    }
+  }
+
+  // 再収斂する TFO を tfo_level 段たどる．
+  // 新たな入力が増えないように全てのファンインがウィンドウ内か
+  // 入力であるノードのみを加える．
+  frontier.clear();
+  frontier.push_back(pivot.id());
+  for ( SizeType level = 0; level < mTfoLevel; ++ level ) {
+    vector<SizeType> next_frontier;
+    for ( auto id: frontier ) {
+      auto node = mNetwork.node(id);
+      for ( SizeType i = 0; i < node.fanout_num(); ++ i ) {
+	auto onode = node.fanout(i);
+	auto oid = onode.id();
+	if ( !onode.is_logic() || in_window(oid) || is_leaf(oid) ) {
+	  continue;
+	}
+	bool ok = true;
+	for ( SizeType j = 0; j < onode.fanin_num(); ++ j ) {
+	  auto iid = onode.fanin_id(j);
+	  if ( !in_window(iid) && !is_leaf(iid) ) {
+	    ok = false;
+	    break;
+	  }
+	}
+	if ( ok ) {
+	  add_node(oid);
+	  next_frontier.push_back(oid);
+	}
+      }
+    }
+    frontier.swap(next_frontier);
+  }
+
+  // ウィンドウ内のノードをトポロジカル順に並べる．
+  vector<SizeType> order_list;
+  order_list.reserve(mNodeList.size());
+  vector<pair<SizeType, bool>> stack;
+  for ( auto root: mNodeList ) {
+    if ( mOrderMark[root] == mStamp ) {
+      continue;
+    }
+    stack.push_back(make_pair(root, false));
+    while ( !stack.empty() ) {
+      auto id = stack.back().first;
+      auto done = stack.back().second;
+      stack.pop_back();
+      if ( done ) {
+	order_list.push_back(id);
+	continue;
+      }
+      if ( mOrderMark[id] == mStamp ) {
+	continue;
+      }
+      mOrderMark[id] = mStamp;
+      stack.push_back(make_pair(id, true));
+      auto node = mNetwork.node(id);
+      for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+	auto iid = node.fanin_id(i);
+	if ( in_window(iid) && mOrderMark[iid] != mStamp ) {
+	  stack.push_back(make_pair(iid, false));
+	}
+      }
+    }
+  }
+
+  // 部分回路を作る．
+  BnModifier mod;
+  mod.set_library(mNetwork.library());
+  BnNodeMap node_map;
+
+  input_list.clear();
+  input_list.reserve(mLeafList.size());
+  for ( auto id: mLeafList ) {
+    auto src_node = mNetwork.node(id);
+    auto dst_port = mod.new_input_port(src_node.name());
+    auto dst_node = dst_port.bit(0);
+    node_map.put(id, dst_node);
+    input_list.push_back(src_node);
+  }
+
+  output_list.clear();
+  for ( auto id: order_list ) {
+    auto src_node = mNetwork.node(id);
+    auto dst_node = mod.copy_logic(src_node, node_map);
+    node_map.put(id, dst_node);
+
+    // ウィンドウ外にファンアウトを持つノードが出力となる．
+    bool external = false;
+    for ( SizeType i = 0; i < src_node.fanout_num(); ++ i ) {
+      if ( !in_window(src_node.fanout(i).id()) ) {
+	external = true;
+	break;
+      }
+    }
+    if ( external ) {
+      output_list.push_back(src_node);
+    }
+  }
+
+  for ( auto& src_node: output_list ) {
+    auto dst_inode = node_map.get(src_node.id());
+    auto dst_port = mod.new_output_port(src_node.name());
+    auto dst_node = dst_port.bit(0);
+    mod.set_output_src(dst_node, dst_inode);
+  }
+
+  return BnNetwork{std::move(mod)};
+}
+
+// @brief 世代番号を進める．
+void
+BnWindowExtractor::new_stamp()
+{
+  SizeType n = mNetwork.node_num() + 1;
+  if ( mWindowMark.size() < n ) {
+    mWindowMark.resize(n, 0);
+    mLeafMark.resize(n, 0);
+    mOrderMark.resize(n, 0);
+  }
+  ++ mStamp;
+  if ( mStamp == 0 ) {
+    // 桁あふれしたのでクリアする．
+    std::fill(mWindowMark.begin(), mWindowMark.end(), 0);
+    std::fill(mLeafMark.begin(), mLeafMark.end(), 0);
+    std::fill(mOrderMark.begin(), mOrderMark.end(), 0);
+    mStamp = 1;
+  }
+}
+
+END_NAMESPACE_YM_BNET
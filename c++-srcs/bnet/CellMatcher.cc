@@ -0,0 +1,175 @@
+
+/// @file CellMatcher.cc
+/// @brief CellMatcher の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CellMatcher.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/ClibCell.h"
+#include "ym/Expr.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// 変数の射影の真理値表
+const PackedVal PROJ_TABLE[] = {
+  0xAAAAAAAAAAAAAAAAUL,
+  0xCCCCCCCCCCCCCCCCUL,
+  0xF0F0F0F0F0F0F0F0UL,
+  0xFF00FF00FF00FF00UL,
+  0xFFFF0000FFFF0000UL,
+  0xFFFFFFFF00000000UL
+};
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス CellMatcher
+//////////////////////////////////////////////////////////////////////
+
+// @brief 変数の射影の真理値表を返す．
+PackedVal
+CellMatcher::proj(
+  SizeType var
+)
+{
+  ASSERT_COND( var < 6 );
+  return PROJ_TABLE[var];
+}
+
+// @brief コンストラクタ
+CellMatcher::CellMatcher(
+  const ClibCellLibrary& library,
+  SizeType max_ni
+) : mMatchTable(max_ni + 1)
+{
+  ASSERT_COND( max_ni <= 6 );
+
+  // 単一出力の論理セルの関数を求める．
+  vector<pair<SizeType, PackedVal>> cell_list;
+  for ( SizeType id = 0; id < library.cell_num(); ++ id ) {
+    auto cell = library.cell(id);
+    if ( !cell.is_logic() ||
+	 cell.output_num() != 1 ||
+	 cell.inout_num() > 0 ||
+	 cell.has_tristate(0) ) {
+      continue;
+    }
+    SizeType ni = cell.input_num();
+    if ( ni > max_ni ) {
+      continue;
+    }
+    vector<PackedVal> ival_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      ival_list[i] = PROJ_TABLE[i];
+    }
+    auto func = Simulator::calc_expr(cell.logic_expr(0), ival_list);
+    cell_list.push_back(make_pair(id, func));
+
+    // 最小面積のインバーターを探す．
+    if ( ni == 1 && func == ~PROJ_TABLE[0] ) {
+      double area = cell.area().value();
+      if ( mInvCell == CLIB_NULLID || mInvArea > area ) {
+	mInvCell = id;
+	mInvArea = area;
+      }
+    }
+  }
+
+  for ( auto& p: cell_list ) {
+    reg_cell(library.cell(p.first), p.second);
+  }
+}
+
+// @brief 関数に一致するセルのリストを返す．
+const vector<CellMatch>*
+CellMatcher::find(
+  SizeType ni,
+  PackedVal tt
+) const
+{
+  if ( ni >= mMatchTable.size() ) {
+    return nullptr;
+  }
+  auto& table = mMatchTable[ni];
+  auto p = table.find(tt);
+  if ( p == table.end() ) {
+    return nullptr;
+  }
+  return &p->second;
+}
+
+// @brief セルの NPN 変換を列挙して登録する．
+void
+CellMatcher::reg_cell(
+  const ClibCell& cell,
+  PackedVal func
+)
+{
+  SizeType ni = cell.input_num();
+  double cell_area = cell.area().value();
+  auto& table = mMatchTable[ni];
+  bool has_inv = mInvCell != CLIB_NULLID;
+  SizeType inv_num = has_inv ? (1U << ni) : 1;
+  SizeType oinv_num = has_inv ? 2 : 1;
+
+  // perm[i] はセルの i 番目の入力に接続するカットの葉の位置
+  vector<SizeType> perm(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    perm[i] = i;
+  }
+  do {
+    for ( std::uint32_t iinv = 0; iinv < inv_num; ++ iinv ) {
+      // カットの関数を求める．
+      PackedVal tt = 0UL;
+      for ( SizeType p = 0; p < 64; ++ p ) {
+	SizeType q = 0;
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  auto pos = perm[i];
+	  if ( ((p >> pos) ^ (iinv >> pos)) & 1U ) {
+	    q |= (1U << i);
+	  }
+	}
+	if ( (func >> q) & 1UL ) {
+	  tt |= (1UL << p);
+	}
+      }
+      SizeType inum = 0;
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	if ( (iinv >> i) & 1U ) {
+	  ++ inum;
+	}
+      }
+      for ( SizeType oinv = 0; oinv < oinv_num; ++ oinv ) {
+	auto tt1 = oinv ? ~tt : tt;
+	double area = cell_area + mInvArea * (inum + oinv);
+	// 同じ極性の組み合わせのものは面積の小さい方だけを残す．
+	auto& match_list = table[tt1];
+	bool found = false;
+	for ( auto& match: match_list ) {
+	  if ( match.mInputInv == iinv && match.mOutputInv == (oinv == 1) ) {
+	    if ( match.mArea > area ) {
+	      match.mCellId = cell.id();
+	      match.mLeafPos = perm;
+	      match.mArea = area;
+	    }
+	    found = true;
+	    break;
+	  }
+	}
+	if ( !found ) {
+	  match_list.push_back(CellMatch{cell.id(), perm, iinv,
+					 oinv == 1, area});
+	}
+      }
+    }
+  } while ( std::next_permutation(perm.begin(), perm.end()) );
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,139 @@
+#ifndef CELLMATCHER_H
+#define CELLMATCHER_H
+
+/// @file CellMatcher.h
+/// @brief CellMatcher のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/clib.h"
+#include "Simulator.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class CellMatch CellMatcher.h "CellMatcher.h"
+/// @brief カットの関数をセルで実現する方法を表す構造体
+///
+/// - カットの葉の極性(と出力の極性)をインバーターで調整して
+///   セルの入力に接続する．
+/// - 面積はインバーターの分を含む．
+//////////////////////////////////////////////////////////////////////
+struct CellMatch
+{
+  // セル番号
+  SizeType mCellId;
+
+  // セルの入力ピンごとに接続するカットの葉の位置を格納する配列
+  vector<SizeType> mLeafPos;
+
+  // 反転させるカットの葉のビットマスク
+  std::uint32_t mInputInv;
+
+  // 出力を反転させる時 true
+  bool mOutputInv;
+
+  // 面積
+  double mArea;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class CellMatcher CellMatcher.h "CellMatcher.h"
+/// @brief 真理値表からセルを求めるクラス
+///
+/// セルライブラリの単一出力の論理セルについて，入力の置換と
+/// 入出力の否定(NPN変換)を施した関数を全て列挙して，
+/// 真理値表をキーにした表を作っておく．
+/// こうしておけばカットの関数の NPN 同値類を求めなくても
+/// 表を1回引くだけで照合できる．
+///
+/// 真理値表は6入力分の64ビットで表す．
+/// 変数 i の射影は Simulator と同じく (p >> i) & 1 とし，
+/// 入力数が6未満の時は上位の変数に関して複製された形となる．
+//////////////////////////////////////////////////////////////////////
+class CellMatcher
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// - 入力数が max_ni を超えるセルは用いない．
+  /// - インバーターのセルがない場合は否定を含む変換は行わない．
+  CellMatcher(
+    const ClibCellLibrary& library, ///< [in] セルライブラリ
+    SizeType max_ni                 ///< [in] 入力数の最大値 ( <= 6 )
+  );
+
+  /// @brief デストラクタ
+  ~CellMatcher() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 関数に一致するセルのリストを返す．
+  /// @return 一致するものがない場合は nullptr を返す．
+  ///
+  /// 複数のスレッドから同時に呼び出してもよい．
+  const vector<CellMatch>*
+  find(
+    SizeType ni,  ///< [in] 入力数
+    PackedVal tt  ///< [in] 真理値表
+  ) const;
+
+  /// @brief インバーターのセル番号を返す．
+  ///
+  /// ない場合は CLIB_NULLID を返す．
+  SizeType
+  inv_cell() const
+  {
+    return mInvCell;
+  }
+
+  /// @brief 変数の射影の真理値表を返す．
+  static
+  PackedVal
+  proj(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < 6 )
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief セルの NPN 変換を列挙して登録する．
+  void
+  reg_cell(
+    const ClibCell& cell, ///< [in] 対象のセル
+    PackedVal func        ///< [in] セルの真理値表
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力数ごとに真理値表をキーにしてセルのリストを格納する辞書
+  vector<unordered_map<PackedVal, vector<CellMatch>>> mMatchTable;
+
+  // インバーターのセル番号
+  SizeType mInvCell{CLIB_NULLID};
+
+  // インバーターの面積
+  double mInvArea{0.0};
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // CELLMATCHER_H
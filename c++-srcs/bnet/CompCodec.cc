@@ -0,0 +1,410 @@
+
+/// @file CompCodec.cc
+/// @brief Decoder, Encoder の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CompCodec.h"
+#include <cstring>
+#if defined(YM_BNET_USE_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(YM_BNET_USE_ZSTD)
+#include <zstd.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// 1回の呼び出しで出力領域を伸ばす大きさ
+const SizeType CHUNK_SIZE = 1 << 16;
+
+// 文字列が suffix で終わっている時 true を返す．
+bool
+has_suffix(
+  const string& str,
+  const char* suffix
+)
+{
+  SizeType n = std::strlen(suffix);
+  return str.size() > n && str.compare(str.size() - n, n, suffix) == 0;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Decoder
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Decoder::Decoder(
+  CompType type
+) : mType{type}
+{
+  switch ( mType ) {
+  case CompType::Gzip:
+#if defined(YM_BNET_USE_ZLIB)
+    {
+      auto z = new z_stream;
+      std::memset(z, 0, sizeof(z_stream));
+      // 15 + 32 で gzip/zlib ヘッダを自動判別する．
+      if ( inflateInit2(z, 15 + 32) == Z_OK ) {
+	mCtx = z;
+      }
+      else {
+	delete z;
+      }
+    }
+#endif
+    break;
+
+  case CompType::Zstd:
+#if defined(YM_BNET_USE_ZSTD)
+    mCtx = ZSTD_createDCtx();
+#endif
+    break;
+
+  default:
+    break;
+  }
+}
+
+// @brief デストラクタ
+Decoder::~Decoder()
+{
+  if ( mCtx == nullptr ) {
+    return;
+  }
+  switch ( mType ) {
+  case CompType::Gzip:
+#if defined(YM_BNET_USE_ZLIB)
+    {
+      auto z = static_cast<z_stream*>(mCtx);
+      inflateEnd(z);
+      delete z;
+    }
+#endif
+    break;
+
+  case CompType::Zstd:
+#if defined(YM_BNET_USE_ZSTD)
+    ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(mCtx));
+#endif
+    break;
+
+  default:
+    break;
+  }
+}
+
+// @brief 先頭のマジックナンバーから圧縮形式を判定する．
+CompType
+Decoder::detect(
+  const char* data,
+  SizeType size
+)
+{
+  auto p = reinterpret_cast<const unsigned char*>(data);
+  if ( size >= 2 && p[0] == 0x1f && p[1] == 0x8b ) {
+    return CompType::Gzip;
+  }
+  if ( size >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd ) {
+    return CompType::Zstd;
+  }
+  return CompType::None;
+}
+
+// @brief 圧縮形式が扱えるか調べる．
+bool
+Decoder::is_supported(
+  CompType type
+)
+{
+  switch ( type ) {
+  case CompType::None:
+    return true;
+
+  case CompType::Gzip:
+#if defined(YM_BNET_USE_ZLIB)
+    return true;
+#else
+    return false;
+#endif
+
+  case CompType::Zstd:
+#if defined(YM_BNET_USE_ZSTD)
+    return true;
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+// @brief メモリ上の圧縮データ全体を展開する．
+bool
+Decoder::decode_all(
+  CompType type,
+  std::string_view src,
+  string& dst
+)
+{
+  Decoder decoder{type};
+  if ( !decoder.is_valid() ) {
+    return false;
+  }
+  dst.clear();
+  // 圧縮率を適当に見積もって領域を確保しておく．
+  dst.reserve(src.size() * 4);
+  if ( !decoder.decode(src.data(), src.size(), dst) ) {
+    return false;
+  }
+  return decoder.is_complete();
+}
+
+// @brief データを展開する．
+bool
+Decoder::decode(
+  const char* data,
+  SizeType size,
+  string& dst
+)
+{
+  if ( mCtx == nullptr ) {
+    return false;
+  }
+  switch ( mType ) {
+  case CompType::Gzip:
+#if defined(YM_BNET_USE_ZLIB)
+    {
+      auto z = static_cast<z_stream*>(mCtx);
+      z->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+      z->avail_in = size;
+      for ( ; ; ) {
+	auto old_size = dst.size();
+	dst.resize(old_size + CHUNK_SIZE);
+	z->next_out = reinterpret_cast<Bytef*>(&dst[old_size]);
+	z->avail_out = CHUNK_SIZE;
+	auto ret = inflate(z, Z_NO_FLUSH);
+	dst.resize(old_size + CHUNK_SIZE - z->avail_out);
+	if ( ret == Z_STREAM_END ) {
+	  mPending = false;
+	  if ( z->avail_in == 0 ) {
+	    break;
+	  }
+	  // 連結された次のメンバを読む．
+	  inflateReset(z);
+	  continue;
+	}
+	if ( ret != Z_OK && ret != Z_BUF_ERROR ) {
+	  return false;
+	}
+	mPending = true;
+	if ( z->avail_in == 0 && z->avail_out != 0 ) {
+	  break;
+	}
+      }
+      return true;
+    }
+#endif
+    break;
+
+  case CompType::Zstd:
+#if defined(YM_BNET_USE_ZSTD)
+    {
+      auto ctx = static_cast<ZSTD_DCtx*>(mCtx);
+      ZSTD_inBuffer in{data, size, 0};
+      SizeType out_size = ZSTD_DStreamOutSize();
+      for ( ; ; ) {
+	auto old_size = dst.size();
+	dst.resize(old_size + out_size);
+	ZSTD_outBuffer out{&dst[old_size], out_size, 0};
+	auto ret = ZSTD_decompressStream(ctx, &out, &in);
+	dst.resize(old_size + out.pos);
+	if ( ZSTD_isError(ret) ) {
+	  return false;
+	}
+	mPending = ret != 0;
+	if ( in.pos == in.size && out.pos < out.size ) {
+	  break;
+	}
+      }
+      return true;
+    }
+#endif
+    break;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Encoder
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Encoder::Encoder(
+  CompType type
+) : mType{type}
+{
+  switch ( mType ) {
+  case CompType::Gzip:
+#if defined(YM_BNET_USE_ZLIB)
+    {
+      auto z = new z_stream;
+      std::memset(z, 0, sizeof(z_stream));
+      // 15 + 16 で gzip ヘッダを出力する．
+      if ( deflateInit2(z, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+			15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK ) {
+	mCtx = z;
+      }
+      else {
+	delete z;
+      }
+    }
+#endif
+    break;
+
+  case CompType::Zstd:
+#if defined(YM_BNET_USE_ZSTD)
+    mCtx = ZSTD_createCCtx();
+#endif
+    break;
+
+  default:
+    break;
+  }
+}
+
+// @brief デストラクタ
+Encoder::~Encoder()
+{
+  if ( mCtx == nullptr ) {
+    return;
+  }
+  switch ( mType ) {
+  case CompType::Gzip:
+#if defined(YM_BNET_USE_ZLIB)
+    {
+      auto z = static_cast<z_stream*>(mCtx);
+      deflateEnd(z);
+      delete z;
+    }
+#endif
+    break;
+
+  case CompType::Zstd:
+#if defined(YM_BNET_USE_ZSTD)
+    ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(mCtx));
+#endif
+    break;
+
+  default:
+    break;
+  }
+}
+
+// @brief ファイル名の拡張子から圧縮形式を判定する．
+CompType
+Encoder::type_from_filename(
+  const string& filename
+)
+{
+  if ( has_suffix(filename, ".gz") ) {
+    return CompType::Gzip;
+  }
+  if ( has_suffix(filename, ".zst") ) {
+    return CompType::Zstd;
+  }
+  return CompType::None;
+}
+
+// @brief データを圧縮する．
+bool
+Encoder::encode(
+  const char* data,
+  SizeType size,
+  bool last,
+  string& dst
+)
+{
+  if ( mCtx == nullptr ) {
+    return false;
+  }
+  switch ( mType ) {
+  case CompType::Gzip:
+#if defined(YM_BNET_USE_ZLIB)
+    {
+      auto z = static_cast<z_stream*>(mCtx);
+      z->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+      z->avail_in = size;
+      auto flush = last ? Z_FINISH : Z_NO_FLUSH;
+      for ( ; ; ) {
+	auto old_size = dst.size();
+	dst.resize(old_size + CHUNK_SIZE);
+	z->next_out = reinterpret_cast<Bytef*>(&dst[old_size]);
+	z->avail_out = CHUNK_SIZE;
+	auto ret = deflate(z, flush);
+	dst.resize(old_size + CHUNK_SIZE - z->avail_out);
+	if ( ret == Z_STREAM_ERROR ) {
+	  return false;
+	}
+	if ( last ) {
+	  if ( ret == Z_STREAM_END ) {
+	    break;
+	  }
+	}
+	else if ( z->avail_in == 0 && z->avail_out != 0 ) {
+	  break;
+	}
+      }
+      return true;
+    }
+#endif
+    break;
+
+  case CompType::Zstd:
+#if defined(YM_BNET_USE_ZSTD)
+    {
+      auto ctx = static_cast<ZSTD_CCtx*>(mCtx);
+      ZSTD_inBuffer in{data, size, 0};
+      auto mode = last ? ZSTD_e_end : ZSTD_e_continue;
+      SizeType out_size = ZSTD_CStreamOutSize();
+      for ( ; ; ) {
+	auto old_size = dst.size();
+	dst.resize(old_size + out_size);
+	ZSTD_outBuffer out{&dst[old_size], out_size, 0};
+	auto ret = ZSTD_compressStream2(ctx, &out, &in, mode);
+	dst.resize(old_size + out.pos);
+	if ( ZSTD_isError(ret) ) {
+	  return false;
+	}
+	if ( last ) {
+	  if ( ret == 0 ) {
+	    break;
+	  }
+	}
+	else if ( in.pos == in.size ) {
+	  break;
+	}
+      }
+      return true;
+    }
+#endif
+    break;
+
+  default:
+    break;
+  }
+  return false;
+}
+
+END_NAMESPACE_YM_BNET
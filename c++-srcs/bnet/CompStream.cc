@@ -0,0 +1,355 @@
+
+/// @file CompStream.cc
+/// @brief CompInStream, CompOutStream の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CompStream.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// ファイルから1回に読み込む大きさ
+const SizeType READ_SIZE = 1 << 16;
+
+// 展開済みのチャンクの大きさの目安
+const SizeType CHUNK_SIZE = 1 << 18;
+
+// キューに積めるチャンク数の上限
+const SizeType QUEUE_SIZE = 4;
+
+// 書き込み用のバッファの大きさ
+const SizeType WRITE_SIZE = 1 << 16;
+
+// マジックナンバーの判定に用いる大きさ
+const SizeType MAGIC_SIZE = 4;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CompInBuf
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CompInBuf::CompInBuf(
+  const string& filename
+)
+{
+  mFd = ::open(filename.c_str(), O_RDONLY);
+  if ( mFd < 0 ) {
+    return;
+  }
+
+  char buff[MAGIC_SIZE];
+  SizeType n = 0;
+  while ( n < MAGIC_SIZE ) {
+    auto n1 = ::read(mFd, buff + n, MAGIC_SIZE - n);
+    if ( n1 <= 0 ) {
+      break;
+    }
+    n += n1;
+  }
+  mHead.assign(buff, n);
+
+  auto type = Decoder::detect(buff, n);
+  if ( type == CompType::None ) {
+    return;
+  }
+  if ( !Decoder::is_supported(type) ) {
+    ::close(mFd);
+    mFd = -1;
+    return;
+  }
+  mThread = std::thread{&CompInBuf::decode_loop, this, type};
+}
+
+// @brief デストラクタ
+CompInBuf::~CompInBuf()
+{
+  if ( mThread.joinable() ) {
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mStop = true;
+    }
+    mCond.notify_all();
+    mThread.join();
+  }
+  if ( mFd >= 0 ) {
+    ::close(mFd);
+  }
+}
+
+// @brief 読み出し領域が空になった時に呼ばれる関数
+CompInBuf::int_type
+CompInBuf::underflow()
+{
+  if ( gptr() < egptr() ) {
+    return traits_type::to_int_type(*gptr());
+  }
+  if ( mFd < 0 ) {
+    return traits_type::eof();
+  }
+
+  if ( mThread.joinable() ) {
+    // 展開スレッドから次のチャンクを受け取る．
+    std::unique_lock<std::mutex> lock{mMutex};
+    while ( mQueue.empty() && !mDone ) {
+      mCond.wait(lock);
+    }
+    if ( mQueue.empty() ) {
+      if ( mError ) {
+	throw std::invalid_argument{"CompInBuf: broken compressed data"};
+      }
+      return traits_type::eof();
+    }
+    mChunk.swap(mQueue.front());
+    mQueue.pop_front();
+    mCond.notify_all();
+  }
+  else if ( !mHead.empty() ) {
+    // 先読みした内容を返す．
+    mChunk.swap(mHead);
+    mHead.clear();
+  }
+  else {
+    mChunk.resize(READ_SIZE);
+    auto n = ::read(mFd, &mChunk[0], READ_SIZE);
+    while ( n < 0 && errno == EINTR ) {
+      n = ::read(mFd, &mChunk[0], READ_SIZE);
+    }
+    if ( n <= 0 ) {
+      mChunk.clear();
+      if ( n < 0 ) {
+	throw std::invalid_argument{"CompInBuf: read error"};
+      }
+      return traits_type::eof();
+    }
+    mChunk.resize(n);
+  }
+
+  auto p = &mChunk[0];
+  setg(p, p, p + mChunk.size());
+  return traits_type::to_int_type(*p);
+}
+
+// @brief 展開スレッドの本体
+void
+CompInBuf::decode_loop(
+  CompType type
+)
+{
+  Decoder decoder{type};
+  string chunk;
+  bool ok = decoder.is_valid() &&
+    decoder.decode(mHead.data(), mHead.size(), chunk);
+  vector<char> buff(READ_SIZE);
+  while ( ok ) {
+    auto n = ::read(mFd, buff.data(), READ_SIZE);
+    if ( n < 0 ) {
+      if ( errno == EINTR ) {
+	continue;
+      }
+      // 読み込みエラー
+      ok = false;
+      break;
+    }
+    if ( n == 0 ) {
+      // 圧縮データの途中でファイルが終わっていたらエラー
+      ok = decoder.is_complete();
+      break;
+    }
+    ok = decoder.decode(buff.data(), n, chunk);
+    if ( chunk.size() >= CHUNK_SIZE ) {
+      ok = push_chunk(chunk) && ok;
+    }
+  }
+  // エラーの場合もそこまでに展開できた内容は渡しておく．
+  if ( !chunk.empty() ) {
+    push_chunk(chunk);
+  }
+
+  std::lock_guard<std::mutex> lock{mMutex};
+  // mStop による中断は読み出し側が終わっているので問題ない．
+  mError = !ok;
+  mDone = true;
+  mCond.notify_all();
+}
+
+// @brief 展開済みのチャンクをキューに積む．
+bool
+CompInBuf::push_chunk(
+  string& chunk
+)
+{
+  std::unique_lock<std::mutex> lock{mMutex};
+  while ( mQueue.size() >= QUEUE_SIZE && !mStop ) {
+    mCond.wait(lock);
+  }
+  if ( mStop ) {
+    return false;
+  }
+  mQueue.push_back(string{});
+  mQueue.back().swap(chunk);
+  mCond.notify_all();
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CompInStream
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CompInStream::CompInStream(
+  const string& filename
+) : istream{nullptr},
+    mBuf{filename}
+{
+  rdbuf(&mBuf);
+  if ( !mBuf.is_valid() ) {
+    setstate(std::ios::failbit);
+  }
+  // 展開中のエラーで CompInBuf が送出した例外を呼び出し側に伝える．
+  exceptions(std::ios::badbit);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CompOutBuf
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CompOutBuf::CompOutBuf(
+  const string& filename
+) : mBuff(WRITE_SIZE)
+{
+  auto type = Encoder::type_from_filename(filename);
+  if ( type != CompType::None ) {
+    mEncoder = std::unique_ptr<Encoder>{new Encoder{type}};
+    if ( !mEncoder->is_valid() ) {
+      return;
+    }
+  }
+  mFd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  setp(mBuff.data(), mBuff.data() + mBuff.size());
+}
+
+// @brief デストラクタ
+CompOutBuf::~CompOutBuf()
+{
+  if ( mFd >= 0 ) {
+    close();
+  }
+}
+
+// @brief 残りの内容を書き出してファイルを閉じる．
+bool
+CompOutBuf::close()
+{
+  if ( mFd < 0 ) {
+    return false;
+  }
+  write_buffer(true);
+  if ( ::close(mFd) != 0 ) {
+    mError = true;
+  }
+  mFd = -1;
+  return !mError;
+}
+
+// @brief 書き込み領域が一杯になった時に呼ばれる関数
+CompOutBuf::int_type
+CompOutBuf::overflow(
+  int_type c
+)
+{
+  if ( !write_buffer(false) ) {
+    return traits_type::eof();
+  }
+  if ( !traits_type::eq_int_type(c, traits_type::eof()) ) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+// @brief 内容を書き出す．
+int
+CompOutBuf::sync()
+{
+  return write_buffer(false) ? 0 : -1;
+}
+
+// @brief バッファの内容を(圧縮して)書き出す．
+bool
+CompOutBuf::write_buffer(
+  bool last
+)
+{
+  if ( mFd < 0 ) {
+    return false;
+  }
+  SizeType n = pptr() - pbase();
+  setp(mBuff.data(), mBuff.data() + mBuff.size());
+
+  const char* p = mBuff.data();
+  if ( mEncoder ) {
+    mCompBuff.clear();
+    if ( !mEncoder->encode(p, n, last, mCompBuff) ) {
+      mError = true;
+      return false;
+    }
+    p = mCompBuff.data();
+    n = mCompBuff.size();
+  }
+  while ( n > 0 ) {
+    auto n1 = ::write(mFd, p, n);
+    if ( n1 < 0 && errno == EINTR ) {
+      continue;
+    }
+    if ( n1 <= 0 ) {
+      // 書き込みエラー
+      mError = true;
+      return false;
+    }
+    p += n1;
+    n -= n1;
+  }
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CompOutStream
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CompOutStream::CompOutStream(
+  const string& filename
+) : ostream{nullptr},
+    mBuf{filename}
+{
+  rdbuf(&mBuf);
+  if ( !mBuf.is_valid() ) {
+    setstate(std::ios::failbit);
+  }
+}
+
+// @brief 残りの内容を書き出してファイルを閉じる．
+void
+CompOutStream::close()
+{
+  if ( !mBuf.close() ) {
+    setstate(std::ios::badbit);
+  }
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,606 @@
+
+/// @file CutMapper.cc
+/// @brief CutMapper の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "CutMapper.h"
+#include "Bnet2Aig.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNodeMap.h"
+#include "ym/BnDff.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/ClibCell.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// ノードあたりのカット数の上限
+const SizeType CUT_LIMIT = 10;
+
+// 要求時刻の初期値
+const int INF_TIME = std::numeric_limits<int>::max();
+
+// 真理値表の変数を並べ替える．
+//
+// leaf_list を葉とする関数を new_leaf_list を葉とする関数に変換する．
+// leaf_list は new_leaf_list に含まれていなければならない．
+PackedVal
+expand_func(
+  PackedVal func,
+  const vector<SizeType>& leaf_list,
+  const vector<SizeType>& new_leaf_list
+)
+{
+  SizeType n = leaf_list.size();
+  vector<SizeType> pos_list(n);
+  SizeType j = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    while ( new_leaf_list[j] != leaf_list[i] ) {
+      ++ j;
+    }
+    pos_list[i] = j;
+  }
+  PackedVal ans = 0UL;
+  for ( SizeType p = 0; p < 64; ++ p ) {
+    SizeType q = 0;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      if ( (p >> pos_list[i]) & 1U ) {
+	q |= (1U << i);
+      }
+    }
+    if ( (func >> q) & 1UL ) {
+      ans |= (1UL << p);
+    }
+  }
+  return ans;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief セルライブラリを用いてテクノロジマッピングを行ったネットワークを返す．
+BnNetwork
+BnNetwork::tech_map(
+  SizeType cut_size,
+  SizeType thread_num
+) const
+{
+  if ( cut_size < 2 || cut_size > 6 ) {
+    ostringstream buf;
+    buf << "BnNetwork::tech_map(" << cut_size << "): "
+	<< "cut_size should be in the range [2, 6]";
+    throw std::invalid_argument{buf.str()};
+  }
+  if ( library().cell_num() == 0 ) {
+    throw std::invalid_argument{"BnNetwork::tech_map(): no cell library"};
+  }
+  for ( auto dff: dff_list() ) {
+    if ( !dff.is_cell() ) {
+      throw std::invalid_argument{"BnNetwork::tech_map(): DFF without cell"};
+    }
+  }
+
+  auto src_network = balanced_decomp(2);
+  CutMapper op{cut_size, thread_num};
+  op.map(src_network);
+  return BnNetwork{std::move(op)};
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CutMapper
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CutMapper::CutMapper(
+  SizeType cut_size,
+  SizeType thread_num
+) : mCutSize{cut_size},
+    mThreadNum{std::max(thread_num, static_cast<SizeType>(1))}
+{
+  ASSERT_COND( mCutSize >= 2 && mCutSize <= 6 );
+}
+
+// @brief マッピングを行う．
+void
+CutMapper::map(
+  const BnNetwork& src_network
+)
+{
+  mMatcher.reset(new CellMatcher{src_network.library(), mCutSize});
+  if ( mMatcher->inv_cell() == CLIB_NULLID ) {
+    throw std::invalid_argument{"CutMapper: no inverter cell in the library"};
+  }
+
+  make_aig(src_network);
+  enum_all_cuts();
+
+  // 最初は AIG 上のファンアウト数を参照回数とする．
+  SizeType n = mAigNodeList.size();
+  mRefArray.clear();
+  mRefArray.resize(n, 0);
+  for ( auto& node: mAigNodeList ) {
+    if ( !node.mIsLeaf ) {
+      ++ mRefArray[node.mFanin[0] / 2];
+      ++ mRefArray[node.mFanin[1] / 2];
+    }
+  }
+  for ( auto lit: mRootList ) {
+    ++ mRefArray[lit / 2];
+  }
+  mReqArray.clear();
+  mReqArray.resize(n, INF_TIME);
+  mBestArray.clear();
+  mBestArray.resize(n, BestInfo{0, 0, 0, 0.0});
+
+  // 段数最小の被覆を求めてから面積を回復する．
+  select_cuts(false);
+  calc_required();
+  for ( SizeType c = 0; c < 2; ++ c ) {
+    select_cuts(true);
+    calc_required();
+  }
+
+  auto node_map = make_skelton_copy(src_network);
+  for ( auto src_dff: src_network.dff_list() ) {
+    copy_dff(src_dff, node_map);
+  }
+  make_network(src_network, node_map);
+}
+
+// @brief 元のネットワークから AIG を作る．
+void
+CutMapper::make_aig(
+  const BnNetwork& src_network
+)
+{
+  Bnet2Aig op;
+  if ( !op.make_comb(src_network, mLitArray) ) {
+    // balanced_decomp() の結果は真理値表型や BDD 型のノードを含まない．
+    throw std::invalid_argument{"CutMapper: cannot convert to AIG"};
+  }
+
+  SizeType n = op.node_num();
+  mAigNodeList.clear();
+  mAigNodeList.reserve(n);
+  // 定数0
+  mAigNodeList.push_back(AigNode{true, BNET_NULLID, {0, 0}, 0});
+  for ( SizeType id = 1; id < n; ++ id ) {
+    if ( op.is_leaf(id) ) {
+      mAigNodeList.push_back(AigNode{true, BNET_NULLID, {0, 0}, 0});
+    }
+    else {
+      mAigNodeList.push_back(AigNode{false, BNET_NULLID,
+				     {op.and_src1(id), op.and_src2(id)},
+				     op.level(id * 2)});
+    }
+  }
+
+  // 葉の元のノード番号を設定する．
+  for ( auto src_node: src_network.input_list() ) {
+    auto id = src_node.id();
+    mAigNodeList[mLitArray[id] / 2].mSrcId = id;
+  }
+  mRootList.clear();
+  for ( auto src_node: src_network.logic_list() ) {
+    if ( src_node.type() != BnNodeType::Cell ) {
+      continue;
+    }
+    auto id = src_node.id();
+    mAigNodeList[mLitArray[id] / 2].mSrcId = id;
+    // セル型のノードのファンインはマッピングの根となる．
+    for ( SizeType i = 0; i < src_node.fanin_num(); ++ i ) {
+      mRootList.push_back(mLitArray[src_node.fanin_id(i)]);
+    }
+  }
+
+  for ( auto src_node: src_network.output_list() ) {
+    auto src = src_node.output_src();
+    if ( src.is_valid() ) {
+      mRootList.push_back(mLitArray[src.id()]);
+    }
+  }
+}
+
+// @brief 全てのノードのカットを列挙する．
+void
+CutMapper::enum_all_cuts()
+{
+  SizeType n = mAigNodeList.size();
+  mCutArray.clear();
+  mCutArray.resize(n);
+
+  // 葉のカットは自分自身のみ
+  // AND ノードは段数ごとに分ける．
+  vector<vector<SizeType>> level_list;
+  for ( SizeType id = 1; id < n; ++ id ) {
+    auto& node = mAigNodeList[id];
+    if ( node.mIsLeaf ) {
+      mCutArray[id].push_back(Cut{{id}, CellMatcher::proj(0), nullptr});
+      continue;
+    }
+    auto level = node.mLevel;
+    if ( level_list.size() <= level ) {
+      level_list.resize(level + 1);
+    }
+    level_list[level].push_back(id);
+  }
+
+  // 同じ段数のノードは互いに依存しないので並列に処理できる．
+  for ( auto& id_list: level_list ) {
+    if ( mThreadNum == 1 || id_list.size() < mThreadNum ) {
+      for ( auto id: id_list ) {
+	enum_cuts(id);
+      }
+      continue;
+    }
+    vector<std::thread> thread_list;
+    for ( SizeType t = 0; t < mThreadNum; ++ t ) {
+      thread_list.push_back(std::thread{&CutMapper::enum_cuts_thread,
+					this, std::cref(id_list), t});
+    }
+    for ( auto& thr: thread_list ) {
+      thr.join();
+    }
+  }
+}
+
+// @brief スレッドごとにノードのカットを列挙する．
+void
+CutMapper::enum_cuts_thread(
+  const vector<SizeType>& id_list,
+  SizeType start
+)
+{
+  for ( SizeType i = start; i < id_list.size(); i += mThreadNum ) {
+    enum_cuts(id_list[i]);
+  }
+}
+
+// @brief ノードのカットを列挙する．
+void
+CutMapper::enum_cuts(
+  SizeType id
+)
+{
+  auto& node = mAigNodeList[id];
+  auto lit0 = node.mFanin[0];
+  auto lit1 = node.mFanin[1];
+  auto& cut_list0 = mCutArray[lit0 / 2];
+  auto& cut_list1 = mCutArray[lit1 / 2];
+
+  // 先頭は自明なカットなので，
+  // ファンインからなるカットが最初に作られる．
+  vector<Cut> cut_list;
+  for ( auto& cut0: cut_list0 ) {
+    for ( auto& cut1: cut_list1 ) {
+      vector<SizeType> leaf_list;
+      std::set_union(cut0.mLeafList.begin(), cut0.mLeafList.end(),
+		     cut1.mLeafList.begin(), cut1.mLeafList.end(),
+		     std::back_inserter(leaf_list));
+      if ( leaf_list.size() > mCutSize ) {
+	continue;
+      }
+
+      // 既存のカットに支配されている場合は加えない．
+      bool dominated = false;
+      for ( auto& cut: cut_list ) {
+	if ( std::includes(leaf_list.begin(), leaf_list.end(),
+			   cut.mLeafList.begin(), cut.mLeafList.end()) ) {
+	  dominated = true;
+	  break;
+	}
+      }
+      if ( dominated ) {
+	continue;
+      }
+
+      // 新しいカットに支配されるカットを取り除く．
+      SizeType wpos = 0;
+      for ( SizeType rpos = 0; rpos < cut_list.size(); ++ rpos ) {
+	auto& cut = cut_list[rpos];
+	if ( std::includes(cut.mLeafList.begin(), cut.mLeafList.end(),
+			   leaf_list.begin(), leaf_list.end()) ) {
+	  continue;
+	}
+	if ( wpos < rpos ) {
+	  cut_list[wpos] = std::move(cut);
+	}
+	++ wpos;
+      }
+      cut_list.erase(cut_list.begin() + wpos, cut_list.end());
+
+      auto func0 = expand_func(cut0.mFunc, cut0.mLeafList, leaf_list);
+      if ( lit0 & 1 ) {
+	func0 = ~func0;
+      }
+      auto func1 = expand_func(cut1.mFunc, cut1.mLeafList, leaf_list);
+      if ( lit1 & 1 ) {
+	func1 = ~func1;
+      }
+      cut_list.push_back(Cut{leaf_list, func0 & func1, nullptr});
+    }
+  }
+
+  // 葉の数の少ないものを残す．
+  // ファンインからなるカットは同じ大きさのものの中で先頭になる．
+  for ( SizeType i = 1; i < cut_list.size(); ++ i ) {
+    for ( SizeType j = i; j > 0; -- j ) {
+      if ( cut_list[j - 1].mLeafList.size() <= cut_list[j].mLeafList.size() ) {
+	break;
+      }
+      std::swap(cut_list[j - 1], cut_list[j]);
+    }
+  }
+  if ( cut_list.size() > CUT_LIMIT ) {
+    cut_list.erase(cut_list.begin() + CUT_LIMIT, cut_list.end());
+  }
+
+  for ( auto& cut: cut_list ) {
+    cut.mMatchList = mMatcher->find(cut.mLeafList.size(), cut.mFunc);
+  }
+
+  // 自明なカットを先頭に置く．
+  cut_list.insert(cut_list.begin(), Cut{{id}, CellMatcher::proj(0), nullptr});
+  mCutArray[id].swap(cut_list);
+}
+
+// @brief 被覆を求める．
+void
+CutMapper::select_cuts(
+  bool area_mode
+)
+{
+  SizeType n = mAigNodeList.size();
+  for ( SizeType id = 1; id < n; ++ id ) {
+    if ( mAigNodeList[id].mIsLeaf ) {
+      mBestArray[id] = BestInfo{0, 0, 0, 0.0};
+      continue;
+    }
+
+    // best は条件を満たすもので最良のもの
+    // fallback は到着時刻が最小のもの
+    bool found = false;
+    BestInfo best{0, 0, 0, 0.0};
+    BestInfo fallback{0, 0, INF_TIME, 0.0};
+    auto& cut_list = mCutArray[id];
+    for ( SizeType cpos = 1; cpos < cut_list.size(); ++ cpos ) {
+      auto& cut = cut_list[cpos];
+      if ( cut.mMatchList == nullptr ) {
+	continue;
+      }
+      auto& match_list = *cut.mMatchList;
+      for ( SizeType mpos = 0; mpos < match_list.size(); ++ mpos ) {
+	auto& match = match_list[mpos];
+	int arrival = 0;
+	double area_flow = match.mArea;
+	for ( SizeType i = 0; i < cut.mLeafList.size(); ++ i ) {
+	  auto& info = mBestArray[cut.mLeafList[i]];
+	  int arrival1 = info.mArrival;
+	  if ( (match.mInputInv >> i) & 1U ) {
+	    ++ arrival1;
+	  }
+	  arrival = std::max(arrival, arrival1);
+	  area_flow += info.mAreaFlow;
+	}
+	arrival += match.mOutputInv ? 2 : 1;
+	BestInfo info{cpos, mpos, arrival, area_flow};
+
+	if ( arrival < fallback.mArrival ||
+	     (arrival == fallback.mArrival && area_flow < fallback.mAreaFlow) ) {
+	  fallback = info;
+	}
+	if ( area_mode && arrival <= mReqArray[id] ) {
+	  if ( !found ||
+	       area_flow < best.mAreaFlow ||
+	       (area_flow == best.mAreaFlow && arrival < best.mArrival) ) {
+	    best = info;
+	    found = true;
+	  }
+	}
+      }
+    }
+    if ( fallback.mArrival == INF_TIME ) {
+      throw std::invalid_argument{"CutMapper: cannot map with the cell library"};
+    }
+    if ( !found ) {
+      best = fallback;
+    }
+    best.mAreaFlow /= std::max(mRefArray[id], static_cast<SizeType>(1));
+    mBestArray[id] = best;
+  }
+}
+
+// @brief 選ばれた被覆に含まれるノードの参照回数と要求時刻を求める．
+void
+CutMapper::calc_required()
+{
+  SizeType n = mAigNodeList.size();
+  mRefArray.clear();
+  mRefArray.resize(n, 0);
+  mReqArray.clear();
+  mReqArray.resize(n, INF_TIME);
+
+  // 否定の出力にはインバーターが1段加わる．
+  int max_arrival = 0;
+  for ( auto lit: mRootList ) {
+    int arrival = mBestArray[lit / 2].mArrival + (lit & 1);
+    max_arrival = std::max(max_arrival, arrival);
+  }
+  for ( auto lit: mRootList ) {
+    auto id = lit / 2;
+    ++ mRefArray[id];
+    int req = max_arrival - (lit & 1);
+    mReqArray[id] = std::min(mReqArray[id], req);
+  }
+
+  // 出力側から被覆をたどる．
+  for ( SizeType id = n; id -- > 1; ) {
+    if ( mAigNodeList[id].mIsLeaf || mRefArray[id] == 0 ) {
+      continue;
+    }
+    auto& best = mBestArray[id];
+    auto& cut = mCutArray[id][best.mCutPos];
+    auto& match = (*cut.mMatchList)[best.mMatchPos];
+    int req = mReqArray[id] - (match.mOutputInv ? 2 : 1);
+    for ( SizeType i = 0; i < cut.mLeafList.size(); ++ i ) {
+      auto leaf = cut.mLeafList[i];
+      ++ mRefArray[leaf];
+      int req1 = req;
+      if ( (match.mInputInv >> i) & 1U ) {
+	-- req1;
+      }
+      mReqArray[leaf] = std::min(mReqArray[leaf], req1);
+    }
+  }
+}
+
+// @brief マッピング結果のネットワークを作る．
+void
+CutMapper::make_network(
+  const BnNetwork& src_network,
+  BnNodeMap& node_map
+)
+{
+  SizeType n = mAigNodeList.size();
+  mNodeArray.clear();
+  mNodeArray.resize(n);
+  mInvArray.clear();
+  mInvArray.resize(n);
+
+  for ( SizeType id = 1; id < n; ++ id ) {
+    auto& node = mAigNodeList[id];
+    if ( node.mIsLeaf ) {
+      auto src_node = src_network.node(node.mSrcId);
+      if ( src_node.is_logic() ) {
+	// セル型のノード
+	SizeType ni = src_node.fanin_num();
+	vector<BnNode> fanin_list(ni);
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  fanin_list[i] = lit_node(mLitArray[src_node.fanin_id(i)]);
+	}
+	mNodeArray[id] = new_logic_cell(src_node.name(), src_node.cell(),
+					fanin_list);
+      }
+      else {
+	mNodeArray[id] = node_map.get(node.mSrcId);
+      }
+      continue;
+    }
+    if ( mRefArray[id] == 0 ) {
+      continue;
+    }
+
+    auto& best = mBestArray[id];
+    auto& cut = mCutArray[id][best.mCutPos];
+    auto& match = (*cut.mMatchList)[best.mMatchPos];
+    auto cell_node = new_cell(match, cut.mLeafList);
+    if ( match.mOutputInv ) {
+      mInvArray[id] = cell_node;
+      mNodeArray[id] = new_inv(cell_node);
+    }
+    else {
+      mNodeArray[id] = cell_node;
+    }
+  }
+
+  for ( auto src_node: src_network.output_list() ) {
+    auto src = src_node.output_src();
+    if ( src.is_valid() ) {
+      auto dst_node = node_map.get(src_node.id());
+      set_output_src(dst_node, lit_node(mLitArray[src.id()]));
+    }
+  }
+}
+
+// @brief リテラルを実現するノードを返す．
+BnNode
+CutMapper::lit_node(
+  SizeType lit
+)
+{
+  auto id = lit / 2;
+  bool inv = (lit & 1) == 1;
+  if ( id == 0 ) {
+    // 定数ノードは必要になった時点で作る．
+    auto& node = inv ? mInvArray[0] : mNodeArray[0];
+    if ( node.is_invalid() ) {
+      node = new_const(inv);
+    }
+    return node;
+  }
+  if ( !inv ) {
+    return mNodeArray[id];
+  }
+  if ( mInvArray[id].is_invalid() ) {
+    mInvArray[id] = new_inv(mNodeArray[id]);
+  }
+  return mInvArray[id];
+}
+
+// @brief セルを用いてノードを作る．
+BnNode
+CutMapper::new_cell(
+  const CellMatch& match,
+  const vector<SizeType>& leaf_list
+)
+{
+  SizeType ni = match.mLeafPos.size();
+  vector<BnNode> fanin_list(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto pos = match.mLeafPos[i];
+    auto lit = leaf_list[pos] * 2 + ((match.mInputInv >> pos) & 1U);
+    fanin_list[i] = lit_node(lit);
+  }
+  auto cell = library().cell(match.mCellId);
+  return new_logic_cell({}, cell, fanin_list);
+}
+
+// @brief 定数ノードを作る．
+BnNode
+CutMapper::new_const(
+  bool val
+)
+{
+  auto match_list = mMatcher->find(0, val ? ~0UL : 0UL);
+  if ( match_list == nullptr ) {
+    throw std::invalid_argument{"CutMapper: no constant cell in the library"};
+  }
+  // 面積最小のものを選ぶ．
+  const CellMatch* best = nullptr;
+  for ( auto& match: *match_list ) {
+    if ( best == nullptr || best->mArea > match.mArea ) {
+      best = &match;
+    }
+  }
+  auto node = new_cell(*best, {});
+  if ( best->mOutputInv ) {
+    node = new_inv(node);
+  }
+  return node;
+}
+
+// @brief インバーターを作る．
+BnNode
+CutMapper::new_inv(
+  BnNode node
+)
+{
+  auto cell = library().cell(mMatcher->inv_cell());
+  return new_logic_cell({}, cell, {node});
+}
+
+END_NAMESPACE_YM_BNET
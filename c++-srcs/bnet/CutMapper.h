@@ -0,0 +1,246 @@
+#ifndef CUTMAPPER_H
+#define CUTMAPPER_H
+
+/// @file CutMapper.h
+/// @brief CutMapper のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "CellMatcher.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class CutMapper CutMapper.h "CutMapper.h"
+/// @brief カットに基づいたテクノロジマッピングを行うクラス
+///
+/// 以下の手順で処理を行う．
+/// 1. 元のネットワークを2入力に分解して，Bnet2Aig::make_comb() を用いて
+///    否定枝つきの AND グラフ(AIG)に変換する．構造的に同じ AND ノードは
+///    共有する．セル型のノードはそのまま残し，AIG の葉として扱う．
+/// 2. 各 AND ノードの cut_size 入力以下のカットを列挙する．
+///    同じ段数のノードは独立に処理できるので複数のスレッドで処理する．
+/// 3. CellMatcher を用いてカットの関数に一致するセルを求める．
+/// 4. 段数(セル1個を1段とする単位遅延)が最小となる被覆を求める．
+/// 5. 要求時刻を満たす範囲で面積フロー(area flow)が最小となるように
+///    被覆を選び直す．
+///
+/// DFF はそのままコピーするので，セル型の DFF のみを扱う．
+//////////////////////////////////////////////////////////////////////
+class CutMapper :
+  public BnModifier
+{
+public:
+
+  /// @brief コンストラクタ
+  CutMapper(
+    SizeType cut_size,  ///< [in] カットの入力数の最大値 ( 2 <= cut_size <= 6 )
+    SizeType thread_num ///< [in] カットの列挙に用いるスレッド数
+  );
+
+  /// @brief デストラクタ
+  ~CutMapper() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief マッピングを行う．
+  ///
+  /// ライブラリのセルで実現できないノードがある場合と，
+  /// セル型でない DFF がある場合は std::invalid_argument 例外が送出される．
+  void
+  map(
+    const BnNetwork& src_network ///< [in] 元のネットワーク
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // AIG のノード
+  // ノード番号は Bnet2Aig の変数番号と同じで，0番目は定数0を表す．
+  struct AigNode
+  {
+    // 葉の時 true
+    bool mIsLeaf;
+
+    // 葉の場合の元のノード番号
+    SizeType mSrcId;
+
+    // AND ノードの場合のファンインのリテラル
+    // リテラルは (ノード番号 * 2 + 反転属性) で表す．
+    SizeType mFanin[2];
+
+    // 段数
+    SizeType mLevel;
+  };
+
+  // カット
+  struct Cut
+  {
+    // 葉のノード番号のリスト(昇順)
+    vector<SizeType> mLeafList;
+
+    // 真理値表
+    PackedVal mFunc;
+
+    // 一致するセルのリスト
+    const vector<CellMatch>* mMatchList;
+  };
+
+  // ノードごとの被覆の情報
+  struct BestInfo
+  {
+    // 選ばれたカットの番号
+    SizeType mCutPos;
+
+    // 選ばれたセルの番号
+    SizeType mMatchPos;
+
+    // 到着時刻
+    int mArrival;
+
+    // 面積フロー
+    double mAreaFlow;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 元のネットワークから AIG を作る．
+  void
+  make_aig(
+    const BnNetwork& src_network ///< [in] 元のネットワーク
+  );
+
+  /// @brief 全てのノードのカットを列挙する．
+  void
+  enum_all_cuts();
+
+  /// @brief ノードのカットを列挙する．
+  ///
+  /// 結果は mCutArray[id] に格納される．
+  /// ファンインのカットは列挙済みでなければならない．
+  void
+  enum_cuts(
+    SizeType id ///< [in] AND ノードの番号
+  );
+
+  /// @brief スレッドごとにノードのカットを列挙する．
+  ///
+  /// id_list の start 番目から mThreadNum 個おきに処理する．
+  void
+  enum_cuts_thread(
+    const vector<SizeType>& id_list, ///< [in] 同じ段数のノード番号のリスト
+    SizeType start                   ///< [in] 開始位置
+  );
+
+  /// @brief 被覆を求める．
+  ///
+  /// area_mode が false の時は到着時刻を最小にする．
+  /// true の時は要求時刻を満たす範囲で面積フローを最小にする．
+  void
+  select_cuts(
+    bool area_mode ///< [in] 面積を優先する時 true
+  );
+
+  /// @brief 選ばれた被覆に含まれるノードの参照回数と要求時刻を求める．
+  void
+  calc_required();
+
+  /// @brief マッピング結果のネットワークを作る．
+  void
+  make_network(
+    const BnNetwork& src_network, ///< [in] 元のネットワーク
+    BnNodeMap& node_map           ///< [inout] ID番号の対応表
+  );
+
+  /// @brief リテラルを実現するノードを返す．
+  BnNode
+  lit_node(
+    SizeType lit ///< [in] リテラル
+  );
+
+  /// @brief セルを用いてノードを作る．
+  /// @return 生成したノードを返す．
+  ///
+  /// 出力の否定は含まない．
+  BnNode
+  new_cell(
+    const CellMatch& match,           ///< [in] セル
+    const vector<SizeType>& leaf_list ///< [in] カットの葉のリスト
+  );
+
+  /// @brief 定数ノードを作る．
+  /// @return 生成したノードを返す．
+  BnNode
+  new_const(
+    bool val ///< [in] 値
+  );
+
+  /// @brief インバーターを作る．
+  /// @return 生成したノードを返す．
+  BnNode
+  new_inv(
+    BnNode node ///< [in] 入力のノード
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // カットの入力数の最大値
+  SizeType mCutSize;
+
+  // スレッド数
+  SizeType mThreadNum;
+
+  // セルの照合器
+  unique_ptr<CellMatcher> mMatcher;
+
+  // AIG のノードのリスト
+  vector<AigNode> mAigNodeList;
+
+  // 元のノード番号をキーにしてリテラルを格納する配列
+  vector<SizeType> mLitArray;
+
+  // マッピングの根となるリテラルのリスト
+  vector<SizeType> mRootList;
+
+  // AIG のノード番号をキーにしてカットのリストを格納する配列
+  vector<vector<Cut>> mCutArray;
+
+  // AIG のノード番号をキーにして被覆の情報を格納する配列
+  vector<BestInfo> mBestArray;
+
+  // AIG のノード番号をキーにして参照回数を格納する配列
+  vector<SizeType> mRefArray;
+
+  // AIG のノード番号をキーにして要求時刻を格納する配列
+  vector<int> mReqArray;
+
+  // AIG のノード番号をキーにして生成したノードを格納する配列
+  vector<BnNode> mNodeArray;
+
+  // AIG のノード番号をキーにして否定のノードを格納する配列
+  vector<BnNode> mInvArray;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // CUTMAPPER_H
@@ -0,0 +1,365 @@
+
+/// @file Eliminate.cc
+/// @brief Eliminate の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Eliminate.h"
+#include "ExprUtil.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNode.h"
+#include "ym/TvFunc.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// 論理式のリテラル数を数える．
+SizeType
+count_literals(
+  const Expr& expr
+)
+{
+  if ( expr.is_literal() ) {
+    return 1;
+  }
+  SizeType n = 0;
+  if ( expr.is_op() ) {
+    for ( auto& opr: expr.operand_list() ) {
+      n += count_literals(opr);
+    }
+  }
+  return n;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 論理ノードをファンアウト先に併合したネットワークを返す．
+BnNetwork
+BnNetwork::eliminate(
+  SizeType fanin_limit,
+  SizeType literal_limit,
+  int value_limit,
+  SizeType& eliminated_num
+) const
+{
+  BnModifier mod{BnNetwork{*this}};
+  Eliminate op{mod, fanin_limit, literal_limit, value_limit};
+  eliminated_num = op.eliminate();
+  BnNetwork network{std::move(mod)};
+  return network.sweep();
+}
+
+// @brief 論理ノードをファンアウト先に併合したネットワークを返す．
+BnNetwork
+BnNetwork::eliminate(
+  SizeType fanin_limit,
+  SizeType literal_limit,
+  int value_limit
+) const
+{
+  SizeType eliminated_num;
+  return eliminate(fanin_limit, literal_limit, value_limit, eliminated_num);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Eliminate
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Eliminate::Eliminate(
+  BnModifier& network,
+  SizeType fanin_limit,
+  SizeType literal_limit,
+  int value_limit
+) : mNetwork{network},
+    mFaninLimit{fanin_limit},
+    mLiteralLimit{literal_limit},
+    mValueLimit{value_limit}
+{
+}
+
+// @brief 併合を行う．
+SizeType
+Eliminate::eliminate()
+{
+  SizeType n = mNetwork.node_num();
+  mInfoArray.clear();
+  mInfoArray.resize(n + 1);
+  mQueue = decltype(mQueue){};
+
+  for ( auto node: mNetwork.logic_list() ) {
+    init_node(node);
+  }
+
+  // ファンアウトのリストを作る．
+  for ( auto node: mNetwork.logic_list() ) {
+    auto id = node.id();
+    auto& info = mInfoArray[id];
+    for ( auto iid: info.mFaninList ) {
+      add_fanout(iid, id);
+      if ( info.mKind == NodeKind::Keep ) {
+	mInfoArray[iid].mFixed = true;
+      }
+    }
+  }
+  for ( auto node: mNetwork.output_list() ) {
+    auto src = node.output_src();
+    if ( src.is_valid() ) {
+      mInfoArray[src.id()].mFixed = true;
+    }
+  }
+
+  for ( auto node: mNetwork.logic_list() ) {
+    push_cand(node.id());
+  }
+
+  SizeType eliminated_num = 0;
+  vector<Collapsed> result_list;
+  unordered_set<SizeType> affected_set;
+  while ( !mQueue.empty() ) {
+    SizeType id;
+    SizeType stamp;
+    std::tie(std::ignore, id, stamp) = mQueue.top();
+    mQueue.pop();
+    auto& info = mInfoArray[id];
+    if ( stamp != info.mStamp ) {
+      // 再評価済みの古い要素
+      continue;
+    }
+    int value;
+    result_list.clear();
+    if ( !calc_collapse(id, value, result_list) ) {
+      continue;
+    }
+
+    // ファンアウト先の関数を置き換える．
+    affected_set.clear();
+    for ( auto& result: result_list ) {
+      auto oid = result.mId;
+      auto& oinfo = mInfoArray[oid];
+      for ( auto iid: oinfo.mFaninList ) {
+	erase_fanout(iid, oid);
+      }
+      oinfo.mExpr = result.mExpr;
+      oinfo.mLitNum = result.mLitNum;
+      oinfo.mFaninList = result.mFaninList;
+      oinfo.mChanged = true;
+      for ( auto iid: oinfo.mFaninList ) {
+	add_fanout(iid, oid);
+	affected_set.emplace(iid);
+      }
+      affected_set.emplace(oid);
+    }
+
+    // ノードを取り除く．
+    for ( auto iid: info.mFaninList ) {
+      erase_fanout(iid, id);
+    }
+    info.mKind = NodeKind::None;
+    info.mFaninList.clear();
+    info.mFanoutList.clear();
+    ++ info.mStamp;
+    ++ eliminated_num;
+
+    // 評価値が変わりうるのはファンアウト先とそのファンインのみ
+    for ( auto id1: affected_set ) {
+      push_cand(id1);
+    }
+  }
+
+  // 結果をネットワークに反映させる．
+  for ( SizeType id = 0; id <= n; ++ id ) {
+    auto& info = mInfoArray[id];
+    if ( !info.mChanged || info.mKind == NodeKind::None ) {
+      continue;
+    }
+    auto node = mNetwork.node(id);
+    SizeType ni = info.mFaninList.size();
+    vector<BnNode> fanin_list;
+    fanin_list.reserve(ni);
+    for ( auto iid: info.mFaninList ) {
+      fanin_list.push_back(mNetwork.node(iid));
+    }
+    if ( info.mKind == NodeKind::TvFunc ) {
+      mNetwork.change_tv(node, info.mExpr.make_tv(ni), fanin_list);
+    }
+    else {
+      mNetwork.change_expr(node, info.mExpr, fanin_list);
+    }
+  }
+
+  return eliminated_num;
+}
+
+// @brief ノードの情報を初期化する．
+void
+Eliminate::init_node(
+  const BnNode& node
+)
+{
+  auto& info = mInfoArray[node.id()];
+  SizeType ni = node.fanin_num();
+  info.mFaninList.clear();
+  info.mFaninList.reserve(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    info.mFaninList.push_back(node.fanin_id(i));
+  }
+  info.mKind = NodeKind::Keep;
+  if ( ni > mFaninLimit ) {
+    // 併合先にも併合元にもならない．
+    return;
+  }
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+  case BnNodeType::Expr:
+    info.mKind = NodeKind::Expr;
+    break;
+
+  case BnNodeType::TvFunc:
+    info.mKind = NodeKind::TvFunc;
+    break;
+
+  default:
+    return;
+  }
+  info.mExpr = node_expr(node);
+  info.mLitNum = count_literals(info.mExpr);
+}
+
+// @brief ノードを評価してワークリストに積む．
+void
+Eliminate::push_cand(
+  SizeType id
+)
+{
+  auto& info = mInfoArray[id];
+  ++ info.mStamp;
+  int value;
+  vector<Collapsed> result_list;
+  if ( calc_collapse(id, value, result_list) ) {
+    mQueue.push(make_tuple(value, id, info.mStamp));
+  }
+}
+
+// @brief ノードを併合した結果を求める．
+bool
+Eliminate::calc_collapse(
+  SizeType id,
+  int& value,
+  vector<Collapsed>& result_list
+)
+{
+  auto& info = mInfoArray[id];
+  if ( info.mKind != NodeKind::Expr && info.mKind != NodeKind::TvFunc ) {
+    return false;
+  }
+  if ( info.mFixed || info.mFanoutList.empty() ) {
+    return false;
+  }
+
+  value = - static_cast<int>(info.mLitNum);
+  for ( auto oid: info.mFanoutList ) {
+    auto& oinfo = mInfoArray[oid];
+    if ( oinfo.mKind != NodeKind::Expr && oinfo.mKind != NodeKind::TvFunc ) {
+      return false;
+    }
+    auto result = compose(id, oid);
+    if ( result.mFaninList.size() > mFaninLimit ||
+	 result.mLitNum > mLiteralLimit ) {
+      return false;
+    }
+    value += static_cast<int>(result.mLitNum) - static_cast<int>(oinfo.mLitNum);
+    result_list.push_back(std::move(result));
+  }
+  return value <= mValueLimit;
+}
+
+// @brief ノードをファンアウト先に代入した結果を求める．
+Eliminate::Collapsed
+Eliminate::compose(
+  SizeType id,
+  SizeType fanout_id
+)
+{
+  auto& info = mInfoArray[id];
+  auto& oinfo = mInfoArray[fanout_id];
+
+  // 併合後のファンインは元のファンアウト先のファンイン(id を除く)に
+  // id のファンインを加えたものとなる．同じノードは1つにまとめる．
+  Collapsed result;
+  result.mId = fanout_id;
+  unordered_map<SizeType, SizeType> var_map;
+  SizeType oni = oinfo.mFaninList.size();
+  vector<Expr> sub_list(oni);
+  for ( SizeType i = 0; i < oni; ++ i ) {
+    auto iid = oinfo.mFaninList[i];
+    if ( iid == id ) {
+      continue;
+    }
+    if ( var_map.count(iid) == 0 ) {
+      var_map.emplace(iid, result.mFaninList.size());
+      result.mFaninList.push_back(iid);
+    }
+    sub_list[i] = Expr::make_posi_literal(var_map.at(iid));
+  }
+  SizeType ni = info.mFaninList.size();
+  vector<Expr> sub_list1(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto iid = info.mFaninList[i];
+    if ( var_map.count(iid) == 0 ) {
+      var_map.emplace(iid, result.mFaninList.size());
+      result.mFaninList.push_back(iid);
+    }
+    sub_list1[i] = Expr::make_posi_literal(var_map.at(iid));
+  }
+  auto expr = compose_expr(info.mExpr, sub_list1);
+  for ( SizeType i = 0; i < oni; ++ i ) {
+    if ( oinfo.mFaninList[i] == id ) {
+      sub_list[i] = expr;
+    }
+  }
+  result.mExpr = compose_expr(oinfo.mExpr, sub_list);
+  result.mLitNum = count_literals(result.mExpr);
+  return result;
+}
+
+// @brief ファンアウトリストから要素を取り除く．
+void
+Eliminate::erase_fanout(
+  SizeType id,
+  SizeType fanout_id
+)
+{
+  auto& fanout_list = mInfoArray[id].mFanoutList;
+  auto p = std::find(fanout_list.begin(), fanout_list.end(), fanout_id);
+  if ( p != fanout_list.end() ) {
+    fanout_list.erase(p);
+  }
+}
+
+// @brief ファンアウトリストに要素を加える．
+void
+Eliminate::add_fanout(
+  SizeType id,
+  SizeType fanout_id
+)
+{
+  auto& fanout_list = mInfoArray[id].mFanoutList;
+  auto p = std::find(fanout_list.begin(), fanout_list.end(), fanout_id);
+  if ( p == fanout_list.end() ) {
+    fanout_list.push_back(fanout_id);
+  }
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,210 @@
+#ifndef ELIMINATE_H
+#define ELIMINATE_H
+
+/// @file Eliminate.h
+/// @brief Eliminate のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "ym/Expr.h"
+#include <queue>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class Eliminate Eliminate.h "Eliminate.h"
+/// @brief 論理ノードをファンアウト先に併合(collapse)するクラス
+///
+/// SIS の eliminate と同様の処理を行う．
+/// - ノードの関数をファンアウト先の論理式に代入し，ノードを取り除く．
+/// - ノードの評価値(value)は併合によって増えるリテラル数
+///   (併合後のファンアウト先のリテラル数 - 併合前のファンアウト先の
+///   リテラル数 - ノード自身のリテラル数)とする．
+/// - 併合後のファンアウト先のファンイン数が fanin_limit 以下，
+///   リテラル数が literal_limit 以下で，評価値が value_limit 以下の
+///   ノードのみを併合する．
+/// - 評価値の小さいノードから順に処理する．併合によって評価値が
+///   変わるのは局所的なノードのみなので，それらのみを再評価して
+///   ワークリストに積み直す．
+///
+/// 処理はネットワーク上で直接行う．
+/// - プリミティブ型，論理式型，真理値表型のノードが対象となる．
+///   BDD型とセル型のノードはそのまま残し，そのファンインも併合しない．
+/// - 出力(DFFの入力を含む)に接続しているノードは併合しない．
+/// - 真理値表型のノードは併合後も真理値表型とする．
+///   それ以外は論理式型となる．
+/// - 取り除いたノードはネットワーク上に残るので，後で BnNetwork::sweep() を
+///   用いて取り除く必要がある．
+//////////////////////////////////////////////////////////////////////
+class Eliminate
+{
+public:
+
+  /// @brief コンストラクタ
+  Eliminate(
+    BnModifier& network,    ///< [in] 対象のネットワーク
+    SizeType fanin_limit,   ///< [in] 併合後のファンイン数の上限
+    SizeType literal_limit, ///< [in] 併合後のリテラル数の上限
+    int value_limit         ///< [in] 評価値の上限
+  );
+
+  /// @brief デストラクタ
+  ~Eliminate() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 併合を行う．
+  /// @return 取り除いたノード数を返す．
+  SizeType
+  eliminate();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの種類
+  enum class NodeKind {
+    None,   // 論理ノード以外か取り除いたノード
+    Expr,   // 論理式として扱うノード
+    TvFunc, // 論理式として扱い，最後に真理値表に戻すノード
+    Keep    // そのまま残すノード
+  };
+
+  // ノードの情報
+  struct NodeInfo
+  {
+    // 種類
+    NodeKind mKind{NodeKind::None};
+
+    // 論理式
+    Expr mExpr;
+
+    // リテラル数
+    SizeType mLitNum{0};
+
+    // ファンインのノード番号のリスト
+    vector<SizeType> mFaninList;
+
+    // ファンアウトのノード番号のリスト
+    vector<SizeType> mFanoutList;
+
+    // 併合できないファンアウト(出力など)を持つ時 true
+    bool mFixed{false};
+
+    // 関数が変わった時 true
+    bool mChanged{false};
+
+    // ワークリストの世代番号
+    SizeType mStamp{0};
+  };
+
+  // 併合後のファンアウト先の関数
+  struct Collapsed
+  {
+    // ファンアウト先のノード番号
+    SizeType mId;
+
+    // 論理式
+    Expr mExpr;
+
+    // リテラル数
+    SizeType mLitNum;
+
+    // ファンインのノード番号のリスト
+    vector<SizeType> mFaninList;
+  };
+
+  // ワークリストの要素 (評価値, ノード番号, 世代番号)
+  using Cand = tuple<int, SizeType, SizeType>;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの情報を初期化する．
+  void
+  init_node(
+    const BnNode& node ///< [in] 論理ノード
+  );
+
+  /// @brief ノードを評価してワークリストに積む．
+  ///
+  /// 併合の条件を満たさない場合はなにもしない．
+  void
+  push_cand(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief ノードを併合した結果を求める．
+  /// @return 併合の条件を満たす時 true を返す．
+  bool
+  calc_collapse(
+    SizeType id,                    ///< [in] ノード番号
+    int& value,                     ///< [out] 評価値
+    vector<Collapsed>& result_list  ///< [out] 併合後の関数のリスト
+  );
+
+  /// @brief ノードをファンアウト先に代入した結果を求める．
+  Collapsed
+  compose(
+    SizeType id,       ///< [in] 代入するノード番号
+    SizeType fanout_id ///< [in] ファンアウト先のノード番号
+  );
+
+  /// @brief ファンアウトリストから要素を取り除く．
+  void
+  erase_fanout(
+    SizeType id,       ///< [in] ノード番号
+    SizeType fanout_id ///< [in] 取り除くファンアウトのノード番号
+  );
+
+  /// @brief ファンアウトリストに要素を加える．
+  ///
+  /// すでに含まれている場合はなにもしない．
+  void
+  add_fanout(
+    SizeType id,       ///< [in] ノード番号
+    SizeType fanout_id ///< [in] 加えるファンアウトのノード番号
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  BnModifier& mNetwork;
+
+  // 併合後のファンイン数の上限
+  SizeType mFaninLimit;
+
+  // 併合後のリテラル数の上限
+  SizeType mLiteralLimit;
+
+  // 評価値の上限
+  int mValueLimit;
+
+  // ノード番号をキーにしてノードの情報を格納する配列
+  vector<NodeInfo> mInfoArray;
+
+  // ワークリスト
+  std::priority_queue<Cand, vector<Cand>, std::greater<Cand>> mQueue;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // ELIMINATE_H
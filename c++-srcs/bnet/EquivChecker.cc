@@ -0,0 +1,167 @@
+
+/// @file EquivChecker.cc
+/// @brief EquivChecker の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "EquivChecker.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス EquivChecker
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+EquivChecker::EquivChecker(
+  const SatSolverType& solver_type,
+  SizeType conflict_limit
+) : mSolver{solver_type},
+    mConflictLimit{conflict_limit}
+{
+}
+
+// @brief 入力用の変数を作る．
+SatLiteral
+EquivChecker::new_input()
+{
+  auto lit = mSolver.new_variable(true);
+  mInputLitList.push_back(lit);
+  return lit;
+}
+
+// @brief 2つのリテラルが等価か調べる．
+SatBool3
+EquivChecker::check_equiv(
+  SatLiteral lit1,
+  SatLiteral lit2,
+  vector<bool>& cex
+)
+{
+  auto ans = SatBool3::True;
+  for ( int b: {0, 1} ) {
+    vector<SatLiteral> assumptions{lit1, ~lit2};
+    if ( b ) {
+      assumptions = vector<SatLiteral>{~lit1, lit2};
+    }
+    if ( mConflictLimit > 0 ) {
+      mSolver.set_conflict_budget(mConflictLimit);
+    }
+    auto stat = mSolver.solve(assumptions);
+    if ( stat == SatBool3::True ) {
+      SizeType ni = mInputLitList.size();
+      cex.resize(ni);
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	cex[i] = mSolver.read_model(mInputLitList[i]) == SatBool3::True;
+      }
+      return SatBool3::False;
+    }
+    if ( stat == SatBool3::X ) {
+      ans = SatBool3::X;
+    }
+  }
+  if ( ans == SatBool3::True ) {
+    mSolver.add_clause(~lit1,  lit2);
+    mSolver.add_clause( lit1, ~lit2);
+  }
+  return ans;
+}
+
+// @brief 等価候補の辞書を作り直す．
+void
+EquivChecker::make_cand_map(
+  const vector<SizeType>& id_list,
+  const vector<vector<PackedVal>>& sig_array
+)
+{
+  mCandMap.clear();
+  for ( auto id: id_list ) {
+    add_cand(id, sig_array[id]);
+  }
+}
+
+// @brief 等価候補を辞書に登録する．
+void
+EquivChecker::add_cand(
+  SizeType id,
+  const vector<PackedVal>& sig
+)
+{
+  auto sig1 = sig;
+  bool inv = normalize(sig1);
+  if ( mCandMap.count(sig1) == 0 ) {
+    mCandMap.emplace(sig1, make_pair(id, inv));
+  }
+}
+
+// @brief 等価候補を辞書に登録する．
+void
+EquivChecker::replace_cand(
+  SizeType id,
+  const vector<PackedVal>& sig
+)
+{
+  auto sig1 = sig;
+  bool inv = normalize(sig1);
+  mCandMap[sig1] = make_pair(id, inv);
+}
+
+// @brief シグネチャが等しい等価候補を探す．
+bool
+EquivChecker::find_cand(
+  const vector<PackedVal>& sig,
+  SizeType& id,
+  bool& inv
+) const
+{
+  auto sig1 = sig;
+  bool inv1 = normalize(sig1);
+  if ( mCandMap.count(sig1) == 0 ) {
+    return false;
+  }
+  const auto& cand = mCandMap.at(sig1);
+  id = cand.first;
+  inv = cand.second != inv1;
+  return true;
+}
+
+// @brief 反例をシミュレーションパタンに加える．
+bool
+EquivChecker::add_pattern(
+  const vector<bool>& cex
+)
+{
+  mPatList.push_back(cex);
+  return mPatList.size() == 64;
+}
+
+// @brief たまっている反例を 64 ビットにまとめて取り出す．
+bool
+EquivChecker::pack_pattern(
+  vector<PackedVal>& ival_list
+)
+{
+  if ( mPatList.empty() ) {
+    return false;
+  }
+  SizeType ni = mInputLitList.size();
+  ival_list.clear();
+  ival_list.resize(ni, 0UL);
+  // 余ったビットには最後のパタンを複製する．
+  for ( SizeType b = 0; b < 64; ++ b ) {
+    SizeType k = std::min(b, mPatList.size() - 1);
+    auto& pat = mPatList[k];
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      if ( pat[i] ) {
+	ival_list[i] |= (1UL << b);
+      }
+    }
+  }
+  mPatList.clear();
+  return true;
+}
+
+END_NAMESPACE_YM_BNET
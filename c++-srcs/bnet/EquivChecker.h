@@ -0,0 +1,176 @@
+#ifndef EQUIVCHECKER_H
+#define EQUIVCHECKER_H
+
+/// @file EquivChecker.h
+/// @brief EquivChecker のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/SatSolver.h"
+#include "Simulator.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class EquivChecker EquivChecker.h "EquivChecker.h"
+/// @brief シミュレーションと SAT を用いた等価性判定の補助クラス
+///
+/// BnCec と Fraig で共通に用いる以下の処理をまとめたもの．
+/// - 正規化したシグネチャをキーにした等価候補の辞書
+/// - SAT による2つのリテラルの等価性判定
+/// - SAT の反例を 64 個ずつまとめたシミュレーションパタン
+///
+/// シミュレーションとシグネチャの管理は使う側で行う．
+/// CNF 式の符号化器は solver() を用いて作る．
+//////////////////////////////////////////////////////////////////////
+class EquivChecker
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// conflict_limit が 0 の時は制限なしとなる．
+  EquivChecker(
+    const SatSolverType& solver_type, ///< [in] SATソルバのタイプ
+    SizeType conflict_limit           ///< [in] SAT 1回あたりのコンフリクト数の上限
+  );
+
+  /// @brief デストラクタ
+  ~EquivChecker() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // SAT 関係の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief SATソルバを返す．
+  SatSolver&
+  solver()
+  {
+    return mSolver;
+  }
+
+  /// @brief 入力用の変数を作る．
+  /// @return 作った変数のリテラルを返す．
+  ///
+  /// 反例はこの関数を呼んだ順に入力値を並べたものとなる．
+  SatLiteral
+  new_input();
+
+  /// @brief 入力数を返す．
+  SizeType
+  input_num() const
+  {
+    return mInputLitList.size();
+  }
+
+  /// @brief 2つのリテラルが等価か調べる．
+  ///
+  /// - 等価な場合には等価性を表す節を追加する．
+  /// - 等価でない場合には cex に反例を入れる．
+  SatBool3
+  check_equiv(
+    SatLiteral lit1,  ///< [in] リテラル1
+    SatLiteral lit2,  ///< [in] リテラル2
+    vector<bool>& cex ///< [out] 反例
+  );
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 等価候補の辞書に関する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 等価候補の辞書を作り直す．
+  ///
+  /// id_list の順に add_cand() を呼ぶ．
+  void
+  make_cand_map(
+    const vector<SizeType>& id_list,           ///< [in] 候補のノード番号のリスト
+    const vector<vector<PackedVal>>& sig_array ///< [in] ノード番号をキーにしたシグネチャの配列
+  );
+
+  /// @brief 等価候補を辞書に登録する．
+  ///
+  /// 同じシグネチャのノードが既に登録されていた場合は何もしない．
+  void
+  add_cand(
+    SizeType id,                 ///< [in] ノード番号
+    const vector<PackedVal>& sig ///< [in] シグネチャ
+  );
+
+  /// @brief 等価候補を辞書に登録する．
+  ///
+  /// 同じシグネチャのノードが既に登録されていた場合は置き換える．
+  /// SAT で非等価と分かった候補と比べ続けないようにするために用いる．
+  void
+  replace_cand(
+    SizeType id,                 ///< [in] ノード番号
+    const vector<PackedVal>& sig ///< [in] シグネチャ
+  );
+
+  /// @brief シグネチャが等しい等価候補を探す．
+  /// @return 見つかった時 true を返す．
+  ///
+  /// inv には sig に対して逆相の時 true が入る．
+  bool
+  find_cand(
+    const vector<PackedVal>& sig, ///< [in] シグネチャ
+    SizeType& id,                 ///< [out] 候補のノード番号
+    bool& inv                     ///< [out] 反転フラグ
+  ) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 反例のパタンに関する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 反例をシミュレーションパタンに加える．
+  /// @return 64 個たまった時 true を返す．
+  bool
+  add_pattern(
+    const vector<bool>& cex ///< [in] 反例
+  );
+
+  /// @brief たまっている反例を 64 ビットにまとめて取り出す．
+  /// @return 反例がなかった時 false を返す．
+  ///
+  /// 余ったビットには最後のパタンを複製する．
+  bool
+  pack_pattern(
+    vector<PackedVal>& ival_list ///< [out] 入力値のリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // SATソルバ
+  SatSolver mSolver;
+
+  // SAT 1回あたりのコンフリクト数の上限
+  SizeType mConflictLimit;
+
+  // 入力のリテラルのリスト
+  vector<SatLiteral> mInputLitList;
+
+  // 正規化したシグネチャをキーにして候補のノード番号と
+  // 反転フラグを格納する辞書
+  unordered_map<vector<PackedVal>, pair<SizeType, bool>, SigHash> mCandMap;
+
+  // シミュレーションに加える反例のリスト
+  vector<vector<bool>> mPatList;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // EQUIVCHECKER_H
@@ -0,0 +1,136 @@
+
+/// @file ExprUtil.cc
+/// @brief 論理式を扱う関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ExprUtil.h"
+#include "ym/BnNode.h"
+#include "ym/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+// @brief プリミティブ型の関数を論理式にする．
+Expr
+prim_expr(
+  PrimType prim_type,
+  SizeType ni
+)
+{
+  vector<Expr> lit_list(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    lit_list[i] = Expr::make_posi_literal(i);
+  }
+  switch ( prim_type ) {
+  case PrimType::C0:   return Expr::make_zero();
+  case PrimType::C1:   return Expr::make_one();
+  case PrimType::Buff: return lit_list[0];
+  case PrimType::Not:  return ~lit_list[0];
+  case PrimType::And:  return Expr::make_and(lit_list);
+  case PrimType::Nand: return ~Expr::make_and(lit_list);
+  case PrimType::Or:   return Expr::make_or(lit_list);
+  case PrimType::Nor:  return ~Expr::make_or(lit_list);
+  case PrimType::Xor:  return Expr::make_xor(lit_list);
+  case PrimType::Xnor: return ~Expr::make_xor(lit_list);
+  default: break;
+  }
+  ASSERT_NOT_REACHED;
+  return Expr::make_zero();
+}
+
+// @brief 非冗長積和形を論理式にする．
+Expr
+cover_expr(
+  const vector<IsopCube>& cover
+)
+{
+  vector<Expr> cube_list;
+  cube_list.reserve(cover.size());
+  for ( auto& cube: cover ) {
+    if ( cube.empty() ) {
+      return Expr::make_one();
+    }
+    vector<Expr> lit_list;
+    lit_list.reserve(cube.size());
+    for ( auto lit: cube ) {
+      lit_list.push_back(Expr::make_literal(lit / 2, (lit & 1) == 1));
+    }
+    if ( lit_list.size() == 1 ) {
+      cube_list.push_back(lit_list[0]);
+    }
+    else {
+      cube_list.push_back(Expr::make_and(lit_list));
+    }
+  }
+  if ( cube_list.empty() ) {
+    return Expr::make_zero();
+  }
+  if ( cube_list.size() == 1 ) {
+    return cube_list[0];
+  }
+  return Expr::make_or(cube_list);
+}
+
+// @brief 論理ノードの関数を論理式にする．
+Expr
+node_expr(
+  const BnNode& node
+)
+{
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    return prim_expr(node.primitive_type(), node.fanin_num());
+
+  case BnNodeType::Expr:
+    return node.expr();
+
+  case BnNodeType::TvFunc:
+    return cover_expr(isop(node.func()));
+
+  default:
+    break;
+  }
+  ASSERT_NOT_REACHED;
+  return Expr::make_zero();
+}
+
+// @brief 論理式の変数に論理式を代入する．
+Expr
+compose_expr(
+  const Expr& expr,
+  const vector<Expr>& sub_list
+)
+{
+  if ( expr.is_zero() || expr.is_one() ) {
+    return expr;
+  }
+  if ( expr.is_posi_literal() ) {
+    return sub_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return ~sub_list[expr.varid()];
+  }
+
+  ASSERT_COND( expr.is_op() );
+  vector<Expr> opr_list;
+  opr_list.reserve(expr.operand_num());
+  for ( auto& opr: expr.operand_list() ) {
+    opr_list.push_back(compose_expr(opr, sub_list));
+  }
+  if ( expr.is_and() ) {
+    return Expr::make_and(opr_list);
+  }
+  if ( expr.is_or() ) {
+    return Expr::make_or(opr_list);
+  }
+  if ( expr.is_xor() ) {
+    return Expr::make_xor(opr_list);
+  }
+  ASSERT_NOT_REACHED;
+  return Expr::make_zero();
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,51 @@
+#ifndef EXPRUTIL_H
+#define EXPRUTIL_H
+
+/// @file ExprUtil.h
+/// @brief 論理式を扱う関数のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/Expr.h"
+#include "Isop.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+/// @brief プリミティブ型の関数を論理式にする．
+Expr
+prim_expr(
+  PrimType prim_type, ///< [in] プリミティブ型
+  SizeType ni         ///< [in] 入力数
+);
+
+/// @brief 非冗長積和形を論理式にする．
+Expr
+cover_expr(
+  const vector<IsopCube>& cover ///< [in] 積項のリスト
+);
+
+/// @brief 論理ノードの関数を論理式にする．
+///
+/// プリミティブ型，論理式型，真理値表型のノードのみが対象となる．
+/// 真理値表型は非冗長積和形を用いる．
+Expr
+node_expr(
+  const BnNode& node ///< [in] 対象のノード
+);
+
+/// @brief 論理式の変数に論理式を代入する．
+///
+/// 変数 i は sub_list[i] に置き換えられる．
+Expr
+compose_expr(
+  const Expr& expr,            ///< [in] 元の論理式
+  const vector<Expr>& sub_list ///< [in] 代入する論理式のリスト
+);
+
+END_NAMESPACE_YM_BNET
+
+#endif // EXPRUTIL_H
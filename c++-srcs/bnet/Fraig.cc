@@ -0,0 +1,193 @@
+
+/// @file Fraig.cc
+/// @brief Fraig の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Fraig.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNode.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 機能的に等価なノードを併合したネットワークを返す．
+BnNetwork
+BnNetwork::fraig(
+  SizeType sim_num,
+  SizeType conflict_limit,
+  SizeType& merged_num
+) const
+{
+  BnModifier mod{BnNetwork{*this}};
+  Fraig op{mod, conflict_limit};
+  merged_num = op.fraig(sim_num);
+  BnNetwork network{std::move(mod)};
+  return network.sweep();
+}
+
+// @brief 機能的に等価なノードを併合したネットワークを返す．
+BnNetwork
+BnNetwork::fraig(
+  SizeType sim_num,
+  SizeType conflict_limit
+) const
+{
+  SizeType merged_num;
+  return fraig(sim_num, conflict_limit, merged_num);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Fraig
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Fraig::Fraig(
+  BnModifier& network,
+  SizeType conflict_limit
+) : mNetwork{network},
+    mSim{network},
+    mSigArray(network.node_num() + 1),
+    mEquiv{SatSolverType{}, conflict_limit},
+    mEnc{mEquiv.solver(), network}
+{
+  for ( auto node: mNetwork.input_list() ) {
+    auto lit = mEquiv.new_input();
+    mEnc.set_lit(node.id(), lit);
+  }
+
+  auto& solver = mEquiv.solver();
+  mConstLit = solver.new_variable(false);
+  solver.add_clause(mConstLit);
+}
+
+// @brief 等価なノードを併合する．
+SizeType
+Fraig::fraig(
+  SizeType sim_num
+)
+{
+  SizeType ni = mEquiv.input_num();
+  vector<PackedVal> ival_list(ni);
+  for ( SizeType c = 0; c < sim_num; ++ c ) {
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      ival_list[i] = mRandGen();
+    }
+    simulate(ival_list);
+  }
+
+  // 定数0と入力ノードは常に代表ノードとなる．
+  // 定数0は BNET_NULLID で表し，シグネチャは mSigArray[BNET_NULLID] に置く．
+  mRepList.push_back(BNET_NULLID);
+  mEquiv.add_cand(BNET_NULLID, mSigArray[BNET_NULLID]);
+  for ( auto node: mNetwork.input_list() ) {
+    auto id = node.id();
+    mRepList.push_back(id);
+    mEquiv.add_cand(id, mSigArray[id]);
+  }
+
+  // 途中でノードを置き換えるので先にノード番号のリストを作っておく．
+  // logic_list() はトポロジカル順とは限らないので並べ直したものを用いる．
+  vector<SizeType> id_list;
+  id_list.reserve(mNetwork.logic_num());
+  for ( auto node: mNetwork.sorted_logic_list() ) {
+    id_list.push_back(node.id());
+  }
+
+  SizeType merged_num = 0;
+  // 同相で併合したノードと代表ノードの対のリスト
+  vector<pair<SizeType, SizeType>> subst_list;
+  for ( auto id: id_list ) {
+    SizeType rep_id;
+    bool rep_inv;
+    if ( !mEquiv.find_cand(mSigArray[id], rep_id, rep_inv) ) {
+      mRepList.push_back(id);
+      mEquiv.add_cand(id, mSigArray[id]);
+      continue;
+    }
+
+    auto rep_lit = rep_id == BNET_NULLID ? ~mConstLit : mEnc.make_cnf(rep_id);
+    auto lit = mEnc.make_cnf(id);
+    if ( rep_inv ) {
+      rep_lit = ~rep_lit;
+    }
+    vector<bool> cex;
+    auto stat = mEquiv.check_equiv(rep_lit, lit, cex);
+    if ( stat == SatBool3::True ) {
+      // 代表ノードはこのノードよりも前にあるので
+      // その場で置き換えてもトポロジカル順は保たれる．
+      auto node = mNetwork.node(id);
+      if ( rep_id == BNET_NULLID ) {
+	auto prim_type = rep_inv ? PrimType::C1 : PrimType::C0;
+	mNetwork.change_primitive(node, prim_type, {});
+	++ merged_num;
+	continue;
+      }
+      auto rep_node = mNetwork.node(rep_id);
+      if ( rep_inv ) {
+	mNetwork.change_primitive(node, PrimType::Not, {rep_node});
+      }
+      else {
+	mNetwork.change_primitive(node, PrimType::Buff, {rep_node});
+	subst_list.push_back(make_pair(id, rep_id));
+      }
+      ++ merged_num;
+    }
+    else {
+      // 反例を反映するまではシグネチャが変わらないので，
+      // 後続のノードが同じ代表ノードと比べ続けないように置き換えておく．
+      mRepList.push_back(id);
+      mEquiv.replace_cand(id, mSigArray[id]);
+      if ( stat == SatBool3::False && mEquiv.add_pattern(cex) ) {
+	flush_pattern();
+      }
+    }
+  }
+
+  // 同相で併合したノードのファンアウトを代表ノードにつなぎ替える．
+  mNetwork.wrap_up();
+  for ( auto& p: subst_list ) {
+    auto old_node = mNetwork.node(p.first);
+    auto new_node = mNetwork.node(p.second);
+    mNetwork.substitute_fanout(old_node, new_node);
+  }
+
+  return merged_num;
+}
+
+// @brief 64パタン分のシミュレーションを行いシグネチャに加える．
+void
+Fraig::simulate(
+  const vector<PackedVal>& ival_list
+)
+{
+  mSim.simulate(ival_list);
+  // 定数0のシグネチャ
+  mSigArray[BNET_NULLID].push_back(0UL);
+  for ( SizeType id = 1; id < mSigArray.size(); ++ id ) {
+    mSigArray[id].push_back(mSim.val(id));
+  }
+}
+
+// @brief たまっている反例を用いてシミュレーションを行う．
+void
+Fraig::flush_pattern()
+{
+  vector<PackedVal> ival_list;
+  if ( !mEquiv.pack_pattern(ival_list) ) {
+    return;
+  }
+  simulate(ival_list);
+
+  // シグネチャが変わったので辞書を作り直す．
+  mEquiv.make_cand_map(mRepList, mSigArray);
+}
+
+END_NAMESPACE_YM_BNET
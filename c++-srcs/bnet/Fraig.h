@@ -0,0 +1,124 @@
+#ifndef FRAIG_H
+#define FRAIG_H
+
+/// @file Fraig.h
+/// @brief Fraig のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "ym/BnNodeEnc.h"
+#include "Simulator.h"
+#include "EquivChecker.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class Fraig Fraig.h "Fraig.h"
+/// @brief SAT sweeping により機能的に等価なノードを併合するクラス
+///
+/// 以下の手順で処理を行う．
+/// 1. ランダムシミュレーションで各ノードのシグネチャを求める．
+/// 2. 論理ノードをトポロジカル順に調べ，(極性を正規化した)シグネチャが
+///    等しい先行ノード(代表ノード)との等価性を SAT で調べる．
+///    定数0も代表ノードの候補とし，等価な場合は定数ノードに置き換える．
+///    - 等価な場合は等価性を表す節を追加し，ノードをバッファ(逆相の場合は
+///      インバーター)に置き換える．ノード番号は変わらないので
+///      トポロジカル順は保たれる．
+///    - 等価でない場合はそのノードを新たな代表ノードとし，
+///      反例を 64 個ずつまとめてシミュレーションしてシグネチャを細分化する．
+/// 3. 同相で併合したノードのファンアウトを substitute_fanout() で
+///    代表ノードにつなぎ替える．
+///
+/// 併合したノードはネットワーク上に残るので，後で BnNetwork::sweep() を
+/// 用いて取り除く必要がある．
+//////////////////////////////////////////////////////////////////////
+class Fraig
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// conflict_limit が 0 の時は制限なしとなる．
+  Fraig(
+    BnModifier& network,    ///< [in] 対象のネットワーク
+    SizeType conflict_limit ///< [in] SAT 1回あたりのコンフリクト数の上限
+  );
+
+  /// @brief デストラクタ
+  ~Fraig() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 等価なノードを併合する．
+  /// @return 併合したノード数を返す．
+  SizeType
+  fraig(
+    SizeType sim_num ///< [in] ランダムシミュレーションの回数
+                     ///<      (1回あたり64パタン)
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 64パタン分のシミュレーションを行いシグネチャに加える．
+  void
+  simulate(
+    const vector<PackedVal>& ival_list ///< [in] 入力値のリスト
+  );
+
+  /// @brief たまっている反例を用いてシミュレーションを行う．
+  ///
+  /// シグネチャが変わるので代表ノードの辞書を作り直す．
+  void
+  flush_pattern();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  BnModifier& mNetwork;
+
+  // 乱数生成器
+  std::mt19937_64 mRandGen;
+
+  // シミュレータ
+  Simulator mSim;
+
+  // ノード番号をキーにしてシグネチャを格納する配列
+  // BNET_NULLID の位置には定数0のシグネチャを置く．
+  vector<vector<PackedVal>> mSigArray;
+
+  // 代表ノードのリスト
+  // トポロジカル順に並んでいる．
+  vector<SizeType> mRepList;
+
+  // 代表ノードの辞書と SAT による等価性判定
+  // 入力は input_list() の順に登録する．
+  EquivChecker mEquiv;
+
+  // CNF 式の符号化器
+  BnNodeEnc mEnc;
+
+  // 定数1を表すリテラル
+  SatLiteral mConstLit;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // FRAIG_H
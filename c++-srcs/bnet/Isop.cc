@@ -0,0 +1,123 @@
+
+/// @file Isop.cc
+/// @brief 非冗長積和形(ISOP)を求める関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Isop.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// L <= f <= U を満たす非冗長積和形を求める．
+// 結果は cover に追加され，その真理値表を返す．
+//
+// 真理値表は k 変数のもので，変数 k - 1 が最上位ビットに対応する．
+// Minato-Morreale のアルゴリズムを用いる．
+vector<bool>
+isop_sub(
+  const vector<bool>& L,
+  const vector<bool>& U,
+  SizeType k,
+  vector<IsopCube>& cover
+)
+{
+  SizeType n = L.size();
+  bool l_zero = true;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( L[i] ) {
+      l_zero = false;
+      break;
+    }
+  }
+  if ( l_zero ) {
+    return vector<bool>(n, false);
+  }
+  bool u_one = true;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    if ( !U[i] ) {
+      u_one = false;
+      break;
+    }
+  }
+  if ( u_one ) {
+    cover.push_back(IsopCube{});
+    return vector<bool>(n, true);
+  }
+  ASSERT_COND( k > 0 );
+
+  SizeType var = k - 1;
+  SizeType half = n / 2;
+
+  // var = 0 の部分でのみ必要な積項
+  vector<bool> tmp(half);
+  for ( SizeType i = 0; i < half; ++ i ) {
+    tmp[i] = L[i] && !U[i + half];
+  }
+  vector<bool> U0(U.begin(), U.begin() + half);
+  vector<IsopCube> cover0;
+  auto R0 = isop_sub(tmp, U0, k - 1, cover0);
+
+  // var = 1 の部分でのみ必要な積項
+  for ( SizeType i = 0; i < half; ++ i ) {
+    tmp[i] = L[i + half] && !U[i];
+  }
+  vector<bool> U1(U.begin() + half, U.end());
+  vector<IsopCube> cover1;
+  auto R1 = isop_sub(tmp, U1, k - 1, cover1);
+
+  // 残りの部分は var を含まない積項で覆う．
+  vector<bool> Us(half);
+  for ( SizeType i = 0; i < half; ++ i ) {
+    tmp[i] = (L[i] && !R0[i]) || (L[i + half] && !R1[i]);
+    Us[i] = U[i] && U[i + half];
+  }
+  vector<IsopCube> cover_s;
+  auto Rs = isop_sub(tmp, Us, k - 1, cover_s);
+
+  for ( auto& cube: cover0 ) {
+    cube.push_back(var * 2 + 1);
+    cover.push_back(std::move(cube));
+  }
+  for ( auto& cube: cover1 ) {
+    cube.push_back(var * 2 + 0);
+    cover.push_back(std::move(cube));
+  }
+  for ( auto& cube: cover_s ) {
+    cover.push_back(std::move(cube));
+  }
+
+  vector<bool> R(n);
+  for ( SizeType i = 0; i < half; ++ i ) {
+    R[i] = R0[i] || Rs[i];
+    R[i + half] = R1[i] || Rs[i];
+  }
+  return R;
+}
+
+END_NONAMESPACE
+
+
+// @brief 真理値表の非冗長積和形(ISOP)を求める．
+vector<IsopCube>
+isop(
+  const TvFunc& func,
+  bool inv
+)
+{
+  SizeType ni = func.input_num();
+  SizeType np = 1 << ni;
+  vector<bool> f(np);
+  for ( SizeType p = 0; p < np; ++ p ) {
+    f[p] = (func.value(p) != 0) ^ inv;
+  }
+  vector<IsopCube> cover;
+  isop_sub(f, f, ni, cover);
+  return cover;
+}
+
+END_NAMESPACE_YM_BNET
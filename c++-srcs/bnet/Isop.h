@@ -0,0 +1,35 @@
+#ifndef ISOP_H
+#define ISOP_H
+
+/// @file Isop.h
+/// @brief 非冗長積和形(ISOP)を求める関数のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+/// @brief 積項を表す型
+///
+/// 要素は 変数番号 * 2 + 否定フラグ
+using IsopCube = vector<SizeType>;
+
+/// @brief 真理値表の非冗長積和形(ISOP)を求める．
+/// @return 積項のリストを返す．
+///
+/// Minato-Morreale のアルゴリズムを用いる．
+/// 定数0の場合は空のリストを，定数1の場合は空の積項を1つ含むリストを返す．
+vector<IsopCube>
+isop(
+  const TvFunc& func, ///< [in] 対象の関数
+  bool inv = false    ///< [in] true の時は否定の関数を対象とする．
+);
+
+END_NAMESPACE_YM_BNET
+
+#endif // ISOP_H
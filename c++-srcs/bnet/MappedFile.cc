@@ -0,0 +1,109 @@
+
+/// @file MappedFile.cc
+/// @brief MappedFile の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MappedFile.h"
+#include "CompCodec.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// read() で一度に読み込む大きさ
+const SizeType READ_SIZE = 1 << 16;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス MappedFile
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファイルを読み込むコンストラクタ
+MappedFile::MappedFile(
+  const string& filename
+)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    return;
+  }
+  struct stat st;
+  if ( ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 ) {
+    SizeType size = st.st_size;
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( addr != MAP_FAILED ) {
+      ::madvise(addr, size, MADV_SEQUENTIAL);
+      mMapAddr = addr;
+      mMapSize = size;
+      mContents = std::string_view{static_cast<const char*>(addr), size};
+    }
+  }
+  if ( mMapAddr == nullptr ) {
+    // 通常のファイルでない場合や mmap() が失敗した場合は全体を読み込む．
+    vector<char> buff(READ_SIZE);
+    for ( ; ; ) {
+      auto n = ::read(fd, buff.data(), buff.size());
+      if ( n < 0 && errno == EINTR ) {
+	continue;
+      }
+      if ( n < 0 ) {
+	// 読み込みエラー
+	::close(fd);
+	return;
+      }
+      if ( n == 0 ) {
+	break;
+      }
+      mBuffer.append(buff.data(), n);
+    }
+    mContents = mBuffer;
+  }
+  ::close(fd);
+
+  auto type = Decoder::detect(mContents.data(), mContents.size());
+  if ( type != CompType::None ) {
+    // 圧縮されている場合は展開した内容を mBuffer に置く．
+    string buff;
+    bool ok = Decoder::decode_all(type, mContents, buff);
+    unmap();
+    if ( !ok ) {
+      mBuffer.clear();
+      mContents = std::string_view{};
+      return;
+    }
+    mBuffer.swap(buff);
+    mContents = mBuffer;
+  }
+
+  mValid = true;
+}
+
+// @brief デストラクタ
+MappedFile::~MappedFile()
+{
+  unmap();
+}
+
+// @brief mmap() した領域を解放する．
+void
+MappedFile::unmap()
+{
+  if ( mMapAddr != nullptr ) {
+    ::munmap(mMapAddr, mMapSize);
+    mMapAddr = nullptr;
+    mMapSize = 0;
+  }
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,122 @@
+
+/// @file NameTable.cc
+/// @brief NameTable の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "NameTable.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// アリーナのブロックサイズ
+const SizeType BLOCK_SIZE = 1 << 20;
+
+// ハッシュ表の初期サイズ
+const SizeType INIT_TABLE_SIZE = 1024;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス NameTable
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+NameTable::NameTable(
+) : mTable(INIT_TABLE_SIZE, 0),
+    mMask{INIT_TABLE_SIZE - 1}
+{
+}
+
+// @brief 名前に対応する識別子番号を返す．
+SizeType
+NameTable::intern(
+  std::string_view name
+)
+{
+  auto h = hash_func(name);
+  auto pos = h & mMask;
+  for ( ; ; ) {
+    auto val = mTable[pos];
+    if ( val == 0 ) {
+      break;
+    }
+    auto id = val - 1;
+    if ( mHashArray[id] == h && mNameArray[id] == name ) {
+      return id;
+    }
+    pos = (pos + 1) & mMask;
+  }
+
+  // 新しく登録する．
+  auto id = mNameArray.size();
+  mNameArray.push_back(copy_name(name));
+  mHashArray.push_back(h);
+  mTable[pos] = id + 1;
+  if ( mNameArray.size() * 2 > mTable.size() ) {
+    // 使用率が 1/2 を超えたら拡大する．
+    expand();
+  }
+  return id;
+}
+
+// @brief 名前をアリーナにコピーする．
+std::string_view
+NameTable::copy_name(
+  std::string_view name
+)
+{
+  auto n = name.size();
+  if ( n > mFreeSize ) {
+    auto size = std::max(BLOCK_SIZE, n);
+    mBlockList.push_back(std::unique_ptr<char[]>{new char[size]});
+    mFreePtr = mBlockList.back().get();
+    mFreeSize = size;
+  }
+  auto p = mFreePtr;
+  std::memcpy(p, name.data(), n);
+  mFreePtr += n;
+  mFreeSize -= n;
+  return std::string_view{p, n};
+}
+
+// @brief ハッシュ表を拡大する．
+void
+NameTable::expand()
+{
+  SizeType new_size = mTable.size() * 2;
+  mTable.clear();
+  mTable.resize(new_size, 0);
+  mMask = new_size - 1;
+  SizeType n = mNameArray.size();
+  for ( SizeType id = 0; id < n; ++ id ) {
+    auto pos = mHashArray[id] & mMask;
+    while ( mTable[pos] != 0 ) {
+      pos = (pos + 1) & mMask;
+    }
+    mTable[pos] = id + 1;
+  }
+}
+
+// @brief ハッシュ値を求める．
+SizeType
+NameTable::hash_func(
+  std::string_view name
+)
+{
+  // FNV-1a
+  std::uint64_t h = 14695981039346656037ULL;
+  for ( char c: name ) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+END_NAMESPACE_YM_BNET
@@ -10,6 +10,7 @@
 #include "ym/BnNetwork.h"
 #include "ym/BnPort.h"
 #include "ym/BddMgr.h"
+#include "CompStream.h"
 
 
 BEGIN_NAMESPACE_YM_BNET
@@ -21,7 +22,7 @@ BnNetwork::read_truth(
   const string& filename ///< [in] ファイル名
 )
 {
-  ifstream s{filename};
+  CompInStream s{filename};
   if ( !s ) {
     ostringstream buf;
     buf << filename << ": No such file";
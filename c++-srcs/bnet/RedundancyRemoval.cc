@@ -0,0 +1,485 @@
+
+/// @file RedundancyRemoval.cc
+/// @brief RedundancyRemoval の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "RedundancyRemoval.h"
+#include "ExprUtil.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNode.h"
+#include "ym/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+// クラス BnNetwork
+//////////////////////////////////////////////////////////////////////
+
+// @brief 冗長な接続を取り除いたネットワークを返す．
+BnNetwork
+BnNetwork::remove_redundancy(
+  SizeType sim_num,
+  SizeType conflict_limit,
+  SizeType& removed_num
+) const
+{
+  BnModifier mod{BnNetwork{*this}};
+  RedundancyRemoval op{mod, conflict_limit};
+  removed_num = op.remove(sim_num);
+  BnNetwork network{std::move(mod)};
+  return network.sweep();
+}
+
+// @brief 冗長な接続を取り除いたネットワークを返す．
+BnNetwork
+BnNetwork::remove_redundancy(
+  SizeType sim_num,
+  SizeType conflict_limit
+) const
+{
+  SizeType removed_num;
+  return remove_redundancy(sim_num, conflict_limit, removed_num);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス RedundancyRemoval
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+RedundancyRemoval::RedundancyRemoval(
+  BnModifier& network,
+  SizeType conflict_limit
+) : mNetwork{network},
+    mConflictLimit{conflict_limit},
+    mSim{network}
+{
+}
+
+// @brief 冗長な接続を取り除く．
+SizeType
+RedundancyRemoval::remove(
+  SizeType sim_num
+)
+{
+  mNetwork.wrap_up();
+
+  SizeType n = mNetwork.node_num();
+  mOrderArray.clear();
+  mOrderArray.resize(n + 1, 0);
+  // logic_list() は change_primitive() などの後ではトポロジカル順に
+  // なっているとは限らない．
+  SizeType pos = 0;
+  for ( auto node: mNetwork.sorted_logic_list() ) {
+    mOrderArray[node.id()] = pos;
+    ++ pos;
+  }
+  mFvalArray.clear();
+  mFvalArray.resize(n + 1, 0UL);
+  mFmarkArray.clear();
+  mFmarkArray.resize(n + 1, false);
+  mQmarkArray.clear();
+  mQmarkArray.resize(n + 1, false);
+  mCexList.clear();
+  mGoodEnc = nullptr;
+  mSolver = nullptr;
+
+  make_faults();
+
+  // 1. ランダムパタンで検出できる故障を除く．
+  SizeType ni = mNetwork.input_num();
+  vector<PackedVal> ival_list(ni);
+  for ( SizeType c = 0; c < sim_num; ++ c ) {
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      ival_list[i] = mRandGen();
+    }
+    fault_sim(ival_list);
+  }
+
+  // 2. 残った故障を SAT で調べる．
+  SizeType removed_num = 0;
+  for ( SizeType i = 0; i < mFaultList.size(); ++ i ) {
+    // 反例の故障シミュレーションで mFaultList の要素が変わるのでコピーする．
+    auto fault = mFaultList[i];
+    if ( fault.mDetected ) {
+      continue;
+    }
+    vector<bool> cex;
+    auto stat = check_fault(fault, cex);
+    if ( stat == SatBool3::False ) {
+      replace_fault(fault);
+      ++ removed_num;
+    }
+    else if ( stat == SatBool3::True ) {
+      mFaultList[i].mDetected = true;
+      mCexList.push_back(cex);
+      if ( mCexList.size() == 64 ) {
+	flush_cex();
+      }
+    }
+  }
+
+  return removed_num;
+}
+
+// @brief 故障のリストを作る．
+void
+RedundancyRemoval::make_faults()
+{
+  mFaultList.clear();
+  for ( auto node: mNetwork.logic_list() ) {
+    if ( node.fanout_num() == 0 ) {
+      continue;
+    }
+    auto id = node.id();
+    if ( node.type() == BnNodeType::Prim ) {
+      auto prim_type = node.primitive_type();
+      if ( prim_type == PrimType::C0 || prim_type == PrimType::C1 ) {
+	continue;
+      }
+    }
+    for ( bool val: {false, true} ) {
+      mFaultList.push_back(Fault{id, BNET_NULLID, val, false});
+    }
+    if ( node.type() == BnNodeType::Bdd || node.type() == BnNodeType::Cell ) {
+      continue;
+    }
+    SizeType ni = node.fanin_num();
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto inode = node.fanin(i);
+      if ( inode.is_logic() && inode.fanout_num() == 1 ) {
+	// ファンインのステム故障と等価
+	continue;
+      }
+      // 同じファンインが複数回現れる場合は扱わない．
+      bool dup = false;
+      for ( SizeType j = 0; j < ni; ++ j ) {
+	if ( j != i && node.fanin_id(j) == inode.id() ) {
+	  dup = true;
+	  break;
+	}
+      }
+      if ( dup ) {
+	continue;
+      }
+      for ( bool val: {false, true} ) {
+	mFaultList.push_back(Fault{id, i, val, false});
+      }
+    }
+  }
+}
+
+// @brief 64パタン分の故障シミュレーションを行う．
+void
+RedundancyRemoval::fault_sim(
+  const vector<PackedVal>& ival_list
+)
+{
+  mSim.simulate(ival_list);
+  for ( auto& fault: mFaultList ) {
+    if ( fault.mDetected ) {
+      continue;
+    }
+    if ( propagate(fault) ) {
+      fault.mDetected = true;
+    }
+  }
+}
+
+// @brief 1つの故障の影響を伝搬させる．
+bool
+RedundancyRemoval::propagate(
+  const Fault& fault
+)
+{
+  auto node = mNetwork.node(fault.mNodeId);
+  PackedVal fval = fault.mVal ? ~0UL : 0UL;
+  if ( fault.mPos != BNET_NULLID ) {
+    SizeType ni = node.fanin_num();
+    vector<PackedVal> ival_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      ival_list[i] = mSim.val(node.fanin_id(i));
+    }
+    ival_list[fault.mPos] = fval;
+    fval = Simulator::calc_logic(node, ival_list);
+  }
+  if ( fval == mSim.val(node.id()) ) {
+    // 故障が励起されない．
+    return false;
+  }
+
+  // 故障値の変化をトポロジカル順に伝搬させる．
+  vector<SizeType> changed_list;
+  std::priority_queue<Event, vector<Event>, std::greater<Event>> queue;
+  bool detected = false;
+  mFvalArray[node.id()] = fval;
+  mFmarkArray[node.id()] = true;
+  changed_list.push_back(node.id());
+  for ( auto onode: node.fanout_list() ) {
+    if ( onode.is_output() ) {
+      detected = true;
+      break;
+    }
+    if ( !mQmarkArray[onode.id()] ) {
+      mQmarkArray[onode.id()] = true;
+      queue.push(make_pair(mOrderArray[onode.id()], onode.id()));
+    }
+  }
+  while ( !detected && !queue.empty() ) {
+    auto id = queue.top().second;
+    queue.pop();
+    mQmarkArray[id] = false;
+    auto node1 = mNetwork.node(id);
+    SizeType ni = node1.fanin_num();
+    vector<PackedVal> ival_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto iid = node1.fanin_id(i);
+      ival_list[i] = mFmarkArray[iid] ? mFvalArray[iid] : mSim.val(iid);
+    }
+    auto val = Simulator::calc_logic(node1, ival_list);
+    if ( val == mSim.val(id) ) {
+      continue;
+    }
+    mFvalArray[id] = val;
+    mFmarkArray[id] = true;
+    changed_list.push_back(id);
+    for ( auto onode: node1.fanout_list() ) {
+      if ( onode.is_output() ) {
+	detected = true;
+	break;
+      }
+      if ( !mQmarkArray[onode.id()] ) {
+	mQmarkArray[onode.id()] = true;
+	queue.push(make_pair(mOrderArray[onode.id()], onode.id()));
+      }
+    }
+  }
+
+  // 後始末
+  for ( auto id: changed_list ) {
+    mFmarkArray[id] = false;
+  }
+  while ( !queue.empty() ) {
+    mQmarkArray[queue.top().second] = false;
+    queue.pop();
+  }
+  return detected;
+}
+
+// @brief 故障が検出不能か SAT で調べる．
+SatBool3
+RedundancyRemoval::check_fault(
+  const Fault& fault,
+  vector<bool>& cex
+)
+{
+  auto node = mNetwork.node(fault.mNodeId);
+
+  // 故障箇所の TFO を求める．
+  vector<SizeType> tfo_list;
+  vector<SizeType> output_list;
+  vector<bool> tfo_mark(mNetwork.node_num() + 1, false);
+  tfo_mark[node.id()] = true;
+  tfo_list.push_back(node.id());
+  for ( SizeType rpos = 0; rpos < tfo_list.size(); ++ rpos ) {
+    auto node1 = mNetwork.node(tfo_list[rpos]);
+    for ( auto onode: node1.fanout_list() ) {
+      if ( tfo_mark[onode.id()] ) {
+	continue;
+      }
+      tfo_mark[onode.id()] = true;
+      if ( onode.is_output() ) {
+	output_list.push_back(onode.id());
+      }
+      else {
+	tfo_list.push_back(onode.id());
+      }
+    }
+  }
+  if ( output_list.empty() ) {
+    // 観測できない．
+    return SatBool3::False;
+  }
+
+  init_solver();
+  auto& solver = *mSolver;
+  auto& genc = *mGoodEnc;
+  vector<SatLiteral> glit_list;
+  glit_list.reserve(output_list.size());
+  for ( auto id: output_list ) {
+    glit_list.push_back(genc.make_cnf(id));
+  }
+
+  // 故障箇所の故障値を表すリテラルを作る．
+  auto vlit = fault.mVal ? mConstLit : ~mConstLit;
+  SatLiteral flit;
+  if ( fault.mPos == BNET_NULLID ) {
+    flit = vlit;
+  }
+  else {
+    // 入力を定数にしたノードを符号化する．
+    BnNodeEnc nenc{solver, mNetwork};
+    for ( SizeType i = 0; i < node.fanin_num(); ++ i ) {
+      auto iid = node.fanin_id(i);
+      if ( i == fault.mPos ) {
+	nenc.set_lit(iid, vlit);
+      }
+      else {
+	nenc.set_lit(iid, genc.make_cnf(iid));
+      }
+    }
+    flit = nenc.make_cnf(node);
+  }
+
+  // 故障回路は TFO のみ複製する．
+  BnNodeEnc fenc{solver, mNetwork};
+  fenc.set_lit(node.id(), flit);
+  for ( SizeType i = 1; i < tfo_list.size(); ++ i ) {
+    auto node1 = mNetwork.node(tfo_list[i]);
+    for ( SizeType j = 0; j < node1.fanin_num(); ++ j ) {
+      auto iid = node1.fanin_id(j);
+      if ( !tfo_mark[iid] && !fenc.is_encoded(iid) ) {
+	fenc.set_lit(iid, genc.make_cnf(iid));
+      }
+    }
+  }
+
+  // いずれかの出力が異なるという条件
+  // alit が 1 の時のみ有効にする．
+  auto alit = solver.new_variable(true);
+  vector<SatLiteral> diff_list;
+  diff_list.reserve(output_list.size() + 1);
+  diff_list.push_back(~alit);
+  for ( SizeType i = 0; i < output_list.size(); ++ i ) {
+    auto glit = glit_list[i];
+    auto flit1 = fenc.make_cnf(output_list[i]);
+    auto dlit = solver.new_variable(true);
+    solver.add_clause(~dlit,  glit,  flit1);
+    solver.add_clause(~dlit, ~glit, ~flit1);
+    diff_list.push_back(dlit);
+  }
+  solver.add_clause(diff_list);
+
+  if ( mConflictLimit > 0 ) {
+    solver.set_conflict_budget(mConflictLimit);
+  }
+  auto stat = solver.solve(vector<SatLiteral>{alit});
+  if ( stat == SatBool3::True ) {
+    SizeType ni = mNetwork.input_num();
+    cex.clear();
+    cex.resize(ni, false);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      auto id = mNetwork.input_id(i);
+      if ( genc.is_encoded(id) ) {
+	cex[i] = solver.read_model(genc.lit(id)) == SatBool3::True;
+      }
+    }
+  }
+
+  // この故障の比較回路を無効にする．
+  solver.add_clause(~alit);
+  return stat;
+}
+
+// @brief 正常回路用の SAT ソルバと符号化器を用意する．
+void
+RedundancyRemoval::init_solver()
+{
+  if ( mSolver != nullptr ) {
+    return;
+  }
+  mSolver = std::unique_ptr<SatSolver>{new SatSolver};
+  mGoodEnc = std::unique_ptr<BnNodeEnc>{new BnNodeEnc{*mSolver, mNetwork}};
+  mConstLit = mSolver->new_variable(true);
+  mSolver->add_clause(mConstLit);
+}
+
+// @brief 故障箇所を定数に置き換える．
+void
+RedundancyRemoval::replace_fault(
+  const Fault& fault
+)
+{
+  auto node = mNetwork.node(fault.mNodeId);
+  if ( fault.mPos == BNET_NULLID ) {
+    auto prim_type = fault.mVal ? PrimType::C1 : PrimType::C0;
+    mNetwork.change_primitive(node, prim_type, {});
+  }
+  else {
+    // 入力を定数にした関数を作る．
+    SizeType ni = node.fanin_num();
+    vector<Expr> sub_list(ni);
+    vector<BnNode> fanin_list;
+    fanin_list.reserve(ni - 1);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      if ( i == fault.mPos ) {
+	sub_list[i] = fault.mVal ? Expr::make_one() : Expr::make_zero();
+      }
+      else {
+	sub_list[i] = Expr::make_posi_literal(fanin_list.size());
+	fanin_list.push_back(node.fanin(i));
+      }
+    }
+    auto expr = compose_expr(node_expr(node), sub_list);
+    if ( node.type() == BnNodeType::TvFunc ) {
+      mNetwork.change_tv(node, expr.make_tv(ni - 1), fanin_list);
+    }
+    else {
+      mNetwork.change_expr(node, expr, fanin_list);
+    }
+  }
+
+  // 同じノードの残りの故障を更新する．
+  // 置き換えた故障は以降調べないように検出済みとする．
+  for ( auto& fault1: mFaultList ) {
+    if ( fault1.mNodeId != fault.mNodeId ) {
+      continue;
+    }
+    if ( fault.mPos == BNET_NULLID ) {
+      // ノード自体が定数になった．
+      fault1.mDetected = true;
+    }
+    else if ( fault1.mPos == fault.mPos ) {
+      fault1.mDetected = true;
+    }
+    else if ( fault1.mPos != BNET_NULLID && fault1.mPos > fault.mPos ) {
+      -- fault1.mPos;
+    }
+  }
+
+  // ファンアウトのリストを作り直す．
+  mNetwork.wrap_up();
+
+  // 正常回路の符号化が古くなったので作り直す．
+  mGoodEnc = nullptr;
+  mSolver = nullptr;
+}
+
+// @brief 反例をまとめて故障シミュレーションを行う．
+void
+RedundancyRemoval::flush_cex()
+{
+  if ( mCexList.empty() ) {
+    return;
+  }
+  SizeType ni = mNetwork.input_num();
+  vector<PackedVal> ival_list(ni, 0UL);
+  // 余ったビットには最後のパタンを複製する．
+  for ( SizeType b = 0; b < 64; ++ b ) {
+    SizeType k = std::min(b, mCexList.size() - 1);
+    auto& cex = mCexList[k];
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      if ( cex[i] ) {
+	ival_list[i] |= (1UL << b);
+      }
+    }
+  }
+  mCexList.clear();
+  fault_sim(ival_list);
+}
+
+END_NAMESPACE_YM_BNET
@@ -0,0 +1,215 @@
+#ifndef REDUNDANCYREMOVAL_H
+#define REDUNDANCYREMOVAL_H
+
+/// @file RedundancyRemoval.h
+/// @brief RedundancyRemoval のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "ym/SatSolver.h"
+#include "ym/BnNodeEnc.h"
+#include "Simulator.h"
+#include <queue>
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class RedundancyRemoval RedundancyRemoval.h "RedundancyRemoval.h"
+/// @brief 検出不能な縮退故障を用いて冗長な接続を取り除くクラス
+///
+/// 以下の手順で処理を行う．
+/// 1. 論理ノードの出力(ステム)と入力(ブランチ)の 0/1 縮退故障を列挙する．
+///    ファンインのファンアウトが1つのブランチ故障はファンインのステム故障
+///    と等価なので除く．
+/// 2. ランダムパタンを用いた故障シミュレーションで検出できる故障を除く．
+///    故障の影響はトポロジカル順に必要なノードのみ伝搬させる．
+/// 3. 残った故障を順に SAT で調べる．
+///    - 正常回路の符号化は SAT ソルバとともに故障間で共有し，必要になった
+///      ノードのみ追加で符号化する．
+///    - 故障ごとに故障の TFO の複製と出力の比較回路を追加し，比較回路の節は
+///      活性化リテラルを仮定した時のみ有効にする．
+///      調べ終わった故障の活性化リテラルは単位節で否定する．
+///    - 検出不能(UNSAT)の場合は故障箇所を定数に置き換える．
+///      ステム故障の場合はノードを定数ノードに，ブランチ故障の場合は
+///      その入力を定数にした関数のノードに置き換える．
+///      ノード番号は変わらないのでトポロジカル順は保たれる．
+///      置き換えで内部のノードの関数が変わるので共有している SAT ソルバは
+///      作り直す．
+///    - 検出可能な場合は反例を 64 個ずつまとめて故障シミュレーションを行い，
+///      残りの故障のうち検出できたものを除く．
+///    - 制限内に終わらなかった故障はそのまま残す．
+///
+/// 組み合わせ回路部分のみを対象とする(入力と DFF の出力を自由な入力，
+/// 出力と DFF の入力を観測点とみなす)．
+/// BDD型とセル型のノードのブランチ故障は扱わない．
+/// 置き換えたノードはネットワーク上に残るので，後で BnNetwork::sweep() を
+/// 用いて定数を伝搬させる必要がある．
+//////////////////////////////////////////////////////////////////////
+class RedundancyRemoval
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// conflict_limit が 0 の時は制限なしとなる．
+  RedundancyRemoval(
+    BnModifier& network,    ///< [in] 対象のネットワーク
+    SizeType conflict_limit ///< [in] SAT 1回あたりのコンフリクト数の上限
+  );
+
+  /// @brief デストラクタ
+  ~RedundancyRemoval() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 冗長な接続を取り除く．
+  /// @return 定数に置き換えた故障数を返す．
+  SizeType
+  remove(
+    SizeType sim_num ///< [in] ランダムシミュレーションの回数
+                     ///<      (1回あたり64パタン)
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 縮退故障
+  struct Fault
+  {
+    // ノード番号
+    SizeType mNodeId;
+
+    // 入力位置
+    // ステム故障の場合は BNET_NULLID
+    SizeType mPos;
+
+    // 縮退値
+    bool mVal;
+
+    // 検出済みの時 true
+    bool mDetected;
+  };
+
+  // イベントキューの要素 (トポロジカル順の位置, ノード番号)
+  using Event = pair<SizeType, SizeType>;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 故障のリストを作る．
+  void
+  make_faults();
+
+  /// @brief 64パタン分の故障シミュレーションを行う．
+  ///
+  /// 検出された故障の mDetected を true にする．
+  void
+  fault_sim(
+    const vector<PackedVal>& ival_list ///< [in] 入力値のリスト
+  );
+
+  /// @brief 1つの故障の影響を伝搬させる．
+  /// @return いずれかの出力で検出できた時 true を返す．
+  ///
+  /// 正常値は mSim に求められていなければならない．
+  bool
+  propagate(
+    const Fault& fault ///< [in] 対象の故障
+  );
+
+  /// @brief 故障が検出不能か SAT で調べる．
+  /// @return 検出不能なら SatBool3::False，検出可能なら SatBool3::True，
+  /// 制限内に終わらなかったら SatBool3::X を返す．
+  ///
+  /// 検出可能な場合は反例を cex に格納する．
+  SatBool3
+  check_fault(
+    const Fault& fault, ///< [in] 対象の故障
+    vector<bool>& cex   ///< [out] 反例(入力値のリスト)
+  );
+
+  /// @brief 正常回路用の SAT ソルバと符号化器を用意する．
+  ///
+  /// 既に作られている場合は何もしない．
+  void
+  init_solver();
+
+  /// @brief 故障箇所を定数に置き換える．
+  ///
+  /// 共有している SAT ソルバは破棄する．
+  void
+  replace_fault(
+    const Fault& fault ///< [in] 対象の故障
+  );
+
+  /// @brief 反例をまとめて故障シミュレーションを行う．
+  void
+  flush_cex();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  BnModifier& mNetwork;
+
+  // SAT 1回あたりのコンフリクト数の上限
+  SizeType mConflictLimit;
+
+  // 正常回路のシミュレータ
+  Simulator mSim;
+
+  // 故障間で共有する SAT ソルバ
+  std::unique_ptr<SatSolver> mSolver;
+
+  // 正常回路の符号化器
+  // mSolver を参照しているので mSolver の後に宣言する．
+  std::unique_ptr<BnNodeEnc> mGoodEnc;
+
+  // 定数1を表すリテラル
+  SatLiteral mConstLit;
+
+  // 乱数生成器
+  std::mt19937_64 mRandGen;
+
+  // 故障のリスト
+  vector<Fault> mFaultList;
+
+  // ノード番号をキーにしてトポロジカル順の位置を格納する配列
+  // BnNetwork::sorted_logic_list() の順に番号をつける．
+  vector<SizeType> mOrderArray;
+
+  // ノード番号をキーにして故障値を格納する配列
+  vector<PackedVal> mFvalArray;
+
+  // ノード番号をキーにして故障値を持つかを表す配列
+  vector<bool> mFmarkArray;
+
+  // ノード番号をキーにしてイベントキューに入っているかを表す配列
+  vector<bool> mQmarkArray;
+
+  // まだ故障シミュレーションしていない反例のリスト
+  vector<vector<bool>> mCexList;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // REDUNDANCYREMOVAL_H
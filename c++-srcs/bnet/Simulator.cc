@@ -0,0 +1,228 @@
+
+/// @file Simulator.cc
+/// @brief Simulator の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Simulator.h"
+#include "ym/BnNetwork.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+const PackedVal PV_ALL0 = 0UL;
+const PackedVal PV_ALL1 = ~0UL;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス Simulator
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Simulator::Simulator(
+  const BnNetwork& network
+) : mNetwork{network},
+    mValArray(network.node_num() + 1, PV_ALL0)
+{
+  for ( auto node: network.sorted_logic_list() ) {
+    mLogicList.push_back(node.id());
+  }
+}
+
+// @brief シミュレーションを行う．
+void
+Simulator::simulate(
+  const vector<PackedVal>& ival_list
+)
+{
+  ASSERT_COND( ival_list.size() == mNetwork.input_num() );
+
+  SizeType pos = 0;
+  for ( auto node: mNetwork.input_list() ) {
+    mValArray[node.id()] = ival_list[pos];
+    ++ pos;
+  }
+  for ( auto id: mLogicList ) {
+    auto node = mNetwork.node(id);
+    SizeType ni = node.fanin_num();
+    vector<PackedVal> ival_list(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      ival_list[i] = mValArray[node.fanin_id(i)];
+    }
+    mValArray[node.id()] = calc_logic(node, ival_list);
+  }
+  for ( auto node: mNetwork.output_list() ) {
+    auto src = node.output_src();
+    mValArray[node.id()] = src.is_valid() ? mValArray[src.id()] : PV_ALL0;
+  }
+}
+
+// @brief ファンインの値を与えて論理ノードの値を計算する．
+PackedVal
+Simulator::calc_logic(
+  const BnNode& node,
+  const vector<PackedVal>& ival_list
+)
+{
+  SizeType ni = ival_list.size();
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    {
+      auto prim_type = node.primitive_type();
+      switch ( prim_type ) {
+      case PrimType::C0:
+	return PV_ALL0;
+
+      case PrimType::C1:
+	return PV_ALL1;
+
+      case PrimType::Buff:
+	return ival_list[0];
+
+      case PrimType::Not:
+	return ~ival_list[0];
+
+      case PrimType::And:
+      case PrimType::Nand:
+	{
+	  PackedVal val = PV_ALL1;
+	  for ( auto ival: ival_list ) {
+	    val &= ival;
+	  }
+	  return prim_type == PrimType::Nand ? ~val : val;
+	}
+
+      case PrimType::Or:
+      case PrimType::Nor:
+	{
+	  PackedVal val = PV_ALL0;
+	  for ( auto ival: ival_list ) {
+	    val |= ival;
+	  }
+	  return prim_type == PrimType::Nor ? ~val : val;
+	}
+
+      case PrimType::Xor:
+      case PrimType::Xnor:
+	{
+	  PackedVal val = PV_ALL0;
+	  for ( auto ival: ival_list ) {
+	    val ^= ival;
+	  }
+	  return prim_type == PrimType::Xnor ? ~val : val;
+	}
+
+      default:
+	break;
+      }
+    }
+    break;
+
+  case BnNodeType::Expr:
+    return calc_expr(node.expr(), ival_list);
+
+  case BnNodeType::TvFunc:
+    {
+      const auto& func = node.func();
+      PackedVal val = PV_ALL0;
+      for ( SizeType b = 0; b < 64; ++ b ) {
+	SizeType p = 0;
+	for ( SizeType i = 0; i < ni; ++ i ) {
+	  if ( (ival_list[i] >> b) & 1UL ) {
+	    p |= (1 << i);
+	  }
+	}
+	if ( func.value(p) ) {
+	  val |= (1UL << b);
+	}
+      }
+      return val;
+    }
+
+  case BnNodeType::Bdd:
+    {
+      auto bdd = node.bdd();
+      PackedVal val = PV_ALL0;
+      for ( SizeType b = 0; b < 64; ++ b ) {
+	auto f = bdd;
+	while ( !f.is_zero() && !f.is_one() ) {
+	  auto var = f.root_var();
+	  if ( (ival_list[var] >> b) & 1UL ) {
+	    f = f.root_cofactor1();
+	  }
+	  else {
+	    f = f.root_cofactor0();
+	  }
+	}
+	if ( f.is_one() ) {
+	  val |= (1UL << b);
+	}
+      }
+      return val;
+    }
+
+  case BnNodeType::Cell:
+    return calc_expr(node.cell().logic_expr(0), ival_list);
+
+  default:
+    break;
+  }
+  ASSERT_NOT_REACHED;
+  return PV_ALL0;
+}
+
+// @brief 論理式の値を計算する．
+PackedVal
+Simulator::calc_expr(
+  const Expr& expr,
+  const vector<PackedVal>& ival_list
+)
+{
+  if ( expr.is_zero() ) {
+    return PV_ALL0;
+  }
+  if ( expr.is_one() ) {
+    return PV_ALL1;
+  }
+  if ( expr.is_posi_literal() ) {
+    return ival_list[expr.varid()];
+  }
+  if ( expr.is_nega_literal() ) {
+    return ~ival_list[expr.varid()];
+  }
+
+  ASSERT_COND( expr.is_op() );
+  if ( expr.is_and() ) {
+    PackedVal val = PV_ALL1;
+    for ( auto& opr: expr.operand_list() ) {
+      val &= calc_expr(opr, ival_list);
+    }
+    return val;
+  }
+  if ( expr.is_or() ) {
+    PackedVal val = PV_ALL0;
+    for ( auto& opr: expr.operand_list() ) {
+      val |= calc_expr(opr, ival_list);
+    }
+    return val;
+  }
+  if ( expr.is_xor() ) {
+    PackedVal val = PV_ALL0;
+    for ( auto& opr: expr.operand_list() ) {
+      val ^= calc_expr(opr, ival_list);
+    }
+    return val;
+  }
+  ASSERT_NOT_REACHED;
+  return PV_ALL0;
+}
+
+END_NAMESPACE_YM_BNET
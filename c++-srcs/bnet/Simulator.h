@@ -0,0 +1,138 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+/// @file Simulator.h
+/// @brief Simulator のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/BnNode.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+/// @brief 64ビット分のパタンをまとめた型
+using PackedVal = std::uint64_t;
+
+/// @brief シミュレーション結果を並べたもの(シグネチャ)のハッシュ関数
+struct SigHash
+{
+  SizeType
+  operator()(
+    const vector<PackedVal>& sig
+  ) const
+  {
+    SizeType h = 0;
+    for ( auto val: sig ) {
+      h = h * 1000003 + (val ^ (val >> 32));
+    }
+    return h;
+  }
+};
+
+/// @brief シグネチャを先頭のビットが 0 になるように正規化する．
+/// @return 反転した場合には true を返す．
+inline
+bool
+normalize(
+  vector<PackedVal>& sig ///< [inout] 対象のシグネチャ
+)
+{
+  if ( sig.empty() || (sig[0] & 1UL) == 0 ) {
+    return false;
+  }
+  for ( auto& val: sig ) {
+    val = ~val;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @class Simulator Simulator.h "Simulator.h"
+/// @brief BnNetwork の組み合わせ回路部分のビット並列論理シミュレータ
+///
+/// - 入力(DFFの出力を含む)に 64 パタン分の値を与えて全ノードの値を求める．
+/// - 論理ノードはコンストラクタで求めたトポロジカル順に評価する．
+///   その後にノードの関数やファンインを変更する場合はこの順序を
+///   崩さないようにする必要がある．
+/// - 真理値表型と BDD 型はビットごとに評価する．
+//////////////////////////////////////////////////////////////////////
+class Simulator
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// network はこのオブジェクトよりも長く存在する必要がある．
+  Simulator(
+    const BnNetwork& network ///< [in] 対象のネットワーク
+  );
+
+  /// @brief デストラクタ
+  ~Simulator() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief シミュレーションを行う．
+  void
+  simulate(
+    const vector<PackedVal>& ival_list ///< [in] 入力値のリスト
+                                       ///<      input_list() の順に並べる．
+  );
+
+  /// @brief ノードの値を返す．
+  PackedVal
+  val(
+    SizeType node_id ///< [in] ノード番号
+  ) const
+  {
+    return mValArray[node_id];
+  }
+
+  /// @brief ファンインの値を与えて論理ノードの値を計算する．
+  ///
+  /// ファンインに変数の射影パタンを与えれば
+  /// 6入力以下の関数の真理値表が得られる．
+  static
+  PackedVal
+  calc_logic(
+    const BnNode& node,                ///< [in] 対象のノード
+    const vector<PackedVal>& ival_list ///< [in] ファンインの値のリスト
+  );
+
+  /// @brief 論理式の値を計算する．
+  static
+  PackedVal
+  calc_expr(
+    const Expr& expr,                  ///< [in] 論理式
+    const vector<PackedVal>& ival_list ///< [in] 入力値のリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BnNetwork& mNetwork;
+
+  // トポロジカル順に並べた論理ノード番号のリスト
+  vector<SizeType> mLogicList;
+
+  // ノード番号をキーにして値を格納する配列
+  vector<PackedVal> mValArray;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // SIMULATOR_H
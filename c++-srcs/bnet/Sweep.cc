@@ -0,0 +1,711 @@
+
+/// @file Sweep.cc
+/// @brief Sweep の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Sweep.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnNodeMap.h"
+#include "ym/BnDff.h"
+#include "ym/ClibCell.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// 定数を表す変数番号
+const SizeType CONST_VAR = static_cast<SizeType>(-1);
+
+// 論理式の変数の置き換え先
+// mVar が CONST_VAR の時は定数で mInv がその値を表す．
+struct LitMap
+{
+  SizeType mVar;
+  bool mInv;
+};
+
+// 変数を置き換えつつ論理式を作り直す．
+//
+// 以下の簡単化を行う．
+// - 定数の伝搬
+// - AND/OR の重複したリテラルの削除と x & ~x, x | ~x の定数化
+// - XOR のリテラルの極性の追い出しと偶数回現れるリテラルの削除
+Expr
+rebuild_expr(
+  const Expr& expr,
+  const vector<LitMap>& lit_map
+)
+{
+  if ( expr.is_zero() ) {
+    return Expr::make_zero();
+  }
+  if ( expr.is_one() ) {
+    return Expr::make_one();
+  }
+  if ( expr.is_literal() ) {
+    const auto& lm = lit_map[expr.varid()];
+    bool inv = lm.mInv ^ expr.is_nega_literal();
+    if ( lm.mVar == CONST_VAR ) {
+      return inv ? Expr::make_one() : Expr::make_zero();
+    }
+    return Expr::make_literal(lm.mVar, inv);
+  }
+
+  if ( expr.is_and() || expr.is_or() ) {
+    bool is_and = expr.is_and();
+    vector<Expr> opr_list;
+    opr_list.reserve(expr.operand_num());
+    // 現れたリテラル(変数番号 * 2 + 否定フラグ)の集合
+    unordered_set<SizeType> lit_set;
+    for ( auto& opr: expr.operand_list() ) {
+      auto opr1 = rebuild_expr(opr, lit_map);
+      if ( opr1.is_zero() ) {
+	if ( is_and ) {
+	  return Expr::make_zero();
+	}
+	continue;
+      }
+      if ( opr1.is_one() ) {
+	if ( !is_and ) {
+	  return Expr::make_one();
+	}
+	continue;
+      }
+      if ( opr1.is_literal() ) {
+	SizeType code = opr1.varid() * 2 + (opr1.is_nega_literal() ? 1 : 0);
+	if ( lit_set.count(code) > 0 ) {
+	  continue;
+	}
+	if ( lit_set.count(code ^ 1) > 0 ) {
+	  return is_and ? Expr::make_zero() : Expr::make_one();
+	}
+	lit_set.emplace(code);
+      }
+      opr_list.push_back(opr1);
+    }
+    if ( opr_list.empty() ) {
+      return is_and ? Expr::make_one() : Expr::make_zero();
+    }
+    if ( opr_list.size() == 1 ) {
+      return opr_list[0];
+    }
+    return is_and ? Expr::make_and(opr_list) : Expr::make_or(opr_list);
+  }
+
+  if ( expr.is_xor() ) {
+    bool inv = false;
+    vector<Expr> opr_list;
+    opr_list.reserve(expr.operand_num());
+    // 変数番号をキーにして現れた回数を数える．
+    unordered_map<SizeType, SizeType> count_map;
+    for ( auto& opr: expr.operand_list() ) {
+      auto opr1 = rebuild_expr(opr, lit_map);
+      if ( opr1.is_zero() ) {
+	continue;
+      }
+      if ( opr1.is_one() ) {
+	inv = !inv;
+	continue;
+      }
+      if ( opr1.is_literal() ) {
+	if ( opr1.is_nega_literal() ) {
+	  inv = !inv;
+	}
+	auto var = opr1.varid();
+	if ( count_map.count(var) == 0 ) {
+	  count_map.emplace(var, 1);
+	  opr_list.push_back(Expr::make_literal(var, false));
+	}
+	else {
+	  ++ count_map.at(var);
+	}
+	continue;
+      }
+      opr_list.push_back(opr1);
+    }
+    vector<Expr> opr_list1;
+    opr_list1.reserve(opr_list.size());
+    for ( auto& opr: opr_list ) {
+      if ( opr.is_literal() && (count_map.at(opr.varid()) % 2) == 0 ) {
+	continue;
+      }
+      opr_list1.push_back(opr);
+    }
+    Expr ans = Expr::make_zero();
+    if ( opr_list1.size() == 1 ) {
+      ans = opr_list1[0];
+    }
+    else if ( opr_list1.size() > 1 ) {
+      ans = Expr::make_xor(opr_list1);
+    }
+    return inv ? ~ans : ans;
+  }
+
+  ASSERT_NOT_REACHED;
+  return Expr::make_zero();
+}
+
+// 論理式中に現れる変数に印をつける．
+void
+collect_vars(
+  const Expr& expr,
+  vector<bool>& used
+)
+{
+  if ( expr.is_literal() ) {
+    used[expr.varid()] = true;
+  }
+  else if ( expr.is_op() ) {
+    for ( auto& opr: expr.operand_list() ) {
+      collect_vars(opr, used);
+    }
+  }
+}
+
+// 変数を置き換えつつ BDD を作り直す．
+//
+// 結果は mgr 上に作られる．
+Bdd
+rebuild_bdd(
+  const Bdd& bdd,
+  const vector<LitMap>& lit_map,
+  BddMgr& mgr,
+  unordered_map<Bdd, Bdd>& result_map
+)
+{
+  if ( bdd.is_zero() ) {
+    return mgr.zero();
+  }
+  if ( bdd.is_one() ) {
+    return mgr.one();
+  }
+  if ( result_map.count(bdd) > 0 ) {
+    return result_map.at(bdd);
+  }
+  const auto& lm = lit_map[bdd.root_var()];
+  Bdd result;
+  if ( lm.mVar == CONST_VAR ) {
+    // 定数の場合は該当するコファクターのみをたどる．
+    auto f = lm.mInv ? bdd.root_cofactor1() : bdd.root_cofactor0();
+    result = rebuild_bdd(f, lit_map, mgr, result_map);
+  }
+  else {
+    auto r0 = rebuild_bdd(bdd.root_cofactor0(), lit_map, mgr, result_map);
+    auto r1 = rebuild_bdd(bdd.root_cofactor1(), lit_map, mgr, result_map);
+    auto g = mgr.literal(lm.mVar);
+    if ( lm.mInv ) {
+      g = ~g;
+    }
+    result = (g & r1) | (~g & r0);
+  }
+  result_map.emplace(bdd, result);
+  return result;
+}
+
+// BDD 中に現れる変数に印をつける．
+void
+collect_vars(
+  const Bdd& bdd,
+  vector<bool>& used,
+  unordered_set<Bdd>& mark
+)
+{
+  if ( bdd.is_zero() || bdd.is_one() ) {
+    return;
+  }
+  if ( mark.count(bdd) > 0 ) {
+    return;
+  }
+  mark.emplace(bdd);
+  used[bdd.root_var()] = true;
+  collect_vars(bdd.root_cofactor0(), used, mark);
+  collect_vars(bdd.root_cofactor1(), used, mark);
+}
+
+END_NONAMESPACE
+
+
+// @brief 定数伝搬とバッファ/インバーターの除去を行ったネットワークを返す．
+BnNetwork
+BnNetwork::sweep(
+  SizeType& removed_num
+) const
+{
+  Sweep op;
+  removed_num = op.sweep(*this);
+  return BnNetwork{std::move(op)};
+}
+
+// @brief 定数伝搬とバッファ/インバーターの除去を行ったネットワークを返す．
+BnNetwork
+BnNetwork::sweep() const
+{
+  SizeType removed_num;
+  return sweep(removed_num);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Sweep
+//////////////////////////////////////////////////////////////////////
+
+// @brief 簡単化を行う．
+SizeType
+Sweep::sweep(
+  const BnNetwork& src_network
+)
+{
+  SizeType n = src_network.node_num();
+  mSignalArray.clear();
+  mSignalArray.resize(n + 1, Signal{BNET_NULLID, false});
+  mInfoArray.clear();
+  mInfoArray.resize(n + 1);
+  mInvMap.clear();
+  mConstNode[0] = BnNode{};
+  mConstNode[1] = BnNode{};
+
+  // 入力ノード(DFFの出力を含む)は自分自身を表す．
+  for ( auto src_node: src_network.input_list() ) {
+    auto id = src_node.id();
+    mSignalArray[id] = Signal{id, false};
+  }
+
+  // 1. 入力側から簡単化する．
+  // logic_list() はトポロジカル順とは限らないので並べ直したものを用いる．
+  // 3. でも同じ順序でノードを作る．
+  auto logic_list = src_network.sorted_logic_list();
+  for ( auto src_node: logic_list ) {
+    simplify_node(src_node);
+  }
+
+  // 2. 使われているノードに印をつける．
+  mark_nodes(src_network);
+
+  // 3. 印のついたノードを作る．
+  auto node_map = make_skelton_copy(src_network);
+  for ( auto src_dff: src_network.dff_list() ) {
+    copy_dff(src_dff, node_map);
+  }
+
+  SizeType removed_num = 0;
+  for ( auto src_node: logic_list ) {
+    auto id = src_node.id();
+    const auto& info = mInfoArray[id];
+    if ( info.mKind == NodeKind::Alias || !mMarkArray[id] ) {
+      ++ removed_num;
+      continue;
+    }
+
+    auto name = src_node.name();
+    vector<BnNode> fanin_list;
+    fanin_list.reserve(info.mFaninList.size());
+    for ( auto signal: info.mFaninList ) {
+      fanin_list.push_back(make_signal(signal, node_map));
+    }
+    BnNode dst_node;
+    switch ( info.mKind ) {
+    case NodeKind::Expr:
+      dst_node = new_logic_expr(name, info.mExpr, fanin_list);
+      break;
+
+    case NodeKind::TvFunc:
+      dst_node = new_logic_tv(name, info.mFunc, fanin_list);
+      break;
+
+    case NodeKind::Bdd:
+      dst_node = new_logic_bdd(name, info.mBdd, fanin_list);
+      break;
+
+    case NodeKind::Keep:
+      ASSERT_COND( src_node.type() == BnNodeType::Cell );
+      dst_node = new_logic_cell(name, src_node.cell(), fanin_list);
+      break;
+
+    default:
+      ASSERT_NOT_REACHED;
+      break;
+    }
+    node_map.put(id, dst_node);
+  }
+
+  // 出力のファンインをセットする．
+  for ( auto src_node: src_network.output_list() ) {
+    auto dst_node = node_map.get(src_node.id());
+    auto signal = mSignalArray[src_node.output_src().id()];
+    auto dst_src = make_signal(signal, node_map);
+    set_output_src(dst_node, dst_src);
+  }
+
+  return removed_num;
+}
+
+// @brief 論理ノードを簡単化する．
+void
+Sweep::simplify_node(
+  const BnNode& src_node
+)
+{
+  auto id = src_node.id();
+  switch ( src_node.type() ) {
+  case BnNodeType::Prim:
+    {
+      auto prim_type = src_node.primitive_type();
+      switch ( prim_type ) {
+      case PrimType::C0:
+	mSignalArray[id] = Signal{BNET_NULLID, false};
+	return;
+
+      case PrimType::C1:
+	mSignalArray[id] = Signal{BNET_NULLID, true};
+	return;
+
+      case PrimType::Buff:
+	mSignalArray[id] = mSignalArray[src_node.fanin_id(0)];
+	return;
+
+      case PrimType::Not:
+	{
+	  auto signal = mSignalArray[src_node.fanin_id(0)];
+	  signal.mInv = !signal.mInv;
+	  mSignalArray[id] = signal;
+	}
+	return;
+
+      default:
+	break;
+      }
+
+      // それ以外は論理式として扱う．
+      SizeType ni = src_node.fanin_num();
+      vector<Expr> lit_list(ni);
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	lit_list[i] = Expr::make_literal(i, false);
+      }
+      Expr expr;
+      switch ( prim_type ) {
+      case PrimType::And:  expr = Expr::make_and(lit_list); break;
+      case PrimType::Nand: expr = ~Expr::make_and(lit_list); break;
+      case PrimType::Or:   expr = Expr::make_or(lit_list); break;
+      case PrimType::Nor:  expr = ~Expr::make_or(lit_list); break;
+      case PrimType::Xor:  expr = Expr::make_xor(lit_list); break;
+      case PrimType::Xnor: expr = ~Expr::make_xor(lit_list); break;
+      default: ASSERT_NOT_REACHED; break;
+      }
+      simplify_expr(src_node, expr);
+    }
+    return;
+
+  case BnNodeType::Expr:
+    simplify_expr(src_node, src_node.expr());
+    return;
+
+  case BnNodeType::TvFunc:
+    simplify_tv(src_node);
+    return;
+
+  case BnNodeType::Bdd:
+    simplify_bdd(src_node);
+    return;
+
+  default:
+    break;
+  }
+
+  // セル型は関数はそのままでファンインのみ置き換える．
+  auto& info = mInfoArray[id];
+  info.mKind = NodeKind::Keep;
+  SizeType ni = src_node.fanin_num();
+  info.mFaninList.clear();
+  info.mFaninList.reserve(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    info.mFaninList.push_back(mSignalArray[src_node.fanin_id(i)]);
+  }
+  mSignalArray[id] = Signal{id, false};
+}
+
+// @brief 論理式型として簡単化する．
+void
+Sweep::simplify_expr(
+  const BnNode& src_node,
+  const Expr& expr
+)
+{
+  auto id = src_node.id();
+
+  // ファンインを極性付きのノードに置き換える．
+  // 同じノードは同じ変数にまとめる．
+  SizeType ni = src_node.fanin_num();
+  vector<LitMap> lit_map(ni);
+  vector<SizeType> base_list;
+  unordered_map<SizeType, SizeType> var_map;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto signal = mSignalArray[src_node.fanin_id(i)];
+    if ( signal.mId == BNET_NULLID ) {
+      lit_map[i] = LitMap{CONST_VAR, signal.mInv};
+      continue;
+    }
+    if ( var_map.count(signal.mId) == 0 ) {
+      var_map.emplace(signal.mId, base_list.size());
+      base_list.push_back(signal.mId);
+    }
+    lit_map[i] = LitMap{var_map.at(signal.mId), signal.mInv};
+  }
+  auto expr1 = rebuild_expr(expr, lit_map);
+
+  if ( expr1.is_zero() ) {
+    mSignalArray[id] = Signal{BNET_NULLID, false};
+    return;
+  }
+  if ( expr1.is_one() ) {
+    mSignalArray[id] = Signal{BNET_NULLID, true};
+    return;
+  }
+  if ( expr1.is_literal() ) {
+    auto base = base_list[expr1.varid()];
+    mSignalArray[id] = Signal{base, expr1.is_nega_literal()};
+    return;
+  }
+
+  // 現れる変数のみに詰める．
+  SizeType nb = base_list.size();
+  vector<bool> used(nb, false);
+  collect_vars(expr1, used);
+  auto& info = mInfoArray[id];
+  info.mKind = NodeKind::Expr;
+  info.mFaninList.clear();
+  vector<LitMap> lit_map2(nb, LitMap{CONST_VAR, false});
+  for ( SizeType v = 0; v < nb; ++ v ) {
+    if ( used[v] ) {
+      lit_map2[v] = LitMap{info.mFaninList.size(), false};
+      info.mFaninList.push_back(Signal{base_list[v], false});
+    }
+  }
+  info.mExpr = rebuild_expr(expr1, lit_map2);
+  mSignalArray[id] = Signal{id, false};
+}
+
+// @brief 真理値表型として簡単化する．
+void
+Sweep::simplify_tv(
+  const BnNode& src_node
+)
+{
+  auto id = src_node.id();
+  const auto& func = src_node.func();
+
+  // ファンインを極性付きのノードに置き換える．
+  // 同じノードは同じ変数にまとめる．
+  SizeType ni = src_node.fanin_num();
+  vector<LitMap> lit_map(ni);
+  vector<SizeType> base_list;
+  unordered_map<SizeType, SizeType> var_map;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto signal = mSignalArray[src_node.fanin_id(i)];
+    if ( signal.mId == BNET_NULLID ) {
+      lit_map[i] = LitMap{CONST_VAR, signal.mInv};
+      continue;
+    }
+    if ( var_map.count(signal.mId) == 0 ) {
+      var_map.emplace(signal.mId, base_list.size());
+      base_list.push_back(signal.mId);
+    }
+    lit_map[i] = LitMap{var_map.at(signal.mId), signal.mInv};
+  }
+
+  // 置き換えた後の真理値表を作る．
+  SizeType nb = base_list.size();
+  SizeType np = 1 << nb;
+  vector<int> vals(np);
+  for ( SizeType p = 0; p < np; ++ p ) {
+    SizeType q = 0;
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      const auto& lm = lit_map[i];
+      bool b = lm.mInv;
+      if ( lm.mVar != CONST_VAR ) {
+	b ^= ((p >> lm.mVar) & 1) == 1;
+      }
+      if ( b ) {
+	q |= (1 << i);
+      }
+    }
+    vals[p] = func.value(q) ? 1 : 0;
+  }
+
+  // 実際に依存している変数を求める．
+  vector<SizeType> sup_list;
+  for ( SizeType v = 0; v < nb; ++ v ) {
+    SizeType bit = 1 << v;
+    for ( SizeType p = 0; p < np; ++ p ) {
+      if ( (p & bit) == 0 && vals[p] != vals[p | bit] ) {
+	sup_list.push_back(v);
+	break;
+      }
+    }
+  }
+
+  SizeType ns = sup_list.size();
+  if ( ns == 0 ) {
+    mSignalArray[id] = Signal{BNET_NULLID, vals[0] == 1};
+    return;
+  }
+  if ( ns == 1 ) {
+    auto v = sup_list[0];
+    // vals[0] が 1 なら否定
+    mSignalArray[id] = Signal{base_list[v], vals[0] == 1};
+    return;
+  }
+
+  SizeType ns_p = 1 << ns;
+  vector<int> vals2(ns_p);
+  for ( SizeType p2 = 0; p2 < ns_p; ++ p2 ) {
+    SizeType p = 0;
+    for ( SizeType j = 0; j < ns; ++ j ) {
+      if ( p2 & (1 << j) ) {
+	p |= (1 << sup_list[j]);
+      }
+    }
+    vals2[p2] = vals[p];
+  }
+  auto& info = mInfoArray[id];
+  info.mKind = NodeKind::TvFunc;
+  info.mFunc = TvFunc{ns, vals2};
+  info.mFaninList.clear();
+  for ( auto v: sup_list ) {
+    info.mFaninList.push_back(Signal{base_list[v], false});
+  }
+  mSignalArray[id] = Signal{id, false};
+}
+
+// @brief BDD型として簡単化する．
+void
+Sweep::simplify_bdd(
+  const BnNode& src_node
+)
+{
+  auto id = src_node.id();
+
+  // ファンインを極性付きのノードに置き換える．
+  // 同じノードは同じ変数にまとめる．
+  SizeType ni = src_node.fanin_num();
+  vector<LitMap> lit_map(ni);
+  vector<SizeType> base_list;
+  unordered_map<SizeType, SizeType> var_map;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto signal = mSignalArray[src_node.fanin_id(i)];
+    if ( signal.mId == BNET_NULLID ) {
+      lit_map[i] = LitMap{CONST_VAR, signal.mInv};
+      continue;
+    }
+    if ( var_map.count(signal.mId) == 0 ) {
+      var_map.emplace(signal.mId, base_list.size());
+      base_list.push_back(signal.mId);
+    }
+    lit_map[i] = LitMap{var_map.at(signal.mId), signal.mInv};
+  }
+  unordered_map<Bdd, Bdd> result_map;
+  auto bdd1 = rebuild_bdd(src_node.bdd(), lit_map, mBddMgr, result_map);
+
+  if ( bdd1.is_zero() ) {
+    mSignalArray[id] = Signal{BNET_NULLID, false};
+    return;
+  }
+  if ( bdd1.is_one() ) {
+    mSignalArray[id] = Signal{BNET_NULLID, true};
+    return;
+  }
+
+  // 実際に依存している変数を求める．
+  SizeType nb = base_list.size();
+  vector<bool> used(nb, false);
+  unordered_set<Bdd> mark;
+  collect_vars(bdd1, used, mark);
+  vector<SizeType> sup_list;
+  for ( SizeType v = 0; v < nb; ++ v ) {
+    if ( used[v] ) {
+      sup_list.push_back(v);
+    }
+  }
+
+  if ( sup_list.size() == 1 ) {
+    auto v = sup_list[0];
+    // 0 コファクターが 1 なら否定
+    mSignalArray[id] = Signal{base_list[v], bdd1.root_cofactor0().is_one()};
+    return;
+  }
+
+  // 現れる変数のみに詰める．
+  auto& info = mInfoArray[id];
+  info.mKind = NodeKind::Bdd;
+  info.mFaninList.clear();
+  vector<LitMap> lit_map2(nb, LitMap{CONST_VAR, false});
+  for ( auto v: sup_list ) {
+    lit_map2[v] = LitMap{info.mFaninList.size(), false};
+    info.mFaninList.push_back(Signal{base_list[v], false});
+  }
+  unordered_map<Bdd, Bdd> result_map2;
+  info.mBdd = rebuild_bdd(bdd1, lit_map2, mBddMgr, result_map2);
+  mSignalArray[id] = Signal{id, false};
+}
+
+// @brief 使われているノードに印をつける．
+void
+Sweep::mark_nodes(
+  const BnNetwork& src_network
+)
+{
+  mMarkArray.clear();
+  mMarkArray.resize(src_network.node_num() + 1, false);
+  vector<SizeType> stack;
+  for ( auto src_node: src_network.output_list() ) {
+    auto signal = mSignalArray[src_node.output_src().id()];
+    if ( signal.mId != BNET_NULLID ) {
+      stack.push_back(signal.mId);
+    }
+  }
+  while ( !stack.empty() ) {
+    auto id = stack.back();
+    stack.pop_back();
+    if ( mMarkArray[id] ) {
+      continue;
+    }
+    mMarkArray[id] = true;
+    for ( auto signal: mInfoArray[id].mFaninList ) {
+      if ( signal.mId != BNET_NULLID && !mMarkArray[signal.mId] ) {
+	stack.push_back(signal.mId);
+      }
+    }
+  }
+}
+
+// @brief 極性付きのノードを実体化する．
+BnNode
+Sweep::make_signal(
+  Signal signal,
+  BnNodeMap& node_map
+)
+{
+  if ( signal.mId == BNET_NULLID ) {
+    SizeType val = signal.mInv ? 1 : 0;
+    if ( mConstNode[val].is_invalid() ) {
+      mConstNode[val] = signal.mInv ? new_c1(string{}) : new_c0(string{});
+    }
+    return mConstNode[val];
+  }
+
+  auto node = node_map.get(signal.mId);
+  if ( !signal.mInv ) {
+    return node;
+  }
+  auto id = node.id();
+  if ( mInvMap.count(id) == 0 ) {
+    auto inv = new_not(string{}, node);
+    mInvMap.emplace(id, inv);
+  }
+  return mInvMap.at(id);
+}
+
+END_NAMESPACE_YM_BNET
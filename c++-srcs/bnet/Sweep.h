@@ -0,0 +1,182 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+/// @file Sweep.h
+/// @brief Sweep のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class Sweep Sweep.h "Sweep.h"
+/// @brief 定数伝搬とバッファ/インバーターの除去を行うクラス
+///
+/// 以下の3段階で処理を行う．いずれもノード数に比例した時間で終わる．
+/// 1. 入力側から(BnNetwork::sorted_logic_list() の順に)各ノードの関数を
+///    簡単化する．
+///    - 定数のファンインを関数に代入する．
+///    - バッファとインバーターはファンインの極性として吸収する．
+///    - 同じファンインの重複や x & ~x のような自明な部分を取り除く．
+///    - 結果が定数やリテラルになったノードは他のノードの別名となる．
+/// 2. 出力側から実際に使われているノードに印をつける．
+/// 3. 印のついたノードのみを作る．
+///
+/// 否定のファンインは論理式の負リテラルとして表すので，
+/// インバーターが必要になるのは出力とセル型のノードのファンインだけとなる．
+/// BDD型のノードは定数と極性を代入した BDD を作り直す．
+/// セル型のノードの関数はそのまま用いる．
+//////////////////////////////////////////////////////////////////////
+class Sweep :
+  public BnModifier
+{
+public:
+
+  /// @brief コンストラクタ
+  Sweep() = default;
+
+  /// @brief デストラクタ
+  ~Sweep() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 簡単化を行う．
+  /// @return 取り除かれた論理ノード数を返す．
+  ///
+  /// 新たに追加したインバーターと定数ノードは数に含めない．
+  SizeType
+  sweep(
+    const BnNetwork& src_network ///< [in] 元のネットワーク
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 元のネットワークのノードを極性付きで表す構造体
+  // mId が BNET_NULLID の時は定数で mInv がその値を表す．
+  struct Signal
+  {
+    SizeType mId;
+    bool mInv;
+  };
+
+  // 簡単化後のノードの種類
+  enum class NodeKind {
+    Alias,  // 他のノードの別名
+    Expr,   // 論理式
+    TvFunc, // 真理値表
+    Bdd,    // BDD
+    Keep    // 元のノードの関数をそのまま用いる．
+  };
+
+  // 簡単化後のノードの情報
+  struct NodeInfo
+  {
+    // 種類
+    NodeKind mKind{NodeKind::Alias};
+
+    // 論理式
+    Expr mExpr;
+
+    // 真理値表
+    TvFunc mFunc;
+
+    // BDD
+    // Sweep::mBddMgr 上に作られる．
+    Bdd mBdd;
+
+    // ファンインのリスト
+    // Keep の場合以外は全て肯定の非定数となる．
+    vector<Signal> mFaninList;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 論理ノードを簡単化する．
+  ///
+  /// 結果は mSignalArray と mInfoArray に格納される．
+  void
+  simplify_node(
+    const BnNode& src_node ///< [in] 対象のノード
+  );
+
+  /// @brief 論理式型として簡単化する．
+  void
+  simplify_expr(
+    const BnNode& src_node, ///< [in] 対象のノード
+    const Expr& expr        ///< [in] 論理式
+  );
+
+  /// @brief 真理値表型として簡単化する．
+  void
+  simplify_tv(
+    const BnNode& src_node ///< [in] 対象のノード
+  );
+
+  /// @brief BDD型として簡単化する．
+  void
+  simplify_bdd(
+    const BnNode& src_node ///< [in] 対象のノード
+  );
+
+  /// @brief 使われているノードに印をつける．
+  void
+  mark_nodes(
+    const BnNetwork& src_network ///< [in] 元のネットワーク
+  );
+
+  /// @brief 極性付きのノードを実体化する．
+  BnNode
+  make_signal(
+    Signal signal,      ///< [in] 対象の極性付きノード
+    BnNodeMap& node_map ///< [in] ID番号の対応表
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 元のノード番号をキーにして簡単化後の極性付きノードを格納する配列
+  vector<Signal> mSignalArray;
+
+  // 簡単化後の BDD を作るためのマネージャ
+  BddMgr mBddMgr;
+
+  // 元のノード番号をキーにして簡単化後の情報を格納する配列
+  vector<NodeInfo> mInfoArray;
+
+  // 元のノード番号をキーにして使われているかを表す配列
+  vector<bool> mMarkArray;
+
+  // 新しいノード番号をキーにして否定のノードを格納する辞書
+  unordered_map<SizeType, BnNode> mInvMap;
+
+  // 定数ノード
+  BnNode mConstNode[2];
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // SWEEP_H
@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "Bench2Bnet.h"
+#include "Iscas89BnetReader.h"
 #include "ym/Iscas89ExParser.h"
 #include "ym/Iscas89Model.h"
 #include "ym/BnNetwork.h"
@@ -25,6 +26,21 @@ BnNetwork::read_iscas89(
   const string& clock_name
 )
 {
+  auto _clock_name = clock_name;
+  if ( _clock_name == string{} ) {
+    _clock_name = "clock";
+  }
+
+  {
+    // まず高速版で読み込む．
+    Iscas89BnetReader reader{_clock_name};
+    if ( reader.read(filename) ) {
+      return reader.get_network();
+    }
+  }
+
+  // 高速版で扱えなかった場合(エラーを含む)は通常版で読み直す．
+  // エラーメッセージはこちらで出力される．
   Iscas89ExParser parser;
   Iscas89Model model;
   bool stat = parser.read(filename, model);
@@ -34,11 +50,6 @@ BnNetwork::read_iscas89(
     throw std::invalid_argument{buff.str()};
   }
 
-  auto _clock_name = clock_name;
-  if ( _clock_name == string{} ) {
-    _clock_name = "clock";
-  }
-
   Bench2Bnet conv{model, _clock_name};
 
   return conv.get_network();
@@ -0,0 +1,373 @@
+
+/// @file Iscas89BnetReader.cc
+/// @brief Iscas89BnetReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Iscas89BnetReader.h"
+#include "MuxHandler.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnDff.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+using nsIscas89::Iscas89Token;
+
+//////////////////////////////////////////////////////////////////////
+// クラス Iscas89BnetReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Iscas89BnetReader::Iscas89BnetReader(
+  const string& clock_name
+) : mClockName{clock_name}
+{
+}
+
+// @brief 読み込みを行う．
+//
+// 文法は ParserImpl::read() と同じ
+bool
+Iscas89BnetReader::read(
+  const string& filename
+)
+{
+  nsIscas89::Iscas89MmapScanner scanner{filename};
+  if ( !scanner.is_valid() ) {
+    return false;
+  }
+  mScanner = &scanner;
+
+  for ( ; ; ) {
+    auto tk = mScanner->read_token();
+    bool ok = false;
+    switch ( tk ) {
+    case Iscas89Token::INPUT:
+      ok = read_input();
+      break;
+
+    case Iscas89Token::OUTPUT:
+      ok = read_output();
+      break;
+
+    case Iscas89Token::NAME:
+      ok = read_gate(find_id(mScanner->cur_view()));
+      break;
+
+    case Iscas89Token::_EOF:
+      mScanner = nullptr;
+      return make_network();
+
+    default:
+      break;
+    }
+    if ( !ok ) {
+      mScanner = nullptr;
+      return false;
+    }
+  }
+}
+
+// @brief 結果のネットワークを返す．
+BnNetwork
+Iscas89BnetReader::get_network()
+{
+  return BnNetwork{std::move(mNetwork)};
+}
+
+// @brief INPUT 文を読み込む．
+bool
+Iscas89BnetReader::read_input()
+{
+  SizeType id;
+  if ( !parse_name(id) ) {
+    return false;
+  }
+  auto& node = mNodeArray[id];
+  if ( node.mType != None ) {
+    // 二重定義
+    return false;
+  }
+  node.mType = Input;
+  mInputList.push_back(id);
+  return true;
+}
+
+// @brief OUTPUT 文を読み込む．
+bool
+Iscas89BnetReader::read_output()
+{
+  SizeType id;
+  if ( !parse_name(id) ) {
+    return false;
+  }
+  mOutputList.push_back(id);
+  return true;
+}
+
+// @brief ゲート/DFF 文を読み込む．
+bool
+Iscas89BnetReader::read_gate(
+  SizeType oid
+)
+{
+  if ( !expect(Iscas89Token::EQ) ) {
+    return false;
+  }
+  if ( mNodeArray[oid].mType != None ) {
+    // 二重定義
+    return false;
+  }
+
+  // mNodeArray は parse_name_list() 中で伸びるので
+  // ノードの情報はローカル変数に作っておく．
+  Node node;
+  node.mFaninBegin = mFaninBuf.size();
+  auto tk = mScanner->read_token();
+  if ( tk == Iscas89Token::GATE ) {
+    node.mType = Gate;
+    node.mGateType = mScanner->cur_gate_type();
+    if ( node.mGateType != PrimType::C0 && node.mGateType != PrimType::C1 ) {
+      if ( !parse_name_list(node.mFaninNum) ) {
+	return false;
+      }
+    }
+  }
+  else if ( tk == Iscas89Token::DFF ) {
+    SizeType iid;
+    if ( !parse_name(iid) ) {
+      return false;
+    }
+    node.mType = Dff;
+    mFaninBuf.push_back(iid);
+    node.mFaninNum = 1;
+    mDffList.push_back(oid);
+  }
+  else if ( tk == Iscas89Token::EXGATE ) {
+    // MUX のみ
+    if ( !parse_name_list(node.mFaninNum) ) {
+      return false;
+    }
+    auto ni = node.mFaninNum;
+    if ( mMuxDict.count(ni) == 0 ) {
+      Expr expr;
+      if ( !nsIscas89::MuxHandler::make_expr(ni, expr) ) {
+	return false;
+      }
+      mMuxDict.emplace(ni, mExprList.size());
+      mExprList.push_back(expr);
+    }
+    node.mType = Complex;
+    node.mExprId = mMuxDict.at(ni);
+  }
+  else {
+    return false;
+  }
+  mNodeArray[oid] = node;
+  return true;
+}
+
+// @brief '(' ')' で囲まれた名前のリストを読み込む．
+bool
+Iscas89BnetReader::parse_name_list(
+  SizeType& num
+)
+{
+  if ( !expect(Iscas89Token::LPAR) ) {
+    return false;
+  }
+  num = 0;
+  for ( ; ; ) {
+    if ( !expect(Iscas89Token::NAME) ) {
+      return false;
+    }
+    mFaninBuf.push_back(find_id(mScanner->cur_view()));
+    ++ num;
+
+    auto tk = mScanner->read_token();
+    if ( tk == Iscas89Token::RPAR ) {
+      return true;
+    }
+    if ( tk != Iscas89Token::COMMA ) {
+      return false;
+    }
+  }
+}
+
+// @brief 名前を読み込んで識別子番号を返す．
+bool
+Iscas89BnetReader::parse_name(
+  SizeType& id
+)
+{
+  if ( !expect(Iscas89Token::LPAR) ) {
+    return false;
+  }
+  if ( !expect(Iscas89Token::NAME) ) {
+    return false;
+  }
+  id = find_id(mScanner->cur_view());
+  if ( !expect(Iscas89Token::RPAR) ) {
+    return false;
+  }
+  return true;
+}
+
+// @brief ノードをトポロジカル順に並べる．
+//
+// ParserImpl::order_node() と同じ順番になるが，
+// 深い再帰を避けるためにスタックを用いる．
+bool
+Iscas89BnetReader::order_node(
+  SizeType id,
+  vector<int>& mark,
+  vector<SizeType>& order
+)
+{
+  if ( mark[id] != 0 ) {
+    return true;
+  }
+
+  // スタックには識別子番号と次に調べるファンインの位置を積む．
+  vector<pair<SizeType, SizeType>> stack;
+  stack.push_back(make_pair(id, 0));
+  mark[id] = 1;
+  while ( !stack.empty() ) {
+    auto id1 = stack.back().first;
+    auto pos = stack.back().second;
+    auto& node = mNodeArray[id1];
+    if ( pos < node.mFaninNum ) {
+      ++ stack.back().second;
+      auto iid = mFaninBuf[node.mFaninBegin + pos];
+      if ( mark[iid] == 1 ) {
+	// ループ
+	return false;
+      }
+      if ( mark[iid] == 0 ) {
+	mark[iid] = 1;
+	stack.push_back(make_pair(iid, 0));
+      }
+    }
+    else {
+      mark[id1] = 2;
+      order.push_back(id1);
+      stack.pop_back();
+    }
+  }
+  return true;
+}
+
+// @brief ネットワークを作る．
+bool
+Iscas89BnetReader::make_network()
+{
+  // 未定義の名前のチェック
+  SizeType n = mNodeArray.size();
+  for ( SizeType id = 0; id < n; ++ id ) {
+    if ( mNodeArray[id].mType == None ) {
+      return false;
+    }
+  }
+
+  // 出力と DFF の入力からファンインをたどって
+  // 論理ノードをトポロジカル順に並べる．
+  // 0: 未処理，1: 処理中，2: 処理済み
+  vector<int> mark(n, 0);
+  for ( auto id: mInputList ) {
+    mark[id] = 2;
+  }
+  for ( auto id: mDffList ) {
+    mark[id] = 2;
+  }
+  vector<SizeType> gate_list;
+  for ( auto id: mOutputList ) {
+    if ( !order_node(id, mark, gate_list) ) {
+      return false;
+    }
+  }
+  for ( auto id: mDffList ) {
+    auto iid = mFaninBuf[mNodeArray[id].mFaninBegin];
+    if ( !order_node(iid, mark, gate_list) ) {
+      return false;
+    }
+  }
+
+  // ここから先は Bench2Bnet と同じ処理を行う．
+  mNetwork.set_name("iscas89_network");
+
+  vector<BnNode> node_map(n);
+  for ( auto id: mInputList ) {
+    auto port = mNetwork.new_input_port(node_name(id));
+    node_map[id] = port.bit(0);
+  }
+
+  BnNode clock;
+  vector<pair<SizeType, SizeType>> dff_input_list;
+  dff_input_list.reserve(mDffList.size());
+  for ( auto id: mDffList ) {
+    // この形式ではクロック以外の制御端子はない．
+    auto dff = mNetwork.new_dff(node_name(id));
+    node_map[id] = dff.data_out();
+
+    // 入力側の接続は最後に行う．
+    auto iid = mFaninBuf[mNodeArray[id].mFaninBegin];
+    dff_input_list.push_back(make_pair(dff.data_in().id(), iid));
+
+    if ( clock.is_invalid() ) {
+      // クロックのポートを作る．
+      auto clock_port = mNetwork.new_input_port(mClockName);
+      clock = clock_port.bit(0);
+    }
+    // クロック入力とdffのクロック端子を結びつける．
+    mNetwork.set_output_src(dff.clock(), clock);
+  }
+
+  vector<BnNode> fanin_list;
+  for ( auto id: gate_list ) {
+    auto& node = mNodeArray[id];
+    fanin_list.clear();
+    fanin_list.reserve(node.mFaninNum);
+    for ( SizeType i = 0; i < node.mFaninNum; ++ i ) {
+      auto iid = mFaninBuf[node.mFaninBegin + i];
+      ASSERT_COND( node_map[iid].is_valid() );
+      fanin_list.push_back(node_map[iid]);
+    }
+    if ( node.mType == Gate ) {
+      node_map[id] = mNetwork.new_logic_primitive(node_name(id),
+						  node.mGateType,
+						  fanin_list);
+    }
+    else {
+      ASSERT_COND( node.mType == Complex );
+      node_map[id] = mNetwork.new_logic_expr(node_name(id),
+					     mExprList[node.mExprId],
+					     fanin_list);
+    }
+  }
+
+  for ( auto id: mOutputList ) {
+    auto name = node_name(id);
+    string name1;
+    if ( mNetwork.find_port(name).is_invalid() ) {
+      name1 = name;
+    }
+    auto port = mNetwork.new_output_port(name1);
+    ASSERT_COND( node_map[id].is_valid() );
+    mNetwork.set_output_src(port.bit(0), node_map[id]);
+  }
+
+  for ( auto& p: dff_input_list ) {
+    auto node_id = p.first;
+    auto iid = p.second;
+    ASSERT_COND( node_map[iid].is_valid() );
+    mNetwork.set_output_src(mNetwork.node(node_id), node_map[iid]);
+  }
+
+  return true;
+}
+
+END_NAMESPACE_YM_BNET
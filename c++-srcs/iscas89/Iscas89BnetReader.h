@@ -0,0 +1,223 @@
+#ifndef ISCAS89BNETREADER_H
+#define ISCAS89BNETREADER_H
+
+/// @file Iscas89BnetReader.h
+/// @brief Iscas89BnetReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/BnModifier.h"
+#include "ym/Expr.h"
+#include "Iscas89MmapScanner.h"
+#include "NameTable.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class Iscas89BnetReader Iscas89BnetReader.h "Iscas89BnetReader.h"
+/// @brief iscas89 ファイルを Iscas89Model を経由せずに読み込むクラス
+///
+/// BnNetwork::read_iscas89() の高速版として用いる．
+/// - ファイルは Iscas89MmapScanner で読む．
+/// - 名前は NameTable で識別子番号に変換する．
+/// - ファイル上の位置は記録しない．
+/// - ノードの情報は識別子番号をキーにした配列に保持し，
+///   最後に Bench2Bnet と同じ順番でノードを生成する．
+///   そのため，結果は通常版と同一となる．
+///
+/// エラーや通常版と解釈が異なりうる記述を見つけた場合はメッセージを
+/// 出さずに false を返す．この場合は通常版のパーサーで読み直すことで
+/// ファイル上の位置を含むエラーメッセージが出力される．
+//////////////////////////////////////////////////////////////////////
+class Iscas89BnetReader
+{
+public:
+
+  /// @brief コンストラクタ
+  Iscas89BnetReader(
+    const string& clock_name ///< [in] クロック端子名
+  );
+
+  /// @brief デストラクタ
+  ~Iscas89BnetReader() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込みを行う．
+  /// @retval true 読み込みが成功した．
+  /// @retval false 通常版で読み直す必要がある．
+  bool
+  read(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief 結果のネットワークを返す．
+  BnNetwork
+  get_network();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ノードの種類
+  enum NodeType {
+    None,    ///< 未定義
+    Input,   ///< 入力
+    Dff,     ///< DFF
+    Gate,    ///< 組み込み型のゲート
+    Complex  ///< 論理式を持つゲート
+  };
+
+  /// @brief ノードの情報
+  struct Node
+  {
+    // 種類
+    NodeType mType{None};
+
+    // ゲートの種類(Gate の時のみ意味を持つ)
+    PrimType mGateType{PrimType::None};
+
+    // 論理式番号(Complex の時のみ意味を持つ)
+    SizeType mExprId{0};
+
+    // mFaninBuf 中のファンインの開始位置
+    // DFF の場合は入力を1つのファンインとして持つ．
+    SizeType mFaninBegin{0};
+
+    // ファンイン数
+    SizeType mFaninNum{0};
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief INPUT 文を読み込む．
+  bool
+  read_input();
+
+  /// @brief OUTPUT 文を読み込む．
+  bool
+  read_output();
+
+  /// @brief ゲート/DFF 文を読み込む．
+  bool
+  read_gate(
+    SizeType oid ///< [in] 出力名の識別子番号
+  );
+
+  /// @brief '(' ')' で囲まれた名前のリストを読み込む．
+  ///
+  /// 結果は mFaninBuf の末尾に追加される．
+  bool
+  parse_name_list(
+    SizeType& num ///< [out] 読み込んだ名前の数
+  );
+
+  /// @brief 名前を読み込んで識別子番号を返す．
+  bool
+  parse_name(
+    SizeType& id ///< [out] 識別子番号
+  );
+
+  /// @brief 次のトークンが期待されている型か調べる．
+  bool
+  expect(
+    nsIscas89::Iscas89Token::Type exp_type ///< [in] トークンの期待値
+  )
+  {
+    return mScanner->read_token() == exp_type;
+  }
+
+  /// @brief 名前に対応する識別子番号を返す．
+  SizeType
+  find_id(
+    std::string_view name ///< [in] 名前
+  )
+  {
+    auto id = mNameTable.intern(name);
+    if ( id == mNodeArray.size() ) {
+      mNodeArray.push_back(Node{});
+    }
+    return id;
+  }
+
+  /// @brief ノードをトポロジカル順に並べる．
+  /// @return ループがあった場合は false を返す．
+  bool
+  order_node(
+    SizeType id,             ///< [in] 識別子番号
+    vector<int>& mark,       ///< [inout] 処理中/処理済みの印
+    vector<SizeType>& order  ///< [out] 結果を格納するリスト
+  );
+
+  /// @brief ネットワークを作る．
+  /// @return ループがあった場合は false を返す．
+  bool
+  make_network();
+
+  /// @brief 名前を文字列として返す．
+  string
+  node_name(
+    SizeType id ///< [in] 識別子番号
+  ) const
+  {
+    return string{mNameTable.name(id)};
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ネットワーク
+  BnModifier mNetwork;
+
+  // クロック端子名
+  string mClockName;
+
+  // 字句解析器
+  // この変数は read() 内でのみ有効
+  nsIscas89::Iscas89MmapScanner* mScanner{nullptr};
+
+  // 名前の表
+  NameTable mNameTable;
+
+  // 識別子番号をキーにしてノードの情報を格納する配列
+  vector<Node> mNodeArray;
+
+  // ファンインの識別子番号を連結したもの
+  vector<SizeType> mFaninBuf;
+
+  // 入力の識別子番号のリスト
+  vector<SizeType> mInputList;
+
+  // 出力の識別子番号のリスト
+  vector<SizeType> mOutputList;
+
+  // DFF の識別子番号のリスト
+  vector<SizeType> mDffList;
+
+  // 論理式のリスト
+  vector<Expr> mExprList;
+
+  // MUX の入力数をキーにして論理式番号を格納する辞書
+  unordered_map<SizeType, SizeType> mMuxDict;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // ISCAS89BNETREADER_H
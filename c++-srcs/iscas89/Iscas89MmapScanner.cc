@@ -0,0 +1,240 @@
+
+/// @file Iscas89MmapScanner.cc
+/// @brief Iscas89MmapScanner の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Iscas89MmapScanner.h"
+#include <cstring>
+
+
+BEGIN_NAMESPACE_YM_ISCAS89
+
+BEGIN_NONAMESPACE
+
+// word が upper か lower に等しい時 true を返す．
+// 長さは等しいと仮定している．
+inline
+bool
+match(
+  std::string_view word,
+  const char* upper,
+  const char* lower
+)
+{
+  return std::memcmp(word.data(), upper, word.size()) == 0 ||
+    std::memcmp(word.data(), lower, word.size()) == 0;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Iscas89MmapScanner
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Iscas89MmapScanner::Iscas89MmapScanner(
+  const string& filename
+) : mFile{filename}
+{
+  if ( !mFile.is_valid() ) {
+    return;
+  }
+  auto contents = mFile.contents();
+  mCur = contents.data();
+  mEnd = mCur + contents.size();
+  mValid = true;
+}
+
+// @brief トークンを一つ読み出す．
+Iscas89Token::Type
+Iscas89MmapScanner::read_token()
+{
+  // 字句の区切りは Iscas89Scanner::scan() と同じ
+
+ ST_INIT:
+  mTokenBegin = mCur;
+  mTokenEnd = mCur;
+  if ( mCur == mEnd ) {
+    return Iscas89Token::_EOF;
+  }
+  switch ( *mCur ) {
+  case ' ':
+  case '\t':
+  case '\n':
+    // ホワイトスペースは読み飛ばす．
+    ++ mCur;
+    goto ST_INIT;
+
+  case '#':
+    {
+      // 改行までは読み飛ばす．
+      auto p = static_cast<const char*>(std::memchr(mCur, '\n', mEnd - mCur));
+      if ( p == nullptr ) {
+	mCur = mEnd;
+	return Iscas89Token::_EOF;
+      }
+      mCur = p + 1;
+      goto ST_INIT;
+    }
+
+  case '=':
+    ++ mCur;
+    return Iscas89Token::EQ;
+
+  case '(':
+    ++ mCur;
+    return Iscas89Token::LPAR;
+
+  case ')':
+    ++ mCur;
+    return Iscas89Token::RPAR;
+
+  case ',':
+    ++ mCur;
+    return Iscas89Token::COMMA;
+
+  case '\r':
+    // 通常版との解釈の違いを避けるため扱わない．
+    return Iscas89Token::ERROR;
+
+  default:
+    break;
+  }
+
+  auto p = mCur;
+  for ( ; p < mEnd; ++ p ) {
+    auto c = *p;
+    if ( c == ' ' || c == '\t' || c == '\n' || c == '#' ||
+	 c == '=' || c == '(' || c == ')' || c == ',' ) {
+      break;
+    }
+    if ( c == '\r' ) {
+      return Iscas89Token::ERROR;
+    }
+  }
+  mCur = p;
+  mTokenEnd = p;
+  return check_word(cur_view());
+}
+
+// @brief 予約語を調べる．
+Iscas89Token::Type
+Iscas89MmapScanner::check_word(
+  std::string_view word
+)
+{
+  switch ( word.size() ) {
+  case 2:
+    if ( match(word, "OR", "or") ) {
+      mGateType = PrimType::Or;
+      return Iscas89Token::GATE;
+    }
+    break;
+
+  case 3:
+    switch ( word[0] ) {
+    case 'A': case 'a':
+      if ( match(word, "AND", "and") ) {
+	mGateType = PrimType::And;
+	return Iscas89Token::GATE;
+      }
+      break;
+    case 'B': case 'b':
+      if ( match(word, "BUF", "buf") ) {
+	mGateType = PrimType::Buff;
+	return Iscas89Token::GATE;
+      }
+      break;
+    case 'D': case 'd':
+      if ( match(word, "DFF", "dff") ) {
+	return Iscas89Token::DFF;
+      }
+      break;
+    case 'I': case 'i':
+      if ( match(word, "INV", "inv") ) {
+	mGateType = PrimType::Not;
+	return Iscas89Token::GATE;
+      }
+      break;
+    case 'M': case 'm':
+      if ( match(word, "MUX", "mux") ) {
+	return Iscas89Token::EXGATE;
+      }
+      break;
+    case 'N': case 'n':
+      if ( match(word, "NOT", "not") ) {
+	mGateType = PrimType::Not;
+	return Iscas89Token::GATE;
+      }
+      if ( match(word, "NOR", "nor") ) {
+	mGateType = PrimType::Nor;
+	return Iscas89Token::GATE;
+      }
+      break;
+    case 'X': case 'x':
+      if ( match(word, "XOR", "xor") ) {
+	mGateType = PrimType::Xor;
+	return Iscas89Token::GATE;
+      }
+      break;
+    default:
+      break;
+    }
+    break;
+
+  case 4:
+    switch ( word[0] ) {
+    case 'B': case 'b':
+      if ( match(word, "BUFF", "buff") ) {
+	mGateType = PrimType::Buff;
+	return Iscas89Token::GATE;
+      }
+      break;
+    case 'N': case 'n':
+      if ( match(word, "NAND", "nand") ) {
+	mGateType = PrimType::Nand;
+	return Iscas89Token::GATE;
+      }
+      break;
+    case 'X': case 'x':
+      if ( match(word, "XNOR", "xnor") ) {
+	mGateType = PrimType::Xnor;
+	return Iscas89Token::GATE;
+      }
+      break;
+    default:
+      break;
+    }
+    break;
+
+  case 5:
+    if ( match(word, "INPUT", "input") ) {
+      return Iscas89Token::INPUT;
+    }
+    break;
+
+  case 6:
+    if ( match(word, "OUTPUT", "output") ) {
+      return Iscas89Token::OUTPUT;
+    }
+    if ( match(word, "CONST0", "const0") ) {
+      mGateType = PrimType::C0;
+      return Iscas89Token::GATE;
+    }
+    if ( match(word, "CONST1", "const1") ) {
+      mGateType = PrimType::C1;
+      return Iscas89Token::GATE;
+    }
+    break;
+
+  default:
+    break;
+  }
+  return Iscas89Token::NAME;
+}
+
+END_NAMESPACE_YM_ISCAS89
@@ -0,0 +1,138 @@
+#ifndef ISCAS89MMAPSCANNER_H
+#define ISCAS89MMAPSCANNER_H
+
+/// @file Iscas89MmapScanner.h
+/// @brief Iscas89MmapScanner のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/iscas89_nsdef.h"
+#include "ym/logic.h"
+#include "Iscas89Token.h"
+#include "MappedFile.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_ISCAS89
+
+//////////////////////////////////////////////////////////////////////
+/// @class Iscas89MmapScanner Iscas89MmapScanner.h "Iscas89MmapScanner.h"
+/// @brief ファイルをメモリにマップして読む iscas89 用の字句解析器
+///
+/// 高速読み込み用の字句解析器で，Iscas89Scanner と以下の点が異なる．
+/// - ファイル全体を MappedFile でメモリ上に置き，1文字ずつのコピーを行わない．
+/// - 名前はマップした領域を指す std::string_view で返す．
+/// - ファイル上の位置は求めない．
+/// - 予約語は Iscas89ExParser のものに固定されている．
+///   CONST0/CONST1 は GATE(ゲート型は C0/C1)，MUX は EXGATE となる．
+/// - '\r' は ERROR となる．
+//////////////////////////////////////////////////////////////////////
+class Iscas89MmapScanner
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// ファイルが開けなかった場合は is_valid() が false となる．
+  Iscas89MmapScanner(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  Iscas89MmapScanner(
+    const Iscas89MmapScanner& src
+  ) = delete;
+
+  /// @brief 代入演算子は禁止
+  Iscas89MmapScanner&
+  operator=(
+    const Iscas89MmapScanner& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~Iscas89MmapScanner() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイルを読み込めた時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mValid;
+  }
+
+  /// @brief トークンを一つ読み出す．
+  Iscas89Token::Type
+  read_token();
+
+  /// @brief 最後の read_token() で読み出した字句を返す．
+  std::string_view
+  cur_view() const
+  {
+    return std::string_view{mTokenBegin,
+			    static_cast<SizeType>(mTokenEnd - mTokenBegin)};
+  }
+
+  /// @brief 最後の read_token() で読み出したゲートの種類を返す．
+  ///
+  /// read_token() が GATE を返した時のみ意味を持つ．
+  PrimType
+  cur_gate_type() const
+  {
+    return mGateType;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 予約語を調べる．
+  /// @return 予約語の場合は対応するトークンを，
+  /// そうでなければ Iscas89Token::NAME を返す．
+  ///
+  /// GATE の場合はゲートの種類を mGateType に設定する．
+  Iscas89Token::Type
+  check_word(
+    std::string_view word ///< [in] 字句
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 読み込めた時 true
+  bool mValid{false};
+
+  // ファイルの内容
+  nsBnet::MappedFile mFile;
+
+  // 内容の末尾
+  const char* mEnd{nullptr};
+
+  // 次に読む位置
+  const char* mCur{nullptr};
+
+  // 最後のトークンの先頭
+  const char* mTokenBegin{nullptr};
+
+  // 最後のトークンの末尾
+  const char* mTokenEnd{nullptr};
+
+  // 最後のゲートの種類
+  PrimType mGateType{PrimType::None};
+
+};
+
+END_NAMESPACE_YM_ISCAS89
+
+#endif // ISCAS89MMAPSCANNER_H
@@ -28,13 +28,8 @@ MuxHandler::read(
   FileRegion loc{first_loc, last_loc};
   // 入力数をチェックする．
   SizeType ni = iname_id_list.size();
-  SizeType nc = 0;
-  SizeType nd = 1;
-  while ( nc + nd < ni ) {
-    ++ nc;
-    nd <<= 1;
-  }
-  if ( nc + nd != ni ) {
+  Expr expr;
+  if ( !make_expr(ni, expr) ) {
     // 引数の数が合わない．
     ostringstream buf;
     auto oname = id2str(oname_id);
@@ -45,6 +40,27 @@ MuxHandler::read(
 		    buf.str());
     return false;
   }
+  set_complex(oname_id, loc, expr, iname_id_list);
+
+  return true;
+}
+
+// @brief MUX を表す論理式を作る．
+bool
+MuxHandler::make_expr(
+  SizeType ni,
+  Expr& expr
+)
+{
+  SizeType nc = 0;
+  SizeType nd = 1;
+  while ( nc + nd < ni ) {
+    ++ nc;
+    nd <<= 1;
+  }
+  if ( nc + nd != ni ) {
+    return false;
+  }
 
   vector<Expr> control_inputs(nc);
   for ( SizeType i = 0; i < nc; ++ i ) {
@@ -68,10 +84,7 @@ MuxHandler::read(
     auto and_expr = Expr::make_and(fanin_list);
     data_inputs[i] = and_expr;
   }
-  auto expr = Expr::make_or(data_inputs);
-
-  set_complex(oname_id, loc, expr, iname_id_list);
-
+  expr = Expr::make_or(data_inputs);
   return true;
 }
 
@@ -42,6 +42,18 @@ public:
     SizeType oname_id      ///< [in] 出力名の ID 番号
   ) override;
 
+  /// @brief MUX を表す論理式を作る．
+  /// @retval true 論理式を作った．
+  /// @retval false 入力数が MUX として正しくなかった．
+  ///
+  /// 入力は制御入力，データ入力の順に並んでいるものとする．
+  static
+  bool
+  make_expr(
+    SizeType ni, ///< [in] 入力数
+    Expr& expr   ///< [out] 結果の論理式
+  );
+
 };
 
 END_NAMESPACE_YM_ISCAS89
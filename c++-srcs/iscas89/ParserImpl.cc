@@ -11,6 +11,7 @@
 #include "ym/Iscas89Model.h"
 #include "ym/Iscas89Handler.h"
 #include "ModelImpl.h"
+#include "CompStream.h"
 #include "ym/MsgMgr.h"
 
 
@@ -56,7 +57,8 @@ ParserImpl::read(
 )
 {
   // ファイルをオープンする．
-  ifstream fin{filename};
+  // gzip/zstd で圧縮されている場合は展開しながら読む．
+  nsBnet::CompInStream fin{filename};
   if ( !fin ) {
     // エラー
     ostringstream buf;
@@ -527,6 +527,23 @@ bnet_name(
   return 1;
 }
 
+// ヒストグラムを配列としてスタックに積む．
+void
+push_hist(
+  lua_State* L,
+  const vector<SizeType>& hist
+)
+{
+  LuaBnet lua{L};
+
+  lua.create_table();
+  int idx = lua.absindex(-1);
+  for ( SizeType i = 0; i < hist.size(); ++ i ) {
+    lua.push_integer(hist[i]);
+    lua_rawseti(L, idx, i + 1);
+  }
+}
+
 // 諸元を格納したターブルを作る．
 int
 bnet_stats(
@@ -543,6 +560,9 @@ bnet_stats(
   // 対象のネットワーク
   auto bnet = lua.to_bnet(1);
 
+  // 統計情報はネイティブ側で1回の走査で求める．
+  auto stats = bnet->stats();
+
   // 結果のテーブルを作る．
   lua.create_table();
   int tbl_idx = lua.absindex(-1);
@@ -555,35 +575,81 @@ bnet_stats(
   }
 
   { // port_num
-    SizeType n = bnet->port_num();
-    lua.push_integer(n);
+    lua.push_integer(stats.port_num);
     lua.set_field(tbl_idx, "port_num");
   }
   { // dff_num
-    SizeType n = bnet->dff_num();
-    lua.push_integer(n);
-    lua.set_field(tbl_idx, "dff_num");
-  }
-  { // dff_num
-    SizeType n = bnet->dff_num();
-    lua.push_integer(n);
+    lua.push_integer(stats.dff_num);
     lua.set_field(tbl_idx, "dff_num");
   }
   { // input_num
-    SizeType n = bnet->input_num();
-    lua.push_integer(n);
+    lua.push_integer(stats.input_num);
     lua.set_field(tbl_idx, "input_num");
   }
+  { // primary_input_num
+    lua.push_integer(stats.primary_input_num);
+    lua.set_field(tbl_idx, "primary_input_num");
+  }
   { // output_num
-    SizeType n = bnet->output_num();
-    lua.push_integer(n);
+    lua.push_integer(stats.output_num);
     lua.set_field(tbl_idx, "output_num");
   }
+  { // primary_output_num
+    lua.push_integer(stats.primary_output_num);
+    lua.set_field(tbl_idx, "primary_output_num");
+  }
   { // logic_num
-    SizeType n = bnet->logic_num();
-    lua.push_integer(n);
+    lua.push_integer(stats.logic_num);
     lua.set_field(tbl_idx, "logic_num");
   }
+  { // depth
+    lua.push_integer(stats.depth);
+    lua.set_field(tbl_idx, "depth");
+  }
+  { // expr_num
+    lua.push_integer(stats.expr_num);
+    lua.set_field(tbl_idx, "expr_num");
+  }
+  { // func_num
+    lua.push_integer(stats.func_num);
+    lua.set_field(tbl_idx, "func_num");
+  }
+  { // node_type_num
+    lua.create_table();
+    int sub_idx = lua.absindex(-1);
+    for ( SizeType i = 0; i < BnNetworkStats::NODE_TYPE_NUM; ++ i ) {
+      lua.push_integer(stats.node_type_num[i]);
+      lua.set_field(sub_idx, BnNetworkStats::NODE_TYPE_NAME[i]);
+    }
+    lua.set_field(tbl_idx, "node_type_num");
+  }
+  { // prim_type_num
+    lua.create_table();
+    int sub_idx = lua.absindex(-1);
+    for ( SizeType i = 0; i < BnNetworkStats::PRIM_TYPE_NUM; ++ i ) {
+      lua.push_integer(stats.prim_type_num[i]);
+      lua.set_field(sub_idx, BnNetworkStats::PRIM_TYPE_NAME[i]);
+    }
+    lua.set_field(tbl_idx, "prim_type_num");
+  }
+  { // dff_type_num
+    lua.create_table();
+    int sub_idx = lua.absindex(-1);
+    for ( SizeType i = 0; i < BnNetworkStats::DFF_TYPE_NUM; ++ i ) {
+      lua.push_integer(stats.dff_type_num[i]);
+      lua.set_field(sub_idx, BnNetworkStats::DFF_TYPE_NAME[i]);
+    }
+    lua.set_field(tbl_idx, "dff_type_num");
+  }
+  { // fanin_hist
+    // Lua の配列は 1 から始まるので fanin_hist[k + 1] がファンイン数 k の数となる．
+    push_hist(L, stats.fanin_hist);
+    lua.set_field(tbl_idx, "fanin_hist");
+  }
+  { // fanout_hist
+    push_hist(L, stats.fanout_hist);
+    lua.set_field(tbl_idx, "fanout_hist");
+  }
   if ( 0 ) { // literal_sum
     SizeType n = 0;
     for ( auto& node: bnet->logic_list() ) {
@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "BlifWriter.h"
+#include "CompStream.h"
 #include "ym/BnNetwork.h"
 #include "ym/Expr.h"
 #include "ym/TvFunc.h"
@@ -27,9 +28,15 @@ BnNetwork::write_blif(
   const string& suffix
 ) const
 {
-  ofstream ofs{filename};
+  CompOutStream ofs{filename};
   if ( ofs ) {
     write_blif(ofs, prefix, suffix);
+    ofs.close();
+    if ( !ofs ) {
+      ostringstream buf;
+      buf << filename << ": Write error";
+      throw std::invalid_argument{buf.str()};
+    }
   }
 }
 
@@ -60,7 +67,12 @@ BnNetwork::write_blif(
   }
 
   BlifWriter writer{*this, prefix, suffix};
-  writer(s);
+  OutBuffer buff{s};
+  writer(buff);
+  buff.close();
+  if ( !buff.is_ok() ) {
+    throw std::invalid_argument{"BnNetwork::write_blif(): Write error"};
+  }
 }
 
 
@@ -68,7 +80,7 @@ BEGIN_NONAMESPACE
 
 void
 write_primitive(
-  ostream& s,
+  OutBuffer& s,
   PrimType type,
   SizeType ni
 )
@@ -78,54 +90,54 @@ write_primitive(
     ASSERT_NOT_REACHED;
     break;
   case PrimType::C0:
-    s << "0" << endl;
+    s.put_string("0\n");
     break;
   case PrimType::C1:
-    s << "1" << endl;
+    s.put_string("1\n");
     break;
   case PrimType::Buff:
-    s << "1 1" << endl;
+    s.put_string("1 1\n");
     break;
   case PrimType::Not:
-    s << "0 1" << endl;
+    s.put_string("0 1\n");
     break;
   case PrimType::And:
     for ( auto i: Range(ni) ) {
-      s << "1";
+      s.put_char('1');
     }
-    s << " 1" << endl;
+    s.put_string(" 1\n");
     break;
   case PrimType::Nand:
     for ( auto i: Range(ni) ) {
       for ( auto j: Range(ni) ) {
 	if ( i == j ) {
-	  s << "0";
+	  s.put_char('0');
 	}
 	else {
-	  s << "-";
+	  s.put_char('-');
 	}
       }
-      s << " 1" << endl;
+      s.put_string(" 1\n");
     }
     break;
   case PrimType::Or:
     for ( auto i: Range(ni) ) {
       for ( auto j: Range(ni) ) {
 	if ( i == j ) {
-	  s << "1";
+	  s.put_char('1');
 	}
 	else {
-	  s << "-";
+	  s.put_char('-');
 	}
       }
-      s << " 1" << endl;
+      s.put_string(" 1\n");
     }
     break;
   case PrimType::Nor:
     for ( auto i: Range(ni) ) {
-      s << "0";
+      s.put_char('0');
     }
-    s << " 1" << endl;
+    s.put_string(" 1\n");
     break;
   case PrimType::Xor:
     for ( auto p: Range(1 << ni) ) {
@@ -138,13 +150,13 @@ write_primitive(
       if ( parity ) {
 	for ( auto i: Range(ni) ) {
 	  if ( p & (1 << i) ) {
-	    s << "1";
+	    s.put_char('1');
 	  }
 	  else {
-	    s << "0";
+	    s.put_char('0');
 	  }
 	}
-	s << " 1" << endl;
+	s.put_string(" 1\n");
       }
     }
     break;
@@ -159,13 +171,13 @@ write_primitive(
       if ( parity == 0 ) {
 	for ( auto i: Range(ni) ) {
 	  if ( p & (1 << i) ) {
-	    s << "1";
+	    s.put_char('1');
 	  }
 	  else {
-	    s << "0";
+	    s.put_char('0');
 	  }
 	}
-	s << " 1" << endl;
+	s.put_string(" 1\n");
       }
     }
     break;
@@ -174,7 +186,7 @@ write_primitive(
 
 void
 write_expr(
-  ostream& s,
+  OutBuffer& s,
   const Expr& expr,
   SizeType ni
 )
@@ -198,12 +210,12 @@ write_expr(
       }
       for ( auto i: Range(ni) ) {
 	switch ( pol_array[i] ) {
-	case 0: s << "-"; break;
-	case 1: s << "1"; break;
-	case 2: s << "0"; break;
+	case 0: s.put_char('-'); break;
+	case 1: s.put_char('1'); break;
+	case 2: s.put_char('0'); break;
 	}
       }
-      s << " 1" << endl;
+      s.put_string(" 1\n");
     }
     else if ( expr.is_or() ) {
       for ( auto& expr1: expr.operand_list() ) {
@@ -211,25 +223,25 @@ write_expr(
 	  auto var = expr1.varid();
 	  for ( auto j: Range(ni) ) {
 	    if ( j == var ) {
-	      s << "1";
+	      s.put_char('1');
 	    }
 	    else {
-	      s << "-";
+	      s.put_char('-');
 	    }
 	  }
-	  s << " 1" << endl;
+	  s.put_string(" 1\n");
 	}
 	else if ( expr1.is_nega_literal() ) {
 	  auto var = expr1.varid();
 	  for ( auto j: Range(ni) ) {
 	    if ( j == var ) {
-	      s << "0";
+	      s.put_char('0');
 	    }
 	    else {
-	      s << "-";
+	      s.put_char('-');
 	    }
 	  }
-	  s << " 1" << endl;
+	  s.put_string(" 1\n");
 	}
 	else if ( expr1.is_and() ) {
 	  vector<SizeType> lit_map(ni, 0);
@@ -245,16 +257,16 @@ write_expr(
 	  }
 	  for ( auto j: Range(ni) ) {
 	    if ( lit_map[j] == 1 ) {
-	      s << "1";
+	      s.put_char('1');
 	    }
 	    else if ( lit_map[j] == 2 ) {
-	      s << "0";
+	      s.put_char('0');
 	    }
 	    else {
-	      s << "-";
+	      s.put_char('-');
 	    }
 	  }
-	  s << " 1" << endl;
+	  s.put_string(" 1\n");
 	}
       }
     }
@@ -277,13 +289,13 @@ write_expr(
       if ( expr.eval(vect_array, 1) == 1 ) {
 	for ( auto i: Range(ni) ) {
 	  if ( p & (1 << i) ) {
-	    s << "1";
+	    s.put_char('1');
 	  }
 	  else {
-	    s << "0";
+	    s.put_char('0');
 	  }
 	}
-	s << " 1" << endl;
+	s.put_string(" 1\n");
       }
     }
   }
@@ -291,7 +303,7 @@ write_expr(
 
 void
 write_tvfunc(
-  ostream& s,
+  OutBuffer& s,
   const TvFunc& func
 )
 {
@@ -300,13 +312,13 @@ write_tvfunc(
     if ( func.value(p) ) {
       for ( auto i: Range(ni) ) {
 	if ( p & (1 << i) ) {
-	  s << "1";
+	  s.put_char('1');
 	}
 	else {
-	  s << "0";
+	  s.put_char('0');
 	}
       }
-      s << " 1" << endl;
+      s.put_string(" 1\n");
     }
   }
 }
@@ -338,11 +350,13 @@ BlifWriter::BlifWriter(
 // @brief blif 形式で出力する．
 void
 BlifWriter::operator()(
-  ostream& s
+  OutBuffer& s
 )
 {
   // .model 文の出力
-  s << ".model " << network().name() << endl;
+  s.put_string(".model ");
+  s.put_string(network().name());
+  s.put_char('\n');
 
   // .inputs 文の出力
   int count = 0;
@@ -351,52 +365,60 @@ BlifWriter::operator()(
       continue;
     }
     if ( count == 0 ) {
-      s << ".inputs";
+      s.put_string(".inputs");
     }
-    s << " " << node_name(node);
+    s.put_char(' ');
+    s.put_string(node_name(node));
     ++ count;
     if ( count >= 10 ) {
-      s << endl;
+      s.put_char('\n');
       count = 0;
     }
   }
   if ( count > 0 ) {
-    s << endl;
+    s.put_char('\n');
   }
 
   // .outputs 文の出力
   count = 0;
   for ( auto node: network().primary_output_list() ) {
     if ( count == 0 ) {
-      s << ".outputs";
+      s.put_string(".outputs");
     }
 
     auto src_node = node.output_src();
-    s << " " << node_name(src_node);
+    s.put_char(' ');
+    s.put_string(node_name(src_node));
     ++ count;
     if ( count >= 10 ) {
-      s << endl;
+      s.put_char('\n');
       count = 0;
     }
   }
   if ( count > 0 ) {
-    s << endl;
+    s.put_char('\n');
   }
 
   // .latch 文の出力
   for ( auto dff: network().dff_list() ) {
-    s << ".latch " << node_name(dff.data_in())
-      << " " << node_name(dff.data_out()) << endl;
+    s.put_string(".latch ");
+    s.put_string(node_name(dff.data_in()));
+    s.put_char(' ');
+    s.put_string(node_name(dff.data_out()));
+    s.put_char('\n');
   }
 
   // 出力用の追加の .names 文
   for ( auto node: network().primary_output_list() ) {
-    string name = node_name(node);
+    auto name = node_name(node);
     auto src_node = node.output_src();
-    string src_name = node_name(src_node);
+    auto src_name = node_name(src_node);
     if ( name != src_name ) {
-      s << ".names " << src_name << " " << name << endl
-	<< "1 1" << endl;
+      s.put_string(".names ");
+      s.put_string(src_name);
+      s.put_char(' ');
+      s.put_string(name);
+      s.put_string("\n1 1\n");
     }
   }
 
@@ -406,11 +428,14 @@ BlifWriter::operator()(
       continue;
     }
 
-    s << ".names";
+    s.put_string(".names");
     for ( auto inode: node.fanin_list() ) {
-      s << " " << inode.name();
+      s.put_char(' ');
+      s.put_string(inode.name());
     }
-    s << " " << node_name(node) << endl;
+    s.put_char(' ');
+    s.put_string(node_name(node));
+    s.put_char('\n');
     auto type = node.type();
     auto ni = node.fanin_num();
     switch ( type ) {
@@ -428,7 +453,7 @@ BlifWriter::operator()(
       break;
     }
   }
-  s << ".end" << endl;
+  s.put_string(".end\n");
 }
 
 END_NAMESPACE_YM_BNET
@@ -41,7 +41,7 @@ public:
   /// @brief blif 形式で出力する．
   void
   operator()(
-    ostream& s ///< [in] 出力先のストリーム
+    OutBuffer& s ///< [in] 出力先
   );
 
 };
@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "Iscas89Writer.h"
+#include "CompStream.h"
 #include "ym/BnNetwork.h"
 #include "ym/Expr.h"
 #include "ym/TvFunc.h"
@@ -26,9 +27,15 @@ BnNetwork::write_iscas89(
   const string& suffix
 ) const
 {
-  ofstream ofs{filename};
+  CompOutStream ofs{filename};
   if ( ofs ) {
     write_iscas89(ofs, prefix, suffix);
+    ofs.close();
+    if ( !ofs ) {
+      ostringstream buf;
+      buf << filename << ": Write error";
+      throw std::invalid_argument{buf.str()};
+    }
   }
 }
 
@@ -70,12 +77,22 @@ BnNetwork::write_iscas89(
     // iscas89 フォーマットに合うように変形する
     auto network = simple_decomp();
     Iscas89Writer writer{network, prefix, suffix};
-    writer(s);
+    OutBuffer buff{s};
+    writer(buff);
+    buff.close();
+    if ( !buff.is_ok() ) {
+      throw std::invalid_argument{"BnNetwork::write_iscas89(): Write error"};
+    }
     return;
   }
   else {
     Iscas89Writer writer{*this, prefix, suffix};
-    writer(s);
+    OutBuffer buff{s};
+    writer(buff);
+    buff.close();
+    if ( !buff.is_ok() ) {
+      throw std::invalid_argument{"BnNetwork::write_iscas89(): Write error"};
+    }
   }
 }
 
@@ -105,39 +122,47 @@ Iscas89Writer::Iscas89Writer(
 // @brief blif 形式で出力する．
 void
 Iscas89Writer::operator()(
-  ostream& s
+  OutBuffer& s
 )
 {
   // INPUT 文の出力
-  int count = 0;
   for ( auto node: network().primary_input_list() ) {
     if ( is_data(node) ) {
-      s << "INPUT(" << node_name(node) << ")" << endl;
+      s.put_string("INPUT(");
+      s.put_string(node_name(node));
+      s.put_string(")\n");
     }
   }
-  s << endl;
+  s.put_char('\n');
 
   // OUTPUT 文の出力
   for ( auto node: network().primary_output_list() ) {
     auto src_node = node.output_src();
-    s << "OUTPUT(" << node_name(src_node) << ")" << endl;
+    s.put_string("OUTPUT(");
+    s.put_string(node_name(src_node));
+    s.put_string(")\n");
   }
-  s << endl;
+  s.put_char('\n');
 
   // DFF 文の出力
   for ( auto dff: network().dff_list() ) {
-    s << node_name(dff.data_out())
-      << " = DFF(" << node_name(dff.data_in()) << ")" << endl;
+    s.put_string(node_name(dff.data_out()));
+    s.put_string(" = DFF(");
+    s.put_string(node_name(dff.data_in()));
+    s.put_string(")\n");
   }
-  s << endl;
+  s.put_char('\n');
 
   // 出力用の追加の BUFF 文
   for ( auto node: network().primary_output_list() ) {
-    string name = node_name(node);
+    auto name = node_name(node);
     auto src_node = node.output_src();
-    string src_name = node_name(src_node);
+    auto src_name = node_name(src_node);
     if ( name != src_name ) {
-      s << name << " = BUFF(" << src_name << ")" << endl;
+      s.put_string(name);
+      s.put_string(" = BUFF(");
+      s.put_string(src_name);
+      s.put_string(")\n");
     }
   }
 
@@ -147,30 +172,32 @@ Iscas89Writer::operator()(
       continue;
     }
     ASSERT_COND( node.type() == BnNodeType::Prim );
-    s << node_name(node) << " = ";
+    s.put_string(node_name(node));
+    s.put_string(" = ");
     switch ( node.primitive_type() ) {
-    case PrimType::C0:   s << "CONST0"; break;
-    case PrimType::C1:   s << "CONST1"; break;
-    case PrimType::Buff: s << "BUFF"; break;
-    case PrimType::Not:  s << "NOT"; break;
-    case PrimType::And:  s << "AND"; break;
-    case PrimType::Nand: s << "NAND"; break;
-    case PrimType::Or:   s << "OR"; break;
-    case PrimType::Nor:  s << "NOR"; break;
-    case PrimType::Xor:  s << "XOR"; break;
-    case PrimType::Xnor: s << "XNOR"; break;
+    case PrimType::C0:   s.put_string("CONST0"); break;
+    case PrimType::C1:   s.put_string("CONST1"); break;
+    case PrimType::Buff: s.put_string("BUFF"); break;
+    case PrimType::Not:  s.put_string("NOT"); break;
+    case PrimType::And:  s.put_string("AND"); break;
+    case PrimType::Nand: s.put_string("NAND"); break;
+    case PrimType::Or:   s.put_string("OR"); break;
+    case PrimType::Nor:  s.put_string("NOR"); break;
+    case PrimType::Xor:  s.put_string("XOR"); break;
+    case PrimType::Xnor: s.put_string("XNOR"); break;
     default: ASSERT_NOT_REACHED; break;
     }
     if ( node.fanin_num() > 0 ) {
-      s << "(";
+      s.put_char('(');
       const char* comma = "";
       for ( auto inode: node.fanin_list() ) {
-	s << comma << node_name(inode);
+	s.put_string(comma);
+	s.put_string(node_name(inode));
 	comma = ", ";
       }
-      s << ")";
+      s.put_char(')');
     }
-    s << endl;
+    s.put_char('\n');
   }
 }
 
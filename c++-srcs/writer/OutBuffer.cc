@@ -0,0 +1,180 @@
+
+/// @file OutBuffer.cc
+/// @brief OutBuffer の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "OutBuffer.h"
+#include "CompStream.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+BEGIN_NONAMESPACE
+
+// バッファサイズの最小値
+// 10進数の数値が必ず収まる大きさにしておく．
+const SizeType MIN_BUFF_SIZE = 64;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス OutBuffer
+//////////////////////////////////////////////////////////////////////
+
+// デフォルトのバッファサイズ
+const SizeType OutBuffer::kDefaultBuffSize = 1 << 16;
+
+// @brief ストリームに書き出すコンストラクタ
+OutBuffer::OutBuffer(
+  ostream& s,
+  SizeType buff_size
+) : mStream{&s},
+    mBuff(std::max(buff_size, MIN_BUFF_SIZE))
+{
+}
+
+// @brief ファイル記述子に書き出すコンストラクタ
+OutBuffer::OutBuffer(
+  int fd,
+  SizeType buff_size
+) : mFd{fd},
+    mBuff(std::max(buff_size, MIN_BUFF_SIZE))
+{
+}
+
+// @brief ファイルに書き出すコンストラクタ
+OutBuffer::OutBuffer(
+  const string& filename,
+  SizeType buff_size
+) : mBuff(std::max(buff_size, MIN_BUFF_SIZE))
+{
+  if ( Encoder::type_from_filename(filename) != CompType::None ) {
+    mCompStream = std::unique_ptr<CompOutStream>{new CompOutStream{filename}};
+    if ( *mCompStream ) {
+      mStream = mCompStream.get();
+    }
+    return;
+  }
+  mFd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  mOwnFd = mFd >= 0;
+}
+
+// @brief デストラクタ
+OutBuffer::~OutBuffer()
+{
+  close();
+}
+
+// @brief 文字列を出力する．
+void
+OutBuffer::put_string(
+  std::string_view str
+)
+{
+  const char* p = str.data();
+  SizeType n = str.size();
+  while ( n > 0 ) {
+    if ( mPos == mBuff.size() ) {
+      flush();
+    }
+    auto n1 = std::min(n, mBuff.size() - mPos);
+    std::memcpy(&mBuff[mPos], p, n1);
+    mPos += n1;
+    p += n1;
+    n -= n1;
+  }
+}
+
+// @brief 数値を10進数で出力する．
+void
+OutBuffer::put_decimal(
+  SizeType num
+)
+{
+  // 下の桁から作って逆順に出力する．
+  char tmp[24];
+  SizeType n = 0;
+  do {
+    tmp[n] = static_cast<char>('0' + num % 10);
+    ++ n;
+    num /= 10;
+  } while ( num > 0 );
+  if ( mPos + n > mBuff.size() ) {
+    flush();
+  }
+  while ( n > 0 ) {
+    -- n;
+    mBuff[mPos] = tmp[n];
+    ++ mPos;
+  }
+}
+
+// @brief バッファの内容を書き出す．
+void
+OutBuffer::flush()
+{
+  if ( mPos == 0 ) {
+    return;
+  }
+  if ( mStream != nullptr ) {
+    mStream->write(mBuff.data(), mPos);
+    if ( mStream->fail() ) {
+      mOk = false;
+    }
+  }
+  else if ( mFd >= 0 ) {
+    const char* p = mBuff.data();
+    SizeType n = mPos;
+    while ( n > 0 ) {
+      auto n1 = ::write(mFd, p, n);
+      if ( n1 < 0 && errno == EINTR ) {
+	continue;
+      }
+      if ( n1 <= 0 ) {
+	// 書き込みエラー
+	mOk = false;
+	break;
+      }
+      p += n1;
+      n -= n1;
+    }
+  }
+  else {
+    // 書き出し先がない
+    mOk = false;
+  }
+  mPos = 0;
+}
+
+// @brief 残っている内容を書き出して，自分で開いたファイルを閉じる．
+void
+OutBuffer::close()
+{
+  flush();
+  if ( mCompStream ) {
+    mCompStream->close();
+    if ( !*mCompStream ) {
+      mOk = false;
+    }
+    mCompStream = nullptr;
+  }
+  mStream = nullptr;
+  if ( mOwnFd ) {
+    if ( ::close(mFd) != 0 ) {
+      mOk = false;
+    }
+    mOwnFd = false;
+  }
+  mFd = -1;
+}
+
+END_NAMESPACE_YM_BNET
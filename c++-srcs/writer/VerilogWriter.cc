@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "VerilogWriter.h"
+#include "CompStream.h"
 #include "ym/BnNetwork.h"
 #include "ym/ClibCellLibrary.h"
 #include "ym/ClibCell.h"
@@ -42,7 +43,12 @@ BnNetwork::write_verilog(
 		       port_prefix, port_suffix,
 		       node_prefix, node_suffix,
 		       instance_prefix, instance_suffix);
-  writer(s);
+  OutBuffer buff{s};
+  writer(buff);
+  buff.close();
+  if ( !buff.is_ok() ) {
+    throw std::invalid_argument{"BnNetwork::write_verilog(): Write error"};
+  }
 }
 
 // @brief 内容を Verilog-HDL 形式で出力する．
@@ -57,9 +63,18 @@ BnNetwork::write_verilog(
   const string& instance_suffix
 ) const
 {
-  ofstream ofs(filename);
+  CompOutStream ofs{filename};
   if ( ofs ) {
-    write_verilog(ofs);
+    write_verilog(ofs,
+		  port_prefix, port_suffix,
+		  node_prefix, node_suffix,
+		  instance_prefix, instance_suffix);
+    ofs.close();
+    if ( !ofs ) {
+      ostringstream buf;
+      buf << filename << ": Write error";
+      throw std::invalid_argument{buf.str()};
+    }
   }
 }
 
@@ -85,7 +100,7 @@ udp_name(
 // UDP プリミティブの定義を出力する．
 void
 write_udp(
-  ostream& s,
+  OutBuffer& s,
   const string& udp_name,
   const TvFunc& func
 )
@@ -93,82 +108,89 @@ write_udp(
   SizeType ni = func.input_num();
   SizeType np = 1 << ni;
 
-  s << "  primitive " << udp_name << "(";
+  s.put_string("  primitive ");
+  s.put_string(udp_name);
+  s.put_char('(');
   const char* comma = "";
   for ( SizeType i: Range(ni) ) {
-    s << comma << "i" << i;
+    s.put_string(comma);
+    s.put_char('i');
+    s.put_decimal(i);
     comma = ", ";
   }
-  s << ", o);" << endl;
+  s.put_string(", o);\n");
   for ( SizeType i: Range(ni) ) {
-    s << "    input i" << i << ";" << endl;
+    s.put_string("    input i");
+    s.put_decimal(i);
+    s.put_string(";\n");
   }
-  s << "    output o;";
-  s << "    table" << endl;
+  s.put_string("    output o;");
+  s.put_string("    table\n");
   for ( SizeType p: Range(np) ) {
-    s << "      ";
+    s.put_string("      ");
     for ( SizeType i: Range(ni) ) {
       if ( (p & (1 << i)) == 0 ) {
-	s << "0";
+	s.put_char('0');
       }
       else {
-	s << "1";
+	s.put_char('1');
       }
     }
-    s << " : ";
+    s.put_string(" : ");
     if ( func.value(p) ) {
-      s << "1";
+      s.put_char('1');
     }
     else {
-      s << "0";
+      s.put_char('0');
     }
-    s << ";" << endl;
+    s.put_string(";\n");
   }
-  s << "    endtable" << endl;
-  s << "  endprimitive" << endl;
+  s.put_string("    endtable\n");
+  s.put_string("  endprimitive\n");
 }
 
 void
 write_op(
-  ostream& s,
+  OutBuffer& s,
   const char* op_str,
   bool neg,
-  const vector<string>& iname_array
+  const vector<std::string_view>& iname_array
 )
 {
   if ( neg ) {
-    s << "~(";
+    s.put_string("~(");
   }
   const char* tmp_str = "";
-  for ( const string& name: iname_array ) {
-    s << tmp_str;
+  for ( auto name: iname_array ) {
+    s.put_string(tmp_str);
     tmp_str = op_str;
-    s << name;
+    s.put_string(name);
   }
   if ( neg ) {
-    s << ")";
+    s.put_char(')');
   }
 }
 
 void
 write_primitive(
-  ostream& s,
+  OutBuffer& s,
   PrimType type,
-  const vector<string>& iname_array
+  const vector<std::string_view>& iname_array
 )
 {
   switch ( type ) {
   case PrimType::C0:
-    s << "1'b0";
+    s.put_string("1'b0");
     break;
   case PrimType::C1:
-    s << "1'b1";
+    s.put_string("1'b1");
     break;
   case PrimType::Buff:
-    s << iname_array[0];
+    s.put_string(iname_array[0]);
     break;
   case PrimType::Not:
-    s << "~" << iname_array[0];
+    s.put_char('~');
+    s.put_string(iname_array[0]);
     break;
   case PrimType::And:
     write_op(s, " & ", false, iname_array);
@@ -196,24 +218,25 @@ write_primitive(
 
 void
 write_expr(
-  ostream& s,
+  OutBuffer& s,
   const Expr& expr,
-  const vector<string>& iname_array
+  const vector<std::string_view>& iname_array
 )
 {
   if ( expr.is_zero() ) {
-    s << "1'b0";
+    s.put_string("1'b0");
   }
   else if ( expr.is_one() ) {
-    s << "1'b1";
+    s.put_string("1'b1");
   }
   else if ( expr.is_posi_literal() ) {
     auto varid = expr.varid();
-    s << iname_array[varid];
+    s.put_string(iname_array[varid]);
   }
   else if ( expr.is_nega_literal() ) {
     auto varid = expr.varid();
-    s << "~" << iname_array[varid];
+    s.put_char('~');
+    s.put_string(iname_array[varid]);
   }
   else {
     const char* op_str = "";
@@ -231,11 +254,11 @@ write_expr(
     }
     const char* tmp_str = "";
     for ( auto& opr: expr.operand_list() ) {
-      s << tmp_str;
+      s.put_string(tmp_str);
       tmp_str = op_str;
-      s << "(";
+      s.put_char('(');
       write_expr(s, opr, iname_array);
-      s << ")";
+      s.put_char(')');
     }
   }
 }
@@ -243,6 +266,9 @@ write_expr(
 END_NONAMESPACE
 
 
+// 名前がないことを表す識別子番号
+const SizeType VerilogWriter::kNoName = static_cast<SizeType>(-1);
+
 // @brief コンストラクタ
 VerilogWriter::VerilogWriter(
   const BnNetwork& network,
@@ -253,9 +279,9 @@ VerilogWriter::VerilogWriter(
   const string& instance_prefix,
   const string& instance_suffix
 ) : mNetwork{network},
-    mPortNameArray(network.port_num()),
-    mNodeNameArray(network.node_num()),
-    mNodeInstanceNameArray(network.node_num()),
+    mPortNameArray(network.port_num(), kNoName),
+    mNodeNameArray(network.node_num() + 1, kNoName),
+    mNodeInstanceNameArray(network.node_num() + 1),
     mDffInstanceNameArray(network.dff_num())
 {
   if ( port_prefix == string{} ) {
@@ -299,7 +325,7 @@ VerilogWriter::VerilogWriter(
 // @brief blif 形式で出力する．
 void
 VerilogWriter::operator()(
-  ostream& s
+  OutBuffer& s
 )
 {
   // TODO
@@ -308,46 +334,57 @@ VerilogWriter::operator()(
 
   init_name_array();
 
-  s << "module " << mNetwork.name() << "(";
+  s.put_string("module ");
+  s.put_string(mNetwork.name());
+  s.put_char('(');
   const char* comma = "";
   for ( auto port: mNetwork.port_list() ) {
-    const string& port_name = mPortNameArray[port.id()];
+    auto name_id = mPortNameArray[port.id()];
     SizeType nb = port.bit_width();
-    s << comma;
+    s.put_string(comma);
     comma = ", ";
     if ( nb == 1 ) {
       auto id = port.bit(0).id();
-      if ( port_name == mNodeNameArray[id] ) {
-	s << port_name;
+      if ( name_id == mNodeNameArray[id] ) {
+	s.put_string(port_name(port.id()));
       }
       else {
-	s << "." << port_name << "(" << mNodeNameArray[id] << ")";
+	s.put_char('.');
+	s.put_string(port_name(port.id()));
+	s.put_char('(');
+	s.put_string(node_name(id));
+	s.put_char(')');
       }
     }
     else {
-      s << "." << port_name << "(";
+      s.put_char('.');
+      s.put_string(port_name(port.id()));
+      s.put_char('(');
       const char* bit_comma = "";
       for ( SizeType i: Range(nb) ) {
 	auto id = port.bit(i).id();
-	s << bit_comma << mNodeNameArray[id];
+	s.put_string(bit_comma);
+	s.put_string(node_name(id));
 	bit_comma = ", ";
       }
-      s << ")";
+      s.put_char(')');
     }
   }
-  s << ");" << endl;
+  s.put_string(");\n");
 
   // 外部入力
   for ( auto node: mNetwork.primary_input_list() ) {
-    auto id = node.id();
-    s << "  " << "input  " << mNodeNameArray[id] << ";" << endl;
+    s.put_string("  input  ");
+    s.put_string(node_name(node.id()));
+    s.put_string(";\n");
   }
   // 外部出力
   for ( auto node: mNetwork.primary_output_list() ) {
-    auto onode = node.output_src();
-    s << "  " << "output " << mNodeNameArray[node.id()] << ";" << endl;
+    s.put_string("  output ");
+    s.put_string(node_name(node.id()));
+    s.put_string(";\n");
   }
-  s << endl;
+  s.put_char('\n');
 
   // このネットワークで使用されている TvFunc を UDP として定義しておく．
   for ( SizeType i: Range(mNetwork.func_num()) ) {
@@ -358,14 +395,16 @@ VerilogWriter::operator()(
   // DFFの宣言
   for ( auto dff: mNetwork.dff_list() ) {
     if ( dff.is_dff() || dff.is_latch() ) {
-      s << "  reg    "
-	<< mNodeNameArray[dff.data_out().id()] << ";" << endl;
+      s.put_string("  reg    ");
+      s.put_string(node_name(dff.data_out().id()));
+      s.put_string(";\n");
     }
     else if ( dff.is_cell() ) {
       SizeType no = dff.cell_output_num();
       for ( SizeType i: Range(no) ) {
-	s << "  wire   "
-	  << mNodeNameArray[dff.cell_output(i).id()] << ";" << endl;
+	s.put_string("  wire   ");
+	s.put_string(node_name(dff.cell_output(i).id()));
+	s.put_string(";\n");
       }
     }
     else {
@@ -375,130 +414,154 @@ VerilogWriter::operator()(
 
   // 論理ノードの宣言
   for ( auto node: mNetwork.logic_list() ) {
-    s << "  " << "wire   " << mNodeNameArray[node.id()] << ";" << endl;
+    s.put_string("  wire   ");
+    s.put_string(node_name(node.id()));
+    s.put_string(";\n");
   }
 
-  s << endl;
+  s.put_char('\n');
 
   // DFFの記述
   for ( auto dff: mNetwork.dff_list() ) {
-    if ( dff.is_dff() ) {
-      const string& dff_output = mNodeNameArray[dff.data_out().id()];
-      const string& dff_input = mNodeNameArray[dff.data_in().id()];
-      s << "  " << "always @ ( posedge " << mNodeNameArray[dff.clock().id()];
-      auto clear = dff.clear();
-      if ( clear.is_valid() ) {
-	s << " or posedge " << mNodeNameArray[clear.id()];
-      }
-      auto preset = dff.preset();
-      if ( preset.is_valid() ) {
-	s << " or posedge " << mNodeNameArray[preset.id()];
-      }
-      s << " )" << endl;
-      const char* if_str = "if";
-      if ( clear.is_valid() ) {
-	s << "    " << if_str << " ( " << mNodeNameArray[clear.id()] << ")" << endl
-	  << "      " << dff_output << " <= 1'b0;" << endl;
-	if_str = "else if";
-      }
-      if ( preset.is_valid() ) {
-	s << "    " << if_str << " ( " << mNodeNameArray[preset.id()] << ")" << endl
-	  << "      " << dff_output << " <= 1'b1;" << endl;
-	if_str = "else if";
-      }
-      if ( clear.is_valid() || preset.is_valid() ) {
-	s << "    else" << endl
-	  << "      " << dff_output << " <= " << dff_input << ";" << endl;
-      }
-      else {
-	s << "    " << dff_output << " <= " << dff_input << ";" << endl;
-      }
-    }
-    else if ( dff.is_latch() ) {
-      const string& latch_output = mNodeNameArray[dff.data_out().id()];
-      const string& latch_input = mNodeNameArray[dff.data_in().id()];
-      s << "  " << "always @ ( " << mNodeNameArray[dff.clock().id()];
+    if ( dff.is_dff() || dff.is_latch() ) {
+      // DFF はエッジ，ラッチはレベルで動作し，代入文も異なる．
+      bool is_dff = dff.is_dff();
+      const char* edge_str = is_dff ? "posedge " : "";
+      const char* assign_str = is_dff ? " <= " : " = ";
+      auto dff_output = node_name(dff.data_out().id());
+      auto dff_input = node_name(dff.data_in().id());
+      s.put_string("  always @ ( ");
+      s.put_string(edge_str);
+      s.put_string(node_name(dff.clock().id()));
       auto clear = dff.clear();
       if ( clear.is_valid() ) {
-	s << " or " << mNodeNameArray[clear.id()];
+	s.put_string(" or ");
+	s.put_string(edge_str);
+	s.put_string(node_name(clear.id()));
       }
       auto preset = dff.preset();
       if ( preset.is_valid() ) {
-	s << " or " << mNodeNameArray[preset.id()];
+	s.put_string(" or ");
+	s.put_string(edge_str);
+	s.put_string(node_name(preset.id()));
       }
-      s << " )" << endl;
+      s.put_string(" )\n");
       const char* if_str = "if";
       if ( clear.is_valid() ) {
-	s << "    " << if_str << " ( " << mNodeNameArray[clear.id()] << ")" << endl
-	  << "      " << latch_output << " = 1'b0;" << endl;
+	s.put_string("    ");
+	s.put_string(if_str);
+	s.put_string(" ( ");
+	s.put_string(node_name(clear.id()));
+	s.put_string(")\n      ");
+	s.put_string(dff_output);
+	s.put_string(assign_str);
+	s.put_string("1'b0;\n");
 	if_str = "else if";
       }
       if ( preset.is_valid() ) {
-	s << "    " << if_str << " ( " << mNodeNameArray[preset.id()] << ")" << endl
-	  << "      " << latch_output << " = 1'b1;" << endl;
+	s.put_string("    ");
+	s.put_string(if_str);
+	s.put_string(" ( ");
+	s.put_string(node_name(preset.id()));
+	s.put_string(")\n      ");
+	s.put_string(dff_output);
+	s.put_string(assign_str);
+	s.put_string("1'b1;\n");
 	if_str = "else if";
       }
       if ( clear.is_valid() || preset.is_valid() ) {
-	s << "    else" << endl
-	  << "      " << latch_output << " = " << latch_input << ";" << endl;
+	s.put_string("    else\n      ");
       }
       else {
-	s << "    " << latch_output << " = " << latch_input << ";" << endl;
+	s.put_string("    ");
       }
+      s.put_string(dff_output);
+      s.put_string(assign_str);
+      s.put_string(dff_input);
+      s.put_string(";\n");
     }
     else if ( dff.is_cell() ) {
       // セルインスタンス記述
       auto cell = dff.cell();
-      s << ";" << endl;
-      s << "  " << cell.name()
-	<< " " << mDffInstanceNameArray[dff.id()] << "(";
+      s.put_string(";\n");
+      s.put_string("  ");
+      s.put_string(cell.name());
+      s.put_char(' ');
+      s.put_string(mDffInstanceNameArray[dff.id()]);
+      s.put_char('(');
       SizeType ni = cell.input_num();
       for ( SizeType i: Range(ni) ) {
-	s << ", ." << cell.input(i).name() << "("
-	  << mNodeNameArray[dff.cell_input(i).id()] << ")";
+	s.put_string(", .");
+	s.put_string(cell.input(i).name());
+	s.put_char('(');
+	s.put_string(node_name(dff.cell_input(i).id()));
+	s.put_char(')');
       }
       SizeType no = cell.output_num();
       for ( SizeType i: Range(no) ) {
-	s << "." << cell.output(i).name() << "("
-	  << mNodeNameArray[dff.cell_output(i).id()] << ")";
+	s.put_char('.');
+	s.put_string(cell.output(i).name());
+	s.put_char('(');
+	s.put_string(node_name(dff.cell_output(i).id()));
+	s.put_char(')');
       }
-      s << ");" << endl;
+      s.put_string(");\n");
     }
   }
 
   // 論理ノードの記述
+  vector<std::string_view> iname_array;
   for ( auto node: mNetwork.logic_list() ) {
     auto id = node.id();
     SizeType ni = node.fanin_num();
-    vector<string> iname_array(ni);
+    iname_array.resize(ni);
     for ( SizeType i: Range(ni) ) {
-      iname_array[i] = mNodeNameArray[node.fanin_id(i)];
+      iname_array[i] = node_name(node.fanin_id(i));
     }
     if ( node.type() == BnNodeType::TvFunc ) {
       // 予め mNetwork に登録されている TvFunc に対応する UDP を定義しておいて
       // ここはそのインスタンス化だけを行う．
-      s << "  " << udp_name(node.func_id()) << "(";
-      for ( int i: Range(ni) ) {
-	s << ".i" << i << "(" << iname_array[i] << "), ";
+      s.put_string("  ");
+      s.put_string(udp_name(node.func_id()));
+      s.put_char('(');
+      for ( SizeType i: Range(ni) ) {
+	s.put_string(".i");
+	s.put_decimal(i);
+	s.put_char('(');
+	s.put_string(iname_array[i]);
+	s.put_string("), ");
       }
-      s << ".o(" << mNodeNameArray[id] << ")";
-      s << ");" << endl;
+      s.put_string(".o(");
+      s.put_string(node_name(id));
+      s.put_string("));\n");
     }
     else if ( node.type() == BnNodeType::Cell ) {
       // セルインスタンス記述
       auto cell = node.cell();
-      s << ";" << endl;
-      s << "  " << cell.name()
-	<< " " << mNodeInstanceNameArray[id] << "(";
-      s << "." << cell.output(0).name() << "(" << mNodeNameArray[id] << ")";
-      for ( int i: Range(ni) ) {
-	s << ", ." << cell.input(i).name() << "(" << iname_array[i] << ")";
+      s.put_string(";\n");
+      s.put_string("  ");
+      s.put_string(cell.name());
+      s.put_char(' ');
+      s.put_string(mNodeInstanceNameArray[id]);
+      s.put_string("(.");
+      s.put_string(cell.output(0).name());
+      s.put_char('(');
+      s.put_string(node_name(id));
+      s.put_char(')');
+      for ( SizeType i: Range(ni) ) {
+	s.put_string(", .");
+	s.put_string(cell.input(i).name());
+	s.put_char('(');
+	s.put_string(iname_array[i]);
+	s.put_char(')');
       }
-      s << ");" << endl;
+      s.put_string(");\n");
     }
     else {
       // assign 文で内容を記述する．
-      s << "  " << "assign " << mNodeNameArray[id] << " = ";
+      s.put_string("  assign ");
+      s.put_string(node_name(id));
+      s.put_string(" = ");
       switch ( node.type() ) {
       case BnNodeType::Prim:
 	write_primitive(s, node.primitive_type(), iname_array);
@@ -509,11 +572,11 @@ VerilogWriter::operator()(
       default:
 	ASSERT_NOT_REACHED;
       }
-      s << ";" << endl;
+      s.put_string(";\n");
     }
   }
 
-  s << "endmodule" << endl;
+  s.put_string("endmodule\n");
 }
 
 // @brief 名前の配列を初期化する．
@@ -523,53 +586,54 @@ VerilogWriter::init_name_array()
   // ポート名を管理するクラス
   NameMgr port_name_mgr(mPortPrefix, mPortSuffix);
 
-  // ポート名のハッシュ
-  unordered_set<string> port_name_hash;
+  // 名前の識別子番号をキーにして使用済みのポート名に印をつける配列
+  vector<bool> port_used_mark;
 
   // もともとポート名があればそれを使う．
   // ただし，重複していたら後ろのポート名を無効化する．
   // ポート名を持たない(もしくは無効化された)場合は自動生成名を用いる．
   for ( auto port: mNetwork.port_list() ) {
-    reg_port_name(port, port_name_hash, port_name_mgr);
+    reg_port_name(port, port_used_mark, port_name_mgr);
   }
 
   // 名無しのポートに名前を与える．
   for ( auto port: mNetwork.port_list() ) {
     auto id = port.id();
-    if ( mPortNameArray[id] == string() ) {
+    if ( mPortNameArray[id] == kNoName ) {
       string name = port_name_mgr.new_name(true);
-      mPortNameArray[id] = name;
+      mPortNameArray[id] = mNameTable.intern(name);
     }
   }
 
   // ノード名を管理するクラス
   NameMgr node_name_mgr(mNodePrefix, mNodeSuffix);
 
-  // インスタンス名のハッシュ
-  unordered_set<string> name_hash;
+  // 名前の識別子番号をキーにして使用済みのノード名に印をつける配列
+  vector<bool> node_used_mark;
 
   // 外部入力ノードの名前を登録する．
   for ( auto node: mNetwork.primary_input_list() ) {
-    reg_node_name(node, name_hash, node_name_mgr);
+    reg_node_name(node, node_used_mark, node_name_mgr);
   }
 
   // FFの出力を登録する．
   for ( auto dff: mNetwork.dff_list() ) {
     if ( dff.is_dff() || dff.is_latch() ) {
-      reg_node_name(dff.data_out(), name_hash, node_name_mgr);
+      reg_node_name(dff.data_out(), node_used_mark, node_name_mgr);
     }
   }
 
   // 論理ノードを登録する．
   for ( auto node: mNetwork.logic_list() ) {
-    reg_node_name(node, name_hash, node_name_mgr);
+    reg_node_name(node, node_used_mark, node_name_mgr);
   }
 
   // 名無しのノードに名前を与える．
-  for ( auto id: Range(mNetwork.node_num()) ) {
-    if ( mNodeNameArray[id] == string() ) {
+  for ( auto node: mNetwork.all_node_list() ) {
+    auto id = node.id();
+    if ( mNodeNameArray[id] == kNoName ) {
       string name = node_name_mgr.new_name(true);
-      mNodeNameArray[id] = name;
+      mNodeNameArray[id] = mNameTable.intern(name);
     }
   }
 
@@ -577,8 +641,8 @@ VerilogWriter::init_name_array()
   NameMgr instance_name_mgr(mInstancePrefix, mInstanceSuffix);
 
   // ノード名を instance_name_mgr に登録しておく．
-  for ( auto id: Range(mNetwork.node_num()) ) {
-    string name = mNodeNameArray[id];
+  for ( auto node: mNetwork.all_node_list() ) {
+    string name{node_name(node.id())};
     instance_name_mgr.add(name);
   }
 
@@ -658,7 +722,7 @@ END_NONAMESPACE
 void
 VerilogWriter::reg_port_name(
   BnPort port,
-  unordered_set<string>& name_hash,
+  vector<bool>& used_mark,
   NameMgr& name_mgr
 )
 {
@@ -668,22 +732,22 @@ VerilogWriter::reg_port_name(
     return;
   }
   name = coerce_name(name);
-  if ( name_hash.count(name) > 0 ) {
+  auto name_id = reg_name(name, used_mark);
+  if ( name_id == kNoName ) {
     // 名前が重複していた．
     return;
   }
 
   // 名前を登録する．
   name_mgr.add(name);
-  name_hash.insert(name);
-  mPortNameArray[port.id()] = name;
+  mPortNameArray[port.id()] = name_id;
 }
 
 // @brief ノード名の登録を行う．
 void
 VerilogWriter::reg_node_name(
   BnNode node,
-  unordered_set<string>& name_hash,
+  vector<bool>& used_mark,
   NameMgr& name_mgr
 )
 {
@@ -693,15 +757,33 @@ VerilogWriter::reg_node_name(
     return;
   }
   name = coerce_name(name);
-  if ( name_hash.count(name) > 0 ) {
+  auto name_id = reg_name(name, used_mark);
+  if ( name_id == kNoName ) {
     // 名前が重複していた．
     return;
   }
 
   // 名前を登録する．
   name_mgr.add(name);
-  name_hash.insert(name);
-  mNodeNameArray[node.id()] = name;
+  mNodeNameArray[node.id()] = name_id;
+}
+
+// @brief 名前を登録して使用済みの印をつける．
+SizeType
+VerilogWriter::reg_name(
+  const string& name,
+  vector<bool>& used_mark
+)
+{
+  auto name_id = mNameTable.intern(name);
+  if ( name_id >= used_mark.size() ) {
+    used_mark.resize(mNameTable.size(), false);
+  }
+  if ( used_mark[name_id] ) {
+    return kNoName;
+  }
+  used_mark[name_id] = true;
+  return name_id;
 }
 
 END_NAMESPACE_YM_BNET
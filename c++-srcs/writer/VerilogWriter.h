@@ -10,6 +10,8 @@
 
 #include "ym/bnet.h"
 #include "ym/BnNetwork.h"
+#include "NameTable.h"
+#include "OutBuffer.h"
 
 BEGIN_NAMESPACE_YM
 
@@ -60,6 +62,8 @@ BEGIN_NAMESPACE_YM_BNET
 ///   * すべて自動生成名を用いる．
 ///   * 自動生成名は "%s%d%d", instance_prefix(), instance_id, instance_suffix()
 ///     で作る．instance_id は自動生成するインスタンスに固有の番号
+///
+/// ポート名とノード名は NameTable に登録して識別子番号で管理する．
 //////////////////////////////////////////////////////////////////////
 class VerilogWriter
 {
@@ -88,7 +92,7 @@ public:
   /// @brief blif 形式で出力する．
   void
   operator()(
-    ostream& s ///< [in] 出力先のストリーム
+    OutBuffer& s ///< [in] 出力先
   );
 
 
@@ -104,19 +108,47 @@ private:
   /// @brief ポート名の登録を行う．
   void
   reg_port_name(
-    BnPort port,                      ///< [in] ポート番号
-    unordered_set<string>& name_hash, ///< [in] ポート名のハッシュ
-    NameMgr& name_mgr                 ///< [in] ポート名を管理するクラス
+    BnPort port,             ///< [in] ポート番号
+    vector<bool>& used_mark, ///< [inout] 使用済みのポート名の印
+    NameMgr& name_mgr        ///< [in] ポート名を管理するクラス
   );
 
   /// @brief ノード名の登録を行う．
   void
   reg_node_name(
-    BnNode node,                      ///< [in] ノード番号
-    unordered_set<string>& name_hash, ///< [in] ノード名のハッシュ
-    NameMgr& name_mgr                 ///< [in] ノード名を管理するクラス
+    BnNode node,             ///< [in] ノード番号
+    vector<bool>& used_mark, ///< [inout] 使用済みのノード名の印
+    NameMgr& name_mgr        ///< [in] ノード名を管理するクラス
+  );
+
+  /// @brief 名前を登録して使用済みの印をつける．
+  /// @return 名前の識別子番号を返す．
+  ///
+  /// すでに使用済みだった場合は kNoName を返す．
+  SizeType
+  reg_name(
+    const string& name,     ///< [in] 名前
+    vector<bool>& used_mark ///< [inout] 使用済みの名前の印
   );
 
+  /// @brief ポート名を返す．
+  std::string_view
+  port_name(
+    SizeType port_id ///< [in] ポート番号
+  ) const
+  {
+    return mNameTable.name(mPortNameArray[port_id]);
+  }
+
+  /// @brief ノード名を返す．
+  std::string_view
+  node_name(
+    SizeType node_id ///< [in] ノード番号
+  ) const
+  {
+    return mNameTable.name(mNodeNameArray[node_id]);
+  }
+
   /// @brief ノード名をそのファンインのノード名に付け替える．
   void
   replace_node_name(
@@ -150,11 +182,17 @@ private:
   // インスタンスの自動生成名の接尾語
   string mInstanceSuffix;
 
-  // ポート名を入れた配列
-  vector<string> mPortNameArray;
+  // 名前がないことを表す識別子番号
+  static const SizeType kNoName;
+
+  // 名前の表
+  NameTable mNameTable;
+
+  // ポート番号をキーにしてポート名の識別子番号を入れた配列
+  vector<SizeType> mPortNameArray;
 
-  // ノード名を入れた配列
-  vector<string> mNodeNameArray;
+  // ノード番号をキーにしてノード名の識別子番号を入れた配列
+  vector<SizeType> mNodeNameArray;
 
   // ノードのインスタンス名を入れた配列
   vector<string> mNodeInstanceNameArray;
@@ -14,11 +14,14 @@
 
 BEGIN_NAMESPACE_YM_BNET
 
+// 名前がないことを表す識別子番号
+const SizeType WriterBase::kNoName = static_cast<SizeType>(-1);
+
 // @brief コンストラクタ
 WriterBase::WriterBase(
   const BnNetwork& network
 ) : mNetwork{network},
-    mNameArray(network.node_num()),
+    mNameArray(network.node_num(), kNoName),
     mDataArray(network.node_num(), false)
 {
 }
@@ -33,8 +36,8 @@ WriterBase::init_name_array(
   // ノード名を管理するクラス
   NameMgr name_mgr{prefix, suffix};
 
-  // ノード名のハッシュ
-  unordered_set<string> name_hash;
+  // 名前の識別子番号をキーにして使用済みの名前に印をつける配列
+  vector<bool> used_mark;
 
   // もともと与えられた名前があればそれを使う．
   // ただし重複のチェックを行う．
@@ -51,7 +54,7 @@ WriterBase::init_name_array(
     if ( nb == 1 ) {
       // 1ビットポートならポート名をノード名にする．
       auto node = port.bit(0);
-      reg_node_name(node, name, name_hash, name_mgr);
+      reg_node_name(node, name, used_mark, name_mgr);
     }
     else {
       // 多ビットポートの場合は '[' <ビット番号> ']' を後ろにつける．
@@ -59,7 +62,7 @@ WriterBase::init_name_array(
 	auto node = port.bit(b);
 	ostringstream buf;
 	buf << name << "[" << b << "]";
-	reg_node_name(node, buf.str(), name_hash, name_mgr);
+	reg_node_name(node, buf.str(), used_mark, name_mgr);
       }
     }
   }
@@ -73,21 +76,21 @@ WriterBase::init_name_array(
 	continue;
       }
       auto node = dff.data_out();
-      reg_node_name(node, name, name_hash, name_mgr);
+      reg_node_name(node, name, used_mark, name_mgr);
     }
   }
 
   // 外部入力ノード名
   for ( auto node: mNetwork.primary_input_list() ) {
     const string& name = node.name();
-    reg_node_name(node, name, name_hash, name_mgr);
+    reg_node_name(node, name, used_mark, name_mgr);
   }
 
   // FFの出力ノード名
   for ( auto dff: mNetwork.dff_list() ) {
     auto node = dff.data_out();
     const string& name = node.name();
-    reg_node_name(node, name, name_hash, name_mgr);
+    reg_node_name(node, name, used_mark, name_mgr);
   }
 
   // 外部出力ノード名
@@ -98,7 +101,7 @@ WriterBase::init_name_array(
       set_node_name(node, src_node.name());
     }
     else {
-      reg_node_name(node, name, name_hash, name_mgr);
+      reg_node_name(node, name, used_mark, name_mgr);
     }
   }
 
@@ -106,18 +109,18 @@ WriterBase::init_name_array(
   for ( auto dff: mNetwork.dff_list() ) {
     auto node = dff.data_in();
     const string& name = node.name();
-    reg_node_name(node, name, name_hash, name_mgr);
+    reg_node_name(node, name, used_mark, name_mgr);
   }
 
   // 論理ノード名
   for ( auto node: mNetwork.logic_list() ) {
     const string& name = node.name();
-    reg_node_name(node, name, name_hash, name_mgr);
+    reg_node_name(node, name, used_mark, name_mgr);
   }
 
   // 名無しのノードに名前を与える．
   for ( auto node: mNetwork.all_node_list() ) {
-    if ( node_name(node) == string{} ) {
+    if ( node_name_id(node) == kNoName ) {
       string name = name_mgr.new_name(true);
       set_node_name(node, name);
     }
@@ -127,7 +130,7 @@ WriterBase::init_name_array(
   for ( auto node: mNetwork.primary_output_list() ) {
     auto src_node = node.output_src();
     if ( !src_node.is_input() ) {
-      set_node_name(src_node, node_name(node));
+      set_node_name_id(src_node, node_name_id(node));
     }
   }
 
@@ -135,7 +138,7 @@ WriterBase::init_name_array(
   for ( auto dff: mNetwork.dff_list() ) {
     auto node= dff.data_in();
     auto src_node = node.output_src();
-    set_node_name(node, node_name(src_node));
+    set_node_name_id(node, node_name_id(src_node));
   }
 
   // データ系のノードに印をつける．
@@ -159,11 +162,11 @@ void
 WriterBase::reg_node_name(
   BnNode node,
   const string& name,
-  unordered_set<string>& name_hash,
+  vector<bool>& used_mark,
   NameMgr& name_mgr
 )
 {
-  if ( node_name(node) != string{} ) {
+  if ( node_name_id(node) != kNoName ) {
     // すでに名前がついていた．
     return;
   }
@@ -171,15 +174,19 @@ WriterBase::reg_node_name(
     // 名前がなかった．
     return;
   }
-  if ( name_hash.count(name) > 0 ) {
+  auto name_id = mNameTable.intern(name);
+  if ( name_id >= used_mark.size() ) {
+    used_mark.resize(mNameTable.size(), false);
+  }
+  if ( used_mark[name_id] ) {
     // 名前が重複していた．
     return;
   }
 
   // 名前を登録する．
   name_mgr.add(name.c_str());
-  name_hash.insert(name);
-  set_node_name(node, name);
+  used_mark[name_id] = true;
+  set_node_name_id(node, name_id);
 }
 
 // @brief TFI のノードに印をつける．
@@ -10,6 +10,8 @@
 
 #include "ym/bnet.h"
 #include "ym/BnNode.h"
+#include "NameTable.h"
+#include "OutBuffer.h"
 
 
 BEGIN_NAMESPACE_YM
@@ -45,6 +47,9 @@ BEGIN_NAMESPACE_YM_BNET
 /// 厄介なのは多ビットポートの扱い．基本的には <ポート名> '[' <ビット番号> ']'
 /// だが，重複した場合は(もともと sss[ddd] という形式のポートが別にあった場合)
 /// 自動生成名に置き換えられる．
+///
+/// 名前は NameTable に登録して，ノードごとには識別子番号のみを持つ．
+/// 名前の重複のチェックも識別子番号を用いて行う．
 //////////////////////////////////////////////////////////////////////
 class WriterBase
 {
@@ -76,10 +81,25 @@ protected:
   network() const { return mNetwork; }
 
   /// @brief ノード名を返す．
-  string
+  std::string_view
   node_name(
     BnNode node ///< [in] ノード
   ) const
+  {
+    auto name_id = node_name_id(node);
+    if ( name_id == kNoName ) {
+      return std::string_view{};
+    }
+    return mNameTable.name(name_id);
+  }
+
+  /// @brief ノード名の識別子番号を返す．
+  ///
+  /// 名前がない場合は kNoName を返す．
+  SizeType
+  node_name_id(
+    BnNode node ///< [in] ノード
+  ) const
   {
     SizeType node_id = node.id();
     ASSERT_COND( 1 <= node_id && node_id <= mNameArray.size() );
@@ -111,10 +131,10 @@ protected:
   /// name が空文字列の場合は登録しない．
   void
   reg_node_name(
-    BnNode node,                      ///< [in] ノード
-    const string& name,               ///< [in] 登録する名前
-    unordered_set<string>& name_hash, ///< [in] ノード名のハッシュ
-    NameMgr& name_mgr                 ///< [in] ノード名を管理するクラス
+    BnNode node,             ///< [in] ノード
+    const string& name,      ///< [in] 登録する名前
+    vector<bool>& used_mark, ///< [inout] 使用済みの名前の印
+    NameMgr& name_mgr        ///< [in] ノード名を管理するクラス
   );
 
   /// @brief ノード名をつける．
@@ -123,11 +143,26 @@ protected:
     BnNode node,        ///< [in] ノード
     const string& name  ///< [in] 名前
   )
+  {
+    if ( name == string{} ) {
+      set_node_name_id(node, kNoName);
+    }
+    else {
+      set_node_name_id(node, mNameTable.intern(name));
+    }
+  }
+
+  /// @brief ノード名の識別子番号を設定する．
+  void
+  set_node_name_id(
+    BnNode node,     ///< [in] ノード
+    SizeType name_id ///< [in] 名前の識別子番号
+  )
   {
     SizeType node_id = node.id();
     ASSERT_COND( 1 <= node_id && node_id <= mNameArray.size() );
 
-    mNameArray[node_id - 1] = name;
+    mNameArray[node_id - 1] = name_id;
   }
 
   /// @brief TFI のノードに印をつける．
@@ -145,8 +180,14 @@ private:
   // 対象のネットワーク
   const BnNetwork& mNetwork;
 
-  // ノード名を入れた配列
-  vector<string> mNameArray;
+  // 名前がないことを表す識別子番号
+  static const SizeType kNoName;
+
+  // 名前の表
+  NameTable mNameTable;
+
+  // ノード番号 - 1 をキーにしてノード名の識別子番号を入れた配列
+  vector<SizeType> mNameArray;
 
   // ノード番号をキーにしたデータ属性の配列
   vector<bool> mDataArray;
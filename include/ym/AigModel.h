@@ -9,6 +9,7 @@
 /// All rights reserved.
 
 #include "ym/aig_nsdef.h"
+#include "ym/bnet.h"
 
 
 BEGIN_NAMESPACE_YM_AIG
@@ -17,7 +18,9 @@ class ModelImpl;
 
 //////////////////////////////////////////////////////////////////////
 /// @class AigModel AigModel.h "ym/AigModel.h"
-/// @brief AIG 形式のファイルを読み込んだ結果を表すクラス
+/// @brief AIG を表すクラス
+///
+/// AIG 形式のファイルを読み込むか，BnNetwork を変換して内容を設定する．
 //////////////////////////////////////////////////////////////////////
 class AigModel
 {
@@ -33,6 +36,10 @@ public:
 public:
   //////////////////////////////////////////////////////////////////////
   /// @name ファイル入出力
+  ///
+  /// ファイル名を指定する関数は gzip/zstd で圧縮されたファイルを扱う．
+  /// 入力はマジックナンバーで判別し，出力はファイル名が ".gz" か ".zst"
+  /// で終わる場合に圧縮を行う．
   /// @{
   //////////////////////////////////////////////////////////////////////
 
@@ -52,6 +59,8 @@ public:
 
   /// @brief AIG フォーマットを読み込む．
   /// @return 読み込みが成功したら true を返す．
+  ///
+  /// ファイルはメモリにマップして直接デコードする．
   bool
   read_aig(
     const string& filename ///< [in] ファイル名
@@ -64,6 +73,68 @@ public:
     istream& s ///< [in] 入力ストリーム
   );
 
+  /// @brief Ascii AIG フォーマットで出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
+  void
+  write_aag(
+    const string& filename,          ///< [in] ファイル名
+    const string& comment = string{} ///< [in] 追加のコメント
+  ) const;
+
+  /// @brief Ascii AIG フォーマットで出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
+  void
+  write_aag(
+    ostream& s,                      ///< [in] 出力ストリーム
+    const string& comment = string{} ///< [in] 追加のコメント
+  ) const;
+
+  /// @brief AIG フォーマットで出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
+  void
+  write_aig(
+    const string& filename,          ///< [in] ファイル名
+    const string& comment = string{} ///< [in] 追加のコメント
+  ) const;
+
+  /// @brief AIG フォーマットで出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
+  void
+  write_aig(
+    ostream& s,                      ///< [in] 出力ストリーム
+    const string& comment = string{} ///< [in] 追加のコメント
+  ) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name BnNetwork からの変換
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief BnNetwork の内容を変換する．
+  /// @return 変換できない場合は false を返す．
+  ///
+  /// - 同じファンインを持つ AND ノードは共有される(構造ハッシュ)．
+  /// - 定数や x & ~x などの自明な AND は作られない．
+  /// - 多入力の AND/OR/XOR は段数が最小になるように分解される．
+  /// - 以下の要素を含む場合は変換できない．
+  ///   * Latchタイプ，Cellタイプの DFF
+  ///   * クリア/プリセットを持つ DFF
+  ///   * TvFuncタイプ，Bddタイプ，Cellタイプの論理ノード
+  /// - 変換できない場合には内容は変更されない．
+  bool
+  from_bnet(
+    const BnNetwork& network ///< [in] 変換元のネットワーク
+  );
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -11,6 +11,7 @@
 #include "ym/blif_nsdef.h"
 #include "ym/SopCover.h"
 #include "ym/Expr.h"
+#include "ym/TvFunc.h"
 
 
 BEGIN_NAMESPACE_YM_BLIF
@@ -20,20 +21,23 @@ BEGIN_NAMESPACE_YM_BLIF
 /// @brief blif 形式の .names 本体のカバーを表すクラス
 ///
 /// 内容は SopCover と出力の極性からなる．
+/// 入力数が kMaxTvInputs 以下の場合は生成時に真理値表を計算しておく．
+/// 関数として等しいカバーを見つける際に用いる．
 //////////////////////////////////////////////////////////////////////
 class BlifCover
 {
 public:
 
+  /// @brief 真理値表を持つ最大の入力数
+  static
+  const SizeType kMaxTvInputs;
+
   /// @brief コンストラクタ
   BlifCover(
     SizeType input_num,                    ///< [in] 入力数
     const vector<vector<Literal>>& icover, ///< [in] 入力カバー
     char opat = '1'                        ///< [in] 出力のパタン ( '0', '1' のみ )
-  ) : mInputCover{input_num, icover},
-      mOutputPat{opat}
-  {
-  }
+  );
 
   /// @brief デストラクタ
   ~BlifCover() = default;
@@ -80,6 +84,18 @@ public:
   Expr
   expr() const;
 
+  /// @brief 真理値表を持つ時 true を返す．
+  ///
+  /// input_num() <= kMaxTvInputs の時 true となる．
+  bool
+  has_tvfunc() const { return input_num() <= kMaxTvInputs; }
+
+  /// @brief 真理値表を返す．
+  ///
+  /// has_tvfunc() == false の時の値は意味を持たない．
+  const TvFunc&
+  tvfunc() const { return mTvFunc; }
+
   /// @brief 内容を出力する．
   void
   print(
@@ -98,6 +114,9 @@ private:
   // 出力パタン
   char mOutputPat;
 
+  // 真理値表
+  TvFunc mTvFunc;
+
 };
 
 END_NAMESPACE_YM_BLIF
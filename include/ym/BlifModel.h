@@ -74,10 +74,14 @@ public:
   /// @brief 読み込みを行う(セルライブラリ付き)．
   /// @retval true 読み込みが成功した．
   /// @retval false 読み込みが失敗した．
+  ///
+  /// thread_num が 2 以上の時は並列に読み込む．
+  /// 結果は thread_num によらず同一となる．
   bool
   read(
-    const string& filename,             ///< [in] ファイル名
-    const ClibCellLibrary& cell_library ///< [in] セルライブラリ
+    const string& filename,              ///< [in] ファイル名
+    const ClibCellLibrary& cell_library, ///< [in] セルライブラリ
+    SizeType thread_num = 1              ///< [in] スレッド数
   );
 
   /// @brief 名前を返す．
@@ -0,0 +1,159 @@
+#ifndef YM_BNCEC_H
+#define YM_BNCEC_H
+
+/// @file ym/BnCec.h
+/// @brief BnCec のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/SatBool3.h"
+#include "ym/SatSolverType.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnCec BnCec.h "ym/BnCec.h"
+/// @ingroup BnetGroup
+/// @brief 2つの BnNetwork の組み合わせ回路としての等価検証を行うクラス
+/// @sa BnNetwork
+///
+/// 2つのネットワークは同じポートとDFFの構成を持っている必要がある．
+/// - ポートは名前もしくは位置で対応づける．
+/// - DFFは位置で対応づける．
+/// DFFの出力は擬似入力，DFFの入力は擬似出力として扱う．
+///
+/// 検証は以下の順で行う．
+/// 1. ランダムシミュレーションで異なる値を出力するパタンを探す．
+/// 2. シミュレーション結果が等しい内部ノードの対を SAT で調べる．
+///    等価なものは等価性を表す節を追加し，そうでないものは反例を
+///    シミュレーションパタンに加える(SAT sweeping)．
+/// 3. 残った出力の対をインクリメンタル SAT で調べる．
+///
+/// 結果は出力の対ごとに SatBool3 で表す．
+/// - SatBool3::True:  等価
+/// - SatBool3::False: 非等価(反例あり)
+/// - SatBool3::X:     制限内に判定できなかった
+//////////////////////////////////////////////////////////////////////
+class BnCec
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// - network1, network2 はこのオブジェクトよりも長く存在する必要がある．
+  /// - ポートやDFFの構成が異なる場合は std::invalid_argument 例外が送出される．
+  BnCec(
+    const BnNetwork& network1,                         ///< [in] 対象のネットワーク1
+    const BnNetwork& network2,                         ///< [in] 対象のネットワーク2
+    bool match_by_name = true,                         ///< [in] ポートを名前で対応づける時 true
+    const SatSolverType& solver_type = SatSolverType{} ///< [in] SATソルバの種類
+  );
+
+  /// @brief デストラクタ
+  ~BnCec() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 等価検証を行う．
+  /// @return 全ての出力の対が等価の時 true を返す．
+  ///
+  /// conflict_limit が 0 の時は制限なしとなる．
+  bool
+  check(
+    SizeType sim_num = 16,      ///< [in] ランダムシミュレーションの回数
+                                ///<      (1回あたり64パタン)
+    SizeType conflict_limit = 0 ///< [in] SAT 1回あたりのコンフリクト数の上限
+  );
+
+  /// @brief 比較する出力の対の数を返す．
+  SizeType
+  output_num() const
+  {
+    return mOutputPairList.size();
+  }
+
+  /// @brief 出力の対を返す．
+  ///
+  /// 結果は (network1 のノード番号, network2 のノード番号) となる．
+  const pair<SizeType, SizeType>&
+  output_pair(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    return mOutputPairList[pos];
+  }
+
+  /// @brief 出力の対の検証結果を返す．
+  SatBool3
+  output_status(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    return mStatusList[pos];
+  }
+
+  /// @brief 非等価な出力の対の反例を返す．
+  ///
+  /// - network1 の input_list() の順に入力の値を並べたもの．
+  /// - output_status(pos) == SatBool3::False の時のみ意味を持つ．
+  const vector<bool>&
+  counterexample(
+    SizeType pos ///< [in] 位置番号 ( 0 <= pos < output_num() )
+  ) const
+  {
+    return mCexList[pos];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ポートとDFFの対応をとる．
+  void
+  match(
+    bool match_by_name ///< [in] ポートを名前で対応づける時 true
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ネットワーク1
+  const BnNetwork& mNetwork1;
+
+  // ネットワーク2
+  const BnNetwork& mNetwork2;
+
+  // SATソルバの種類
+  SatSolverType mSolverType;
+
+  // 入力の対のリスト
+  // network1 の input_list() の順に並んでいる．
+  vector<pair<SizeType, SizeType>> mInputPairList;
+
+  // 出力の対のリスト
+  vector<pair<SizeType, SizeType>> mOutputPairList;
+
+  // 出力の対ごとの検証結果
+  vector<SatBool3> mStatusList;
+
+  // 出力の対ごとの反例
+  vector<vector<bool>> mCexList;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // YM_BNCEC_H
@@ -0,0 +1,194 @@
+#ifndef YM_BNGLOBALBDD_H
+#define YM_BNGLOBALBDD_H
+
+/// @file ym/BnGlobalBdd.h
+/// @brief BnGlobalBdd のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/Bdd.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnGlobalBdd BnGlobalBdd.h "ym/BnGlobalBdd.h"
+/// @ingroup BnetGroup
+/// @brief BnNetwork の出力の大域的な BDD を作るクラス
+/// @sa BnNetwork
+///
+/// - 入力(DFFの出力を含む)を変数とし，出力(DFFの入力を含む)の関数を
+///   ネットワーク自身の BddMgr 上に作る．
+/// - 変数順は出力から深さ優先でたどった時に入力に到達した順とする．
+///   到達しない入力は最後に input_list() の順で並べる．
+/// - sifting を指定した場合は BDD を作る間，動的変数順序変更を有効にする．
+/// - 1つのノードの BDD の節点数が node_limit を超えた時点で，そのノードを
+///   含む出力の BDD を作るのを打ち切る．打ち切った出力の BDD は不正値となる．
+/// - 一度作った BDD は内部のノードの分も含めて保持しておき再利用する．
+//////////////////////////////////////////////////////////////////////
+class BnGlobalBdd
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// - network はこのオブジェクトよりも長く存在する必要がある．
+  /// - node_limit が 0 の時は制限なしとなる．
+  BnGlobalBdd(
+    const BnNetwork& network, ///< [in] 対象のネットワーク
+    SizeType node_limit = 0,  ///< [in] BDD の節点数の上限
+    bool sifting = true       ///< [in] 動的変数順序変更を行う時 true にする．
+  );
+
+  /// @brief デストラクタ
+  ~BnGlobalBdd() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力数を返す．
+  SizeType
+  input_num() const
+  {
+    return mInputVarList.size();
+  }
+
+  /// @brief 入力に対応する変数番号を返す．
+  SizeType
+  input_var(
+    SizeType pos ///< [in] input_list() 上の位置番号 ( 0 <= pos < input_num() )
+  ) const
+  {
+    return mInputVarList[pos];
+  }
+
+  /// @brief 変数に対応する入力のノード番号を返す．
+  SizeType
+  var_input(
+    SizeType var ///< [in] 変数番号 ( 0 <= var < input_num() )
+  ) const
+  {
+    return mVarInputList[var];
+  }
+
+  /// @brief 出力数を返す．
+  SizeType
+  output_num() const
+  {
+    return mOutputList.size();
+  }
+
+  /// @brief 出力の BDD を返す．
+  ///
+  /// - 打ち切った場合は不正値を返す．
+  /// - 結果は保持され，2回目以降はそれを返す．
+  Bdd
+  output_bdd(
+    SizeType pos ///< [in] output_list() 上の位置番号 ( 0 <= pos < output_num() )
+  );
+
+  /// @brief 全ての出力の BDD を作る．
+  /// @return 打ち切った出力数を返す．
+  SizeType
+  build_all();
+
+  /// @brief 出力の BDD を打ち切った時 true を返す．
+  bool
+  is_aborted(
+    SizeType pos ///< [in] output_list() 上の位置番号 ( 0 <= pos < output_num() )
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数順を決める．
+  void
+  order_vars();
+
+  /// @brief ノードの BDD を作る．
+  ///
+  /// 結果は mBddArray[id] に格納される．
+  void
+  make_bdd(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief 論理ノードの BDD を計算する．
+  Bdd
+  calc_logic(
+    const BnNode& node,          ///< [in] 対象のノード
+    const vector<Bdd>& ibdd_list ///< [in] ファンインの BDD のリスト
+  );
+
+  /// @brief 論理式の BDD を計算する．
+  Bdd
+  calc_expr(
+    const Expr& expr,            ///< [in] 論理式
+    const vector<Bdd>& ibdd_list ///< [in] ファンインの BDD のリスト
+  );
+
+  /// @brief ローカルな BDD に大域的な BDD を代入する．
+  Bdd
+  compose(
+    const Bdd& bdd,                      ///< [in] ローカルな BDD
+    const vector<Bdd>& ibdd_list,        ///< [in] ファンインの BDD のリスト
+    unordered_map<Bdd, Bdd>& result_map ///< [inout] 計算済みの結果
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ノードの状態
+  enum class Status {
+    None,   // 未処理
+    Done,   // BDD を作った．
+    Aborted // 打ち切った．
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BnNetwork& mNetwork;
+
+  // BDD の節点数の上限
+  SizeType mNodeLimit;
+
+  // 動的変数順序変更を行う時 true
+  bool mSifting;
+
+  // 入力の位置番号をキーにして変数番号を格納する配列
+  vector<SizeType> mInputVarList;
+
+  // 変数番号をキーにして入力のノード番号を格納する配列
+  vector<SizeType> mVarInputList;
+
+  // 出力のノード番号のリスト
+  vector<SizeType> mOutputList;
+
+  // ノード番号をキーにして状態を格納する配列
+  vector<Status> mStatusArray;
+
+  // ノード番号をキーにして BDD を格納する配列
+  vector<Bdd> mBddArray;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // YM_BNGLOBALBDD_H
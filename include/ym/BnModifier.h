@@ -477,6 +477,16 @@ public:
     BnNode new_node  ///< [in] つなぎ替える新しいノード
   );
 
+  /// @brief 整合性のチェックを行う．
+  ///
+  /// - check_loop が true の時には組み合わせ回路部分の
+  ///   ループのチェックも行う．
+  /// - 通常は BnNetwork へのムーブ時に自動的に呼ばれる．
+  void
+  wrap_up(
+    bool check_loop = false ///< [in] ループのチェックを行う時 true にする．
+  );
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
@@ -21,6 +21,7 @@
 #include "ym/BnDffList.h"
 #include "ym/BnNode.h"
 #include "ym/BnNodeList.h"
+#include "ym/BnNetworkStats.h"
 
 
 BEGIN_NAMESPACE_YM_BNET
@@ -68,6 +69,7 @@ class BnNetworkImpl;
 class BnNetwork
 {
   friend class BnModifier;
+  friend class BnGlobalBdd;
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -265,9 +267,20 @@ public:
   ) const;
 
   /// @brief 論理ノードのリストを得る．
+  ///
+  /// change_primitive() などでファンインを変更したり，
+  /// substitute_fanout() を行った後はトポロジカル順とは限らない．
   BnNodeList
   logic_list() const;
 
+  /// @brief 論理ノードを入力からのトポロジカル順に並べたリストを得る．
+  ///
+  /// - logic_list() と同じく全ての論理ノードを含む．
+  /// - 呼び出すごとに深さ優先探索で求める．
+  /// - ループがある場合はループ上のノードの順序は不定となる．
+  BnNodeList
+  sorted_logic_list() const;
+
   /// @brief 実装可能な構造を持っている時 true を返す．
   bool
   is_concrete() const;
@@ -296,6 +309,42 @@ public:
     SizeType expr_id ///< [in] 論理式番号 ( 0 <= expr_id < expr_num() )
   ) const;
 
+  /// @brief 組み合わせ回路部分のループを求める．
+  /// @return ループごとのノードのリストを返す．
+  ///
+  /// - 自己ループおよび2つ以上の論理ノードからなる強連結成分を
+  ///   ループとみなす．
+  /// - ループがない場合には空のリストを返す．
+  vector<BnNodeList>
+  find_loops() const;
+
+  /// @brief 入力側からの直接支配ノードの配列を求める．
+  /// @return ノード番号をキーにして直接支配ノードの番号を持つ配列を返す．
+  ///
+  /// - 配列のサイズは node_num() + 1 で，0番目は使用しない．
+  /// - 入力ノードや複数の入力から到達するノードのように直接支配ノード
+  ///   を持たない場合と，入力から到達不能な場合は BNET_NULLID となる．
+  vector<SizeType>
+  dominator_list() const;
+
+  /// @brief 出力側への直接支配ノード(post-dominator)の配列を求める．
+  /// @return ノード番号をキーにして直接支配ノードの番号を持つ配列を返す．
+  ///
+  /// - あるノードから出力(DFFの入力を含む)へ至る全ての経路が通過する
+  ///   ノードのうち，最も近いものを直接支配ノードとする．
+  /// - 配列のサイズは node_num() + 1 で，0番目は使用しない．
+  /// - 出力ノードや複数の出力に到達するノードのように直接支配ノード
+  ///   を持たない場合と，出力に到達しない場合は BNET_NULLID となる．
+  vector<SizeType>
+  post_dominator_list() const;
+
+  /// @brief 統計情報を得る．
+  ///
+  /// - ノードタイプごとの数，ファンイン/ファンアウト数のヒストグラム，
+  ///   論理段数などを1回の走査でまとめて求める．
+  BnNetworkStats
+  stats() const;
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
@@ -317,6 +366,124 @@ public:
   BnNetwork
   simple_decomp() const;
 
+  /// @brief ファンイン数を制限して段数が小さくなるように分解したネットワークを返す．
+  ///
+  /// - 多入力のゲートは段数の小さいファンインから組み合わせる．
+  /// - インバーターは共有される．
+  /// - 真理値表型は ISOP，BDD型は Shannon 展開で分解される．
+  /// - セル型のノードはそのまま残る．
+  /// - max_fanin が 2 未満の時は std::invalid_argument 例外が送出される．
+  BnNetwork
+  balanced_decomp(
+    SizeType max_fanin = 2 ///< [in] ファンイン数の最大値
+  ) const;
+
+  /// @brief 定数伝搬とバッファ/インバーターの除去を行ったネットワークを返す．
+  ///
+  /// - 定数はすべての種類のノードに伝搬される．
+  /// - バッファとインバーターはファンインの極性として吸収される．
+  /// - 出力から到達できなくなったノードは取り除かれる．
+  BnNetwork
+  sweep(
+    SizeType& removed_num ///< [out] 取り除かれた論理ノード数
+  ) const;
+
+  /// @brief 定数伝搬とバッファ/インバーターの除去を行ったネットワークを返す．
+  BnNetwork
+  sweep() const;
+
+  /// @brief 機能的に等価なノードを併合したネットワークを返す．
+  ///
+  /// - シミュレーションと SAT を用いて等価(もしくは逆相)なノードを
+  ///   トポロジカル順で前にあるノードに併合する(SAT sweeping)．
+  /// - SAT の判定が制限内に終わらなかったノードは併合しない．
+  /// - 最後に sweep() を行うので不要になったノードは取り除かれる．
+  /// - conflict_limit が 0 の時は制限なしとなる．
+  BnNetwork
+  fraig(
+    SizeType sim_num,        ///< [in] ランダムシミュレーションの回数
+                             ///<      (1回あたり64パタン)
+    SizeType conflict_limit, ///< [in] SAT 1回あたりのコンフリクト数の上限
+    SizeType& merged_num     ///< [out] 併合したノード数
+  ) const;
+
+  /// @brief 機能的に等価なノードを併合したネットワークを返す．
+  BnNetwork
+  fraig(
+    SizeType sim_num = 16,         ///< [in] ランダムシミュレーションの回数
+                                   ///<      (1回あたり64パタン)
+    SizeType conflict_limit = 1000 ///< [in] SAT 1回あたりのコンフリクト数の上限
+  ) const;
+
+  /// @brief 論理ノードをファンアウト先に併合したネットワークを返す．
+  ///
+  /// - SIS の eliminate と同様にノードの関数をファンアウト先に代入して
+  ///   ノードを取り除く．
+  /// - 併合によって増えるリテラル数を評価値とし，評価値の小さいノードから
+  ///   順に処理する．
+  /// - 併合後のファンアウト先のファンイン数が fanin_limit 以下，
+  ///   リテラル数が literal_limit 以下で，評価値が value_limit 以下の
+  ///   場合のみ併合する．
+  /// - BDD型とセル型のノード，出力に接続しているノードは併合しない．
+  /// - 最後に sweep() を行うので不要になったノードは取り除かれる．
+  BnNetwork
+  eliminate(
+    SizeType fanin_limit,    ///< [in] 併合後のファンイン数の上限
+    SizeType literal_limit,  ///< [in] 併合後のリテラル数の上限
+    int value_limit,         ///< [in] 評価値の上限
+    SizeType& eliminated_num ///< [out] 取り除いたノード数
+  ) const;
+
+  /// @brief 論理ノードをファンアウト先に併合したネットワークを返す．
+  BnNetwork
+  eliminate(
+    SizeType fanin_limit = 8,    ///< [in] 併合後のファンイン数の上限
+    SizeType literal_limit = 32, ///< [in] 併合後のリテラル数の上限
+    int value_limit = 0          ///< [in] 評価値の上限
+  ) const;
+
+  /// @brief 冗長な接続を取り除いたネットワークを返す．
+  ///
+  /// - 論理ノードの入出力の縮退故障のうち検出不能なものを，
+  ///   ランダムパタンによる故障シミュレーションと SAT を用いて求め，
+  ///   故障箇所を定数に置き換える．
+  /// - 組み合わせ回路部分のみを対象とする．
+  /// - SAT の判定が制限内に終わらなかった故障はそのまま残す．
+  /// - 最後に sweep() を行うので定数は伝搬され，不要になったノードは
+  ///   取り除かれる．
+  /// - conflict_limit が 0 の時は制限なしとなる．
+  BnNetwork
+  remove_redundancy(
+    SizeType sim_num,        ///< [in] ランダムシミュレーションの回数
+                             ///<      (1回あたり64パタン)
+    SizeType conflict_limit, ///< [in] SAT 1回あたりのコンフリクト数の上限
+    SizeType& removed_num    ///< [out] 定数に置き換えた故障数
+  ) const;
+
+  /// @brief 冗長な接続を取り除いたネットワークを返す．
+  BnNetwork
+  remove_redundancy(
+    SizeType sim_num = 16,         ///< [in] ランダムシミュレーションの回数
+                                   ///<      (1回あたり64パタン)
+    SizeType conflict_limit = 1000 ///< [in] SAT 1回あたりのコンフリクト数の上限
+  ) const;
+
+  /// @brief セルライブラリを用いてテクノロジマッピングを行ったネットワークを返す．
+  ///
+  /// - library() の単一出力の論理セルを用いる．
+  /// - カットの関数とセルの関数を NPN 変換を考慮して照合する．
+  /// - 段数(単位遅延)を最小化した後，段数を変えない範囲で面積を削減する．
+  /// - セル型のノードはそのまま残る．
+  /// - DFF はそのままコピーされるので，結果の is_mapped() は true となる．
+  /// - cut_size が [2, 6] の範囲外の時，ライブラリにインバーターがない時，
+  ///   ライブラリのセルで実現できない関数がある時，セル型でない DFF が
+  ///   ある時は std::invalid_argument 例外が送出される．
+  BnNetwork
+  tech_map(
+    SizeType cut_size = 4,  ///< [in] カットの入力数の最大値
+    SizeType thread_num = 1 ///< [in] カットの列挙に用いるスレッド数
+  ) const;
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
@@ -325,6 +492,10 @@ public:
 public:
   //////////////////////////////////////////////////////////////////////
   /// @name ファイル入出力関数
+  ///
+  /// gzip/zstd で圧縮されたファイルはマジックナンバーで判別して
+  /// 透過的に読み込む．
+  /// 出力はファイル名が ".gz" か ".zst" で終わる場合に圧縮を行う．
   /// @{
   //////////////////////////////////////////////////////////////////////
 
@@ -332,12 +503,15 @@ public:
   /// @return ネットワークを返す．
   ///
   /// - エラー時には std::invalid_argumnet が送出される．
+  /// - thread_num が 2 以上の時はファイルを分割して並列に解析する．
+  ///   結果は thread_num によらず同一となる．
   static
   BnNetwork
   read_blif(
     const string& filename,              ///< [in] ファイル名
     const string& clock_name = string{}, ///< [in] クロック端子名
-    const string& reset_name = string{}  ///< [in] リセット端子名
+    const string& reset_name = string{}, ///< [in] リセット端子名
+    SizeType thread_num = 1              ///< [in] 読み込みに用いるスレッド数
   );
 
   /// @brief blif ファイルを読み込む(セルライブラリ付き)．
@@ -350,7 +524,40 @@ public:
     const string& filename,              ///< [in] ファイル名
     const ClibCellLibrary& cell_library, ///< [in] セルライブラリ
     const string& clock_name = string{}, ///< [in] クロック端子名
-    const string& reset_name = string{}  ///< [in] リセット端子名
+    const string& reset_name = string{}, ///< [in] リセット端子名
+    SizeType thread_num = 1              ///< [in] 読み込みに用いるスレッド数
+  );
+
+  /// @brief blif ファイルを BlifModel を経由せずに読み込む．
+  /// @return ネットワークを返す．
+  ///
+  /// - 読み込みながら直接ネットワークを作るので read_blif() よりも
+  ///   使用メモリが少ない．
+  /// - 論理ノードはファイル中の定義順をもとにしたトポロジカル順に作られる．
+  ///   そのためノード番号は read_blif() の結果とは異なる．
+  /// - 出力から到達できない論理ノードも取り除かれない．
+  /// - エラー時には std::invalid_argumnet が送出される．
+  static
+  BnNetwork
+  read_blif_direct(
+    const string& filename,              ///< [in] ファイル名
+    const string& clock_name = string{}, ///< [in] クロック端子名
+    const string& reset_name = string{}, ///< [in] リセット端子名
+    SizeType thread_num = 1              ///< [in] 読み込みに用いるスレッド数
+  );
+
+  /// @brief blif ファイルを BlifModel を経由せずに読み込む(セルライブラリ付き)．
+  /// @return ネットワークを返す．
+  ///
+  /// - エラー時には std::invalid_argumnet が送出される．
+  static
+  BnNetwork
+  read_blif_direct(
+    const string& filename,              ///< [in] ファイル名
+    const ClibCellLibrary& cell_library, ///< [in] セルライブラリ
+    const string& clock_name = string{}, ///< [in] クロック端子名
+    const string& reset_name = string{}, ///< [in] リセット端子名
+    SizeType thread_num = 1              ///< [in] 読み込みに用いるスレッド数
   );
 
   /// @brief iscas89 ファイルを読み込む．
@@ -379,29 +586,36 @@ public:
   /// @return ネットワークを返す．
   ///
   /// - エラー時には std::invalid_argumnet が送出される．
+  /// - prim_and が true の場合，ANDノードは極性に応じて
+  ///   AND/NAND/OR/NOR の組み込み型のノードとなる．
   static
   BnNetwork
   read_aag(
     const string& filename,              ///< [in] ファイル名
     const string& clock_name = string{}, ///< [in] クロック端子名
-    const string& reset_name = string{}  ///< [in] リセット端子名
+    const string& reset_name = string{}, ///< [in] リセット端子名
+    bool prim_and = false                ///< [in] 組み込み型のANDノードを用いる時 true
   );
 
   /// @brief .aig 形式のファイルを読み込む．
   /// @return ネットワークを返す．
   ///
   /// - エラー時には std::invalid_argumnet が送出される．
+  /// - prim_and が true の場合，ANDノードは極性に応じて
+  ///   AND/NAND/OR/NOR の組み込み型のノードとなる．
   static
   BnNetwork
   read_aig(
     const string& filename,              ///< [in] ファイル名
     const string& clock_name = string{}, ///< [in] クロック端子名
-    const string& reset_name = string{}  ///< [in] リセット端子名
+    const string& reset_name = string{}, ///< [in] リセット端子名
+    bool prim_and = false                ///< [in] 組み込み型のANDノードを用いる時 true
   );
 
   /// @brief 内容を blif 形式で出力する．
   ///
   /// ポートの情報は無視される．
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_blif(
     const string& filename,          ///< [in] 出力先のファイル名
@@ -412,6 +626,7 @@ public:
   /// @brief 内容を ISCAS89(.bench) 形式で出力する．
   ///
   /// ポートの情報は無視される．
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_iscas89(
     const string& filename,          ///< [in] 出力先のファイル名
@@ -420,6 +635,8 @@ public:
   ) const;
 
   /// @brief 内容を Verilog-HDL 形式で出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_verilog(
     const string& filename,                   ///< [in] 出力先のファイル名
@@ -432,6 +649,8 @@ public:
   ) const;
 
   /// @brief 内容を aig 形式で出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_aig(
     const string& filename,          ///< [in] ファイル名
@@ -439,6 +658,8 @@ public:
   ) const;
 
   /// @brief 内容を aag (ascii aig) 形式で出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_aag(
     const string& filename,          ///< [in] ファイル名
@@ -459,6 +680,7 @@ public:
   /// @brief 内容を blif 形式で出力する．
   ///
   /// ポートの情報は無視される．
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_blif(
     ostream& s,                      ///< [in] 出力先のストリーム
@@ -469,6 +691,7 @@ public:
   /// @brief 内容を ISCAS89(.bench) 形式で出力する．
   ///
   /// ポートの情報は無視される．
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_iscas89(
     ostream& s,                      ///< [in] 出力先のストリーム
@@ -477,6 +700,8 @@ public:
   ) const;
 
   /// @brief 内容を Verilog-HDL 形式で出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_verilog(
     ostream& s,                               ///< [in] 出力先のストリーム
@@ -489,6 +714,8 @@ public:
   ) const;
 
   /// @brief 内容を aig 形式で出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_aig(
     ostream& s,                      ///< [in] 出力先のストリーム
@@ -496,6 +723,8 @@ public:
   ) const;
 
   /// @brief 内容を aag (ascii aig) 形式で出力する．
+  ///
+  /// 書き出しに失敗した場合には std::invalid_argument 例外を送出する．
   void
   write_aag(
     ostream& s,                      ///< [in] 出力先のストリーム
@@ -527,6 +756,16 @@ public:
     BinEnc& s ///< [in] 出力ストリーム
   ) const;
 
+  /// @brief 内容を独自形式でファイルにバイナリダンプする．
+  ///
+  /// ファイル名が ".gz" か ".zst" で終わる場合は圧縮して出力する．
+  /// ファイルが開けなかった場合と書き出しに失敗した場合には
+  /// std::invalid_argument 例外を送出する．
+  void
+  dump(
+    const string& filename ///< [in] ファイル名
+  ) const;
+
   /// @brief バイナリダンプされた内容を復元する．
   static
   BnNetwork
@@ -534,6 +773,17 @@ public:
     BinDec& s ///< [in] 入力ストリーム
   );
 
+  /// @brief ファイルにバイナリダンプされた内容を復元する．
+  ///
+  /// gzip/zstd で圧縮されたファイルは展開しながら読み込む．
+  /// ファイルが開けなかった場合と圧縮データが壊れていた場合には
+  /// std::invalid_argument 例外を送出する．
+  static
+  BnNetwork
+  restore(
+    const string& filename ///< [in] ファイル名
+  );
+
   //////////////////////////////////////////////////////////////////////
   /// @}
   //////////////////////////////////////////////////////////////////////
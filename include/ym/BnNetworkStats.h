@@ -0,0 +1,148 @@
+#ifndef YM_BNNETWORKSTATS_H
+#define YM_BNNETWORKSTATS_H
+
+/// @file ym/BnNetworkStats.h
+/// @brief BnNetworkStats のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/logic.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnNetworkStats BnNetworkStats.h "ym/BnNetworkStats.h"
+/// @brief BnNetwork の統計情報を表す構造体
+/// @sa BnNetwork::stats()
+//////////////////////////////////////////////////////////////////////
+struct BnNetworkStats
+{
+  /// @brief ノードタイプの種類数
+  static
+  const SizeType NODE_TYPE_NUM = static_cast<SizeType>(BnNodeType::Cell) + 1;
+
+  /// @brief プリミティブタイプの種類数
+  static
+  const SizeType PRIM_TYPE_NUM = static_cast<SizeType>(PrimType::Xnor) + 1;
+
+  /// @brief DFFタイプの種類数
+  static
+  const SizeType DFF_TYPE_NUM = static_cast<SizeType>(BnDffType::Cell) + 1;
+
+  /// @brief ノードタイプ名
+  ///
+  /// BnNodeType を SizeType にキャストした値をインデックスとする．
+  static
+  const char* const NODE_TYPE_NAME[NODE_TYPE_NUM];
+
+  /// @brief プリミティブタイプ名
+  ///
+  /// PrimType を SizeType にキャストした値をインデックスとする．
+  static
+  const char* const PRIM_TYPE_NAME[PRIM_TYPE_NUM];
+
+  /// @brief DFFタイプ名
+  ///
+  /// BnDffType を SizeType にキャストした値をインデックスとする．
+  static
+  const char* const DFF_TYPE_NAME[DFF_TYPE_NUM];
+
+  /// @brief ノードタイプごとの数を返す．
+  SizeType
+  node_type_count(
+    BnNodeType type ///< [in] ノードタイプ
+  ) const
+  {
+    return node_type_num[static_cast<SizeType>(type)];
+  }
+
+  /// @brief プリミティブタイプごとの数を返す．
+  SizeType
+  prim_type_count(
+    PrimType type ///< [in] プリミティブタイプ
+  ) const
+  {
+    return prim_type_num[static_cast<SizeType>(type)];
+  }
+
+  /// @brief DFFタイプごとの数を返す．
+  SizeType
+  dff_type_count(
+    BnDffType type ///< [in] DFFタイプ
+  ) const
+  {
+    return dff_type_num[static_cast<SizeType>(type)];
+  }
+
+  /// @brief ポート数
+  SizeType port_num{0};
+
+  /// @brief DFF数
+  SizeType dff_num{0};
+
+  /// @brief 入力ノード数(DFFの出力を含む)
+  SizeType input_num{0};
+
+  /// @brief 外部入力数
+  SizeType primary_input_num{0};
+
+  /// @brief 出力ノード数(DFFの入力を含む)
+  SizeType output_num{0};
+
+  /// @brief 外部出力数
+  SizeType primary_output_num{0};
+
+  /// @brief 論理ノード数
+  SizeType logic_num{0};
+
+  /// @brief ノードタイプごとの数
+  ///
+  /// BnNodeType を SizeType にキャストした値をインデックスとする．
+  SizeType node_type_num[NODE_TYPE_NUM]{};
+
+  /// @brief プリミティブ型の論理ノードのタイプごとの数
+  ///
+  /// PrimType を SizeType にキャストした値をインデックスとする．
+  SizeType prim_type_num[PRIM_TYPE_NUM]{};
+
+  /// @brief DFFタイプごとの数
+  ///
+  /// BnDffType を SizeType にキャストした値をインデックスとする．
+  SizeType dff_type_num[DFF_TYPE_NUM]{};
+
+  /// @brief 論理ノードのファンイン数のヒストグラム
+  ///
+  /// fanin_hist[k] がファンイン数 k の論理ノード数を表す．
+  vector<SizeType> fanin_hist;
+
+  /// @brief 入力ノードと論理ノードのファンアウト数のヒストグラム
+  ///
+  /// fanout_hist[k] がファンアウト数 k のノード数を表す．
+  vector<SizeType> fanout_hist;
+
+  /// @brief 論理段数の最大値
+  ///
+  /// 入力ノードを 0 段とした時の出力ノードの段数の最大値
+  SizeType depth{0};
+
+  /// @brief 論理式の数
+  SizeType expr_num{0};
+
+  /// @brief 関数(真理値表)の数
+  SizeType func_num{0};
+
+};
+
+END_NAMESPACE_YM_BNET
+
+BEGIN_NAMESPACE_YM
+
+using nsBnet::BnNetworkStats;
+
+END_NAMESPACE_YM
+
+#endif // YM_BNNETWORKSTATS_H
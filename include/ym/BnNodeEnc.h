@@ -5,31 +5,55 @@
 /// @brief BnNodeEnc のヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2018, 2021 Yusuke Matsunaga
+/// Copyright (C) 2018, 2021, 2023 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "ym/bnet.h"
+#include "ym/BnNode.h"
 #include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/Bdd.h"
 #include "ym/SatSolver.h"
-#include "ym/SatTseitinEnc.h"
 
-#error "Don't use me"
 
-BEGIN_NAMESPACE_YM
+BEGIN_NAMESPACE_YM_BNET
 
 //////////////////////////////////////////////////////////////////////
 /// @class BnNodeEnc BnNodeEnc.h "ym/BnNodeEnc.h"
+/// @ingroup BnetGroup
 /// @brief BnNode の入出力の関係を表す CNF 式を作るクラス
+/// @sa BnNetwork
+///
+/// Tseitin 変換を用いてノードの出力を表すリテラルを作る．
+/// CNF 式は make_cnf() で要求されたノードの TFI のうち，
+/// まだ符号化されていないノードに対してのみ作られる．
+/// そのため同じ SatSolver に対して make_cnf() と solve() を
+/// 交互に呼ぶことで，インクリメンタルに SAT 問題を解くことができる．
+///
+/// - 入力ノード(DFFの出力を含む)には新しい変数を割り当てる．
+///   set_lit() で事前に既存のリテラルを割り当てることもできる．
+/// - バッファとインバーターは変数を作らずにファンインのリテラルを用いる．
+/// - AND/OR/XOR 系のプリミティブ型は通常の Tseitin 変換を行う．
+/// - 論理式型，真理値表型，セル型は入力数が kMaxIsopInputs 以下の場合，
+///   肯定と否定の非冗長積和形(ISOP)から節を作る．
+///   論理式型と真理値表型の ISOP は関数ごとに一度だけ求めて使い回す．
+///   論理式型とセル型でそれを超える場合は論理式の構造に従って変換する．
+/// - BDD型は BDD の節点ごとに変数を割り当てて MUX として変換する．
 //////////////////////////////////////////////////////////////////////
 class BnNodeEnc
 {
 public:
 
+  /// @brief ISOP を用いて変換する最大入力数
+  static
+  const SizeType kMaxIsopInputs;
+
   /// @brief コンストラクタ
+  ///
+  /// solver と network はこのオブジェクトよりも長く存在する必要がある．
   BnNodeEnc(
-    SatSolver& solver,               ///< [in] SATソルバ
-    const BnNetwork& network,        ///< [in] 対象のネットワーク
-    const vector<SatLiteral>& varmap ///< [in] 変数番号のマップ
+    SatSolver& solver,       ///< [in] SATソルバ
+    const BnNetwork& network ///< [in] 対象のネットワーク
   );
 
   /// @brief デストラクタ
@@ -41,60 +65,171 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief ノードの入出力の関係を表すCNF式を作る．
-  void
+  /// @brief ノードの出力を表すリテラルを返す．
+  ///
+  /// ノードの TFI のうち，まだ符号化されていないノードの CNF 式を作る．
+  /// 出力ノードの場合はそのソースのノードのリテラルを返す．
+  SatLiteral
   make_cnf(
     const BnNode& node ///< [in] 対象のノード
   );
 
+  /// @brief ノードの出力を表すリテラルを返す．
+  ///
+  /// ノード番号で指定する以外は make_cnf(const BnNode&) と同じ．
+  SatLiteral
+  make_cnf(
+    SizeType node_id ///< [in] 対象のノード番号
+  );
+
+  /// @brief ノードにリテラルを割り当てる．
+  ///
+  /// - 割り当てられたノードは符号化済みとみなされ，
+  ///   そのファンインの CNF 式は作られない．
+  /// - 主に入力ノードを他のネットワークと共有するために用いる．
+  /// - 既に符号化済みのノードに対しては std::invalid_argument 例外が送出される．
+  void
+  set_lit(
+    SizeType node_id, ///< [in] 対象のノード番号
+    SatLiteral lit    ///< [in] 割り当てるリテラル
+  );
+
+  /// @brief ノードが符号化済みか調べる．
+  bool
+  is_encoded(
+    SizeType node_id ///< [in] 対象のノード番号
+  ) const
+  {
+    return node_id < mEncoded.size() && mEncoded[node_id];
+  }
+
+  /// @brief 符号化済みのノードのリテラルを返す．
+  ///
+  /// 符号化されていない場合は std::invalid_argument 例外が送出される．
+  SatLiteral
+  lit(
+    SizeType node_id ///< [in] 対象のノード番号
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 肯定と否定の ISOP
+  // 積項の要素は 変数番号 * 2 + 否定フラグ
+  struct IsopCover
+  {
+    // 求めてある時 true
+    bool mValid{false};
+
+    // 肯定の ISOP
+    vector<vector<SizeType>> mCover1;
+
+    // 否定の ISOP
+    vector<vector<SizeType>> mCover0;
+  };
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 定数０のCNFを作る．
-  void
-  make_zero(SatLiteral olit);
+  /// @brief ノードの入出力の関係を表す CNF 式を作る．
+  ///
+  /// ファンインは全て符号化済みでなければならない．
+  /// @return ノードの出力を表すリテラルを返す．
+  SatLiteral
+  encode_node(
+    const BnNode& node ///< [in] 対象のノード
+  );
 
-  /// @brief 定数1のCNFを作る．
-  void
-  make_one(SatLiteral olit);
+  /// @brief プリミティブ型の CNF 式を作る．
+  /// @return 出力を表すリテラルを返す．
+  SatLiteral
+  make_prim(
+    PrimType prim_type,                  ///< [in] プリミティブ型
+    const vector<SatLiteral>& ilit_array ///< [in] 入力のリテラルのリスト
+  );
 
-  /// @brief BUFFのCNFを作る．
-  void
-  make_buff(SatLiteral olit,
-	    SatLiteral ilit);
+  /// @brief 論理式の CNF 式を作る．
+  /// @return 出力を表すリテラルを返す．
+  SatLiteral
+  make_expr(
+    const Expr& expr,                    ///< [in] 論理式
+    const vector<SatLiteral>& ilit_array ///< [in] 入力のリテラルのリスト
+  );
 
-  /// @brief NOTのCNFを作る．
-  void
-  make_not(SatLiteral olit,
-	   SatLiteral ilit);
+  /// @brief 論理式の構造に従って CNF 式を作る．
+  /// @return 出力を表すリテラルを返す．
+  SatLiteral
+  make_expr_sub(
+    const Expr& expr,                    ///< [in] 論理式
+    const vector<SatLiteral>& ilit_array ///< [in] 入力のリテラルのリスト
+  );
 
-  /// @brief AND論理のCNFを作る．
-  void
-  make_and(SatLiteral olit,
-	   const vector<SatLiteral>& ilit_array);
+  /// @brief 真理値表の ISOP を用いて CNF 式を作る．
+  /// @return 出力を表すリテラルを返す．
+  SatLiteral
+  make_isop(
+    const TvFunc& func,                  ///< [in] 真理値表
+    const vector<SatLiteral>& ilit_array ///< [in] 入力のリテラルのリスト
+  );
 
-  /// @brief OR論理のCNFを作る．
-  void
-  make_or(SatLiteral olit,
-	  const vector<SatLiteral>& ilit_array);
+  /// @brief 論理式型のノードの ISOP を返す．
+  ///
+  /// 結果は論理式番号と入力数の組ごとに保持しておく．
+  const IsopCover&
+  expr_cover(
+    const BnNode& node ///< [in] 対象のノード
+  );
+
+  /// @brief 真理値表型のノードの ISOP を返す．
+  ///
+  /// 結果は関数番号ごとに保持しておく．
+  const IsopCover&
+  func_cover(
+    const BnNode& node ///< [in] 対象のノード
+  );
 
-  /// @brief XOR論理のCNFを作る．
+  /// @brief ISOP から CNF 式を作る．
+  /// @return 出力を表すリテラルを返す．
+  SatLiteral
+  make_cover(
+    const IsopCover& cover,              ///< [in] 肯定と否定の ISOP
+    const vector<SatLiteral>& ilit_array ///< [in] 入力のリテラルのリスト
+  );
+
+  /// @brief BDD の CNF 式を作る．
+  /// @return 出力を表すリテラルを返す．
+  SatLiteral
+  make_bdd(
+    const Bdd& bdd,                         ///< [in] BDD
+    const vector<SatLiteral>& ilit_array,   ///< [in] 入力のリテラルのリスト
+    unordered_map<Bdd, SatLiteral>& lit_map ///< [inout] 変換済みの BDD の対応表
+  );
+
+  /// @brief AND の CNF 式を作る．
   void
-  make_xor(SatLiteral olit,
-	   const vector<SatLiteral>& ilit_array);
+  make_and(
+    SatLiteral olit,                     ///< [in] 出力のリテラル
+    const vector<SatLiteral>& ilit_array ///< [in] 入力のリテラルのリスト
+  );
 
-  /// @brief 論理式のCNFを作る．
+  /// @brief XOR の CNF 式を作る．
+  /// @return 出力を表すリテラルを返す．
+  ///
+  /// 3入力以上の場合は2入力の XOR の連鎖に分解する．
   SatLiteral
-  make_expr(const Expr& expr,
-	    const vector<SatLiteral>& ilit_array);
+  make_xor(
+    const vector<SatLiteral>& ilit_array ///< [in] 入力のリテラルのリスト
+  );
 
-  /// @brief ノードに対応するリテラルを返す．
-  /// @param[in] node_id ノード番号
+  /// @brief 定数1を表すリテラルを返す．
   SatLiteral
-  lit(int node_id);
+  const_lit();
 
 
 private:
@@ -105,17 +240,30 @@ private:
   // SATソルバ
   SatSolver& mSolver;
 
-  // Tseitin 符号化器
-  SatTseitinEnc mEnc;
-
   // 対象のネットワーク
   const BnNetwork& mNetwork;
 
-  // 変数番号のマップ
-  const vector<SatLiteral>& mVarMap;
+  // ノード番号をキーにしてリテラルを格納する配列
+  vector<SatLiteral> mLitArray;
+
+  // ノード番号をキーにして符号化済みかを表す配列
+  vector<bool> mEncoded;
+
+  // 論理式番号 * (kMaxIsopInputs + 1) + 入力数 をキーにして
+  // ISOP を格納する配列
+  vector<IsopCover> mExprCoverArray;
+
+  // 関数番号をキーにして ISOP を格納する配列
+  vector<IsopCover> mFuncCoverArray;
+
+  // 定数1を表すリテラル
+  SatLiteral mConstLit;
+
+  // mConstLit が有効の時 true にするフラグ
+  bool mHasConst{false};
 
 };
 
-END_NAMESPACE_YM
+END_NAMESPACE_YM_BNET
 
 #endif // YM_BNNODEENC_H
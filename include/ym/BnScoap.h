@@ -0,0 +1,323 @@
+#ifndef YM_BNSCOAP_H
+#define YM_BNSCOAP_H
+
+/// @file ym/BnScoap.h
+/// @brief BnScoap のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/BnNode.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnScoap BnScoap.h "ym/BnScoap.h"
+/// @ingroup BnetGroup
+/// @brief SCOAP 値を求めるクラス
+/// @sa BnNetwork
+///
+/// 以下の値をノード番号をキーにした配列で保持する．
+/// - CC0/CC1: 組み合わせ回路としての 0/1 可制御性
+/// - CO:      組み合わせ回路としての可観測性
+/// - SC0/SC1: 順序回路としての 0/1 可制御性(通過するDFF数)
+/// - SO:      順序回路としての可観測性(通過するDFF数)
+///
+/// CC0/CC1 は入力側から，CO は出力側から求める．
+/// DFF/ラッチの出力は data_in の値(とクリア/プリセット)から求め，
+/// SC0/SC1/SO はDFFを通過するごとに 1 増える．
+/// DFFを介したループがあるので収束するまで繰り返す．
+///
+/// 真理値表型と論理式型のノードは入力数が kMaxEnumInputs 以下の場合，
+/// コファクターを列挙して正確な値を求める．
+/// それ以外の場合(BDD型やセル型を含む)は全ての入力を何らかの値に
+/// 設定する必要があるとみなして保守的な値を用いる．
+///
+/// 到達不能な値は INF で表す．
+///
+/// 構造の変更後に update() を呼ぶと変更されたノードから
+/// 影響のある部分のみを再計算する．
+/// 変更前のファンインは前回の計算時に記録したものを用いる．
+//////////////////////////////////////////////////////////////////////
+class BnScoap
+{
+public:
+
+  /// @brief 到達不能を表す値
+  static
+  const SizeType INF;
+
+  /// @brief コファクターを列挙する最大入力数
+  static
+  const SizeType kMaxEnumInputs;
+
+  /// @brief コンストラクタ
+  ///
+  /// - network はこのオブジェクトよりも長く存在する必要がある．
+  /// - network のファンアウト情報が正しい必要がある．
+  BnScoap(
+    const BnNetwork& network ///< [in] 対象のネットワーク
+  );
+
+  /// @brief デストラクタ
+  ~BnScoap() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 計算を行う関数
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 全てのノードの値を計算し直す．
+  void
+  calc();
+
+  /// @brief 変更のあったノードから影響のある部分を再計算する．
+  ///
+  /// - change_xxx() で変更されたノードや新たに追加されたノードを
+  ///   node_list に入れる．
+  ///   変更で外されたファンインを入れる必要はない．
+  /// - BnModifier の場合，事前に wrap_up() を呼んでファンアウト情報を
+  ///   正しくしておく必要がある．
+  /// - 再計算の範囲が大きくなりすぎた場合には calc() を呼ぶ．
+  void
+  update(
+    const vector<BnNode>& node_list ///< [in] 変更のあったノードのリスト
+  );
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  /// @name 値を取り出す関数
+  /// @{
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 0 可制御性を返す．
+  SizeType
+  cc0(
+    const BnNode& node ///< [in] 対象のノード
+  ) const
+  {
+    return mCC0[node.id()];
+  }
+
+  /// @brief 1 可制御性を返す．
+  SizeType
+  cc1(
+    const BnNode& node ///< [in] 対象のノード
+  ) const
+  {
+    return mCC1[node.id()];
+  }
+
+  /// @brief 可観測性を返す．
+  SizeType
+  co(
+    const BnNode& node ///< [in] 対象のノード
+  ) const
+  {
+    return mCO[node.id()];
+  }
+
+  /// @brief 順序回路としての 0 可制御性を返す．
+  SizeType
+  sc0(
+    const BnNode& node ///< [in] 対象のノード
+  ) const
+  {
+    return mSC0[node.id()];
+  }
+
+  /// @brief 順序回路としての 1 可制御性を返す．
+  SizeType
+  sc1(
+    const BnNode& node ///< [in] 対象のノード
+  ) const
+  {
+    return mSC1[node.id()];
+  }
+
+  /// @brief 順序回路としての可観測性を返す．
+  SizeType
+  so(
+    const BnNode& node ///< [in] 対象のノード
+  ) const
+  {
+    return mSO[node.id()];
+  }
+
+  /// @brief 0 可制御性の配列を返す．
+  ///
+  /// ノード番号をキーにする．サイズは node_num() + 1 となる．
+  const vector<SizeType>&
+  cc0_array() const
+  {
+    return mCC0;
+  }
+
+  /// @brief 1 可制御性の配列を返す．
+  const vector<SizeType>&
+  cc1_array() const
+  {
+    return mCC1;
+  }
+
+  /// @brief 可観測性の配列を返す．
+  const vector<SizeType>&
+  co_array() const
+  {
+    return mCO;
+  }
+
+  /// @brief 順序回路としての 0 可制御性の配列を返す．
+  const vector<SizeType>&
+  sc0_array() const
+  {
+    return mSC0;
+  }
+
+  /// @brief 順序回路としての 1 可制御性の配列を返す．
+  const vector<SizeType>&
+  sc1_array() const
+  {
+    return mSC1;
+  }
+
+  /// @brief 順序回路としての可観測性の配列を返す．
+  const vector<SizeType>&
+  so_array() const
+  {
+    return mSO;
+  }
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 配列のサイズをネットワークに合わせる．
+  void
+  resize();
+
+  /// @brief ノードのファンインを記録する．
+  ///
+  /// 出力ノードの場合は出力のソースを記録する．
+  void
+  record_fanins(
+    const BnNode& node ///< [in] 対象のノード
+  );
+
+  /// @brief 全ノードのトポロジカル順を求める．
+  void
+  make_order();
+
+  /// @brief 可制御性をまとめて計算する．
+  void
+  calc_cc();
+
+  /// @brief 可観測性をまとめて計算する．
+  void
+  calc_co();
+
+  /// @brief ノードの可制御性を計算する．
+  /// @return 値が変化したら true を返す．
+  bool
+  update_cc(
+    const BnNode& node ///< [in] 対象のノード
+  );
+
+  /// @brief ノードの可観測性を計算する．
+  /// @return 値が変化したら true を返す．
+  bool
+  update_co(
+    const BnNode& node ///< [in] 対象のノード
+  );
+
+  /// @brief 論理ノードの可制御性を計算する．
+  void
+  calc_logic_cc(
+    const BnNode& node,                  ///< [in] 対象のノード
+    const vector<SizeType>& c0_array,    ///< [in] 0 可制御性の配列
+    const vector<SizeType>& c1_array,    ///< [in] 1 可制御性の配列
+    SizeType delta,                      ///< [in] 加算値
+    SizeType& c0,                        ///< [out] 0 可制御性
+    SizeType& c1                         ///< [out] 1 可制御性
+  );
+
+  /// @brief 論理ノードの入力の可観測性を計算する．
+  SizeType
+  calc_input_co(
+    const BnNode& node,                  ///< [in] 対象のノード
+    SizeType ipos,                       ///< [in] 入力位置
+    const vector<SizeType>& c0_array,    ///< [in] 0 可制御性の配列
+    const vector<SizeType>& c1_array,    ///< [in] 1 可制御性の配列
+    const vector<SizeType>& o_array,     ///< [in] 可観測性の配列
+    SizeType delta                       ///< [in] 加算値
+  );
+
+  /// @brief 真理値表を得る．
+  /// @return 求められなかった場合は nullptr を返す．
+  ///
+  /// - 結果はキャッシュされる．
+  const vector<bool>*
+  truth_table(
+    const BnNode& node ///< [in] 対象のノード
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BnNetwork& mNetwork;
+
+  // 0 可制御性の配列
+  vector<SizeType> mCC0;
+
+  // 1 可制御性の配列
+  vector<SizeType> mCC1;
+
+  // 可観測性の配列
+  vector<SizeType> mCO;
+
+  // 順序回路としての 0 可制御性の配列
+  vector<SizeType> mSC0;
+
+  // 順序回路としての 1 可制御性の配列
+  vector<SizeType> mSC1;
+
+  // 順序回路としての可観測性の配列
+  vector<SizeType> mSO;
+
+  // 全ノードのトポロジカル順のリスト
+  vector<SizeType> mOrder;
+
+  // ノードのファンイン番号のリストを格納する配列
+  // 前回の計算時の値を保持しておき update() で外されたファンインを求める．
+  vector<vector<SizeType>> mFaninArray;
+
+  // 論理式番号と入力数の組をキーにした真理値表のキャッシュ
+  // 論理式番号 * (kMaxEnumInputs + 1) + 入力数 を添字とする．
+  vector<vector<bool>> mExprTvArray;
+
+  // 関数番号をキーにした真理値表のキャッシュ
+  vector<vector<bool>> mFuncTvArray;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // YM_BNSCOAP_H
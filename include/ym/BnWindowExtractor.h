@@ -0,0 +1,163 @@
+#ifndef YM_BNWINDOWEXTRACTOR_H
+#define YM_BNWINDOWEXTRACTOR_H
+
+/// @file ym/BnWindowExtractor.h
+/// @brief BnWindowExtractor のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/BnNode.h"
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class BnWindowExtractor BnWindowExtractor.h "ym/BnWindowExtractor.h"
+/// @ingroup BnetGroup
+/// @brief ノードの周りの部分回路(ウィンドウ)を切り出すクラス
+/// @sa BnNetwork
+///
+/// ウィンドウは以下のノードからなる．
+/// - ピボットノードから tfi_level 段までの TFI の論理ノード
+/// - ピボットノードから tfo_level 段までの TFO の論理ノードのうち，
+///   全てのファンインがウィンドウ内(もしくはその入力)にあるもの
+///   (再収斂するノード)
+///
+/// 切り出したウィンドウは独立した BnNetwork として返す．
+/// その外部入力と外部出力は元のネットワークのノードに対応している．
+/// ウィンドウを最適化した後，
+/// BnModifier::import_subnetwork(window, input_list) で取り込み，
+/// 返された出力を output_list のノードと substitute_fanout() で
+/// つなぎ替えれば元のネットワークに戻すことができる．
+///
+/// 印は世代番号付きの配列で管理しているので，同じオブジェクトで
+/// 繰り返しウィンドウを切り出してもクリアのコストはかからない．
+//////////////////////////////////////////////////////////////////////
+class BnWindowExtractor
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// - network はこのオブジェクトよりも長く存在する必要がある．
+  /// - network のファンアウト情報が正しい必要がある．
+  BnWindowExtractor(
+    const BnNetwork& network, ///< [in] 対象のネットワーク
+    SizeType tfi_level = 3,   ///< [in] TFI の段数
+    SizeType tfo_level = 2    ///< [in] TFO の段数
+  );
+
+  /// @brief デストラクタ
+  ~BnWindowExtractor() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ウィンドウを切り出す．
+  /// @return ウィンドウを表すネットワークを返す．
+  ///
+  /// - pivot は論理ノードでなければならない．
+  /// - 返されるネットワークの i 番目の外部入力は input_list[i] に，
+  ///   i 番目の外部出力は output_list[i] に対応する．
+  /// - ウィンドウ外にファンアウトを持つノードが外部出力となる．
+  BnNetwork
+  extract(
+    BnNode pivot,                ///< [in] ピボットノード
+    vector<BnNode>& input_list,  ///< [out] 入力に対応するノードのリスト
+    vector<BnNode>& output_list  ///< [out] 出力に対応するノードのリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 世代番号を進める．
+  void
+  new_stamp();
+
+  /// @brief ウィンドウ内のノードの時 true を返す．
+  bool
+  in_window(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mWindowMark[id] == mStamp;
+  }
+
+  /// @brief ウィンドウの入力の時 true を返す．
+  bool
+  is_leaf(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mLeafMark[id] == mStamp;
+  }
+
+  /// @brief ウィンドウにノードを加える．
+  void
+  add_node(
+    SizeType id ///< [in] ノード番号
+  )
+  {
+    mWindowMark[id] = mStamp;
+    mNodeList.push_back(id);
+  }
+
+  /// @brief ウィンドウの入力を加える．
+  void
+  add_leaf(
+    SizeType id ///< [in] ノード番号
+  )
+  {
+    if ( !is_leaf(id) ) {
+      mLeafMark[id] = mStamp;
+      mLeafList.push_back(id);
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const BnNetwork& mNetwork;
+
+  // TFI の段数
+  SizeType mTfiLevel;
+
+  // TFO の段数
+  SizeType mTfoLevel;
+
+  // 現在の世代番号
+  SizeType mStamp{0};
+
+  // ノード番号をキーにしてウィンドウ内の時 mStamp を入れる配列
+  vector<SizeType> mWindowMark;
+
+  // ノード番号をキーにしてウィンドウの入力の時 mStamp を入れる配列
+  vector<SizeType> mLeafMark;
+
+  // ノード番号をキーにしてトポロジカル順の処理済みの時 mStamp を入れる配列
+  vector<SizeType> mOrderMark;
+
+  // ウィンドウ内のノード番号のリスト
+  vector<SizeType> mNodeList;
+
+  // ウィンドウの入力のノード番号のリスト
+  vector<SizeType> mLeafList;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // YM_BNWINDOWEXTRACTOR_H
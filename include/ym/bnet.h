@@ -39,6 +39,11 @@ class BnNode;
 class BnNodeMap;
 class BnNodeList;
 class BnModifier;
+class BnCec;
+class BnGlobalBdd;
+class BnNodeEnc;
+class BnScoap;
+class BnWindowExtractor;
 
 END_NAMESPACE_YM_BNET
 
@@ -147,6 +152,11 @@ using nsBnet::BnNode;
 using nsBnet::BnNodeMap;
 using nsBnet::BnNodeList;
 using nsBnet::BnModifier;
+using nsBnet::BnCec;
+using nsBnet::BnGlobalBdd;
+using nsBnet::BnNodeEnc;
+using nsBnet::BnScoap;
+using nsBnet::BnWindowExtractor;
 
 END_NAMESPACE_YM
 
@@ -0,0 +1,279 @@
+#ifndef BNET2AIG_H
+#define BNET2AIG_H
+
+/// @file Bnet2Aig.h
+/// @brief Bnet2Aig のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "ym/aig_nsdef.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM_AIG
+
+class ModelImpl;
+class AigWriter;
+
+END_NAMESPACE_YM_AIG
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class Bnet2Aig Bnet2Aig.h "Bnet2Aig.h"
+/// @brief BnNetwork から AIG を作るクラス
+///
+/// - 同じファンインを持つ AND ノードは構造ハッシュで共有する．
+/// - 定数や x & x, x & ~x などの自明な AND は作らない．
+/// - 多入力の AND/XOR は段数の小さいものから組み合わせて
+///   段数が最小になるように分解する．
+///
+/// make_comb() を用いると組み合わせ回路部分のみを AIG に変換する．
+/// この場合はセル型のノードも葉として扱う．
+//////////////////////////////////////////////////////////////////////
+class Bnet2Aig
+{
+public:
+
+  /// @brief コンストラクタ
+  Bnet2Aig() = default;
+
+  /// @brief デストラクタ
+  ~Bnet2Aig() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief BnNetwork の内容を変換する．
+  /// @return 変換できない場合は false を返す．
+  ///
+  /// 変換できない場合には model の内容は変更されない．
+  bool
+  conv(
+    const BnNetwork& src_network, ///< [in] 変換元のネットワーク
+    nsAig::ModelImpl& model       ///< [out] 結果を格納するオブジェクト
+  );
+
+  /// @brief BnNetwork の内容を変換して直接出力する．
+  /// @return 変換できない場合は false を返す．
+  ///
+  /// ModelImpl を経由せずに AND ノードのリストから直接出力する．
+  /// シンボル名は出力時に src_network から取り出す．
+  /// 変換できない場合にはなにも出力しない．
+  bool
+  write(
+    const BnNetwork& src_network, ///< [in] 変換元のネットワーク
+    nsAig::AigWriter& s,          ///< [in] 出力器
+    const string& comment,        ///< [in] 追加のコメント
+    bool ascii                    ///< [in] aag 形式の時 true
+  );
+
+  /// @brief BnNetwork の組み合わせ回路部分を AIG に変換する．
+  /// @return 変換できない場合は false を返す．
+  ///
+  /// - 入力ノード(外部入力と DFF の出力)とセル型の論理ノードを葉とする．
+  ///   入力ノードには input_list() の順に 1 から変数番号をつける．
+  ///   セル型の論理ノードの変数番号はファンインの AND ノードよりも大きくなる．
+  /// - 真理値表型と BDD 型の論理ノードを持つ時は変換できない．
+  /// - 結果は node_num(), is_leaf(), and_src1(), and_src2(), level() で
+  ///   取り出す．
+  bool
+  make_comb(
+    const BnNetwork& src_network, ///< [in] 変換元のネットワーク
+    vector<SizeType>& lit_map     ///< [out] ノード番号をキーにしてリテラルを格納する配列
+  );
+
+  /// @brief AIG のノード数を返す．
+  ///
+  /// 変数番号 0 の定数ノードを含む．
+  SizeType
+  node_num() const
+  {
+    return mBaseId + mAndList.size() + 1;
+  }
+
+  /// @brief 葉のノードの時 true を返す．
+  bool
+  is_leaf(
+    SizeType var ///< [in] 変数番号 ( 1 <= var < node_num() )
+  ) const
+  {
+    // 葉は段数が 0 となる．
+    return level(var * 2) == 0;
+  }
+
+  /// @brief AND ノードのソース1のリテラルを返す．
+  SizeType
+  and_src1(
+    SizeType var ///< [in] 変数番号 ( is_leaf(var) == false )
+  ) const
+  {
+    return mAndList[var - mBaseId - 1].mSrc1;
+  }
+
+  /// @brief AND ノードのソース2のリテラルを返す．
+  SizeType
+  and_src2(
+    SizeType var ///< [in] 変数番号 ( is_leaf(var) == false )
+  ) const
+  {
+    return mAndList[var - mBaseId - 1].mSrc2;
+  }
+
+  /// @brief リテラルの段数を返す．
+  ///
+  /// 定数と葉は 0 段とする．
+  SizeType
+  level(
+    SizeType lit ///< [in] リテラル
+  ) const
+  {
+    SizeType var = lit / 2;
+    if ( var <= mBaseId ) {
+      return 0;
+    }
+    return mAndList[var - mBaseId - 1].mLevel;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief BnNetwork の内容を AND ノードのリストに変換する．
+  /// @return 変換できない場合は false を返す．
+  bool
+  make_aig(
+    const BnNetwork& src_network, ///< [in] 変換元のネットワーク
+    vector<SizeType>& lit_map     ///< [out] ノード番号をキーにしてリテラルを格納する配列
+  );
+
+  /// @brief 論理ノードを AND ノードのリストに変換する．
+  ///
+  /// 葉となる入力ノードは lit_map に登録されていなければならない．
+  /// セル型のノードは葉として AND ノードのリストに加える．
+  void
+  make_logic(
+    const BnNetwork& src_network, ///< [in] 変換元のネットワーク
+    vector<SizeType>& lit_map     ///< [inout] ノード番号をキーにしてリテラルを格納する配列
+  );
+
+  /// @brief 2入力の AND ノードを作る．
+  /// @return 結果のリテラルを返す．
+  SizeType
+  make_and(
+    SizeType src1, ///< [in] ソース1のリテラル
+    SizeType src2  ///< [in] ソース2のリテラル
+  );
+
+  /// @brief 2入力の XOR を作る．
+  /// @return 結果のリテラルを返す．
+  SizeType
+  make_xor(
+    SizeType src1, ///< [in] ソース1のリテラル
+    SizeType src2  ///< [in] ソース2のリテラル
+  );
+
+  /// @brief AND ゲートをAIGに変換する．
+  /// @return 結果のリテラルを返す．
+  SizeType
+  make_and(
+    const vector<SizeType>& fanin_lits ///< [in] ファンインのリテラル
+  );
+
+  /// @brief OR ゲートをAIGに変換する．
+  /// @return 結果のリテラルを返す．
+  SizeType
+  make_or(
+    const vector<SizeType>& fanin_lits ///< [in] ファンインのリテラル
+  );
+
+  /// @brief XOR ゲートをAIGに変換する．
+  /// @return 結果のリテラルを返す．
+  SizeType
+  make_xor(
+    const vector<SizeType>& fanin_lits ///< [in] ファンインのリテラル
+  );
+
+  /// @brief Expr を AIG に変換する．
+  /// @return 結果のリテラルを返す．
+  SizeType
+  make_expr(
+    const Expr& expr,                  ///< [in] 論理式
+    const vector<SizeType>& fanin_lits ///< [in] ファンインのリテラル
+  );
+
+  /// @brief BnNode に対応する AIG を作る．
+  /// @return 根のリテラルを返す．
+  SizeType
+  make_bnnode(
+    const BnNode& node,                ///< [in] ノード
+    const BnNetwork& network,          ///< [in] ネットワーク
+    const vector<SizeType>& fanin_lits ///< [in] ファンインのリテラルのリスト
+  );
+
+  /// @brief 段数が最小になるように2入力の木で分解する．
+  /// @return 結果のリテラルを返す．
+  ///
+  /// lit_list は空であってはならない．
+  SizeType
+  make_tree(
+    const vector<SizeType>& lit_list, ///< [in] 入力のリテラルのリスト
+    bool is_xor                       ///< [in] XOR の時 true
+  );
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ANDノードの情報
+  // make_comb() で葉としたセル型のノードは段数 0 のノードとして加える．
+  struct AndInfo
+  {
+    SizeType mSrc1;  // ソース1リテラル
+    SizeType mSrc2;  // ソース2リテラル
+    SizeType mLevel; // 段数
+  };
+
+  // 構造ハッシュ用のハッシュ関数
+  struct AndKeyHash
+  {
+    SizeType
+    operator()(
+      const pair<SizeType, SizeType>& key
+    ) const
+    {
+      return key.first * 1048573 + key.second;
+    }
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力数 + ラッチ数
+  // make_comb() の場合は入力ノード数
+  SizeType mBaseId{0};
+
+  // ANDノードのリスト
+  vector<AndInfo> mAndList;
+
+  // ファンインのリテラル対をキーにして AND のリテラルを格納する構造ハッシュ
+  unordered_map<pair<SizeType, SizeType>, SizeType, AndKeyHash> mAndHash;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // BNET2AIG_H
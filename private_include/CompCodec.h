@@ -0,0 +1,220 @@
+#ifndef COMPCODEC_H
+#define COMPCODEC_H
+
+/// @file CompCodec.h
+/// @brief 圧縮/展開器のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @brief 圧縮形式
+//////////////////////////////////////////////////////////////////////
+enum class CompType {
+  None, ///< 非圧縮
+  Gzip, ///< gzip
+  Zstd  ///< zstd
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class Decoder CompCodec.h "CompCodec.h"
+/// @brief 圧縮されたデータを展開するクラス
+///
+/// 入力を任意の大きさに区切って decode() に渡すことができる．
+/// gzip の場合は複数のメンバを連結したものも扱う．
+///
+/// gzip は zlib が，zstd は libzstd が見つかった場合のみ扱える．
+/// 扱えない形式を指定した場合は is_valid() が false となる．
+//////////////////////////////////////////////////////////////////////
+class Decoder
+{
+public:
+
+  /// @brief コンストラクタ
+  explicit
+  Decoder(
+    CompType type ///< [in] 圧縮形式
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  Decoder(
+    const Decoder& src
+  ) = delete;
+
+  /// @brief 代入演算子は禁止
+  Decoder&
+  operator=(
+    const Decoder& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~Decoder();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 先頭のマジックナンバーから圧縮形式を判定する．
+  static
+  CompType
+  detect(
+    const char* data, ///< [in] データの先頭
+    SizeType size     ///< [in] データのサイズ
+  );
+
+  /// @brief 圧縮形式が扱えるか調べる．
+  static
+  bool
+  is_supported(
+    CompType type ///< [in] 圧縮形式
+  );
+
+  /// @brief メモリ上の圧縮データ全体を展開する．
+  /// @return エラーが起きたら false を返す．
+  static
+  bool
+  decode_all(
+    CompType type,        ///< [in] 圧縮形式
+    std::string_view src, ///< [in] 圧縮データ
+    string& dst           ///< [out] 展開結果
+  );
+
+  /// @brief 展開器が使える時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mCtx != nullptr;
+  }
+
+  /// @brief データを展開する．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// 結果は dst の末尾に追加される．
+  bool
+  decode(
+    const char* data, ///< [in] 圧縮データ
+    SizeType size,    ///< [in] データのサイズ
+    string& dst       ///< [inout] 展開結果
+  );
+
+  /// @brief 入力が圧縮データの切れ目で終わっている時 true を返す．
+  ///
+  /// 途中で切れたファイルを検出するために用いる．
+  bool
+  is_complete() const
+  {
+    return !mPending;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 圧縮形式
+  CompType mType;
+
+  // ライブラリのコンテキスト
+  // (z_stream か ZSTD_DCtx)
+  void* mCtx{nullptr};
+
+  // 展開途中のデータが残っている時 true
+  bool mPending{false};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class Encoder CompCodec.h "CompCodec.h"
+/// @brief データを圧縮するクラス
+///
+/// 扱える形式は Decoder と同じ．
+//////////////////////////////////////////////////////////////////////
+class Encoder
+{
+public:
+
+  /// @brief コンストラクタ
+  explicit
+  Encoder(
+    CompType type ///< [in] 圧縮形式
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  Encoder(
+    const Encoder& src
+  ) = delete;
+
+  /// @brief 代入演算子は禁止
+  Encoder&
+  operator=(
+    const Encoder& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~Encoder();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファイル名の拡張子から圧縮形式を判定する．
+  ///
+  /// ".gz" なら gzip, ".zst" なら zstd となる．
+  static
+  CompType
+  type_from_filename(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief 圧縮器が使える時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mCtx != nullptr;
+  }
+
+  /// @brief データを圧縮する．
+  /// @return エラーが起きたら false を返す．
+  ///
+  /// 結果は dst の末尾に追加される．
+  /// last が true の場合は圧縮データの終端を出力する．
+  bool
+  encode(
+    const char* data, ///< [in] データ
+    SizeType size,    ///< [in] データのサイズ
+    bool last,        ///< [in] 最後のデータの時 true
+    string& dst       ///< [inout] 圧縮結果
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 圧縮形式
+  CompType mType;
+
+  // ライブラリのコンテキスト
+  // (z_stream か ZSTD_CCtx)
+  void* mCtx{nullptr};
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // COMPCODEC_H
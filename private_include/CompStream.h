@@ -0,0 +1,305 @@
+#ifndef COMPSTREAM_H
+#define COMPSTREAM_H
+
+/// @file CompStream.h
+/// @brief CompInStream, CompOutStream のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include "CompCodec.h"
+#include <streambuf>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class CompInBuf CompStream.h "CompStream.h"
+/// @brief 圧縮ファイルを透過的に読むための streambuf
+///
+/// ファイルの先頭のマジックナンバーで圧縮形式を判定する．
+/// 圧縮されている場合は別スレッドでファイルの読み込みと展開を行い，
+/// 展開済みのチャンクをキューを通して受け取る．
+/// キューの長さには上限があるので，展開が読み出しよりも
+/// 大きく先行することはない．
+/// 圧縮されていない場合はスレッドを用いずにそのまま読む．
+///
+/// 展開エラー，圧縮データの途中で切れたファイル，読み込みエラーの場合は
+/// そこまでの内容を返した後に underflow() が std::invalid_argument を
+/// 送出する．
+//////////////////////////////////////////////////////////////////////
+class CompInBuf :
+  public std::streambuf
+{
+public:
+
+  /// @brief コンストラクタ
+  CompInBuf(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief デストラクタ
+  ~CompInBuf();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み込み可能な時 true を返す．
+  ///
+  /// ファイルが開けなかった場合と，扱えない圧縮形式の場合に false となる．
+  bool
+  is_valid() const
+  {
+    return mFd >= 0;
+  }
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // std::streambuf の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 読み出し領域が空になった時に呼ばれる関数
+  int_type
+  underflow() override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 展開スレッドの本体
+  void
+  decode_loop(
+    CompType type ///< [in] 圧縮形式
+  );
+
+  /// @brief 展開済みのチャンクをキューに積む．
+  /// @return 中断が指示されていたら false を返す．
+  ///
+  /// キューが一杯の場合は空きができるまで待つ．
+  bool
+  push_chunk(
+    string& chunk ///< [inout] チャンク(呼び出し後は空になる)
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル記述子
+  int mFd{-1};
+
+  // マジックナンバーの判定のために先読みした内容
+  string mHead;
+
+  // 現在読み出し中のチャンク
+  string mChunk;
+
+  // 展開済みのチャンクのキュー
+  std::deque<string> mQueue;
+
+  // mQueue などを保護する mutex
+  std::mutex mMutex;
+
+  // mQueue の状態が変わったことを知らせる条件変数
+  std::condition_variable mCond;
+
+  // 展開スレッドが終了した時 true
+  bool mDone{false};
+
+  // 展開スレッドでエラーが起きた時 true
+  bool mError{false};
+
+  // 展開スレッドに中断を指示する時 true
+  bool mStop{false};
+
+  // 展開スレッド
+  std::thread mThread;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class CompInStream CompStream.h "CompStream.h"
+/// @brief CompInBuf を用いた入力ストリーム
+///
+/// ifstream の代わりに用いる．
+/// 開けなかった場合は failbit が立つ．
+/// 読み込み中のエラーでは badbit が立ち，CompInBuf の送出した例外が
+/// そのまま呼び出し側に伝わる．
+//////////////////////////////////////////////////////////////////////
+class CompInStream :
+  public istream
+{
+public:
+
+  /// @brief コンストラクタ
+  CompInStream(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief デストラクタ
+  ~CompInStream() = default;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // バッファ
+  CompInBuf mBuf;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class CompOutBuf CompStream.h "CompStream.h"
+/// @brief ファイル名の拡張子に応じて圧縮を行う streambuf
+///
+/// ".gz" なら gzip, ".zst" なら zstd で圧縮し，
+/// それ以外は非圧縮で出力する．
+//////////////////////////////////////////////////////////////////////
+class CompOutBuf :
+  public std::streambuf
+{
+public:
+
+  /// @brief コンストラクタ
+  CompOutBuf(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief デストラクタ
+  ///
+  /// close() が呼ばれていなければ close() を呼ぶ．
+  /// エラーの有無を知りたい場合は明示的に close() を呼ぶこと．
+  ~CompOutBuf();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 書き出し可能な時 true を返す．
+  ///
+  /// ファイルが開けなかった場合と，扱えない圧縮形式の場合に false となる．
+  bool
+  is_valid() const
+  {
+    return mFd >= 0;
+  }
+
+  /// @brief 残りの内容と圧縮データの終端を書き出してファイルを閉じる．
+  /// @return それまでの書き出しも含めてエラーが起きていたら false を返す．
+  bool
+  close();
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // std::streambuf の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 書き込み領域が一杯になった時に呼ばれる関数
+  int_type
+  overflow(
+    int_type c ///< [in] 書き込む文字
+  ) override;
+
+  /// @brief 内容を書き出す．
+  int
+  sync() override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief バッファの内容を(圧縮して)書き出す．
+  bool
+  write_buffer(
+    bool last ///< [in] 最後の書き出しの時 true
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ファイル記述子
+  int mFd{-1};
+
+  // 圧縮器
+  // 非圧縮の場合は nullptr
+  std::unique_ptr<Encoder> mEncoder;
+
+  // 書き込み用のバッファ
+  vector<char> mBuff;
+
+  // 圧縮結果を入れるバッファ
+  string mCompBuff;
+
+  // 書き出しでエラーが起きた時 true
+  bool mError{false};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class CompOutStream CompStream.h "CompStream.h"
+/// @brief CompOutBuf を用いた出力ストリーム
+///
+/// ofstream の代わりに用いる．
+/// 開けなかった場合は failbit が立つ．
+/// close() で書き出しに失敗していた場合は badbit が立つ．
+//////////////////////////////////////////////////////////////////////
+class CompOutStream :
+  public ostream
+{
+public:
+
+  /// @brief コンストラクタ
+  CompOutStream(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief デストラクタ
+  ~CompOutStream() = default;
+
+  /// @brief 残りの内容を書き出してファイルを閉じる．
+  ///
+  /// エラーが起きていたら badbit を立てる．
+  void
+  close();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // バッファ
+  CompOutBuf mBuf;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // COMPSTREAM_H
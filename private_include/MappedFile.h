@@ -0,0 +1,116 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+/// @file MappedFile.h
+/// @brief MappedFile のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class MappedFile MappedFile.h "MappedFile.h"
+/// @brief ファイルの内容全体をメモリ上に置くクラス
+///
+/// - 通常のファイルは mmap() でマップする．
+/// - mmap() が使えない場合(パイプなど)はファイル全体をバッファに読み込む．
+/// - gzip/zstd で圧縮されている場合は展開した内容をバッファに置く．
+///
+/// contents() の返すビューはこのオブジェクトが存在する間有効である．
+/// 各種の高速読み込み用の字句解析器とパーサーで共通に用いる．
+//////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// 何も読み込まない．is_valid() は false となる．
+  MappedFile() = default;
+
+  /// @brief ファイルを読み込むコンストラクタ
+  ///
+  /// ファイルが開けなかった場合，読み込みエラーが起きた場合，
+  /// 展開に失敗した場合は is_valid() が false となる．
+  explicit
+  MappedFile(
+    const string& filename ///< [in] ファイル名
+  );
+
+  /// @brief コピーコンストラクタは禁止
+  MappedFile(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief 代入演算子は禁止
+  MappedFile&
+  operator=(
+    const MappedFile& src
+  ) = delete;
+
+  /// @brief デストラクタ
+  ~MappedFile();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を読み込めた時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mValid;
+  }
+
+  /// @brief 内容全体を返す．
+  std::string_view
+  contents() const
+  {
+    return mContents;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief mmap() した領域を解放する．
+  void
+  unmap();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 読み込めた時 true
+  bool mValid{false};
+
+  // mmap() したアドレス
+  // mmap() を用いていない場合は nullptr
+  void* mMapAddr{nullptr};
+
+  // mmap() したサイズ
+  SizeType mMapSize{0};
+
+  // mmap() を用いない場合のバッファ
+  string mBuffer;
+
+  // 内容
+  std::string_view mContents;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,125 @@
+#ifndef NAMETABLE_H
+#define NAMETABLE_H
+
+/// @file NameTable.h
+/// @brief NameTable のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include <string_view>
+#include <memory>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+//////////////////////////////////////////////////////////////////////
+/// @class NameTable NameTable.h "NameTable.h"
+/// @brief 名前に識別子番号を割り当てるハッシュ表
+///
+/// 名前の文字列は大きなブロック(アリーナ)にまとめて格納し，
+/// 名前ごとのメモリ確保は行わない．
+/// ハッシュ表はオープンアドレス法で識別子番号のみを持つ．
+/// 識別子番号は登録順に 0 から割り当てられる．
+///
+/// iscas89 ファイルの読み込みと各種ライタの名前の管理に用いられる．
+//////////////////////////////////////////////////////////////////////
+class NameTable
+{
+public:
+
+  /// @brief コンストラクタ
+  NameTable();
+
+  /// @brief デストラクタ
+  ~NameTable() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 登録されている名前の数を返す．
+  SizeType
+  size() const
+  {
+    return mNameArray.size();
+  }
+
+  /// @brief 名前に対応する識別子番号を返す．
+  ///
+  /// 登録されていなければ新しく登録する．
+  SizeType
+  intern(
+    std::string_view name ///< [in] 名前
+  );
+
+  /// @brief 識別子番号から名前を返す．
+  std::string_view
+  name(
+    SizeType id ///< [in] 識別子番号 ( 0 <= id < size() )
+  ) const
+  {
+    ASSERT_COND( id < size() );
+    return mNameArray[id];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 名前をアリーナにコピーする．
+  std::string_view
+  copy_name(
+    std::string_view name ///< [in] 名前
+  );
+
+  /// @brief ハッシュ表を拡大する．
+  void
+  expand();
+
+  /// @brief ハッシュ値を求める．
+  static
+  SizeType
+  hash_func(
+    std::string_view name ///< [in] 名前
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // アリーナのブロックのリスト
+  vector<std::unique_ptr<char[]>> mBlockList;
+
+  // 現在のブロックの空き領域の先頭
+  char* mFreePtr{nullptr};
+
+  // 現在のブロックの空き領域のサイズ
+  SizeType mFreeSize{0};
+
+  // 識別子番号をキーにして名前を格納する配列
+  vector<std::string_view> mNameArray;
+
+  // 識別子番号をキーにしてハッシュ値を格納する配列
+  vector<SizeType> mHashArray;
+
+  // ハッシュ表
+  // 識別子番号 + 1 を格納する．0 は空きを表す．
+  vector<SizeType> mTable;
+
+  // ハッシュ表のサイズ - 1
+  SizeType mMask;
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // NAMETABLE_H
@@ -0,0 +1,158 @@
+#ifndef OUTBUFFER_H
+#define OUTBUFFER_H
+
+/// @file OutBuffer.h
+/// @brief OutBuffer のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/bnet.h"
+#include <string_view>
+
+
+BEGIN_NAMESPACE_YM_BNET
+
+class CompOutStream;
+
+//////////////////////////////////////////////////////////////////////
+/// @class OutBuffer OutBuffer.h "OutBuffer.h"
+/// @brief テキスト/バイナリ出力用のバッファ
+///
+/// 内容はいったん固定長のバッファに溜めて，バッファが一杯になった時と
+/// flush() が呼ばれた時(デストラクタを含む)にまとめて書き出す．
+/// 書き出し先はストリームかファイル記述子のいずれかとなる．
+/// ストリームへの書き出しは write() のみを用いるので，
+/// endl のように毎行フラッシュすることはない．
+///
+/// 書き出しのエラーは記録しておき，is_ok() で調べられるようにする．
+/// 一度エラーが起きると is_ok() はその後ずっと false を返す．
+///
+/// 各種ライタ(blif, iscas89, Verilog-HDL, aig)の共通の出力層として用いる．
+//////////////////////////////////////////////////////////////////////
+class OutBuffer
+{
+public:
+
+  /// @brief ストリームに書き出すコンストラクタ
+  OutBuffer(
+    ostream& s,                           ///< [in] 出力ストリーム
+    SizeType buff_size = kDefaultBuffSize ///< [in] バッファサイズ
+  );
+
+  /// @brief ファイル記述子に書き出すコンストラクタ
+  ///
+  /// fd のクローズは行わない．
+  OutBuffer(
+    int fd,                               ///< [in] ファイル記述子
+    SizeType buff_size = kDefaultBuffSize ///< [in] バッファサイズ
+  );
+
+  /// @brief ファイルに書き出すコンストラクタ
+  ///
+  /// ファイル名が ".gz" か ".zst" で終わる場合は CompOutStream を通して
+  /// 圧縮しながら書き出す．
+  /// ファイルがオープンできなかった場合は is_valid() が false となる．
+  OutBuffer(
+    const string& filename,               ///< [in] ファイル名
+    SizeType buff_size = kDefaultBuffSize ///< [in] バッファサイズ
+  );
+
+  /// @brief デストラクタ
+  ///
+  /// close() を呼ぶ．
+  ~OutBuffer();
+
+  /// @brief デフォルトのバッファサイズ
+  static const SizeType kDefaultBuffSize;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 書き出し先が有効な時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mStream != nullptr || mFd >= 0;
+  }
+
+  /// @brief これまでの書き出しでエラーが起きていない時 true を返す．
+  ///
+  /// close() の後に調べればファイルを閉じる際のエラーも含まれる．
+  bool
+  is_ok() const
+  {
+    return mOk;
+  }
+
+  /// @brief 1文字出力する．
+  void
+  put_char(
+    char c ///< [in] 文字
+  )
+  {
+    if ( mPos == mBuff.size() ) {
+      flush();
+    }
+    mBuff[mPos] = c;
+    ++ mPos;
+  }
+
+  /// @brief 文字列を出力する．
+  void
+  put_string(
+    std::string_view str ///< [in] 文字列
+  );
+
+  /// @brief 数値を10進数で出力する．
+  void
+  put_decimal(
+    SizeType num ///< [in] 数値
+  );
+
+  /// @brief バッファの内容を書き出す．
+  void
+  flush();
+
+  /// @brief 残っている内容を書き出して，自分で開いたファイルを閉じる．
+  ///
+  /// 呼び出し後は何も書き出さない．
+  void
+  close();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 出力ストリーム
+  ostream* mStream{nullptr};
+
+  // ファイル記述子
+  int mFd{-1};
+
+  // mFd を自分でオープンした時 true
+  bool mOwnFd{false};
+
+  // 圧縮を行う場合に自分で作った出力ストリーム
+  std::unique_ptr<CompOutStream> mCompStream;
+
+  // バッファ
+  vector<char> mBuff;
+
+  // バッファ中の次の書き込み位置
+  SizeType mPos{0};
+
+  // エラーが起きていない時 true
+  bool mOk{true};
+
+};
+
+END_NAMESPACE_YM_BNET
+
+#endif // OUTBUFFER_H
@@ -151,6 +151,108 @@ BnNetwork_write(
   Py_RETURN_NONE;
 }
 
+// 辞書に整数値を登録する．
+bool
+set_int_item(
+  PyObject* dict,
+  const char* key,
+  SizeType val
+)
+{
+  auto obj = PyLong_FromSize_t(val);
+  if ( obj == nullptr ) {
+    return false;
+  }
+  auto stat = PyDict_SetItemString(dict, key, obj);
+  Py_DECREF(obj);
+  return stat == 0;
+}
+
+// ヒストグラムをリストに変換して辞書に登録する．
+bool
+set_hist_item(
+  PyObject* dict,
+  const char* key,
+  const vector<SizeType>& hist
+)
+{
+  auto list_obj = PyList_New(hist.size());
+  if ( list_obj == nullptr ) {
+    return false;
+  }
+  for ( SizeType i = 0; i < hist.size(); ++ i ) {
+    // PyList_SET_ITEM は参照を奪う．
+    PyList_SET_ITEM(list_obj, i, PyLong_FromSize_t(hist[i]));
+  }
+  auto stat = PyDict_SetItemString(dict, key, list_obj);
+  Py_DECREF(list_obj);
+  return stat == 0;
+}
+
+// 名前をキーにした数の辞書を作って登録する．
+bool
+set_count_item(
+  PyObject* dict,
+  const char* key,
+  const char* const name_array[],
+  const SizeType* num_array,
+  SizeType n
+)
+{
+  auto sub_dict = PyDict_New();
+  if ( sub_dict == nullptr ) {
+    return false;
+  }
+  bool ok = true;
+  for ( SizeType i = 0; i < n && ok; ++ i ) {
+    ok = set_int_item(sub_dict, name_array[i], num_array[i]);
+  }
+  if ( ok ) {
+    ok = PyDict_SetItemString(dict, key, sub_dict) == 0;
+  }
+  Py_DECREF(sub_dict);
+  return ok;
+}
+
+PyObject*
+BnNetwork_stats(
+  PyObject* self,
+  PyObject* Py_UNUSED(args)
+)
+{
+  auto& network = PyBnNetwork::Get(self);
+  auto stats = network.stats();
+
+  auto dict = PyDict_New();
+  if ( dict == nullptr ) {
+    return nullptr;
+  }
+  bool ok =
+    set_int_item(dict, "port_num", stats.port_num) &&
+    set_int_item(dict, "dff_num", stats.dff_num) &&
+    set_int_item(dict, "input_num", stats.input_num) &&
+    set_int_item(dict, "primary_input_num", stats.primary_input_num) &&
+    set_int_item(dict, "output_num", stats.output_num) &&
+    set_int_item(dict, "primary_output_num", stats.primary_output_num) &&
+    set_int_item(dict, "logic_num", stats.logic_num) &&
+    set_int_item(dict, "depth", stats.depth) &&
+    set_int_item(dict, "expr_num", stats.expr_num) &&
+    set_int_item(dict, "func_num", stats.func_num) &&
+    set_count_item(dict, "node_type_num", BnNetworkStats::NODE_TYPE_NAME,
+		   stats.node_type_num, BnNetworkStats::NODE_TYPE_NUM) &&
+    set_count_item(dict, "prim_type_num", BnNetworkStats::PRIM_TYPE_NAME,
+		   stats.prim_type_num, BnNetworkStats::PRIM_TYPE_NUM) &&
+    set_count_item(dict, "dff_type_num", BnNetworkStats::DFF_TYPE_NAME,
+		   stats.dff_type_num, BnNetworkStats::DFF_TYPE_NUM) &&
+    set_hist_item(dict, "fanin_hist", stats.fanin_hist) &&
+    set_hist_item(dict, "fanout_hist", stats.fanout_hist);
+  if ( !ok ) {
+    Py_DECREF(dict);
+    return nullptr;
+  }
+  return dict;
+}
+
 // メソッド定義
 PyMethodDef BnNetwork_methods[] = {
   {"read_blif", reinterpret_cast<PyCFunction>(BnNetwork_read_blif),
@@ -162,6 +264,9 @@ PyMethodDef BnNetwork_methods[] = {
   {"write", reinterpret_cast<PyCFunction>(BnNetwork_write),
    METH_VARARGS | METH_KEYWORDS,
    PyDoc_STR("write contents")},
+  {"stats", BnNetwork_stats,
+   METH_NOARGS,
+   PyDoc_STR("return statistics as a dict")},
   {nullptr, nullptr, 0, nullptr}
 };
 
@@ -144,4 +144,32 @@ TEST(BlifCoverTest, test5)
   EXPECT_EQ( "O3N0N1N2", rep_str );
 }
 
+TEST(BlifCoverTest, tvfunc_test1)
+{
+  Literal lit0{0, false};
+  Literal lit1{1, false};
+  // x0 + x1
+  auto cov1 = BlifCover{2, {{lit0}, {lit1}}, '1'};
+  // (x0' x1')' : 表現は異なるが関数は等しい．
+  auto cov2 = BlifCover{2, {{~lit0, ~lit1}}, '0'};
+
+  ASSERT_TRUE( cov1.has_tvfunc() );
+  ASSERT_TRUE( cov2.has_tvfunc() );
+  EXPECT_EQ( cov1.expr().make_tv(2), cov1.tvfunc() );
+  EXPECT_EQ( cov1.tvfunc(), cov2.tvfunc() );
+}
+
+TEST(BlifCoverTest, tvfunc_test2)
+{
+  // 入力数が kMaxTvInputs を超える場合は真理値表を持たない．
+  SizeType ni = BlifCover::kMaxTvInputs + 1;
+  vector<Literal> cube;
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    cube.push_back(Literal{i, false});
+  }
+  auto cov = BlifCover{ni, {cube}, '1'};
+
+  EXPECT_FALSE( cov.has_tvfunc() );
+}
+
 END_NAMESPACE_YM
@@ -3,17 +3,18 @@
 /// @brief BnNodeEncTest の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2017, 2018 Yusuke Matsunaga
+/// Copyright (C) 2017, 2018, 2023 Yusuke Matsunaga
 /// All rights reserved.
 
 
 #include "gtest/gtest.h"
 #include "ym/BnNodeEnc.h"
 #include "ym/BnNetwork.h"
+#include "ym/BnModifier.h"
 #include "ym/BnNode.h"
 #include "ym/BnPort.h"
-#include "ym/Range.h"
 #include "ym/SatSolver.h"
+#include "ym/SatSolverType.h"
 
 
 BEGIN_NAMESPACE_YM
@@ -27,7 +28,7 @@ public:
   BnNodeEncTest();
 
   /// @brief デストラクタ
-  ~BnNodeEncTest();
+  ~BnNodeEncTest() = default;
 
 
 public:
@@ -35,62 +36,37 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 初期化を行う．
-  void
-  SetUp();
-
-  /// @brief 終了処理を行う．
-  void
-  TearDown();
-
   /// @brief 入力ノードを用意する．
-  /// @param[in] ni 入力数
   void
-  make_inputs(int ni);
-
-  /// @brief チェック対象のノードの変数を用意する．
-  /// @param[in] id ノード番号
-  void
-  make_node_variable(int id);
+  make_inputs(
+    SizeType ni ///< [in] 入力数
+  );
 
   /// @brief ノードの出力の論理関数が vals[] で示された真理値表と等しいか調べる．
-  /// @param[in] node_id 対象のノード番号
-  /// @param[in] vals 真理値表の値
-  void
-  check(int node_id,
-	const vector<int>& vals);
-
-  /// @brief ANDのチェックを行う．
   void
-  check_and(int ni);
+  check(
+    BnNode node,            ///< [in] 対象のノード
+    const vector<int>& vals ///< [in] 真理値表の値
+  );
 
-  /// @brief NANDのチェックを行う．
+  /// @brief プリミティブ型のチェックを行う．
   void
-  check_nand(int ni);
-
-  /// @brief ORのチェックを行う．
-  void
-  check_or(int ni);
-
-  /// @brief NORのチェックを行う．
-  void
-  check_nor(int ni);
-
-  /// @brief XORのチェックを行う．
-  void
-  check_xor(int ni);
-
-  /// @brief XNORのチェックを行う．
-  void
-  check_xnor(int ni);
+  check_prim(
+    PrimType prim_type, ///< [in] プリミティブ型
+    SizeType ni         ///< [in] 入力数
+  );
 
   /// @brief 論理式のチェックを行う．
   void
-  check_expr(const Expr& expr);
+  check_expr(
+    const Expr& expr ///< [in] 論理式
+  );
 
   /// @brief 真理値表のチェックを行う．
   void
-  check_tvfunc(const TvFunc& func);
+  check_tvfunc(
+    const TvFunc& func ///< [in] 真理値表
+  );
 
 
 public:
@@ -102,530 +78,306 @@ public:
   SatSolver mSolver;
 
   // ネットワーク
-  BnNetwork mNetwork;
-
-  // 変数の数
-  int mVarNum;
+  BnModifier mNetwork;
 
-  // 変数のマップ
-  vector<SatLiteral> mVarMap;
-
-  // エンコーダ
-  BnNodeEnc mEnc;
+  // 入力ノードのリスト
+  vector<BnNode> mInputList;
 
 };
 
 BnNodeEncTest::BnNodeEncTest() :
-  mSolver(GetParam()),
-  mVarNum(10),
-  mVarMap(mVarNum),
-  mEnc(mSolver, mNetwork, mVarMap)
-{
-}
-
-BnNodeEncTest::~BnNodeEncTest()
-{
-}
-
-// @brief 初期化を行う．
-void
-BnNodeEncTest::SetUp()
-{
-}
-
-// @brief 終了処理を行う．
-void
-BnNodeEncTest::TearDown()
+  mSolver{SatSolverType{GetParam()}}
 {
 }
 
 // @brief 入力ノードを用意する．
-// @param[in] ni 入力数
-void
-BnNodeEncTest::make_inputs(int ni)
-{
-  for ( int i: Range(ni) ) {
-    int port_id = mNetwork.new_input_port("");
-    auto& port = mNetwork.port(port_id);
-    int id = port.bit(0);
-    EXPECT_EQ( i, id );
-    SatLiteral var = mSolver.new_variable();
-    mVarMap[i] = var;
-  }
-}
-
-// @brief チェック対象のノードの変数を用意する．
-// @param[in] id ノード番号
-void
-BnNodeEncTest::make_node_variable(int id)
-{
-  SatLiteral var = mSolver.new_variable();
-  mVarMap[id] = var;
-}
-
-// @brief ノードの出力の論理関数が vals[] で示された真理値表と等しいか調べる．
-void
-BnNodeEncTest::check(int node_id,
-		     const vector<int>& vals)
-{
-  try {
-    auto& node = mNetwork.node(node_id);
-    int ni = node.fanin_num();
-    for ( int i: Range(ni) ) {
-      mNetwork.connect(i, node_id, i);
-    }
-
-    make_node_variable(node_id);
-
-    mEnc.make_cnf(node);
-
-    int np = 1 << ni;
-    EXPECT_EQ( np, vals.size() );
-    SatLiteral olit(mVarMap[ni]);
-    for ( int p: Range(np) ) {
-      for ( int b: {0, 1} ) {
-	vector<SatLiteral> assumptions;
-	for ( int i: Range(ni) ) {
-	  bool inv = (p & (1U << i)) ? false : true;
-	  assumptions.push_back(SatLiteral(mVarMap[i], inv));
-	}
-	if ( b ) {
-	  assumptions.push_back(olit);
-	}
-	else {
-	  assumptions.push_back(~olit);
-	}
-	SatBool3 stat = mSolver.solve(assumptions);
-	SatBool3 exp_stat = ( vals[p] == b ) ? SatBool3::True : SatBool3::False;
-	EXPECT_EQ( exp_stat, stat );
-      }
-    }
-  }
-  catch ( AssertError x ) {
-    cout << x << endl;
-  }
-}
-
-// @brief ANDのチェックを行う．
-void
-BnNodeEncTest::check_and(int ni)
-{
-  make_inputs(ni);
-
-  int oid = mNetwork.new_logic("", BnNodeType::And, ni);
-  ASSERT_COND( oid == ni );
-
-  //  2入力の例
-  // lit0  lit1
-  //  0     0     0
-  //  0     1     0
-  //  1     0     0
-  //  1     1     1
-
-  int np = 1 << ni;
-  vector<int> vals(np);
-  for ( int p: Range(np) ) {
-    if ( p < (1 << ni) - 1) {
-      vals[p] = 0;
-    }
-    else {
-      vals[p] = 1;
-    }
-  }
-
-  check(oid, vals);
-}
-
-// @brief NANDのチェックを行う．
-void
-BnNodeEncTest::check_nand(int ni)
-{
-  make_inputs(ni);
-
-  int oid = mNetwork.new_logic("", BnNodeType::Nand, ni);
-  ASSERT_COND( oid == ni );
-
-  //  2入力の例
-  // lit0  lit1
-  //  0     0     1
-  //  0     1     1
-  //  1     0     1
-  //  1     1     0
-  int np = 1 << ni;
-  vector<int> vals(np);
-  for ( int p: Range(np) ) {
-    if ( p < (1 << ni) - 1 ) {
-      vals[p] = 1;
-    }
-    else {
-      vals[p] = 0;
-    }
-  }
-
-  check(oid, vals);
-}
-
-// @brief ORのチェックを行う．
 void
-BnNodeEncTest::check_or(int ni)
+BnNodeEncTest::make_inputs(
+  SizeType ni
+)
 {
-  make_inputs(ni);
-
-  int oid = mNetwork.new_logic("", BnNodeType::Or, ni);
-  ASSERT_COND( oid == ni );
-
-  //  2入力の例
-  // lit0  lit1
-  //  0     0     0
-  //  0     1     1
-  //  1     0     1
-  //  1     1     1
-
-  int np = 1 << ni;
-  vector<int> vals(np);
-  for ( int p: Range(np) ) {
-    if ( p == 0 ) {
-      vals[p] = 0;
-    }
-    else {
-      vals[p] = 1;
-    }
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    auto port = mNetwork.new_input_port(string{});
+    mInputList.push_back(port.bit(0));
   }
-
-  check(oid, vals);
 }
 
-// @brief NORのチェックを行う．
+// @brief ノードの出力の論理関数が vals[] で示された真理値表と等しいか調べる．
 void
-BnNodeEncTest::check_nor(int ni)
-{
-  make_inputs(ni);
-
-  int oid = mNetwork.new_logic("", BnNodeType::Nor, ni);
-  ASSERT_COND( oid == ni );
-
-  //  2入力の例
-  // lit0  lit1
-  //  0     0     1
-  //  0     1     0
-  //  1     0     0
-  //  1     1     0
-
-  int np = 1 << ni;
-  vector<int> vals(np);
-  for ( int p: Range(np) ) {
-    if ( p == 0 ) {
-      vals[p] = 1;
-    }
-    else {
-      vals[p] = 0;
+BnNodeEncTest::check(
+  BnNode node,
+  const vector<int>& vals
+)
+{
+  BnNodeEnc enc{mSolver, mNetwork};
+  auto olit = enc.make_cnf(node);
+
+  SizeType ni = mInputList.size();
+  vector<SatLiteral> ilit_array(ni);
+  for ( SizeType i = 0; i < ni; ++ i ) {
+    // 関数に現れない入力は符号化されないので変数を割り当てておく．
+    auto id = mInputList[i].id();
+    if ( !enc.is_encoded(id) ) {
+      enc.set_lit(id, mSolver.new_variable(true));
     }
+    ilit_array[i] = enc.lit(id);
   }
 
-  check(oid, vals);
-}
-
-// @brief NORのチェックを行う．
-void
-BnNodeEncTest::check_xor(int ni)
-{
-  make_inputs(ni);
-
-  int oid = mNetwork.new_logic("", BnNodeType::Xor, ni);
-  ASSERT_COND( oid == ni );
-
-  //  2入力の例
-  // lit0  lit1
-  //  0     0     0
-  //  0     1     1
-  //  1     0     1
-  //  1     1     0
-
-  int np = 1 << ni;
-  vector<int> vals(np);
-  for ( int p: Range(np) ) {
-    int c = 0;
-    for ( int i: Range(ni) ) {
-      if ( p & (1 << i) ) {
-	++ c;
+  SizeType np = 1 << ni;
+  EXPECT_EQ( np, vals.size() );
+  for ( SizeType p = 0; p < np; ++ p ) {
+    for ( int b: {0, 1} ) {
+      vector<SatLiteral> assumptions;
+      for ( SizeType i = 0; i < ni; ++ i ) {
+	auto ilit = ilit_array[i];
+	assumptions.push_back(p & (1U << i) ? ilit : ~ilit);
       }
+      assumptions.push_back(b ? olit : ~olit);
+      auto stat = mSolver.solve(assumptions);
+      auto exp_stat = ( vals[p] == b ) ? SatBool3::True : SatBool3::False;
+      EXPECT_EQ( exp_stat, stat );
     }
-    vals[p] = ((c % 2) == 1);
   }
-
-  check(oid, vals);
 }
 
-// @brief NORのチェックを行う．
+// @brief プリミティブ型のチェックを行う．
 void
-BnNodeEncTest::check_xnor(int ni)
+BnNodeEncTest::check_prim(
+  PrimType prim_type,
+  SizeType ni
+)
 {
   make_inputs(ni);
+  auto node = mNetwork.new_logic_primitive(string{}, prim_type, mInputList);
 
-  int oid = mNetwork.new_logic("", BnNodeType::Xnor, ni);
-  ASSERT_COND( oid == ni );
-
-  //  2入力の例
-  // lit0  lit1
-  //  0     0     1
-  //  0     1     0
-  //  1     0     0
-  //  1     1     1
-
-  int np = 1 << ni;
+  SizeType np = 1 << ni;
   vector<int> vals(np);
-  for ( int p: Range(np) ) {
-    int c = 0;
-    for ( int i: Range(ni) ) {
+  for ( SizeType p = 0; p < np; ++ p ) {
+    SizeType c = 0;
+    for ( SizeType i = 0; i < ni; ++ i ) {
       if ( p & (1 << i) ) {
 	++ c;
       }
     }
-    vals[p] = ((c % 2) == 0);
+    int v = 0;
+    switch ( prim_type ) {
+    case PrimType::And:  v = (c == ni); break;
+    case PrimType::Nand: v = (c != ni); break;
+    case PrimType::Or:   v = (c != 0); break;
+    case PrimType::Nor:  v = (c == 0); break;
+    case PrimType::Xor:  v = (c % 2 == 1); break;
+    case PrimType::Xnor: v = (c % 2 == 0); break;
+    default: ASSERT_NOT_REACHED; break;
+    }
+    vals[p] = v;
   }
 
-  check(oid, vals);
+  check(node, vals);
 }
 
 // @brief 論理式のチェックを行う．
 void
-BnNodeEncTest::check_expr(const Expr& expr)
+BnNodeEncTest::check_expr(
+  const Expr& expr
+)
 {
-  int ni = expr.input_size();
+  SizeType ni = expr.input_size();
   make_inputs(ni);
+  auto node = mNetwork.new_logic_expr(string{}, expr, mInputList);
 
-  int id = mNetwork.new_logic("", expr);
-  for ( int i: Range(ni) ) {
-    mNetwork.connect(i, id, i);
-  }
-
-  make_node_variable(id);
-
-  auto& node = mNetwork.node(id);
-
-  mEnc.make_cnf(node);
-
-  int np = 1 << ni;
+  auto func = expr.make_tv(ni);
+  SizeType np = 1 << ni;
   vector<int> vals(np);
-  for ( int p: Range(np) ) {
-    vector<Expr::BitVectType> ipat(ni);
-    for ( int i: Range(ni) ) {
-      if ( p & (1 << i) ) {
-	ipat[i] = 1;
-      }
-      else {
-	ipat[i] = 0;
-      }
-    }
-    Expr::BitVectType opat = expr.eval(ipat, 1UL);
-    if ( opat ) {
-      vals[p] = 1;
-    }
-    else {
-      vals[p] = 0;
-    }
+  for ( SizeType p = 0; p < np; ++ p ) {
+    vals[p] = func.value(p);
   }
 
-  check(id, vals);
+  check(node, vals);
 }
 
 // @brief 真理値表のチェックを行う．
 void
-BnNodeEncTest::check_tvfunc(const TvFunc& func)
+BnNodeEncTest::check_tvfunc(
+  const TvFunc& func
+)
 {
-  int ni = func.input_num();
+  SizeType ni = func.input_num();
   make_inputs(ni);
+  auto node = mNetwork.new_logic_tv(string{}, func, mInputList);
 
-  int id = mNetwork.new_logic("", func);
-  for ( int i: Range(ni) ) {
-    mNetwork.connect(i, id, i);
-  }
-
-  make_node_variable(id);
-
-  auto& node = mNetwork.node(id);
-
-  mEnc.make_cnf(node);
-
-  int np = 1 << ni;
+  SizeType np = 1 << ni;
   vector<int> vals(np);
-  for ( int p: Range(np) ) {
+  for ( SizeType p = 0; p < np; ++ p ) {
     vals[p] = func.value(p);
   }
 
-  check(id, vals);
+  check(node, vals);
 }
 
 TEST_P(BnNodeEncTest, zero)
 {
-  int id = mNetwork.new_logic("", BnNodeType::C0, 0);
-  ASSERT_COND( id == 0 );
+  auto node = mNetwork.new_c0(string{});
 
   //  0
   vector<int> vals({ 0 });
 
-  check(id, vals);
+  check(node, vals);
 }
 
 TEST_P(BnNodeEncTest, one)
 {
-  int id = mNetwork.new_logic("", BnNodeType::C1, 0);
-  ASSERT_COND( id == 0 );
+  auto node = mNetwork.new_c1(string{});
 
   //  1
   vector<int> vals({ 1 });
 
-  check(id, vals);
+  check(node, vals);
 }
 
 TEST_P(BnNodeEncTest, buff)
 {
   make_inputs(1);
-
-  int oid = mNetwork.new_logic("", BnNodeType::Buff, 1);
-  ASSERT_COND( oid == 1 );
+  auto node = mNetwork.new_logic_primitive(string{}, PrimType::Buff, mInputList);
 
   // lit0
   //  0    0
   //  1    1
   vector<int> vals({ 0, 1 });
 
-  check(oid, vals);
+  check(node, vals);
 }
 
 TEST_P(BnNodeEncTest, not)
 {
   make_inputs(1);
-
-  int oid = mNetwork.new_logic("", BnNodeType::Not, 1);
-  ASSERT_COND( oid == 1 );
+  auto node = mNetwork.new_not(string{}, mInputList[0]);
 
   // lit0
   //  0     1
   //  1     0
   vector<int> vals({ 1, 0 });
 
-  check(oid, vals);
+  check(node, vals);
 }
 
 TEST_P(BnNodeEncTest, and2)
 {
-  check_and(2);
+  check_prim(PrimType::And, 2);
 }
 
 TEST_P(BnNodeEncTest, and3)
 {
-  check_and(3);
+  check_prim(PrimType::And, 3);
 }
 
 TEST_P(BnNodeEncTest, and4)
 {
-  check_and(4);
+  check_prim(PrimType::And, 4);
 }
 
 TEST_P(BnNodeEncTest, and5)
 {
-  check_and(5);
+  check_prim(PrimType::And, 5);
 }
 
 TEST_P(BnNodeEncTest, nand2)
 {
-  check_nand(2);
+  check_prim(PrimType::Nand, 2);
 }
 
 TEST_P(BnNodeEncTest, nand3)
 {
-  check_nand(3);
+  check_prim(PrimType::Nand, 3);
 }
 
 TEST_P(BnNodeEncTest, nand4)
 {
-  check_nand(4);
+  check_prim(PrimType::Nand, 4);
 }
 
 TEST_P(BnNodeEncTest, nand5)
 {
-  check_nand(5);
+  check_prim(PrimType::Nand, 5);
 }
 
 TEST_P(BnNodeEncTest, or2)
 {
-  check_or(2);
+  check_prim(PrimType::Or, 2);
 }
 
 TEST_P(BnNodeEncTest, or3)
 {
-  check_or(3);
+  check_prim(PrimType::Or, 3);
 }
 
 TEST_P(BnNodeEncTest, or4)
 {
-  check_or(4);
+  check_prim(PrimType::Or, 4);
 }
 
 TEST_P(BnNodeEncTest, or5)
 {
-  check_or(5);
+  check_prim(PrimType::Or, 5);
 }
 
 TEST_P(BnNodeEncTest, nor2)
 {
-  check_nor(2);
+  check_prim(PrimType::Nor, 2);
 }
 
 TEST_P(BnNodeEncTest, nor3)
 {
-  check_nor(3);
+  check_prim(PrimType::Nor, 3);
 }
 
 TEST_P(BnNodeEncTest, nor4)
 {
-  check_nor(4);
+  check_prim(PrimType::Nor, 4);
 }
 
 TEST_P(BnNodeEncTest, nor5)
 {
-  check_nor(5);
+  check_prim(PrimType::Nor, 5);
 }
 
 TEST_P(BnNodeEncTest, xor2)
 {
-  check_xor(2);
+  check_prim(PrimType::Xor, 2);
 }
 
 TEST_P(BnNodeEncTest, xor3)
 {
-  check_xor(3);
+  check_prim(PrimType::Xor, 3);
 }
 
 TEST_P(BnNodeEncTest, xor4)
 {
-  check_xor(4);
+  check_prim(PrimType::Xor, 4);
 }
 
 TEST_P(BnNodeEncTest, xor5)
 {
-  check_xor(5);
+  check_prim(PrimType::Xor, 5);
 }
 
 TEST_P(BnNodeEncTest, xnor2)
 {
-  check_xnor(2);
+  check_prim(PrimType::Xnor, 2);
 }
 
 TEST_P(BnNodeEncTest, xnor3)
 {
-  check_xnor(3);
+  check_prim(PrimType::Xnor, 3);
 }
 
 TEST_P(BnNodeEncTest, xnor4)
 {
-  check_xnor(4);
+  check_prim(PrimType::Xnor, 4);
 }
 
 TEST_P(BnNodeEncTest, xnor5)
 {
-  check_xnor(5);
+  check_prim(PrimType::Xnor, 5);
 }
 
 TEST_P(BnNodeEncTest, expr1)
@@ -668,14 +420,54 @@ TEST_P(BnNodeEncTest, tvfunc2)
   check_tvfunc(func);
 }
 
-#if 0
-INSTANTIATE_TEST_CASE_P(SatSolverTest,
-			BnNodeEncTest,
-			::testing::Values("glueminisat2", "minisat2", "ymsat2" ));
-#endif
+TEST_P(BnNodeEncTest, incremental)
+{
+  make_inputs(3);
+  auto and1 = mNetwork.new_and(string{}, {mInputList[0], mInputList[1]});
+  auto or1 = mNetwork.new_or(string{}, {and1, mInputList[2]});
+  auto xor1 = mNetwork.new_xor(string{}, {and1, mInputList[2]});
+
+  BnNodeEnc enc{mSolver, mNetwork};
+  auto lit1 = enc.make_cnf(or1);
+  EXPECT_TRUE( enc.is_encoded(and1.id()) );
+  EXPECT_FALSE( enc.is_encoded(xor1.id()) );
+  EXPECT_EQ( SatBool3::True, mSolver.solve({lit1}) );
+
+  // and1 の CNF 式は作り直されない．
+  auto and_lit = enc.lit(and1.id());
+  auto lit2 = enc.make_cnf(xor1);
+  EXPECT_EQ( and_lit, enc.lit(and1.id()) );
+  // or1 = 0 かつ xor1 = 1 にはならない．
+  EXPECT_EQ( SatBool3::False, mSolver.solve({~lit1, lit2}) );
+  EXPECT_EQ( SatBool3::True, mSolver.solve({lit1, ~lit2}) );
+
+  EXPECT_THROW( enc.set_lit(and1.id(), lit1), std::invalid_argument );
+}
+
+TEST_P(BnNodeEncTest, shared_inputs)
+{
+  make_inputs(2);
+  // 同じ関数を別の形で作る．
+  auto and1 = mNetwork.new_and(string{}, mInputList);
+  auto not1 = mNetwork.new_not(string{}, mInputList[0]);
+  auto not2 = mNetwork.new_not(string{}, mInputList[1]);
+  auto nor1 = mNetwork.new_nor(string{}, {not1, not2});
+
+  BnNodeEnc enc1{mSolver, mNetwork};
+  BnNodeEnc enc2{mSolver, mNetwork};
+  for ( auto node: mInputList ) {
+    auto lit = mSolver.new_variable(true);
+    enc1.set_lit(node.id(), lit);
+    enc2.set_lit(node.id(), lit);
+  }
+  auto lit1 = enc1.make_cnf(and1);
+  auto lit2 = enc2.make_cnf(nor1);
+  EXPECT_EQ( SatBool3::False, mSolver.solve({lit1, ~lit2}) );
+  EXPECT_EQ( SatBool3::False, mSolver.solve({~lit1, lit2}) );
+}
 
 INSTANTIATE_TEST_CASE_P(SatSolverTest,
 			BnNodeEncTest,
-			::testing::Values( "ymsat2", "ymsat2" ));
+			::testing::Values("ymsat2", "minisat2"));
 
 END_NAMESPACE_YM
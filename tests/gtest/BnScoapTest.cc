@@ -0,0 +1,226 @@
+
+/// @file BnScoapTest.cc
+/// @brief BnScoapTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnDff.h"
+#include "ym/BnNode.h"
+#include "ym/BnModifier.h"
+#include "ym/BnScoap.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(BnScoapTest, and2)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+
+  auto output1 = port3.bit(0);
+  mod1.set_output_src(output1, and1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  BnScoap scoap{network1};
+  EXPECT_EQ( 1, scoap.cc0(input1) );
+  EXPECT_EQ( 1, scoap.cc1(input1) );
+  EXPECT_EQ( 2, scoap.cc0(and1) );
+  EXPECT_EQ( 3, scoap.cc1(and1) );
+  EXPECT_EQ( 0, scoap.co(output1) );
+  EXPECT_EQ( 0, scoap.co(and1) );
+  EXPECT_EQ( 2, scoap.co(input1) );
+  EXPECT_EQ( 2, scoap.co(input2) );
+  EXPECT_EQ( 0, scoap.sc0(and1) );
+  EXPECT_EQ( 0, scoap.so(input1) );
+}
+
+TEST(BnScoapTest, expr)
+{
+  // 論理式型のノードはプリミティブ型と同じ値になるはず
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2, input3});
+  // ~(x0 | x1) & x2
+  auto lit0 = Expr::make_posi_literal(0);
+  auto lit1 = Expr::make_posi_literal(1);
+  auto lit2 = Expr::make_posi_literal(2);
+  auto expr = ~(lit0 | lit1) & lit2;
+  auto expr1 = mod1.new_logic_expr(string{}, expr, {and1, input2, input3});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, expr1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  BnScoap scoap{network1};
+  EXPECT_EQ( 2, scoap.cc0(and1) );
+  EXPECT_EQ( 4, scoap.cc1(and1) );
+  // 1 にするには and1 = 0, input2 = 0, input3 = 1
+  EXPECT_EQ( 2 + 1 + 1 + 1, scoap.cc1(expr1) );
+  // 0 にするには input3 = 0 だけでよい．
+  EXPECT_EQ( 1 + 1, scoap.cc0(expr1) );
+  // and1 を観測するには input2 = 0, input3 = 1
+  EXPECT_EQ( 0 + 1 + 1 + 1, scoap.co(and1) );
+}
+
+TEST(BnScoapTest, dff)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("clock");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto clock = port2.bit(0);
+
+  auto dff = mod1.new_dff("dff1");
+  auto q = dff.data_out();
+  auto d = dff.data_in();
+  mod1.set_output_src(dff.clock(), clock);
+
+  auto and1 = mod1.new_and(string{}, {input1, q});
+  mod1.set_output_src(d, and1);
+
+  auto output1 = port3.bit(0);
+  mod1.set_output_src(output1, and1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  BnScoap scoap{network1};
+  EXPECT_EQ( 2, scoap.cc0(q) );
+  EXPECT_EQ( BnScoap::INF, scoap.cc1(q) );
+  EXPECT_EQ( 1, scoap.sc0(q) );
+  EXPECT_EQ( BnScoap::INF, scoap.sc1(q) );
+  EXPECT_EQ( 0, scoap.co(and1) );
+  // q を観測するには input1 = 1
+  EXPECT_EQ( 2, scoap.co(q) );
+  EXPECT_EQ( 2, scoap.co(d) );
+  EXPECT_EQ( 1, scoap.so(d) );
+}
+
+TEST(BnScoapTest, update)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto xor1 = mod1.new_xor(string{}, {and1, input3});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, xor1);
+
+  mod1.wrap_up();
+
+  BnScoap scoap{mod1};
+  EXPECT_EQ( 3, scoap.cc1(and1) );
+
+  mod1.change_primitive(and1, PrimType::Or, {input1, input2});
+  mod1.wrap_up();
+  scoap.update({and1});
+
+  BnScoap scoap2{mod1};
+  EXPECT_EQ( scoap2.cc0_array(), scoap.cc0_array() );
+  EXPECT_EQ( scoap2.cc1_array(), scoap.cc1_array() );
+  EXPECT_EQ( scoap2.co_array(), scoap.co_array() );
+  EXPECT_EQ( 2, scoap.cc1(and1) );
+  EXPECT_EQ( 3, scoap.cc0(and1) );
+}
+
+TEST(BnScoapTest, update_removed_fanin)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+
+  auto output1 = port3.bit(0);
+  mod1.set_output_src(output1, and1);
+
+  mod1.wrap_up();
+
+  BnScoap scoap{mod1};
+  EXPECT_EQ( 2, scoap.co(input2) );
+
+  // input2 はファンアウトを失うので観測できなくなる．
+  mod1.change_primitive(and1, PrimType::Buff, {input1});
+  mod1.wrap_up();
+  scoap.update({and1});
+
+  BnScoap scoap2{mod1};
+  EXPECT_EQ( scoap2.co_array(), scoap.co_array() );
+  EXPECT_EQ( BnScoap::INF, scoap.co(input2) );
+  EXPECT_EQ( 1, scoap.co(input1) );
+}
+
+TEST(BnScoapTest, shared_expr)
+{
+  // 同じ論理式番号を入力数の異なるノードで共有する場合
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_input_port("port4");
+  auto port5 = mod1.new_output_port("port5");
+  auto port6 = mod1.new_output_port("port6");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+  auto input4 = port4.bit(0);
+
+  // ~(x0 | x1) & x2
+  auto lit0 = Expr::make_posi_literal(0);
+  auto lit1 = Expr::make_posi_literal(1);
+  auto lit2 = Expr::make_posi_literal(2);
+  auto expr = ~(lit0 | lit1) & lit2;
+  auto expr1 = mod1.new_logic_expr(string{}, expr, {input1, input2, input3});
+  // 4番目の入力は論理式に現れない．
+  auto expr2 = mod1.new_logic_expr(string{}, expr1.expr_id(),
+				   {input1, input2, input3, input4});
+
+  mod1.set_output_src(port5.bit(0), expr1);
+  mod1.set_output_src(port6.bit(0), expr2);
+
+  BnNetwork network1{std::move(mod1)};
+
+  BnScoap scoap{network1};
+  EXPECT_EQ( scoap.cc0(expr1), scoap.cc0(expr2) );
+  EXPECT_EQ( scoap.cc1(expr1), scoap.cc1(expr2) );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,82 @@
+
+/// @file BnWindowExtractorTest.cc
+/// @brief BnWindowExtractorTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnModifier.h"
+#include "ym/BnWindowExtractor.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(BnWindowExtractorTest, test1)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto or1 = mod1.new_or(string{}, {and1, input3});
+  // and1 が再収斂する．
+  auto xor1 = mod1.new_xor(string{}, {and1, or1});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, xor1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  BnWindowExtractor extractor{network1, 1, 2};
+  {
+    // and1 の TFI は外部入力のみ，TFO は再収斂しない．
+    vector<BnNode> input_list;
+    vector<BnNode> output_list;
+    auto window = extractor.extract(and1, input_list, output_list);
+    EXPECT_EQ( 2, window.primary_input_list().size() );
+    EXPECT_EQ( 1, window.primary_output_list().size() );
+    EXPECT_EQ( 1, window.logic_num() );
+    ASSERT_EQ( 2, input_list.size() );
+    EXPECT_EQ( input1.id(), input_list[0].id() );
+    EXPECT_EQ( input2.id(), input_list[1].id() );
+    ASSERT_EQ( 1, output_list.size() );
+    EXPECT_EQ( and1.id(), output_list[0].id() );
+  }
+
+  vector<BnNode> input_list;
+  vector<BnNode> output_list;
+  auto window = extractor.extract(or1, input_list, output_list);
+  EXPECT_EQ( 3, window.primary_input_list().size() );
+  EXPECT_EQ( 1, window.primary_output_list().size() );
+  EXPECT_EQ( 3, window.logic_num() );
+  ASSERT_EQ( 3, input_list.size() );
+  ASSERT_EQ( 1, output_list.size() );
+  EXPECT_EQ( xor1.id(), output_list[0].id() );
+
+  // ウィンドウを元のネットワークに戻す．
+  BnModifier mod2{std::move(network1)};
+  auto new_output_list = mod2.import_subnetwork(window, input_list);
+  ASSERT_EQ( 1, new_output_list.size() );
+  mod2.substitute_fanout(output_list[0], new_output_list[0]);
+  BnNetwork network2{std::move(mod2)};
+
+  EXPECT_EQ( 6, network2.logic_num() );
+  auto new_xor1 = network2.output_node(0).output_src();
+  EXPECT_EQ( new_output_list[0].id(), new_xor1.id() );
+  EXPECT_EQ( BnNodeType::Prim, new_xor1.type() );
+  EXPECT_EQ( PrimType::Xor, new_xor1.primitive_type() );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,170 @@
+
+/// @file aig_conv_test.cc
+/// @brief BnNetwork から AIG への変換のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnDff.h"
+#include "ym/BnModifier.h"
+#include "ym/AigModel.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(AigConvTest, strash)
+{
+  BnModifier mod;
+  auto port_a = mod.new_input_port("a");
+  auto port_b = mod.new_input_port("b");
+  auto port_c = mod.new_input_port("c");
+  auto port_d = mod.new_input_port("d");
+  auto port_o1 = mod.new_output_port("o1");
+  auto port_o2 = mod.new_output_port("o2");
+  auto port_o3 = mod.new_output_port("o3");
+  auto port_o4 = mod.new_output_port("o4");
+
+  auto a = port_a.bit(0);
+  auto b = port_b.bit(0);
+  auto c = port_c.bit(0);
+  auto d = port_d.bit(0);
+
+  auto and1 = mod.new_and(string{}, {a, b});
+  // and1 と同じ構造
+  auto and2 = mod.new_and(string{}, {b, a});
+  // a & ~a は定数0になる．
+  auto not1 = mod.new_not(string{}, a);
+  auto and3 = mod.new_and(string{}, {a, not1});
+  // 段数の小さい c, d が先に組み合わされる．
+  auto and4 = mod.new_and(string{}, {and1, c, d});
+
+  mod.set_output_src(port_o1.bit(0), and1);
+  mod.set_output_src(port_o2.bit(0), and2);
+  mod.set_output_src(port_o3.bit(0), and3);
+  mod.set_output_src(port_o4.bit(0), and4);
+
+  BnNetwork network{std::move(mod)};
+
+  AigModel aig;
+  ASSERT_TRUE( aig.from_bnet(network) );
+
+  EXPECT_EQ( 4, aig.I() );
+  EXPECT_EQ( 0, aig.L() );
+  EXPECT_EQ( 4, aig.O() );
+  ASSERT_EQ( 3, aig.A() );
+  EXPECT_EQ( 7, aig.M() );
+
+  for ( SizeType i = 0; i < 4; ++ i ) {
+    EXPECT_EQ( (i + 1) * 2, aig.input(i) );
+  }
+
+  EXPECT_EQ( 10, aig.and_node(0) );
+  EXPECT_EQ(  4, aig.and_src1(0) );
+  EXPECT_EQ(  2, aig.and_src2(0) );
+  EXPECT_EQ( 12, aig.and_node(1) );
+  EXPECT_EQ(  8, aig.and_src1(1) );
+  EXPECT_EQ(  6, aig.and_src2(1) );
+  EXPECT_EQ( 14, aig.and_node(2) );
+  EXPECT_EQ( 12, aig.and_src1(2) );
+  EXPECT_EQ( 10, aig.and_src2(2) );
+
+  EXPECT_EQ( 10, aig.output_src(0) );
+  EXPECT_EQ( 10, aig.output_src(1) );
+  EXPECT_EQ(  0, aig.output_src(2) );
+  EXPECT_EQ( 14, aig.output_src(3) );
+
+  ostringstream s;
+  aig.write_aag(s);
+  istringstream s2{s.str()};
+  AigModel aig2;
+  ASSERT_TRUE( aig2.read_aag(s2) );
+  EXPECT_EQ( aig.A(), aig2.A() );
+  EXPECT_EQ( aig.output_src(3), aig2.output_src(3) );
+}
+
+TEST(AigConvTest, xor)
+{
+  BnModifier mod;
+  auto port_a = mod.new_input_port("a");
+  auto port_b = mod.new_input_port("b");
+  auto port_o1 = mod.new_output_port("o1");
+  auto port_o2 = mod.new_output_port("o2");
+
+  auto a = port_a.bit(0);
+  auto b = port_b.bit(0);
+
+  auto xor1 = mod.new_xor(string{}, {a, b});
+  // 入力の極性は出力にまとめられるので xor1 と共有される．
+  auto not1 = mod.new_not(string{}, a);
+  auto xor2 = mod.new_xor(string{}, {not1, b});
+
+  mod.set_output_src(port_o1.bit(0), xor1);
+  mod.set_output_src(port_o2.bit(0), xor2);
+
+  BnNetwork network{std::move(mod)};
+
+  AigModel aig;
+  ASSERT_TRUE( aig.from_bnet(network) );
+
+  EXPECT_EQ( 3, aig.A() );
+  EXPECT_EQ( aig.output_src(0), aig.output_src(1) ^ 1 );
+}
+
+TEST(AigConvTest, write_direct)
+{
+  BnModifier mod;
+  auto port_a = mod.new_input_port("a");
+  auto port_b = mod.new_input_port("b");
+  auto port_c = mod.new_input_port("c");
+  auto port_clk = mod.new_input_port("clk");
+  auto port_o1 = mod.new_output_port("o1");
+  auto port_o2 = mod.new_output_port("o2");
+
+  auto a = port_a.bit(0);
+  auto b = port_b.bit(0);
+  auto c = port_c.bit(0);
+
+  auto dff = mod.new_dff("q");
+  mod.set_output_src(dff.clock(), port_clk.bit(0));
+  auto q = dff.data_out();
+  auto and1 = mod.new_and(string{}, {a, b, q});
+  auto or1 = mod.new_or(string{}, {and1, c});
+  auto xor1 = mod.new_xor(string{}, {or1, a});
+
+  mod.set_output_src(dff.data_in(), xor1);
+  mod.set_output_src(port_o1.bit(0), and1);
+  mod.set_output_src(port_o2.bit(0), or1);
+
+  BnNetwork network{std::move(mod)};
+
+  AigModel aig;
+  ASSERT_TRUE( aig.from_bnet(network) );
+
+  // AigModel を経由しない出力は AigModel からの出力と一致する．
+  ostringstream ref_aig;
+  aig.write_aig(ref_aig, "comment\n");
+  ostringstream s_aig;
+  network.write_aig(s_aig, "comment\n");
+  EXPECT_EQ( ref_aig.str(), s_aig.str() );
+
+  ostringstream ref_aag;
+  aig.write_aag(ref_aag);
+  ostringstream s_aag;
+  network.write_aag(s_aag);
+  EXPECT_EQ( ref_aag.str(), s_aag.str() );
+
+  istringstream s2{s_aig.str()};
+  AigModel aig2;
+  ASSERT_TRUE( aig2.read_aig(s2) );
+  EXPECT_EQ( aig.A(), aig2.A() );
+  EXPECT_EQ( aig.latch_src(0), aig2.latch_src(0) );
+  EXPECT_EQ( "q", aig2.latch_symbol(0) );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,115 @@
+
+/// @file balanced_decomp_test.cc
+/// @brief balanced_decomp_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnNetworkStats.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/Expr.h"
+#include "ym/BnModifier.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(BalancedDecompTest, wide_and)
+{
+  BnModifier mod1;
+  vector<BnNode> input_list;
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    ostringstream buf;
+    buf << "i" << i;
+    auto port = mod1.new_input_port(buf.str());
+    input_list.push_back(port.bit(0));
+  }
+  auto port_o = mod1.new_output_port("o");
+  auto and1 = mod1.new_nand(string{}, input_list);
+  mod1.set_output_src(port_o.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.balanced_decomp(2);
+  EXPECT_EQ( 7, network2.logic_num() );
+  for ( auto node: network2.logic_list() ) {
+    EXPECT_EQ( BnNodeType::Prim, node.type() );
+    EXPECT_EQ( 2, node.fanin_num() );
+  }
+  EXPECT_EQ( 3, network2.stats().depth );
+  EXPECT_EQ( PrimType::Nand, network2.output_node(0).output_src().primitive_type() );
+
+  auto network3 = network1.balanced_decomp(3);
+  // 8入力を3入力以下で分解すると4ノード，2段になる．
+  EXPECT_EQ( 4, network3.logic_num() );
+  EXPECT_EQ( 2, network3.stats().depth );
+  for ( auto node: network3.logic_list() ) {
+    EXPECT_GE( 3, node.fanin_num() );
+  }
+
+  EXPECT_THROW( network1.balanced_decomp(1), std::invalid_argument );
+}
+
+TEST(BalancedDecompTest, arrival)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_input_port("port4");
+  auto port5 = mod1.new_output_port("port5");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+  auto input4 = port4.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  // and1 が遅いので input3 と input4 を先に組み合わせる．
+  auto and2 = mod1.new_and(string{}, {and1, input3, input4});
+  mod1.set_output_src(port5.bit(0), and2);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.balanced_decomp(2);
+  EXPECT_EQ( 3, network2.logic_num() );
+  EXPECT_EQ( 2, network2.stats().depth );
+}
+
+TEST(BalancedDecompTest, shared_inverter)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+  auto port5 = mod1.new_output_port("port5");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto lit0 = Expr::make_posi_literal(0);
+  auto lit1 = Expr::make_posi_literal(1);
+  auto expr = ~lit0 & lit1;
+  // 同じ ~input1 を使う2つのノード
+  auto node1 = mod1.new_logic_expr({}, expr, {input1, input2});
+  auto node2 = mod1.new_logic_expr({}, expr, {input1, input3});
+  mod1.set_output_src(port4.bit(0), node1);
+  mod1.set_output_src(port5.bit(0), node2);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.balanced_decomp(2);
+  SizeType not_num = 0;
+  for ( auto node: network2.logic_list() ) {
+    EXPECT_EQ( BnNodeType::Prim, node.type() );
+    if ( node.primitive_type() == PrimType::Not ) {
+      ++ not_num;
+    }
+  }
+  EXPECT_EQ( 1, not_num );
+  EXPECT_EQ( 3, network2.logic_num() );
+}
+
+END_NAMESPACE_YM
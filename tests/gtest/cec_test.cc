@@ -0,0 +1,169 @@
+
+/// @file cec_test.cc
+/// @brief cec_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnCec.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/Expr.h"
+#include "ym/BnModifier.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// (a & ~b) | (~b & c) を作る．
+BnNetwork
+make_network1()
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o");
+
+  auto lit0 = Expr::make_posi_literal(0);
+  auto lit1 = Expr::make_posi_literal(1);
+  auto lit2 = Expr::make_posi_literal(2);
+  auto expr = (lit0 & ~lit1) | (~lit1 & lit2);
+  auto node = mod1.new_logic_expr({}, expr,
+				   {port1.bit(0), port2.bit(0), port3.bit(0)});
+  mod1.set_output_src(port4.bit(0), node);
+  return BnNetwork{std::move(mod1)};
+}
+
+END_NONAMESPACE
+
+TEST(CecTest, simple_decomp)
+{
+  auto network1 = make_network1();
+  auto network2 = network1.simple_decomp();
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+  ASSERT_EQ( 1, cec.output_num() );
+  EXPECT_EQ( SatBool3::True, cec.output_status(0) );
+}
+
+TEST(CecTest, sat_only)
+{
+  auto network1 = make_network1();
+  auto network2 = network1.balanced_decomp(2);
+
+  // シミュレーションを行わずに SAT のみで証明する．
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check(0) );
+}
+
+TEST(CecTest, not_equiv)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o1");
+  auto port4 = mod1.new_output_port("o2");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  mod1.set_output_src(port3.bit(0), and1);
+  mod1.set_output_src(port4.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  BnModifier mod2;
+  auto port5 = mod2.new_input_port("a");
+  auto port6 = mod2.new_input_port("b");
+  auto port7 = mod2.new_output_port("o1");
+  auto port8 = mod2.new_output_port("o2");
+  auto and2 = mod2.new_and({}, {port5.bit(0), port6.bit(0)});
+  auto or2 = mod2.new_or({}, {port5.bit(0), port6.bit(0)});
+  mod2.set_output_src(port7.bit(0), and2);
+  mod2.set_output_src(port8.bit(0), or2);
+  BnNetwork network2{std::move(mod2)};
+
+  for ( SizeType sim_num: {0, 4} ) {
+    BnCec cec{network1, network2};
+    EXPECT_FALSE( cec.check(sim_num) );
+    ASSERT_EQ( 2, cec.output_num() );
+    EXPECT_EQ( SatBool3::True, cec.output_status(0) );
+    EXPECT_EQ( SatBool3::False, cec.output_status(1) );
+    // a & b と a | b が異なるのは a != b の時
+    auto& cex = cec.counterexample(1);
+    ASSERT_EQ( 2, cex.size() );
+    EXPECT_NE( cex[0], cex[1] );
+  }
+}
+
+TEST(CecTest, non_topological)
+{
+  // o = a & (a | b) を logic_list() がトポロジカル順でない形で作る．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {port1.bit(0), port2.bit(0)});
+  mod1.change_primitive(and1, PrimType::And, {port1.bit(0), or1});
+  mod1.set_output_src(port3.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  // o = a
+  BnModifier mod2;
+  auto port4 = mod2.new_input_port("a");
+  mod2.new_input_port("b");
+  auto port6 = mod2.new_output_port("o");
+  mod2.set_output_src(port6.bit(0), port4.bit(0));
+  BnNetwork network2{std::move(mod2)};
+
+  // シミュレーションで誤った反例が見つからないこと
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check(4) );
+}
+
+TEST(CecTest, match_by_name)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto not1 = mod1.new_not({}, port2.bit(0));
+  auto or1 = mod1.new_or({}, {and1, not1});
+  mod1.set_output_src(port3.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  // ポートの順番が異なる．
+  BnModifier mod2;
+  auto port5 = mod2.new_input_port("b");
+  auto port6 = mod2.new_input_port("a");
+  auto port7 = mod2.new_output_port("o");
+  auto not2 = mod2.new_not({}, port5.bit(0));
+  auto or2 = mod2.new_or({}, {port6.bit(0), not2});
+  mod2.set_output_src(port7.bit(0), or2);
+  BnNetwork network2{std::move(mod2)};
+
+  BnCec cec1{network1, network2, true};
+  EXPECT_TRUE( cec1.check() );
+
+  BnCec cec2{network1, network2, false};
+  EXPECT_FALSE( cec2.check() );
+}
+
+TEST(CecTest, mismatch)
+{
+  auto network1 = make_network1();
+
+  BnModifier mod2;
+  auto port1 = mod2.new_input_port("a");
+  auto port2 = mod2.new_output_port("o");
+  mod2.set_output_src(port2.bit(0), port1.bit(0));
+  BnNetwork network2{std::move(mod2)};
+
+  EXPECT_THROW( (BnCec{network1, network2}), std::invalid_argument );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,140 @@
+
+/// @file compress_test.cc
+/// @brief 圧縮ファイルの読み書きのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "ym/BnNetwork.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+// ファイルの内容を読み込む．
+string
+read_file(
+  const string& path
+)
+{
+  ifstream s{path};
+  string contents;
+  string buff;
+  while ( getline(s, buff) ) {
+    contents += buff + '\n';
+  }
+  return contents;
+}
+
+// write() の出力を文字列にする．
+string
+dump_str(
+  const BnNetwork& network
+)
+{
+  ostringstream s;
+  network.write(s);
+  return s.str();
+}
+
+END_NONAMESPACE
+
+TEST(CompressTest, read_iscas89_gz)
+{
+  string path = DATAPATH + string{"b10.bench.gz"};
+  auto network = BnNetwork::read_iscas89(path);
+
+  string ref_path = DATAPATH + string{"b10.bnet"};
+  EXPECT_EQ( read_file(ref_path), dump_str(network) );
+}
+
+TEST(CompressTest, read_blif_gz)
+{
+  string path = DATAPATH + string{"s5378.blif.gz"};
+  auto network1 = BnNetwork::read_blif(path);
+  auto network2 = BnNetwork::read_blif_direct(path);
+
+  string ref_path = DATAPATH + string{"s5378.bnet"};
+  EXPECT_EQ( read_file(ref_path), dump_str(network1) );
+
+  string path0 = DATAPATH + string{"s5378.blif"};
+  auto network0 = BnNetwork::read_blif_direct(path0);
+  EXPECT_EQ( dump_str(network0), dump_str(network2) );
+}
+
+TEST(CompressTest, write_gz)
+{
+  string path = DATAPATH + string{"b10.bench"};
+  auto network = BnNetwork::read_iscas89(path);
+
+  // 非圧縮で書き出したものと同じ結果になることを確かめる．
+  network.write_blif("compress_test.blif");
+  network.write_blif("compress_test.blif.gz");
+  auto network1 = BnNetwork::read_blif("compress_test.blif");
+  auto network2 = BnNetwork::read_blif("compress_test.blif.gz");
+  EXPECT_EQ( dump_str(network1), dump_str(network2) );
+
+  network.write_iscas89("compress_test.bench");
+  network.write_iscas89("compress_test.bench.gz");
+  auto network3 = BnNetwork::read_iscas89("compress_test.bench");
+  auto network4 = BnNetwork::read_iscas89("compress_test.bench.gz");
+  EXPECT_EQ( dump_str(network3), dump_str(network4) );
+
+  network.write_aig("compress_test.aig");
+  network.write_aig("compress_test.aig.gz");
+  auto network5 = BnNetwork::read_aig("compress_test.aig");
+  auto network6 = BnNetwork::read_aig("compress_test.aig.gz");
+  EXPECT_EQ( dump_str(network5), dump_str(network6) );
+
+  network.write_aag("compress_test.aag");
+  network.write_aag("compress_test.aag.gz");
+  auto network7 = BnNetwork::read_aag("compress_test.aag");
+  auto network8 = BnNetwork::read_aag("compress_test.aag.gz");
+  EXPECT_EQ( dump_str(network7), dump_str(network8) );
+}
+
+TEST(CompressTest, dump_restore_gz)
+{
+  string path = DATAPATH + string{"s5378.blif"};
+  auto network = BnNetwork::read_blif(path);
+
+  network.dump("compress_test.bin.gz");
+  auto network2 = BnNetwork::restore("compress_test.bin.gz");
+  EXPECT_EQ( dump_str(network), dump_str(network2) );
+}
+
+TEST(CompressTest, truncated_gz)
+{
+  // 末尾の CRC とサイズを削ったファイルを作る．
+  // 展開結果自体は揃っているが途中で切れたファイルとしてエラーになる．
+  string path = DATAPATH + string{"b10.bench.gz"};
+  ifstream s{path, std::ios::binary};
+  string contents{std::istreambuf_iterator<char>{s},
+		  std::istreambuf_iterator<char>{}};
+  ASSERT_LT( 8, contents.size() );
+  {
+    ofstream t{"compress_test_trunc.bench.gz", std::ios::binary};
+    t.write(contents.data(), contents.size() - 8);
+  }
+  EXPECT_THROW( BnNetwork::read_iscas89("compress_test_trunc.bench.gz"),
+		std::invalid_argument );
+}
+
+#if defined(__linux__)
+TEST(CompressTest, write_error)
+{
+  string path = DATAPATH + string{"b10.bench"};
+  auto network = BnNetwork::read_iscas89(path);
+
+  // /dev/full への書き込みは必ず失敗する．
+  EXPECT_THROW( network.dump("/dev/full"), std::invalid_argument );
+  EXPECT_THROW( network.write_blif("/dev/full"), std::invalid_argument );
+  EXPECT_THROW( network.write_aig("/dev/full"), std::invalid_argument );
+}
+#endif
+
+END_NAMESPACE_YM
@@ -0,0 +1,91 @@
+
+/// @file dominator_test.cc
+/// @brief dominator_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnModifier.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(DominatorTest, test1)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+  auto port5 = mod1.new_output_port("port5");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto not1 = mod1.new_not(string{}, input3);
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto or1 = mod1.new_or(string{}, {and1, not1});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, or1);
+  auto output2 = port5.bit(0);
+  mod1.set_output_src(output2, input2);
+
+  BnNetwork network1{std::move(mod1)};
+
+  auto dom_list = network1.dominator_list();
+  ASSERT_EQ( network1.node_num() + 1, dom_list.size() );
+  EXPECT_EQ( BNET_NULLID, dom_list[input1.id()] );
+  EXPECT_EQ( input3.id(), dom_list[not1.id()] );
+  EXPECT_EQ( BNET_NULLID, dom_list[and1.id()] );
+  EXPECT_EQ( BNET_NULLID, dom_list[or1.id()] );
+  EXPECT_EQ( or1.id(), dom_list[output1.id()] );
+  EXPECT_EQ( input2.id(), dom_list[output2.id()] );
+
+  auto pdom_list = network1.post_dominator_list();
+  ASSERT_EQ( network1.node_num() + 1, pdom_list.size() );
+  EXPECT_EQ( and1.id(), pdom_list[input1.id()] );
+  // input2 は2つの出力に到達する．
+  EXPECT_EQ( BNET_NULLID, pdom_list[input2.id()] );
+  EXPECT_EQ( not1.id(), pdom_list[input3.id()] );
+  EXPECT_EQ( or1.id(), pdom_list[not1.id()] );
+  EXPECT_EQ( or1.id(), pdom_list[and1.id()] );
+  EXPECT_EQ( output1.id(), pdom_list[or1.id()] );
+  EXPECT_EQ( BNET_NULLID, pdom_list[output1.id()] );
+}
+
+TEST(DominatorTest, reconvergence)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+
+  // input1 から xor1 までは and1 と or1 の2つの経路がある．
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto or1 = mod1.new_or(string{}, {input1, input2});
+  auto xor1 = mod1.new_xor(string{}, {and1, or1});
+
+  auto output1 = port3.bit(0);
+  mod1.set_output_src(output1, xor1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  auto pdom_list = network1.post_dominator_list();
+  EXPECT_EQ( xor1.id(), pdom_list[input1.id()] );
+  EXPECT_EQ( xor1.id(), pdom_list[input2.id()] );
+  EXPECT_EQ( xor1.id(), pdom_list[and1.id()] );
+  EXPECT_EQ( xor1.id(), pdom_list[or1.id()] );
+}
+
+END_NAMESPACE_YM
@@ -8,10 +8,192 @@
 
 #include "gtest/gtest.h"
 #include "ym/BnNetwork.h"
+#include "ym/BnDff.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnModifier.h"
+#include "ym/BnNetworkStats.h"
+#include "ym/Bdd.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
 
 
 BEGIN_NAMESPACE_YM
 
+BEGIN_NONAMESPACE
+
+// 以下は v1 形式しかなかった頃の BinIO::dump() をそのまま写したもの．
+// 古い形式のダンプファイルを読めることを確かめるために用いる．
+
+void
+dump_v1_dff(
+  BinEnc& s,
+  const BnDff& dff
+)
+{
+  s.write_string(dff.name());
+  switch ( dff.type() ) {
+  case BnDffType::None:  s.write_8(0); break;
+  case BnDffType::Dff:   s.write_8(1); break;
+  case BnDffType::Latch: s.write_8(2); break;
+  case BnDffType::Cell:  s.write_8(3); break;
+  }
+  if ( dff.is_dff() || dff.is_latch() ) {
+    s.write_vint(dff.data_in().id());
+    s.write_vint(dff.data_out().id());
+    s.write_vint(dff.clock().id());
+    s.write_vint(dff.clear().id());
+    s.write_vint(dff.preset().id());
+  }
+  else if ( dff.is_cell() ) {
+    s.write_vint(dff.cell().id());
+    SizeType ni = dff.cell_input_num();
+    s.write_vint(ni);
+    for ( SizeType i = 0; i < ni; ++ i ) {
+      s.write_vint(dff.cell_input(i).id());
+    }
+    SizeType no = dff.cell_output_num();
+    s.write_vint(no);
+    for ( SizeType i = 0; i < no; ++ i ) {
+      s.write_vint(dff.cell_output(i).id());
+    }
+  }
+}
+
+void
+dump_v1_logic(
+  BinEnc& s,
+  const BnNode& node,
+  const unordered_map<Bdd, SizeType>& bdd_map
+)
+{
+  s.write_vint(node.id());
+  s.write_string(node.name());
+  SizeType nfi = node.fanin_num();
+  s.write_vint(nfi);
+  for ( auto fanin: node.fanin_list() ) {
+    s.write_vint(fanin.id());
+  }
+  switch ( node.type() ) {
+  case BnNodeType::Prim:
+    switch ( node.primitive_type() ) {
+    case PrimType::None: s.write_8(0); break;
+    case PrimType::C0:   s.write_8(1); break;
+    case PrimType::C1:   s.write_8(2); break;
+    case PrimType::Buff: s.write_8(3); break;
+    case PrimType::Not:  s.write_8(4); break;
+    case PrimType::And:  s.write_8(5); break;
+    case PrimType::Nand: s.write_8(6); break;
+    case PrimType::Or:   s.write_8(7); break;
+    case PrimType::Nor:  s.write_8(8); break;
+    case PrimType::Xor:  s.write_8(9); break;
+    case PrimType::Xnor: s.write_8(10); break;
+    }
+    break;
+  case BnNodeType::Expr:
+    s.write_8(11);
+    s.write_vint(node.expr_id());
+    break;
+  case BnNodeType::TvFunc:
+    s.write_8(12);
+    s.write_vint(node.func_id());
+    break;
+  case BnNodeType::Bdd:
+    s.write_8(13);
+    s.write_vint(bdd_map.at(node.bdd()));
+    break;
+  case BnNodeType::Cell:
+    s.write_8(14);
+    s.write_vint(node.cell().id());
+    break;
+  default:
+    s.write_8(0);
+    break;
+  }
+}
+
+void
+dump_v1(
+  BinEnc& s,
+  const BnNetwork& network
+)
+{
+  s.write_signature("ym_bnet1.0");
+  s.write_string(network.name());
+
+  SizeType ne = network.expr_num();
+  s.write_vint(ne);
+  for ( SizeType i = 0; i < ne; ++ i ) {
+    network.expr(i).dump(s);
+  }
+
+  SizeType nf = network.func_num();
+  s.write_vint(nf);
+  for ( SizeType i = 0; i < nf; ++ i ) {
+    network.func(i).dump(s);
+  }
+
+  unordered_map<Bdd, SizeType> bdd_map;
+  {
+    vector<Bdd> bdd_list;
+    for ( auto node: network.logic_list() ) {
+      if ( node.type() == BnNodeType::Bdd ) {
+	auto bdd = node.bdd();
+	if ( bdd_map.count(bdd) == 0 ) {
+	  bdd_map.emplace(bdd, bdd_list.size());
+	  bdd_list.push_back(bdd);
+	}
+      }
+    }
+    Bdd::dump(s, bdd_list);
+  }
+
+  s.write_vint(network.port_num());
+  for ( auto port: network.port_list() ) {
+    s.write_string(port.name());
+    SizeType nb = port.bit_width();
+    s.write_vint(nb);
+    for ( SizeType i = 0; i < nb; ++ i ) {
+      auto node = port.bit(i);
+      s.write_8(node.is_input() ? 0 : 1);
+      s.write_vint(node.id());
+    }
+  }
+
+  s.write_vint(network.dff_num());
+  for ( auto dff: network.dff_list() ) {
+    dump_v1_dff(s, dff);
+  }
+
+  s.write_vint(network.logic_num());
+  for ( auto node: network.logic_list() ) {
+    dump_v1_logic(s, node, bdd_map);
+  }
+
+  s.write_vint(network.output_num());
+  for ( auto node: network.output_list() ) {
+    s.write_vint(node.id());
+    s.write_vint(node.output_src().id());
+  }
+}
+
+// v1 形式でダンプしてから復元する．
+BnNetwork
+v1_roundtrip(
+  const BnNetwork& network
+)
+{
+  ostringstream obuf;
+  BinEnc enc{obuf};
+  dump_v1(enc, network);
+
+  istringstream ibuf{obuf.str()};
+  BinDec dec{ibuf};
+  return BnNetwork::restore(dec);
+}
+
+END_NONAMESPACE
+
 TEST(DumpRestoreTest, test1)
 {
   string filename = "s5378.blif";
@@ -37,4 +219,139 @@ TEST(DumpRestoreTest, test1)
   EXPECT_EQ( nd, network2.dff_num() );
 }
 
+TEST(DumpRestoreTest, test2)
+{
+  string filename = "b10.bench";
+  string path = DATAPATH + filename;
+  BnNetwork network = BnNetwork::read_iscas89(path);
+
+  ostringstream obuf;
+  BinEnc enc{obuf};
+  network.dump(enc);
+
+  istringstream ibuf{obuf.str()};
+  BinDec dec{ibuf};
+  BnNetwork network2 = BnNetwork::restore(dec);
+
+  EXPECT_EQ( network.dff_num(), network2.dff_num() );
+  for ( auto dff: network2.dff_list() ) {
+    EXPECT_EQ( BnDffType::Dff, dff.type() );
+  }
+
+  // 復元したものをもう一度ダンプ/リストアすると
+  // ノード番号を含めて同じ内容になる．
+  ostringstream obuf2;
+  BinEnc enc2{obuf2};
+  network2.dump(enc2);
+
+  istringstream ibuf2{obuf2.str()};
+  BinDec dec2{ibuf2};
+  BnNetwork network3 = BnNetwork::restore(dec2);
+
+  ostringstream s2;
+  network2.write(s2);
+  ostringstream s3;
+  network3.write(s3);
+  EXPECT_EQ( s2.str(), s3.str() );
+}
+
+TEST(DumpRestoreTest, non_topological)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {port1.bit(0), port2.bit(0)});
+  // logic_list() では and1 が後から作った or1 より前にある．
+  mod1.change_primitive(and1, PrimType::And, {port1.bit(0), or1});
+  mod1.set_output_src(port3.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  ostringstream obuf;
+  BinEnc enc{obuf};
+  network1.dump(enc);
+
+  istringstream ibuf{obuf.str()};
+  BinDec dec{ibuf};
+  BnNetwork network2 = BnNetwork::restore(dec);
+
+  EXPECT_EQ( 2, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  ASSERT_TRUE( src.is_logic() );
+  EXPECT_EQ( PrimType::And, src.primitive_type() );
+  ASSERT_EQ( 2, src.fanin_num() );
+  auto node1 = src.fanin(1);
+  ASSERT_TRUE( node1.is_logic() );
+  EXPECT_EQ( PrimType::Or, node1.primitive_type() );
+}
+
+TEST(DumpRestoreTest, restore_v1)
+{
+  string filename = "b10.bench";
+  string path = DATAPATH + filename;
+  BnNetwork network = BnNetwork::read_iscas89(path);
+
+  BnNetwork network2 = v1_roundtrip(network);
+
+  ASSERT_EQ( network.port_num(), network2.port_num() );
+  for ( SizeType i = 0; i < network.port_num(); ++ i ) {
+    auto port1 = network.port(i);
+    auto port2 = network2.port(i);
+    EXPECT_EQ( port1.name(), port2.name() );
+    ASSERT_EQ( port1.bit_width(), port2.bit_width() );
+    for ( SizeType b = 0; b < port1.bit_width(); ++ b ) {
+      EXPECT_EQ( port1.bit(b).is_input(), port2.bit(b).is_input() );
+    }
+  }
+
+  // v1 形式の DFF が Latch として復元されていないことを確かめる．
+  ASSERT_EQ( network.dff_num(), network2.dff_num() );
+  for ( auto dff: network2.dff_list() ) {
+    EXPECT_EQ( BnDffType::Dff, dff.type() );
+  }
+
+  EXPECT_EQ( network.input_num(), network2.input_num() );
+  EXPECT_EQ( network.output_num(), network2.output_num() );
+  EXPECT_EQ( network.logic_num(), network2.logic_num() );
+  auto stats1 = network.stats();
+  auto stats2 = network2.stats();
+  for ( SizeType i = 0; i < BnNetworkStats::NODE_TYPE_NUM; ++ i ) {
+    EXPECT_EQ( stats1.node_type_num[i], stats2.node_type_num[i] );
+  }
+  for ( SizeType i = 0; i < BnNetworkStats::PRIM_TYPE_NUM; ++ i ) {
+    EXPECT_EQ( stats1.prim_type_num[i], stats2.prim_type_num[i] );
+  }
+  EXPECT_EQ( stats1.fanin_hist, stats2.fanin_hist );
+  EXPECT_EQ( stats1.depth, stats2.depth );
+}
+
+TEST(DumpRestoreTest, restore_v1_latch)
+{
+  BnModifier mod;
+  auto port1 = mod.new_input_port("d");
+  auto port2 = mod.new_input_port("clock");
+  auto port3 = mod.new_output_port("q1");
+  auto port4 = mod.new_output_port("q2");
+
+  auto dff = mod.new_dff("dff1");
+  auto latch = mod.new_latch("latch1");
+  mod.set_output_src(dff.data_in(), port1.bit(0));
+  mod.set_output_src(dff.clock(), port2.bit(0));
+  mod.set_output_src(latch.data_in(), port1.bit(0));
+  mod.set_output_src(latch.clock(), port2.bit(0));
+  mod.set_output_src(port3.bit(0), dff.data_out());
+  mod.set_output_src(port4.bit(0), latch.data_out());
+
+  BnNetwork network{std::move(mod)};
+
+  BnNetwork network2 = v1_roundtrip(network);
+
+  EXPECT_EQ( 4, network2.port_num() );
+  ASSERT_EQ( 2, network2.dff_num() );
+  EXPECT_EQ( BnDffType::Dff, network2.dff(0).type() );
+  EXPECT_EQ( BnDffType::Latch, network2.dff(1).type() );
+  EXPECT_EQ( 0, network2.logic_num() );
+}
+
 END_NAMESPACE_YM
@@ -0,0 +1,120 @@
+
+/// @file eliminate_test.cc
+/// @brief eliminate_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnCec.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnModifier.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(EliminateTest, single_fanout)
+{
+  // a & b を (a & b) | c に併合する．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {and1, port3.bit(0)});
+  mod1.set_output_src(port4.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType eliminated_num;
+  auto network2 = network1.eliminate(8, 32, 0, eliminated_num);
+  EXPECT_EQ( 1, eliminated_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(EliminateTest, fanin_limit)
+{
+  // 併合すると3入力になるので併合しない．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {and1, port3.bit(0)});
+  mod1.set_output_src(port4.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType eliminated_num;
+  auto network2 = network1.eliminate(2, 32, 0, eliminated_num);
+  EXPECT_EQ( 0, eliminated_num );
+  EXPECT_EQ( 2, network2.logic_num() );
+}
+
+TEST(EliminateTest, value_limit)
+{
+  // a & b & c を2つのファンアウトに併合すると
+  // リテラル数が (4 + 4) - (2 + 2) - 3 = 1 増える．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_input_port("d");
+  auto port5 = mod1.new_input_port("e");
+  auto port6 = mod1.new_output_port("o1");
+  auto port7 = mod1.new_output_port("o2");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0), port3.bit(0)});
+  auto or1 = mod1.new_or({}, {and1, port4.bit(0)});
+  auto or2 = mod1.new_or({}, {and1, port5.bit(0)});
+  mod1.set_output_src(port6.bit(0), or1);
+  mod1.set_output_src(port7.bit(0), or2);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType eliminated_num;
+  auto network2 = network1.eliminate(8, 32, 0, eliminated_num);
+  EXPECT_EQ( 0, eliminated_num );
+  EXPECT_EQ( 3, network2.logic_num() );
+
+  auto network3 = network1.eliminate(8, 32, 1, eliminated_num);
+  EXPECT_EQ( 1, eliminated_num );
+  EXPECT_EQ( 2, network3.logic_num() );
+
+  BnCec cec{network1, network3};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(EliminateTest, tv_func)
+{
+  // 真理値表型のノードは併合後も真理値表型となる．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o");
+  auto xor1 = mod1.new_xor({}, {port1.bit(0), port2.bit(0)});
+  auto expr = Expr::make_posi_literal(0) | Expr::make_posi_literal(1);
+  auto tv = expr.make_tv(2);
+  auto node2 = mod1.new_logic_tv({}, tv, {xor1, port3.bit(0)});
+  mod1.set_output_src(port4.bit(0), node2);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType eliminated_num;
+  auto network2 = network1.eliminate(8, 32, 0, eliminated_num);
+  EXPECT_EQ( 1, eliminated_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto node = network2.output_node(0).output_src();
+  EXPECT_EQ( BnNodeType::TvFunc, node.type() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+END_NAMESPACE_YM
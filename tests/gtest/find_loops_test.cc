@@ -0,0 +1,109 @@
+
+/// @file find_loops_test.cc
+/// @brief find_loops_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnNodeList.h"
+#include "ym/BnModifier.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(FindLoopsTest, no_loop)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto xor1 = mod1.new_xor(string{}, {and1, input3});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, xor1);
+
+  mod1.wrap_up(true);
+  BnNetwork network1{std::move(mod1)};
+
+  auto loop_list = network1.find_loops();
+  EXPECT_TRUE( loop_list.empty() );
+}
+
+TEST(FindLoopsTest, loop2)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto xor1 = mod1.new_xor(string{}, {and1, input3});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, xor1);
+
+  // and1 -> xor1 -> and1 のループを作る．
+  mod1.change_primitive(and1, PrimType::And, {input1, xor1});
+
+  BnNetwork network1{std::move(mod1)};
+
+  auto loop_list = network1.find_loops();
+  ASSERT_EQ( 1, loop_list.size() );
+  auto& loop = loop_list[0];
+  ASSERT_EQ( 2, loop.size() );
+  bool has_and1 = false;
+  bool has_xor1 = false;
+  for ( auto node: loop ) {
+    if ( node.id() == and1.id() ) {
+      has_and1 = true;
+    }
+    if ( node.id() == xor1.id() ) {
+      has_xor1 = true;
+    }
+  }
+  EXPECT_TRUE( has_and1 );
+  EXPECT_TRUE( has_xor1 );
+}
+
+TEST(FindLoopsTest, self_loop)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_output_port("port2");
+
+  auto input1 = port1.bit(0);
+
+  auto or1 = mod1.new_or(string{}, {input1, input1});
+  mod1.change_primitive(or1, PrimType::Or, {input1, or1});
+
+  auto output1 = port2.bit(0);
+  mod1.set_output_src(output1, or1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  auto loop_list = network1.find_loops();
+  ASSERT_EQ( 1, loop_list.size() );
+  auto& loop = loop_list[0];
+  ASSERT_EQ( 1, loop.size() );
+  EXPECT_EQ( or1.id(), loop[0].id() );
+}
+
+END_NAMESPACE_YM
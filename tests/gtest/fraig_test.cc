@@ -0,0 +1,148 @@
+
+/// @file fraig_test.cc
+/// @brief fraig_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnCec.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/Expr.h"
+#include "ym/BnModifier.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(FraigTest, dup_and)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o1");
+  auto port4 = mod1.new_output_port("o2");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto and2 = mod1.new_and({}, {port2.bit(0), port1.bit(0)});
+  mod1.set_output_src(port3.bit(0), and1);
+  mod1.set_output_src(port4.bit(0), and2);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType merged_num;
+  auto network2 = network1.fraig(16, 1000, merged_num);
+  EXPECT_EQ( 1, merged_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto src1 = network2.output_node(0).output_src();
+  auto src2 = network2.output_node(1).output_src();
+  EXPECT_EQ( src1.id(), src2.id() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(FraigTest, complement)
+{
+  // a & b と ~a | ~b は逆相
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o1");
+  auto port5 = mod1.new_output_port("o2");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto expr = ~Expr::make_posi_literal(0) | ~Expr::make_posi_literal(1);
+  auto node2 = mod1.new_logic_expr({}, expr, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {and1, port3.bit(0)});
+  auto or2 = mod1.new_or({}, {node2, port3.bit(0)});
+  mod1.set_output_src(port4.bit(0), or1);
+  mod1.set_output_src(port5.bit(0), or2);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType merged_num;
+  auto network2 = network1.fraig(16, 1000, merged_num);
+  EXPECT_EQ( 1, merged_num );
+  EXPECT_EQ( 3, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(FraigTest, xor)
+{
+  // (a & ~b) | (~a & b) と a ^ b
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o1");
+  auto port4 = mod1.new_output_port("o2");
+  auto lit0 = Expr::make_posi_literal(0);
+  auto lit1 = Expr::make_posi_literal(1);
+  auto expr = (lit0 & ~lit1) | (~lit0 & lit1);
+  auto node1 = mod1.new_logic_expr({}, expr, {port1.bit(0), port2.bit(0)});
+  auto xor1 = mod1.new_xor({}, {port1.bit(0), port2.bit(0)});
+  mod1.set_output_src(port3.bit(0), node1);
+  mod1.set_output_src(port4.bit(0), xor1);
+  BnNetwork network1{std::move(mod1)};
+
+  // コンフリクト数の制限なし
+  SizeType merged_num;
+  auto network2 = network1.fraig(16, 0, merged_num);
+  EXPECT_EQ( 1, merged_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(FraigTest, not_equiv)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o1");
+  auto port4 = mod1.new_output_port("o2");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {port1.bit(0), port2.bit(0)});
+  mod1.set_output_src(port3.bit(0), and1);
+  mod1.set_output_src(port4.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  for ( SizeType sim_num: {0, 4} ) {
+    SizeType merged_num;
+    auto network2 = network1.fraig(sim_num, 1000, merged_num);
+    EXPECT_EQ( 0, merged_num );
+    EXPECT_EQ( 2, network2.logic_num() );
+
+    BnCec cec{network1, network2};
+    EXPECT_TRUE( cec.check() );
+  }
+}
+
+TEST(FraigTest, const_node)
+{
+  // (a & b) & ~a は定数0
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o1");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto expr = Expr::make_posi_literal(0) & ~Expr::make_posi_literal(1);
+  auto node2 = mod1.new_logic_expr({}, expr, {and1, port1.bit(0)});
+  mod1.set_output_src(port3.bit(0), node2);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType merged_num;
+  auto network2 = network1.fraig(16, 1000, merged_num);
+  EXPECT_EQ( 1, merged_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  EXPECT_EQ( BnNodeType::Prim, src.type() );
+  EXPECT_EQ( PrimType::C0, src.primitive_type() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,96 @@
+
+/// @file global_bdd_test.cc
+/// @brief global_bdd_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnGlobalBdd.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnModifier.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/Bdd.h"
+#include "ym/Expr.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(GlobalBddTest, equiv)
+{
+  // a & b と ~(~a | ~b) は等価
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o1");
+  auto port4 = mod1.new_output_port("o2");
+  auto port5 = mod1.new_output_port("o3");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto expr = ~(~Expr::make_posi_literal(0) | ~Expr::make_posi_literal(1));
+  auto node2 = mod1.new_logic_expr({}, expr, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {port1.bit(0), port2.bit(0)});
+  mod1.set_output_src(port3.bit(0), and1);
+  mod1.set_output_src(port4.bit(0), node2);
+  mod1.set_output_src(port5.bit(0), or1);
+  BnNetwork network{std::move(mod1)};
+
+  BnGlobalBdd gbdd{network};
+  EXPECT_EQ( 3, gbdd.output_num() );
+  EXPECT_EQ( 0, gbdd.build_all() );
+  auto bdd1 = gbdd.output_bdd(0);
+  auto bdd2 = gbdd.output_bdd(1);
+  auto bdd3 = gbdd.output_bdd(2);
+  EXPECT_FALSE( bdd1.is_invalid() );
+  EXPECT_EQ( bdd1, bdd2 );
+  EXPECT_NE( bdd1, bdd3 );
+}
+
+TEST(GlobalBddTest, var_order)
+{
+  // 出力から深さ優先でたどった順に変数番号がつく．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o1");
+  auto and1 = mod1.new_and({}, {port3.bit(0), port1.bit(0)});
+  mod1.set_output_src(port4.bit(0), and1);
+  BnNetwork network{std::move(mod1)};
+
+  BnGlobalBdd gbdd{network, 0, false};
+  EXPECT_EQ( 3, gbdd.input_num() );
+  EXPECT_EQ( 1, gbdd.input_var(0) );
+  EXPECT_EQ( 2, gbdd.input_var(1) );
+  EXPECT_EQ( 0, gbdd.input_var(2) );
+  for ( SizeType pos = 0; pos < gbdd.input_num(); ++ pos ) {
+    auto id = network.input_id(pos);
+    EXPECT_EQ( id, gbdd.var_input(gbdd.input_var(pos)) );
+  }
+}
+
+TEST(GlobalBddTest, abort)
+{
+  // 8入力の XOR は節点数の上限 3 を超える．
+  BnModifier mod1;
+  vector<BnNode> input_list;
+  for ( SizeType i = 0; i < 8; ++ i ) {
+    auto port = mod1.new_input_port("i" + std::to_string(i));
+    input_list.push_back(port.bit(0));
+  }
+  auto port1 = mod1.new_output_port("o1");
+  auto port2 = mod1.new_output_port("o2");
+  auto xor1 = mod1.new_xor({}, input_list);
+  mod1.set_output_src(port1.bit(0), xor1);
+  mod1.set_output_src(port2.bit(0), input_list[0]);
+  BnNetwork network{std::move(mod1)};
+
+  BnGlobalBdd gbdd{network, 3};
+  EXPECT_EQ( 1, gbdd.build_all() );
+  EXPECT_TRUE( gbdd.is_aborted(0) );
+  EXPECT_TRUE( gbdd.output_bdd(0).is_invalid() );
+  EXPECT_FALSE( gbdd.is_aborted(1) );
+}
+
+END_NAMESPACE_YM
@@ -0,0 +1,113 @@
+
+/// @file read_aig_test.cc
+/// @brief BnNetwork::read_aig() のテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+
+
+BEGIN_NAMESPACE_YM
+
+// prim_and.aig の内容
+// x = a & ~b
+// y = a | b  ( ~(~a & ~b) )
+// z = 1
+
+TEST(ReadAigTest, expr_and)
+{
+  string filename = "prim_and.aig";
+  string path = DATAPATH + filename;
+  auto network = BnNetwork::read_aig(path);
+  EXPECT_EQ( 2, network.input_num() );
+  EXPECT_EQ( 3, network.output_num() );
+  EXPECT_EQ( 5, network.port_num() );
+  ASSERT_EQ( 3, network.logic_num() );
+
+  auto a0 = network.logic(0);
+  EXPECT_EQ( "a0", a0.name() );
+  EXPECT_EQ( BnNodeType::Expr, a0.type() );
+  auto a1 = network.logic(1);
+  EXPECT_EQ( "a1", a1.name() );
+  EXPECT_EQ( BnNodeType::Expr, a1.type() );
+  auto c1 = network.logic(2);
+  EXPECT_EQ( BnNodeType::Prim, c1.type() );
+  EXPECT_EQ( PrimType::C1, c1.primitive_type() );
+
+  EXPECT_EQ( "x", network.port(2).name() );
+  EXPECT_EQ( a0, network.port(2).bit(0).output_src() );
+  EXPECT_EQ( a1, network.port(3).bit(0).output_src() );
+  EXPECT_EQ( c1, network.port(4).bit(0).output_src() );
+}
+
+TEST(ReadAigTest, prim_and)
+{
+  string filename = "prim_and.aig";
+  string path = DATAPATH + filename;
+  auto network = BnNetwork::read_aig(path, string{}, string{}, true);
+  EXPECT_EQ( 2, network.input_num() );
+  EXPECT_EQ( 3, network.output_num() );
+  EXPECT_EQ( 5, network.port_num() );
+  ASSERT_EQ( 4, network.logic_num() );
+
+  auto a = network.port(0).bit(0);
+  auto b = network.port(1).bit(0);
+
+  // ~b のインバータ
+  auto nb = network.logic(0);
+  EXPECT_EQ( BnNodeType::Prim, nb.type() );
+  EXPECT_EQ( PrimType::Not, nb.primitive_type() );
+  ASSERT_EQ( 1, nb.fanin_num() );
+  EXPECT_EQ( b, nb.fanin(0) );
+
+  // x = ~b & a
+  auto a0 = network.logic(1);
+  EXPECT_EQ( "a0", a0.name() );
+  EXPECT_EQ( BnNodeType::Prim, a0.type() );
+  EXPECT_EQ( PrimType::And, a0.primitive_type() );
+  ASSERT_EQ( 2, a0.fanin_num() );
+  EXPECT_EQ( nb, a0.fanin(0) );
+  EXPECT_EQ( a, a0.fanin(1) );
+
+  // y = b | a
+  // 出力の否定とファンインの否定は OR に吸収される．
+  auto a1 = network.logic(2);
+  EXPECT_EQ( "a1", a1.name() );
+  EXPECT_EQ( BnNodeType::Prim, a1.type() );
+  EXPECT_EQ( PrimType::Or, a1.primitive_type() );
+  ASSERT_EQ( 2, a1.fanin_num() );
+  EXPECT_EQ( b, a1.fanin(0) );
+  EXPECT_EQ( a, a1.fanin(1) );
+
+  auto c1 = network.logic(3);
+  EXPECT_EQ( BnNodeType::Prim, c1.type() );
+  EXPECT_EQ( PrimType::C1, c1.primitive_type() );
+
+  EXPECT_EQ( a0, network.port(2).bit(0).output_src() );
+  EXPECT_EQ( a1, network.port(3).bit(0).output_src() );
+  EXPECT_EQ( c1, network.port(4).bit(0).output_src() );
+}
+
+TEST(ReadAigTest, illegal_literal)
+{
+  // 出力のリテラルが 2 * (M + 1) 以上になっている．
+  string filename = "broken_literal.aig";
+  string path = DATAPATH + filename;
+  EXPECT_THROW( BnNetwork::read_aig(path), std::invalid_argument );
+}
+
+TEST(ReadAigTest, self_fanin)
+{
+  // AND の1つめのファンインの差分が 0 で自分自身を指している．
+  string filename = "broken_delta.aig";
+  string path = DATAPATH + filename;
+  EXPECT_THROW( BnNetwork::read_aig(path), std::invalid_argument );
+}
+
+END_NAMESPACE_YM
@@ -8,6 +8,7 @@
 
 #include "gtest/gtest.h"
 #include "ym/BnNetwork.h"
+#include "ym/BnCec.h"
 
 
 BEGIN_NAMESPACE_YM
@@ -44,6 +45,126 @@ TEST(ReadBlifTest, test)
   EXPECT_EQ( ref_contents, s1.str() );
 }
 
+TEST(ReadBlifTest, comment)
+{
+  string filename = "comment.blif";
+  string path = DATAPATH + filename;
+  auto network = BnNetwork::read_blif(path);
+  EXPECT_EQ( "comment", network.name() );
+  EXPECT_EQ( 3, network.input_num() );
+  EXPECT_EQ( 1, network.output_num() );
+  EXPECT_EQ( 2, network.logic_num() );
+}
+
+TEST(ReadBlifTest, direct)
+{
+  string filename = "s5378.blif";
+  string path = DATAPATH + filename;
+  auto network1 = BnNetwork::read_blif(path);
+  auto network2 = BnNetwork::read_blif_direct(path);
+  EXPECT_EQ( network1.name(), network2.name() );
+  EXPECT_EQ( network1.input_num(), network2.input_num() );
+  EXPECT_EQ( network1.output_num(), network2.output_num() );
+  EXPECT_EQ( network1.logic_num(), network2.logic_num() );
+  EXPECT_EQ( network1.port_num(), network2.port_num() );
+  EXPECT_EQ( network1.dff_num(), network2.dff_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(ReadBlifTest, direct_forward)
+{
+  // 定義より前に参照される信号を含む
+  string filename = "forward.blif";
+  string path = DATAPATH + filename;
+  auto network1 = BnNetwork::read_blif(path);
+  auto network2 = BnNetwork::read_blif_direct(path);
+  EXPECT_EQ( "forward", network2.name() );
+  EXPECT_EQ( 3, network2.input_num() );
+  EXPECT_EQ( 1, network2.output_num() );
+  EXPECT_EQ( 4, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(ReadBlifTest, direct_loop)
+{
+  string filename = "loop.blif";
+  string path = DATAPATH + filename;
+  EXPECT_THROW( {
+      auto _ = BnNetwork::read_blif_direct(path);
+    }, std::invalid_argument );
+}
+
+TEST(ReadBlifTest, direct_file_not_found)
+{
+  EXPECT_THROW( {
+      auto _ = BnNetwork::read_blif_direct("not_exist_file");
+    }, std::invalid_argument );
+}
+
+TEST(ReadBlifTest, direct_wrong_data)
+{
+  string filename = "broken.blif";
+  string path = DATAPATH + filename;
+  EXPECT_THROW( {
+      auto _ = BnNetwork::read_blif_direct(path);
+    }, std::invalid_argument );
+}
+
+TEST(ReadBlifTest, parallel)
+{
+  string filename = "s5378.blif";
+  string path = DATAPATH + filename;
+  auto network1 = BnNetwork::read_blif(path);
+  ostringstream s1;
+  network1.write(s1);
+  for ( SizeType thread_num: {2, 4, 7} ) {
+    auto network2 = BnNetwork::read_blif(path, string{}, string{}, thread_num);
+    ostringstream s2;
+    network2.write(s2);
+    EXPECT_EQ( s1.str(), s2.str() );
+  }
+}
+
+TEST(ReadBlifTest, parallel_direct)
+{
+  string filename = "s5378.blif";
+  string path = DATAPATH + filename;
+  auto network1 = BnNetwork::read_blif_direct(path);
+  ostringstream s1;
+  network1.write(s1);
+  auto network2 = BnNetwork::read_blif_direct(path, string{}, string{}, 4);
+  ostringstream s2;
+  network2.write(s2);
+  EXPECT_EQ( s1.str(), s2.str() );
+}
+
+TEST(ReadBlifTest, parallel_fallback)
+{
+  // 並列に扱えない内容を含むので逐次版で読み直される．
+  string filename = "comment.blif";
+  string path = DATAPATH + filename;
+  auto network1 = BnNetwork::read_blif(path);
+  ostringstream s1;
+  network1.write(s1);
+  auto network2 = BnNetwork::read_blif(path, string{}, string{}, 4);
+  ostringstream s2;
+  network2.write(s2);
+  EXPECT_EQ( s1.str(), s2.str() );
+}
+
+TEST(ReadBlifTest, parallel_wrong_data)
+{
+  string filename = "broken.blif";
+  string path = DATAPATH + filename;
+  EXPECT_THROW( {
+      auto _ = BnNetwork::read_blif(path, string{}, string{}, 4);
+    }, std::invalid_argument );
+}
+
 TEST(ReadBlifTest, file_not_found)
 {
   EXPECT_THROW( {
@@ -0,0 +1,103 @@
+
+/// @file redundancy_test.cc
+/// @brief redundancy_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnCec.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnModifier.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(RedundancyTest, absorption)
+{
+  // a | (a & b) の a & b は 0 縮退故障が検出不能
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {port1.bit(0), and1});
+  mod1.set_output_src(port3.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType removed_num;
+  auto network2 = network1.remove_redundancy(16, 1000, removed_num);
+  EXPECT_EQ( 1, removed_num );
+  EXPECT_EQ( 0, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(RedundancyTest, sat_only)
+{
+  // ランダムシミュレーションを行わずに SAT のみで調べる．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto and2 = mod1.new_and({}, {port1.bit(0), port2.bit(0), port3.bit(0)});
+  auto or1 = mod1.new_or({}, {and1, and2});
+  mod1.set_output_src(port4.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType removed_num;
+  auto network2 = network1.remove_redundancy(0, 0, removed_num);
+  EXPECT_EQ( 1, removed_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(RedundancyTest, non_topological)
+{
+  // a | (a & b) を logic_list() がトポロジカル順にならないように作る．
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_output_port("o");
+  auto or1 = mod1.new_or({}, {port1.bit(0), port2.bit(0)});
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  mod1.change_primitive(or1, PrimType::Or, {port1.bit(0), and1});
+  mod1.set_output_src(port3.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType removed_num;
+  auto network2 = network1.remove_redundancy(16, 1000, removed_num);
+  EXPECT_EQ( 1, removed_num );
+  EXPECT_EQ( 0, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(RedundancyTest, irredundant)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o");
+  auto xor1 = mod1.new_xor({}, {port1.bit(0), port2.bit(0)});
+  auto and1 = mod1.new_and({}, {xor1, port3.bit(0)});
+  mod1.set_output_src(port4.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType removed_num;
+  auto network2 = network1.remove_redundancy(16, 1000, removed_num);
+  EXPECT_EQ( 0, removed_num );
+  EXPECT_EQ( 2, network2.logic_num() );
+}
+
+END_NAMESPACE_YM
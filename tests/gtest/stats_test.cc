@@ -0,0 +1,93 @@
+
+/// @file stats_test.cc
+/// @brief stats_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnModifier.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(StatsTest, test1)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto xor1 = mod1.new_xor(string{}, {and1, input3});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, xor1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  auto stats = network1.stats();
+  EXPECT_EQ( 4, stats.port_num );
+  EXPECT_EQ( 0, stats.dff_num );
+  EXPECT_EQ( 3, stats.input_num );
+  EXPECT_EQ( 3, stats.primary_input_num );
+  EXPECT_EQ( 1, stats.output_num );
+  EXPECT_EQ( 1, stats.primary_output_num );
+  EXPECT_EQ( 2, stats.logic_num );
+  EXPECT_EQ( 3, stats.node_type_count(BnNodeType::Input) );
+  EXPECT_EQ( 1, stats.node_type_count(BnNodeType::Output) );
+  EXPECT_EQ( 2, stats.node_type_count(BnNodeType::Prim) );
+  EXPECT_EQ( 0, stats.node_type_count(BnNodeType::Expr) );
+  EXPECT_EQ( 1, stats.prim_type_count(PrimType::And) );
+  EXPECT_EQ( 1, stats.prim_type_count(PrimType::Xor) );
+  EXPECT_EQ( 0, stats.prim_type_count(PrimType::Or) );
+  EXPECT_EQ( 0, stats.dff_type_count(BnDffType::Dff) );
+  ASSERT_EQ( 3, stats.fanin_hist.size() );
+  EXPECT_EQ( 2, stats.fanin_hist[2] );
+  ASSERT_EQ( 2, stats.fanout_hist.size() );
+  EXPECT_EQ( 5, stats.fanout_hist[1] );
+  EXPECT_EQ( 2, stats.depth );
+  EXPECT_EQ( 0, stats.expr_num );
+  EXPECT_EQ( 0, stats.func_num );
+}
+
+TEST(StatsTest, depth_after_change)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_input_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto input3 = port3.bit(0);
+
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto xor1 = mod1.new_xor(string{}, {and1, input3});
+  // 後から作ったノードを and1 のファンインにするので
+  // 論理ノードのリストはトポロジカル順ではなくなる．
+  auto not1 = mod1.new_not(string{}, input2);
+  mod1.change_primitive(and1, PrimType::And, {input1, not1});
+
+  auto output1 = port4.bit(0);
+  mod1.set_output_src(output1, xor1);
+
+  BnNetwork network1{std::move(mod1)};
+
+  auto stats = network1.stats();
+  EXPECT_EQ( 3, stats.logic_num );
+  EXPECT_EQ( 3, stats.depth );
+}
+
+END_NAMESPACE_YM
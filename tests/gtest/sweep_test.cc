@@ -0,0 +1,280 @@
+
+/// @file sweep_test.cc
+/// @brief sweep_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/Expr.h"
+#include "ym/TvFunc.h"
+#include "ym/BnModifier.h"
+#include "ym/BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM
+
+TEST(SweepTest, const_and)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_output_port("port2");
+
+  auto input1 = port1.bit(0);
+  auto c0 = mod1.new_c0(string{});
+  auto and1 = mod1.new_and(string{}, {input1, c0});
+  mod1.set_output_src(port2.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType removed_num;
+  auto network2 = network1.sweep(removed_num);
+  EXPECT_EQ( 2, removed_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  EXPECT_EQ( BnNodeType::Prim, src.type() );
+  EXPECT_EQ( PrimType::C0, src.primitive_type() );
+}
+
+TEST(SweepTest, const_or)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto c0 = mod1.new_c0(string{});
+  // (a & b) | c で c が定数0なら a & b になる．
+  auto expr = (Expr::make_posi_literal(0) & Expr::make_posi_literal(1))
+    | Expr::make_posi_literal(2);
+  auto node1 = mod1.new_logic_expr(string{}, expr, {input1, input2, c0});
+  mod1.set_output_src(port3.bit(0), node1);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.sweep();
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  EXPECT_EQ( 2, src.fanin_num() );
+  EXPECT_EQ( PrimType::And, src.primitive_type() );
+}
+
+TEST(SweepTest, inverter_chain)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+  auto port4 = mod1.new_output_port("port4");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto not1 = mod1.new_not(string{}, input1);
+  auto not2 = mod1.new_not(string{}, not1);
+  auto buf1 = mod1.new_logic_primitive(string{}, PrimType::Buff, {not2});
+  mod1.set_output_src(port3.bit(0), buf1);
+  // インバーターはファンインの極性として吸収される．
+  auto not3 = mod1.new_not(string{}, input2);
+  auto and1 = mod1.new_and(string{}, {not1, not3});
+  mod1.set_output_src(port4.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType removed_num;
+  auto network2 = network1.sweep(removed_num);
+  EXPECT_EQ( 4, removed_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto src3 = network2.output_node(0).output_src();
+  EXPECT_EQ( BnNodeType::Input, src3.type() );
+  EXPECT_EQ( network2.input_node(0).id(), src3.id() );
+  auto src4 = network2.output_node(1).output_src();
+  // ~input1 & ~input2 となり，入力を直接ファンインに持つ．
+  ASSERT_EQ( 2, src4.fanin_num() );
+  EXPECT_EQ( network2.input_node(0).id(), src4.fanin_id(0) );
+  EXPECT_EQ( network2.input_node(1).id(), src4.fanin_id(1) );
+}
+
+TEST(SweepTest, inverted_output)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_output_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto not1 = mod1.new_not(string{}, input1);
+  auto buf1 = mod1.new_logic_primitive(string{}, PrimType::Buff, {not1});
+  mod1.set_output_src(port2.bit(0), not1);
+  mod1.set_output_src(port3.bit(0), buf1);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.sweep();
+  // インバーターは共有される．
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto src2 = network2.output_node(0).output_src();
+  auto src3 = network2.output_node(1).output_src();
+  EXPECT_EQ( src2.id(), src3.id() );
+  EXPECT_EQ( PrimType::Not, src2.primitive_type() );
+}
+
+TEST(SweepTest, xor_cancel)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto buf1 = mod1.new_logic_primitive(string{}, PrimType::Buff, {input1});
+  // input1 ^ input2 ^ input1 = input2
+  auto xor1 = mod1.new_xor(string{}, {input1, input2, buf1});
+  mod1.set_output_src(port3.bit(0), xor1);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.sweep();
+  EXPECT_EQ( 0, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  EXPECT_EQ( network2.input_node(1).id(), src.id() );
+}
+
+TEST(SweepTest, dead_node)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto or1 = mod1.new_or(string{}, {input1, input2});
+  // or1 とそれだけが使っている xor1 はどこからも参照されない．
+  mod1.new_xor(string{}, {or1, input2});
+  mod1.set_output_src(port3.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  SizeType removed_num;
+  auto network2 = network1.sweep(removed_num);
+  EXPECT_EQ( 2, removed_num );
+  EXPECT_EQ( 1, network2.logic_num() );
+  EXPECT_EQ( PrimType::And, network2.output_node(0).output_src().primitive_type() );
+}
+
+TEST(SweepTest, tv_const)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto c1 = mod1.new_c1(string{});
+  // f(a, b, c) = a & c | b & ~c
+  TvFunc func{3, vector<int>{0, 0, 1, 1, 0, 1, 0, 1}};
+  auto node1 = mod1.new_logic_tv(string{}, func, {input1, input2, c1});
+  mod1.set_output_src(port3.bit(0), node1);
+  BnNetwork network1{std::move(mod1)};
+
+  // c = 1 なので f = a となる．
+  auto network2 = network1.sweep();
+  EXPECT_EQ( 0, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  EXPECT_EQ( network2.input_node(0).id(), src.id() );
+}
+
+
+TEST(SweepTest, non_topological)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto and1 = mod1.new_and(string{}, {input1, input2});
+  auto or1 = mod1.new_or(string{}, {input1, input2});
+  // and1 を後から作った or1 に依存させる．
+  // logic_list() では and1 が or1 より前にある．
+  mod1.change_primitive(and1, PrimType::And, {input1, or1});
+  mod1.set_output_src(port3.bit(0), and1);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.sweep();
+  EXPECT_EQ( 2, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  ASSERT_TRUE( src.is_logic() );
+  ASSERT_EQ( 2, src.fanin_num() );
+  auto node1 = network2.node(src.fanin_id(1));
+  // or1 が定数0と誤って扱われると and1 も定数0になる．
+  EXPECT_TRUE( node1.is_logic() );
+  EXPECT_EQ( network2.input_node(0).id(), src.fanin_id(0) );
+}
+
+TEST(SweepTest, bdd_const)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto c1 = mod1.new_c1(string{});
+  // f(a, b, c) = a & c | b & ~c
+  BddMgr mgr;
+  auto a = mgr.literal(0);
+  auto b = mgr.literal(1);
+  auto c = mgr.literal(2);
+  auto bdd = (a & c) | (b & ~c);
+  auto node1 = mod1.new_logic_bdd(string{}, bdd, {input1, input2, c1});
+  mod1.set_output_src(port3.bit(0), node1);
+  BnNetwork network1{std::move(mod1)};
+
+  // c = 1 なので f = a となる．
+  auto network2 = network1.sweep();
+  EXPECT_EQ( 0, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  EXPECT_EQ( network2.input_node(0).id(), src.id() );
+}
+
+TEST(SweepTest, bdd_fanin)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("port1");
+  auto port2 = mod1.new_input_port("port2");
+  auto port3 = mod1.new_output_port("port3");
+
+  auto input1 = port1.bit(0);
+  auto input2 = port2.bit(0);
+  auto c0 = mod1.new_c0(string{});
+  // f(a, b, c) = a & b | c
+  BddMgr mgr;
+  auto a = mgr.literal(0);
+  auto b = mgr.literal(1);
+  auto c = mgr.literal(2);
+  auto bdd = (a & b) | c;
+  auto node1 = mod1.new_logic_bdd(string{}, bdd, {input1, input2, c0});
+  mod1.set_output_src(port3.bit(0), node1);
+  BnNetwork network1{std::move(mod1)};
+
+  // c = 0 なので定数のファンインが取り除かれて f = a & b となる．
+  auto network2 = network1.sweep();
+  EXPECT_EQ( 1, network2.logic_num() );
+  auto src = network2.output_node(0).output_src();
+  EXPECT_EQ( BnNodeType::Bdd, src.type() );
+  ASSERT_EQ( 2, src.fanin_num() );
+  EXPECT_EQ( network2.input_node(0).id(), src.fanin_id(0) );
+  EXPECT_EQ( network2.input_node(1).id(), src.fanin_id(1) );
+  // a = 0 なら 0 となる．
+  auto f = src.bdd();
+  EXPECT_TRUE( f.root_cofactor0().is_zero() );
+  EXPECT_FALSE( f.root_cofactor1().is_zero() );
+}
+
+END_NAMESPACE_YM
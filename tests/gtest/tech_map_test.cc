@@ -0,0 +1,158 @@
+
+/// @file tech_map_test.cc
+/// @brief tech_map_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2023 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/BnCec.h"
+#include "ym/BnNetwork.h"
+#include "ym/BnPort.h"
+#include "ym/BnNode.h"
+#include "ym/BnDff.h"
+#include "ym/Expr.h"
+#include "ym/BnModifier.h"
+#include "ym/ClibCellLibrary.h"
+
+
+BEGIN_NAMESPACE_YM
+
+BEGIN_NONAMESPACE
+
+ClibCellLibrary
+read_library()
+{
+  string path = DATAPATH + string{"simple.genlib"};
+  return ClibCellLibrary::read_mislib(path);
+}
+
+END_NONAMESPACE
+
+TEST(TechMapTest, and_or)
+{
+  BnModifier mod1;
+  mod1.set_library(read_library());
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_output_port("o");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port2.bit(0)});
+  auto or1 = mod1.new_or({}, {and1, port3.bit(0)});
+  mod1.set_output_src(port4.bit(0), or1);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.tech_map();
+  EXPECT_TRUE( network2.is_mapped() );
+  // (a & b) | c は ~aoi21 で実現できる．
+  EXPECT_EQ( 2, network2.logic_num() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(TechMapTest, expr)
+{
+  BnModifier mod1;
+  mod1.set_library(read_library());
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("b");
+  auto port3 = mod1.new_input_port("c");
+  auto port4 = mod1.new_input_port("d");
+  auto port5 = mod1.new_output_port("o1");
+  auto port6 = mod1.new_output_port("o2");
+  auto lit0 = Expr::make_posi_literal(0);
+  auto lit1 = Expr::make_posi_literal(1);
+  auto lit2 = Expr::make_posi_literal(2);
+  auto lit3 = Expr::make_posi_literal(3);
+  auto expr1 = (lit0 & ~lit1) | (lit2 ^ lit3);
+  auto expr2 = ~(lit0 | lit1 | lit2 | lit3);
+  vector<BnNode> fanin_list{port1.bit(0), port2.bit(0),
+			    port3.bit(0), port4.bit(0)};
+  auto node1 = mod1.new_logic_expr({}, expr1, fanin_list);
+  auto node2 = mod1.new_logic_expr({}, expr2, fanin_list);
+  mod1.set_output_src(port5.bit(0), node1);
+  mod1.set_output_src(port6.bit(0), node2);
+  BnNetwork network1{std::move(mod1)};
+
+  for ( SizeType cut_size: {2, 4, 6} ) {
+    auto network2 = network1.tech_map(cut_size);
+    EXPECT_TRUE( network2.is_mapped() );
+
+    BnCec cec{network1, network2};
+    EXPECT_TRUE( cec.check() );
+  }
+
+  // スレッド数によらず同じ結果になる．
+  auto network3 = network1.tech_map(4, 1);
+  auto network4 = network1.tech_map(4, 4);
+  EXPECT_EQ( network3.logic_num(), network4.logic_num() );
+}
+
+TEST(TechMapTest, const_output)
+{
+  BnModifier mod1;
+  mod1.set_library(read_library());
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_output_port("o1");
+  auto port3 = mod1.new_output_port("o2");
+  auto and1 = mod1.new_and({}, {port1.bit(0), port1.bit(0)});
+  auto c1 = mod1.new_c1({});
+  mod1.set_output_src(port2.bit(0), and1);
+  mod1.set_output_src(port3.bit(0), c1);
+  BnNetwork network1{std::move(mod1)};
+
+  auto network2 = network1.tech_map();
+  EXPECT_TRUE( network2.is_mapped() );
+  // a & a は a そのものになり，定数1は one セルになる．
+  EXPECT_EQ( 1, network2.logic_num() );
+  EXPECT_EQ( network2.input_node(0).id(),
+	     network2.output_node(0).output_src().id() );
+
+  BnCec cec{network1, network2};
+  EXPECT_TRUE( cec.check() );
+}
+
+TEST(TechMapTest, bad_cut_size)
+{
+  BnModifier mod1;
+  mod1.set_library(read_library());
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_output_port("o");
+  mod1.set_output_src(port2.bit(0), port1.bit(0));
+  BnNetwork network1{std::move(mod1)};
+
+  EXPECT_THROW( network1.tech_map(1), std::invalid_argument );
+  EXPECT_THROW( network1.tech_map(7), std::invalid_argument );
+}
+
+TEST(TechMapTest, dff)
+{
+  // セル型でない DFF は扱わない．
+  BnModifier mod1;
+  mod1.set_library(read_library());
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_input_port("clk");
+  auto port3 = mod1.new_output_port("o");
+  auto dff = mod1.new_dff("q");
+  mod1.set_output_src(dff.data_in(), port1.bit(0));
+  mod1.set_output_src(dff.clock(), port2.bit(0));
+  mod1.set_output_src(port3.bit(0), dff.data_out());
+  BnNetwork network1{std::move(mod1)};
+
+  EXPECT_THROW( network1.tech_map(), std::invalid_argument );
+}
+
+TEST(TechMapTest, no_library)
+{
+  BnModifier mod1;
+  auto port1 = mod1.new_input_port("a");
+  auto port2 = mod1.new_output_port("o");
+  mod1.set_output_src(port2.bit(0), port1.bit(0));
+  BnNetwork network1{std::move(mod1)};
+
+  EXPECT_THROW( network1.tech_map(), std::invalid_argument );
+}
+
+END_NAMESPACE_YM
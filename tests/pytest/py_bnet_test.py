@@ -39,3 +39,30 @@ def test_read_iscas89():
     assert ng == network.logic_num
     assert ni + no + 1 == network.port_num
     assert nd == network.dff_num
+
+def test_stats():
+    TESTDATA_DIR = os.environ.get('TESTDATA_DIR')
+    filename = os.path.join(TESTDATA_DIR, 'b10.bench')
+    network = BnNetwork.read_iscas89(filename)
+    stats = network.stats()
+    ni = 11
+    no = 6
+    nd = 17
+    ng = 172
+    assert ni + no + 1 == stats['port_num']
+    assert nd == stats['dff_num']
+    assert ni + nd + 1 == stats['input_num']
+    assert no + nd + nd == stats['output_num']
+    assert ng == stats['logic_num']
+    node_type_num = stats['node_type_num']
+    assert ni + nd + 1 == node_type_num['Input']
+    assert no + nd + nd == node_type_num['Output']
+    nl = 0
+    for name in ('Prim', 'Expr', 'TvFunc', 'Bdd', 'Cell'):
+        nl += node_type_num[name]
+    assert ng == nl
+    assert node_type_num['Prim'] == sum(stats['prim_type_num'].values())
+    assert nd == stats['dff_type_num']['Dff']
+    assert 0 == stats['dff_type_num']['Latch']
+    assert ng == sum(stats['fanin_hist'])
+    assert 0 < stats['depth']